@@ -51,6 +51,7 @@
 #include "common/padding.hpp"
 #include "utils/kmer_utils.hpp"
 #include "utils/bitgroup_ops.hpp"
+#include "utils/bitgroup_dispatch.hpp"
 
 #define KMER_INLINE inline
 
@@ -1571,45 +1572,12 @@ namespace bliss
 
 
 
-//    /// reverse the kmer.  only parameter of ALPHABET that matters here is bitsPerChar.
-//    template <typename A = ALPHABET,
-//        typename ::std::enable_if<::std::is_same<A, DNA6>::value ||
-//                                  ::std::is_same<A, RNA6>::value, int>::type = 0>
-//    KMER_INLINE void do_reverse(Kmer const & src, Kmer & result) const
-//    {
-//
-//      // choose based on performance.  AVX is faster >256 bit, below it SWAR is faster.
-//      if (nAllocBytes >= 16)
-//        ::bliss::utils::bit_ops::reverse<bitsPerChar, ::bliss::utils::bit_ops::BIT_REV_AVX2>(result.data, src.data);
-//      else if (nAllocBytes >= 12)
-//        ::bliss::utils::bit_ops::reverse<bitsPerChar, ::bliss::utils::bit_ops::BIT_REV_SSSE3>(result.data, src.data);
-//      else
-//        ::bliss::utils::bit_ops::reverse<bitsPerChar, ::bliss::utils::bit_ops::BIT_REV_SWAR>(result.data, src.data);
-//
-//      result.do_right_shift((nWords << LogWordBits) - nBits);
-//
-//    }
-//
-//    /// reverse the kmer.  only parameter of ALPHABET that matters here is bitsPerChar.
-//    template <typename A = ALPHABET,
-//        typename ::std::enable_if<!(::std::is_same<A, DNA6>::value ||
-//                                    ::std::is_same<A, RNA6>::value), int>::type = 0>
-//    KMER_INLINE Kmer do_reverse(Kmer const & src) const
-//    {
-//      Kmer result(false);
-//
-//      // choose based on performance.  AVX is faster >256 bit (and fallback to SSSE3 is okay), below 256 SWAR is faster.
-//      if (nAllocBytes > 32)
-//        ::bliss::utils::bit_ops::reverse<bitsPerChar, ::bliss::utils::bit_ops::BIT_REV_AVX2>(result.data, src.data);
-////      else if (nAllocBytes > 16)
-////        ::bliss::utils::bit_ops::reverse<bitsPerChar, ::bliss::utils::bit_ops::BIT_REV_SSSE3>(result.data, src.data);
-//      else
-//        ::bliss::utils::bit_ops::reverse<bitsPerChar, ::bliss::utils::bit_ops::BIT_REV_SWAR>(result.data, src.data);
-//
-//      result.do_right_shift((nWords << LogWordBits) - nBits);
-//
-//      return result;
-//    }
+    /// true if reverse / reverse complement should use the run time dispatched kernels (utils/bitgroup_dispatch.hpp):
+    /// the CPU has a wider SIMD than the one compiled in, and the k-mer is long enough to amortize the indirect call.
+    static KMER_INLINE bool use_dispatched_reverse()
+    {
+      return (nAllocBytes >= 32) && ::bliss::utils::bit_ops::cpu_simd_exceeds_compiled();
+    }
 
     /// reverse the bits and shift at the same time.  + means left shift, - means right shift (MSB has index K-1)
     template <typename A = ALPHABET,
@@ -1622,7 +1590,10 @@ namespace bliss
       using SIMDType = bliss::utils::bit_ops::BITREV_AUTO_AGGRESSIVE<nAllocBytes>;
       int nslli = left_shift * bitsPerChar;
 
-      if (left_shift == 0) {
+      if ((left_shift == 0) && use_dispatched_reverse()) {
+        bliss::utils::bit_ops::reverse_dispatch<bitsPerChar>(result.data, src.data, nWords);
+        if (bitstream::padBits > 0) result.do_right_shift(bitstream::padBits);
+      } else if (left_shift == 0) {
         bliss::utils::bit_ops::reverse<bitsPerChar,
                                       SIMDType,
                                       bitstream::padBits,   // right shift field.
@@ -1731,7 +1702,11 @@ namespace bliss
       using SIMDType = bliss::utils::bit_ops::BITREV_AUTO_AGGRESSIVE<nAllocBytes>;
   	  ::bliss::utils::bit_ops::bitgroup_ops<bitsPerChar, SIMDType::SIMDVal> op;
 
-      if (left_shift == 0) {
+      if ((left_shift == 0) && use_dispatched_reverse()) {
+        // the complemented pad bits end up at the low end, and are shifted out.
+        bliss::utils::bit_ops::reverse_complement_dispatch<bitsPerChar>(result.data, src.data, nWords);
+        if (bitstream::padBits > 0) result.do_right_shift(bitstream::padBits);
+      } else if (left_shift == 0) {
         bliss::utils::bit_ops::reverse_transform<SIMDType,
                                       bitstream::padBits,   // right shift field.
                                       0,
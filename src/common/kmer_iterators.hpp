@@ -178,8 +178,82 @@ namespace bliss
     /// The kmer buffer (i.e. the window of the sliding window)
     kmer_type kmer;
   };
-  
-  
+
+
+  /**
+   * @brief The sliding window operator for canonical k-mer generation from character data.
+   * @details  maintains the forward k-mer and its reverse complement side by side,
+   *          so each step costs 2 single character shifts instead of a full
+   *          multi-word reverse complement.  getValue returns the lexicographically
+   *          smaller of the 2, i.e. the same as bliss::kmer::transform::lex_less.
+   * @note  base iterator supplies characters already translated into the alphabet.
+   *
+   * @tparam BaseIterator Type of the underlying base iterator, which returns
+   *                      characters.
+   * @tparam Kmer         The k-mer type, must be of type bliss::Kmer
+   */
+  template <class BaseIterator, class Kmer>
+  class CanonicalKmerSlidingWindow {};
+
+  template <typename BaseIterator, unsigned int KMER_SIZE,
+            typename ALPHABET, typename word_type>
+  class CanonicalKmerSlidingWindow<BaseIterator, bliss::common::Kmer<KMER_SIZE, ALPHABET, word_type> >
+  {
+  public:
+    /// The Kmer type (same as the `value_type` of this iterator)
+    typedef bliss::common::Kmer<KMER_SIZE, ALPHABET, word_type> kmer_type;
+    typedef BaseIterator  base_iterator_type;
+    /// The value_type of the underlying iterator
+    typedef typename std::iterator_traits<BaseIterator>::value_type base_value_type;
+
+    /**
+     * @brief Initializes the sliding window.
+     *
+     * @param it[in|out]  The current base iterator position. This will be set to
+     *                    the last read position.
+     */
+    inline void init(BaseIterator& it)
+    {
+      kmer.fillFromChars(it, true);
+      // reverse complement from the forward kmer once.  subsequent steps are incremental.
+      kmer.reverse_complement(rc);
+    }
+
+    /**
+     * @brief Slides the window by one character taken from the given iterator.
+     *
+     * This will read the current character of the iterator and then advance the
+     * iterator by one.
+     *
+     * @param it[in|out]  The underlying iterator position, this will be read
+     *                    and then advanced.
+     */
+    inline void next(BaseIterator& it)
+    {
+      uint8_t c = static_cast<uint8_t>(*it);
+      kmer.nextFromChar(c);
+      rc.nextReverseFromChar(ALPHABET::to_complement(c));
+      ++it;
+    }
+
+    /**
+     * @brief Returns the value of the current sliding window, i.e., the current
+     *        canonical k-mer value.
+     *
+     * @return The lexicographically smaller of the k-mer and its reverse complement.
+     */
+    inline kmer_type getValue()
+    {
+      return (kmer < rc) ? this->kmer : this->rc;
+    }
+  private:
+    /// The kmer buffer (i.e. the window of the sliding window)
+    kmer_type kmer;
+    /// The reverse complement of the kmer buffer.
+    kmer_type rc;
+  };
+
+
   /**
    * @brief Iterator that generates k-mers from character data.
    *
@@ -276,7 +350,11 @@ namespace bliss
   /// reverse KmerGenerationIterator for generating kmers from a sequence of alphabet characters.  can be used for reverse complements.
   template <class BaseIterator, class Kmer>
   using ReverseKmerGenerationIterator = KmerGenerationIteratorBase<ReverseKmerSlidingWindow<BaseIterator, Kmer > >;
-  
+
+  /// canonical KmerGenerationIterator for generating the lex_less of kmer and its reverse complement, incrementally.
+  template <class BaseIterator, class Kmer>
+  using CanonicalKmerGenerationIterator = KmerGenerationIteratorBase<CanonicalKmerSlidingWindow<BaseIterator, Kmer > >;
+
   
   
   
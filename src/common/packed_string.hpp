@@ -165,7 +165,46 @@ namespace bliss
     {
       return this->nChars;
     }
-  
+
+    /**
+     * @brief   Returns a pointer to the packed storage words.  The words
+     *          contain `size()` packed characters, least significant bits first,
+     *          so that the storage can be written out and later decoded
+     *          in place via `unpackCharAt()`, e.g. from a memory mapped file.
+     *
+     * @return  Pointer to the first storage word.
+     */
+    const WordType* data() const
+    {
+      return this->packedString.data();
+    }
+
+    /**
+     * @brief   Returns the number of storage words used by this PackedString.
+     *
+     * @return  The number of words pointed to by `data()`.
+     */
+    size_type word_count() const
+    {
+      return this->nWords;
+    }
+
+    /**
+     * @brief Returns the packed char with position `idx` from an external
+     *        array of storage words with the same layout as `data()`.
+     *
+     * @param words   Pointer to the first storage word.
+     * @param idx     The index of the packed character to be returned.
+     * @return        The unpacked character with position `idx`.
+     */
+    static inline value_type unpackCharAt(const WordType* words, index_type idx)
+    {
+      return unpackChar(words[idx / charsPerWord], idx % charsPerWord);
+    }
+
+    /// The number of characters that are packed into one storage word.
+    static constexpr BitSizeType chars_per_word = (sizeof(WordType) * 8) / BITS_PER_CHAR;
+
   private:
     /// The base container for the packed sequence.
     std::vector<WordType> packedString;
@@ -275,13 +314,16 @@ namespace bliss
      * @param char_idx[in]  The index to the character to be unpacked and
      *                      returned.
      */
-    inline CharType unpackChar(const WordType& word, const BitSizeType char_idx) const
+    static inline CharType unpackChar(const WordType& word, const BitSizeType char_idx)
     {
       WordType mask = getWordBitMask(bitsPerChar, char_idx * bitsPerChar);
       return static_cast<CharType>((word & mask) >> (char_idx * bitsPerChar));
     }
   };
   
+  template <BitSizeType BITS_PER_CHAR, typename CharType, typename WordType>
+  constexpr BitSizeType PackedStringImpl<BITS_PER_CHAR, CharType, WordType>::chars_per_word;
+
   /**
    * @brief A packed string representation for the given alphabet T.
    *
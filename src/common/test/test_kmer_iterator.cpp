@@ -23,6 +23,7 @@
 #include "common/alphabets.hpp"
 #include "iterators/transform_iterator.hpp"
 #include "common/kmer_iterators.hpp"
+#include "common/kmer_transform.hpp"
 #include "utils/kmer_utils.hpp"
 #include "utils/logging.h"
 
@@ -120,3 +121,62 @@ TEST(KmerIterator, TestKmerIteratorDNA5MultiWord)
 }
 
 
+
+
+template<typename Alphabet, int K>
+void compute_canonical_kmer_iter(std::string input) {
+
+  using KmerType = bliss::common::Kmer<K, Alphabet>;
+
+  using BaseIterator = std::string::const_iterator;
+
+  using Decoder = bliss::common::ASCII2<Alphabet, typename BaseIterator::value_type>;
+  using BaseCharIterator = bliss::iterator::transform_iterator<BaseIterator, Decoder>;
+
+  BaseCharIterator charStart(input.cbegin(), Decoder());
+  BaseCharIterator charEnd  (input.cend(),   Decoder());
+
+  using KmerIterator = bliss::common::KmerGenerationIterator<BaseCharIterator, KmerType>;
+  using CanonicalIterator = bliss::common::CanonicalKmerGenerationIterator<BaseCharIterator, KmerType>;
+
+  KmerIterator start(charStart, true);
+  KmerIterator end(charEnd, false);
+  CanonicalIterator cstart(charStart, true);
+  CanonicalIterator cend(charEnd, false);
+
+  bliss::kmer::transform::lex_less<KmerType> canonicalize;
+
+  int i = 0;
+  KmerType gold, kmer;
+  for (; (start != end) && (cstart != cend); ++start, ++cstart, ++i) {
+    gold = canonicalize(*start);
+    kmer = *cstart;
+
+    if (!(gold == kmer)) {
+      BL_INFOF("%d canonical kmer %s, expected %s\n", i, kmer.toAlphabetString().c_str(), gold.toAlphabetString().c_str());
+    }
+
+    EXPECT_EQ(gold, kmer);
+  }
+  EXPECT_TRUE(start == end);
+  EXPECT_TRUE(cstart == cend);
+  EXPECT_EQ(static_cast<int>(input.length()) - K + 1, i);
+}
+
+/**
+ * Test canonical k-mer generation against lex_less of reverse complements.
+ */
+TEST(KmerIterator, TestCanonicalKmerIterator)
+{
+  std::string input = "GATTTGGGGTTCAAAGCAGT"
+                         "ATCGATCAAATAGTAAATCC"
+                         "ATTTGTTCAACTCACAGTTT";
+
+  compute_canonical_kmer_iter<bliss::common::DNA, 21>(input);
+  compute_canonical_kmer_iter<bliss::common::DNA, 32>(input);
+  compute_canonical_kmer_iter<bliss::common::DNA, 33>(input);
+  compute_canonical_kmer_iter<bliss::common::DNA5, 21>(input);
+  compute_canonical_kmer_iter<bliss::common::DNA5, 33>(input);
+  compute_canonical_kmer_iter<bliss::common::DNA16, 21>(input);
+  compute_canonical_kmer_iter<bliss::common::DNA16, 33>(input);
+}
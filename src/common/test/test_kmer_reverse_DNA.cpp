@@ -36,6 +36,8 @@ typedef ::testing::Types<
     ::bliss::common::Kmer< 64, bliss::common::DNA,   uint64_t>,  // 2 words, full
     ::bliss::common::Kmer< 80, bliss::common::DNA,   uint64_t>,  // 3 words, not full
     ::bliss::common::Kmer< 96, bliss::common::DNA,   uint64_t>,  // 3 words, full
+    ::bliss::common::Kmer<128, bliss::common::DNA,   uint64_t>,  // 4 words, full.  32 bytes and up may use the dispatched reverse
+    ::bliss::common::Kmer<151, bliss::common::DNA,   uint64_t>,  // 5 words, not full
     ::bliss::common::Kmer< 15, bliss::common::DNA,   uint32_t>,  // 1 word, not full
     ::bliss::common::Kmer< 16, bliss::common::DNA,   uint32_t>,  // 1 word, full
     ::bliss::common::Kmer< 32, bliss::common::DNA,   uint32_t>,  // 2 words, full
@@ -35,6 +35,8 @@ typedef ::testing::Types<
      ::bliss::common::Kmer< 32, bliss::common::DNA16, uint64_t>,  // 2 words, full
      ::bliss::common::Kmer< 40, bliss::common::DNA16, uint64_t>,  // 3 words, not full
      ::bliss::common::Kmer< 48, bliss::common::DNA16, uint64_t>,  // 3 words, full
+     ::bliss::common::Kmer< 64, bliss::common::DNA16, uint64_t>,  // 4 words, full.  32 bytes and up may use the dispatched reverse
+     ::bliss::common::Kmer< 75, bliss::common::DNA16, uint64_t>,  // 5 words, not full
      ::bliss::common::Kmer<  7, bliss::common::DNA16, uint32_t>,  // 1 word, not full
      ::bliss::common::Kmer<  8, bliss::common::DNA16, uint32_t>,  // 1 word, full
      ::bliss::common::Kmer< 16, bliss::common::DNA16, uint32_t>,  // 2 words, full
@@ -0,0 +1,202 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    clock_cache.hpp
+ * @ingroup fsc::data_structures
+ * @author  agent <agent@local>
+ * @brief   fixed capacity key-value cache with CLOCK (second chance) replacement.
+ * @details CLOCK approximates LRU with one reference bit per slot instead of a list splice per hit,
+ *          so a hit is a hash lookup plus a bit set.  slots are preallocated in a ring; a miss that needs
+ *          space advances the hand, clearing reference bits, until it finds an unreferenced slot to evict.
+ *
+ *          not thread safe.
+ */
+#ifndef BLISS_CLOCK_CACHE_HPP
+#define BLISS_CLOCK_CACHE_HPP
+
+#include <vector>
+#include <unordered_map>
+#include <functional>   // hash, equal_to
+#include <utility>      // move
+#include <cstddef>
+
+namespace fsc  // fast standard container
+{
+
+  /**
+   * @brief  cache of up to capacity entries, evicted in CLOCK order.
+   * @tparam Key
+   * @tparam V        cached value, e.g. the vector of entries found for a key.
+   * @tparam Hash
+   * @tparam Equal
+   */
+  template <typename Key, typename V, typename Hash = ::std::hash<Key>, typename Equal = ::std::equal_to<Key> >
+  class clock_cache {
+    protected:
+      struct slot {
+          Key key;
+          V value;
+          bool referenced;
+          bool used;
+      };
+
+      ::std::vector<slot> slots;
+      ::std::unordered_map<Key, size_t, Hash, Equal> index;
+      /// unused slots, filled before anything is evicted.
+      ::std::vector<size_t> free_slots;
+      size_t hand;
+
+      size_t hits;
+      size_t misses;
+      size_t evictions;
+      size_t invalidations;
+
+      /// refill the free list with all slots, lowest first.
+      void free_all() {
+        free_slots.resize(slots.size());
+        for (size_t i = 0; i < slots.size(); ++i) {
+          free_slots[i] = slots.size() - 1 - i;
+        }
+        hand = 0;
+      }
+
+      /// next slot to fill, evicting if needed.
+      size_t victim() {
+        if (!free_slots.empty()) {
+          size_t v = free_slots.back();
+          free_slots.pop_back();
+          return v;
+        }
+
+        while (slots[hand].used && slots[hand].referenced) {
+          slots[hand].referenced = false;
+          hand = (hand + 1) % slots.size();
+        }
+        size_t v = hand;
+        hand = (hand + 1) % slots.size();
+
+        index.erase(slots[v].key);
+        slots[v].used = false;
+        slots[v].value = V();
+        ++evictions;
+        return v;
+      }
+
+    public:
+      /// capacity 0 disables the cache: find always misses and insert is a no-op.
+      explicit clock_cache(size_t const & capacity = 0) :
+        hand(0), hits(0), misses(0), evictions(0), invalidations(0) {
+        resize(capacity);
+      }
+
+      /// change capacity.  clears the cache, keeps the statistics.
+      void resize(size_t const & capacity) {
+        index.clear();
+        slots.clear();
+        slots.resize(capacity, slot{Key(), V(), false, false});
+        index.reserve(capacity);
+        free_all();
+      }
+
+      size_t capacity() const {
+        return slots.size();
+      }
+
+      size_t size() const {
+        return index.size();
+      }
+
+      bool enabled() const {
+        return slots.size() > 0;
+      }
+
+      /// look up key.  returns null on a miss.  the pointer is valid until the next insert or invalidation.
+      V const * find(Key const & key) {
+        auto it = index.find(key);
+        if (it == index.end()) {
+          ++misses;
+          return nullptr;
+        }
+        ++hits;
+        slots[it->second].referenced = true;
+        return &(slots[it->second].value);
+      }
+
+      /// insert or replace the value for key.
+      void insert(Key const & key, V value) {
+        if (slots.empty()) return;
+
+        auto it = index.find(key);
+        if (it != index.end()) {
+          slots[it->second].value = ::std::move(value);
+          slots[it->second].referenced = true;
+          return;
+        }
+
+        size_t v = victim();
+        slots[v].key = key;
+        slots[v].value = ::std::move(value);
+        slots[v].referenced = false;   // first reference on the next hit.
+        slots[v].used = true;
+        index.emplace(key, v);
+      }
+
+      /// drop one key.
+      bool erase(Key const & key) {
+        auto it = index.find(key);
+        if (it == index.end()) return false;
+
+        slots[it->second].used = false;
+        slots[it->second].referenced = false;
+        slots[it->second].value = V();
+        free_slots.push_back(it->second);
+        index.erase(it);
+        ++invalidations;
+        return true;
+      }
+
+      /// drop everything.  keeps capacity and statistics.
+      void clear() {
+        if (index.empty()) return;
+
+        invalidations += index.size();
+        index.clear();
+        for (auto & s : slots) {
+          s.used = false;
+          s.referenced = false;
+          s.value = V();
+        }
+        free_all();
+      }
+
+      size_t get_hits() const { return hits; }
+      size_t get_misses() const { return misses; }
+      size_t get_evictions() const { return evictions; }
+      size_t get_invalidations() const { return invalidations; }
+
+      double hit_rate() const {
+        return (hits + misses) == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(hits + misses);
+      }
+
+      void reset_stats() {
+        hits = misses = evictions = invalidations = 0;
+      }
+  };
+
+} /* namespace fsc */
+
+#endif // BLISS_CLOCK_CACHE_HPP
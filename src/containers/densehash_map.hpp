@@ -349,6 +349,53 @@ namespace sparsehash {
 	static constexpr bool need_to_split = false;
   };
 
+
+  /**
+   * @brief  tracks the tombstones ("deleted" buckets) that erase leaves in a dense_hash_map.
+   * @details  dense_hash_map does not expose its deleted count, so it is accumulated from the erases.
+   *           the table drops its tombstones when it is cleared, and when it rehashes to grow, which is seen as
+   *           a change in bucket count.  a rehash that keeps the bucket count is not seen, so this is an upper bound.
+   */
+  struct tombstones {
+      size_t count;
+      size_t buckets;
+
+      tombstones() : count(0), buckets(0) {}
+
+      /// record n keys erased from table.
+      template <typename Table>
+      void add(Table const & table, size_t const & n) {
+        if (table.bucket_count() != buckets) {
+          count = 0;
+          buckets = table.bucket_count();
+        }
+        count += n;
+      }
+
+      template <typename Table>
+      size_t get(Table const & table) const {
+        return (table.bucket_count() == buckets) ? count : 0;
+      }
+
+      void reset() {
+        count = 0;
+        buckets = 0;
+      }
+  };
+
+  /// rebuild table from its entries in one pass.  the copy skips tombstones and is sized for the entries it holds.
+  /// both tables exist until the swap, so peak memory is the old plus the new table.
+  template <typename Table>
+  void compact_table(Table & table) {
+    Table tmp(table);
+    table.swap(tmp);
+  }
+
+  /// tombstones / (tombstones + live keys).  0 for an empty table.
+  inline double tombstone_ratio(size_t const & deleted, size_t const & live) {
+    return (deleted + live) == 0 ? 0.0 : static_cast<double>(deleted) / static_cast<double>(deleted + live);
+  }
+
 }  // namespace sparsehash
 
 
@@ -430,6 +477,16 @@ protected:
     container_type lower_map;
     container_type upper_map;
 
+    /// tombstones left in each table by erase.
+    ::fsc::sparsehash::tombstones lower_deleted;
+    ::fsc::sparsehash::tombstones upper_deleted;
+
+    /// record the keys erased from each table since the sizes were taken.
+    void track_erase(size_t const & lower_before, size_t const & upper_before) {
+      lower_deleted.add(lower_map, lower_before - lower_map.size());
+      upper_deleted.add(upper_map, upper_before - upper_map.size());
+    }
+
     using container_iterator = typename container_type::iterator;
     using container_const_iterator = typename container_type::const_iterator;
     using container_range = ::std::pair<container_iterator, container_iterator>;
@@ -574,11 +631,43 @@ protected:
     void reset() {
     	lower_map.clear();
     	upper_map.clear();
+    	lower_deleted.reset();
+    	upper_deleted.reset();
     }
 
     void clear() {
       lower_map.clear_no_resize();
       upper_map.clear_no_resize();
+      lower_deleted.reset();
+      upper_deleted.reset();
+    }
+
+    /// estimated tombstones left by erase.  they slow down probing until the tables are compacted or rehashed.
+    size_type tombstones() const {
+      return lower_deleted.get(lower_map) + upper_deleted.get(upper_map);
+    }
+
+    /// estimated fraction of occupied buckets that are tombstones.
+    double tombstone_ratio() const {
+      return ::fsc::sparsehash::tombstone_ratio(tombstones(), unique_size());
+    }
+
+    /// rebuild the tables from the surviving entries, right sized and without tombstones.  iterators are invalidated.
+    void compact() {
+#if defined(USE_OPENMP)
+#pragma omp parallel sections num_threads(2)
+      {
+#pragma omp section
+        ::fsc::sparsehash::compact_table(lower_map);
+#pragma omp section
+        ::fsc::sparsehash::compact_table(upper_map);
+      }
+#else
+      ::fsc::sparsehash::compact_table(lower_map);
+      ::fsc::sparsehash::compact_table(upper_map);
+#endif
+      lower_deleted.reset();
+      upper_deleted.reset();
     }
 
     void resize(size_t const n) {
@@ -745,6 +834,8 @@ protected:
       if (first == last) return 0;
 
       size_t count = 0;
+      size_t lower_before = lower_map.size();
+      size_t upper_before = upper_map.size();
 
   	// not doing partitioning, because InputIt may not be writable.
 //      InputIt middle = partition_input(first, last);
@@ -791,6 +882,7 @@ protected:
     	  }
       }
 
+      track_erase(lower_before, upper_before);
 
       return count;
     }
@@ -804,6 +896,8 @@ protected:
         if (first == last) return 0;
 
         size_t count = 0;
+        size_t lower_before = lower_map.size();
+        size_t upper_before = upper_map.size();
 
     	// not doing partitioning, because InputIt may not be writable.
 //        InputIt middle = partition_input(first, last);
@@ -843,12 +937,16 @@ protected:
       	  }
         }
 
+        track_erase(lower_before, upper_before);
+
         return count;
     }
 
     template <typename Pred>
     size_t erase(Pred const & pred) {
     	size_t before = size();
+    	size_t lower_before = lower_map.size();
+    	size_t upper_before = upper_map.size();
 
     	for (auto it = lower_map.begin(); it != lower_map.end(); ++it) {
     		if (pred(*it))
@@ -859,6 +957,8 @@ protected:
     				upper_map.erase(it);
     	}
 
+    	track_erase(lower_before, upper_before);
+
     	return before - size();
     }
 
@@ -939,6 +1039,8 @@ class densehash_map<Key, T, SpecialKeys, Transform, Hash, Equal, Allocator, fals
 
     container_type map;
 
+    /// tombstones left in the table by erase.
+    ::fsc::sparsehash::tombstones deleted;
 
 
   public:
@@ -1054,10 +1156,28 @@ class densehash_map<Key, T, SpecialKeys, Transform, Hash, Equal, Allocator, fals
 
     void reset() {
     	map.clear();
+    	deleted.reset();
     }
 
     void clear() {
       map.clear_no_resize();
+      deleted.reset();
+    }
+
+    /// estimated tombstones left by erase.  they slow down probing until the table is compacted or rehashed.
+    size_type tombstones() const {
+      return deleted.get(map);
+    }
+
+    /// estimated fraction of occupied buckets that are tombstones.
+    double tombstone_ratio() const {
+      return ::fsc::sparsehash::tombstone_ratio(tombstones(), unique_size());
+    }
+
+    /// rebuild the table from the surviving entries, right sized and without tombstones.  iterators are invalidated.
+    void compact() {
+      ::fsc::sparsehash::compact_table(map);
+      deleted.reset();
     }
 
     void resize(size_t const n) {
@@ -1165,6 +1285,7 @@ class densehash_map<Key, T, SpecialKeys, Transform, Hash, Equal, Allocator, fals
           ++count;
         }
       }
+      deleted.add(map, count);
       return count;
     }
 
@@ -1185,6 +1306,7 @@ class densehash_map<Key, T, SpecialKeys, Transform, Hash, Equal, Allocator, fals
             map.erase(iter);
             ++count;
         }
+        deleted.add(map, count);
         return count;
     }
 
@@ -1196,6 +1318,7 @@ class densehash_map<Key, T, SpecialKeys, Transform, Hash, Equal, Allocator, fals
         if (pred(*it))
             map.erase(it);
       }
+      deleted.add(map, before - map.size());
 
       return before - map.size();
     }
@@ -1291,6 +1414,10 @@ class densehash_multimap {
     std::vector<subcontainer_type, vector_allocator_type> vecX;
     size_t s;
 
+    /// tombstones left in each table by erase.
+    ::fsc::sparsehash::tombstones lower_deleted;
+    ::fsc::sparsehash::tombstones upper_deleted;
+
     // TODO: provide iterator implementation for  begin/end.
 
     template <typename InputIt>
@@ -1515,6 +1642,37 @@ class densehash_multimap {
     }
 
 
+    /// number of keys in table with a single entry.
+    static size_t count_singles(supercontainer_type const & map) {
+      size_t n = 0;
+      for (auto it = map.begin(); it != map.end(); ++it) {
+        if (it->second >= 0) ++n;
+      }
+      return n;
+    }
+
+    /// move the entries that table refers to into the packed vectors, starting at i1 and iX, and point the table at them.
+    void repack_impl(supercontainer_type & map, subcontainer_type & new1, size_t i1,
+                     std::vector<subcontainer_type, vector_allocator_type> & newX, size_t iX) {
+      for (auto it = map.begin(); it != map.end(); ++it) {
+        if (it->second < 0) {
+          newX[iX].swap(vecX[it->second & ::std::numeric_limits<int64_t>::max()]);
+          it->second = static_cast<int64_t>(iX) | ~(::std::numeric_limits<int64_t>::max());
+          ++iX;
+        } else {
+          new1[i1] = ::std::move(vec1[it->second]);
+          it->second = static_cast<int64_t>(i1);
+          ++i1;
+        }
+      }
+    }
+
+    /// record the keys erased from each table since the sizes were taken.
+    void track_erase(size_t const & lower_before, size_t const & upper_before) {
+      lower_deleted.add(lower_map, lower_before - lower_map.size());
+      upper_deleted.add(upper_map, upper_before - upper_map.size());
+    }
+
     template <typename InputIt, typename Pred>
     void erase_impl(InputIt first, InputIt last, Pred const & pred, supercontainer_type & map) {
 
@@ -1827,6 +1985,8 @@ class densehash_multimap {
     	decltype(vecX) tmpX;  vecX.swap(tmpX);
     	lower_map.clear();
     	upper_map.clear();
+    	lower_deleted.reset();
+    	upper_deleted.reset();
     	s = 0UL;
     }
 
@@ -1835,9 +1995,74 @@ class densehash_multimap {
       vecX.clear();
       lower_map.clear_no_resize();
       upper_map.clear_no_resize();
+      lower_deleted.reset();
+      upper_deleted.reset();
       s = 0UL;
     }
 
+    /// estimated tombstones left by erase.  they slow down probing until the tables are compacted or rehashed.
+    size_type tombstones() const {
+      return lower_deleted.get(lower_map) + upper_deleted.get(upper_map);
+    }
+
+    /// estimated fraction of occupied buckets that are tombstones.
+    double tombstone_ratio() const {
+      return ::fsc::sparsehash::tombstone_ratio(tombstones(), unique_size());
+    }
+
+    /**
+     * @brief rebuild the tables from the surviving keys, right sized and without tombstones, and pack the value
+     *        vectors, which erase leaves with unused singleton slots and emptied multiple entry vectors.
+     *        iterators are invalidated.
+     */
+    void compact() {
+      size_t lower1 = 0, upper1 = 0;
+
+#if defined(USE_OPENMP)
+#pragma omp parallel sections num_threads(2)
+      {
+#pragma omp section
+        {
+          ::fsc::sparsehash::compact_table(lower_map);
+          lower1 = count_singles(lower_map);
+        }
+#pragma omp section
+        {
+          ::fsc::sparsehash::compact_table(upper_map);
+          upper1 = count_singles(upper_map);
+        }
+      }
+#else
+      ::fsc::sparsehash::compact_table(lower_map);
+      lower1 = count_singles(lower_map);
+      ::fsc::sparsehash::compact_table(upper_map);
+      upper1 = count_singles(upper_map);
+#endif
+
+      // each table fills its own range of the packed vectors.
+      subcontainer_type new1(lower1 + upper1);
+      std::vector<subcontainer_type, vector_allocator_type> newX(unique_size() - lower1 - upper1);
+      size_t lowerX = lower_map.size() - lower1;
+
+#if defined(USE_OPENMP)
+#pragma omp parallel sections num_threads(2)
+      {
+#pragma omp section
+        repack_impl(lower_map, new1, 0, newX, 0);
+#pragma omp section
+        repack_impl(upper_map, new1, lower1, newX, lowerX);
+      }
+#else
+      repack_impl(lower_map, new1, 0, newX, 0);
+      repack_impl(upper_map, new1, lower1, newX, lowerX);
+#endif
+
+      vec1.swap(new1);
+      vecX.swap(newX);
+      lower_deleted.reset();
+      upper_deleted.reset();
+    }
+
     void resize(size_t const n) {
       // densehash map resize takes into account the max_load_factor.
       lower_map.resize(n/2);
@@ -1916,6 +2141,8 @@ class densehash_multimap {
 
 
       size_t before = s;
+      size_t lower_before = lower_map.size();
+      size_t upper_before = upper_map.size();
 
 //      auto middle = partition_input(first, last);
 //      erase_impl(first, middle, pred, lower_map);
@@ -1926,6 +2153,8 @@ class densehash_multimap {
   		else this->erase1_impl(*it, pred, upper_map);
       }
 
+      track_erase(lower_before, upper_before);
+
       return before - s;
     }
 
@@ -1937,6 +2166,8 @@ class densehash_multimap {
       if (first == last) return 0;
 
       size_t before = s;
+      size_t lower_before = lower_map.size();
+      size_t upper_before = upper_map.size();
 
 //      auto middle = partition_input(first, last);
 //      erase_impl(first, middle, lower_map);
@@ -1947,6 +2178,8 @@ class densehash_multimap {
   		else this->erase1_impl(*it, upper_map);
       }
 
+      track_erase(lower_before, upper_before);
+
       return before - s;
     }
 
@@ -1956,10 +2189,14 @@ class densehash_multimap {
       if (this->size() == 0) return 0;
 
       size_t before = s;
+      size_t lower_before = lower_map.size();
+      size_t upper_before = upper_map.size();
 
       erase_impl(pred, lower_map);
       erase_impl(pred, upper_map);
 
+      track_erase(lower_before, upper_before);
+
       return before - s;
     }
 
@@ -2043,6 +2280,34 @@ class densehash_multimap<Key, T, SpecialKeys, Transform, Hash, Equal, Allocator,
     supercontainer_type map;
     size_t s;
 
+    /// tombstones left in the table by erase.
+    ::fsc::sparsehash::tombstones deleted;
+
+    /// number of keys in table with a single entry.
+    static size_t count_singles(supercontainer_type const & map) {
+      size_t n = 0;
+      for (auto it = map.begin(); it != map.end(); ++it) {
+        if (it->second >= 0) ++n;
+      }
+      return n;
+    }
+
+    /// move the entries that table refers to into the packed vectors, starting at i1 and iX, and point the table at them.
+    void repack_impl(supercontainer_type & map, subcontainer_type & new1, size_t i1,
+                     std::vector<subcontainer_type, vector_allocator_type> & newX, size_t iX) {
+      for (auto it = map.begin(); it != map.end(); ++it) {
+        if (it->second < 0) {
+          newX[iX].swap(vecX[it->second & ::std::numeric_limits<int64_t>::max()]);
+          it->second = static_cast<int64_t>(iX) | ~(::std::numeric_limits<int64_t>::max());
+          ++iX;
+        } else {
+          new1[i1] = ::std::move(vec1[it->second]);
+          it->second = static_cast<int64_t>(i1);
+          ++i1;
+        }
+      }
+    }
+
     // TODO: provide iterator implementation for  begin/end.
 
 
@@ -2154,6 +2419,7 @@ class densehash_multimap<Key, T, SpecialKeys, Transform, Hash, Equal, Allocator,
     	decltype(vec1) tmp1;  vec1.swap(tmp1);
     	decltype(vecX) tmpX;  vecX.swap(tmpX);
     	map.clear();
+    	deleted.reset();
     	s = 0UL;
     }
 
@@ -2161,9 +2427,38 @@ class densehash_multimap<Key, T, SpecialKeys, Transform, Hash, Equal, Allocator,
       vec1.clear();
       vecX.clear();
       map.clear_no_resize();
+      deleted.reset();
       s = 0UL;
     }
 
+    /// estimated tombstones left by erase.  they slow down probing until the table is compacted or rehashed.
+    size_type tombstones() const {
+      return deleted.get(map);
+    }
+
+    /// estimated fraction of occupied buckets that are tombstones.
+    double tombstone_ratio() const {
+      return ::fsc::sparsehash::tombstone_ratio(tombstones(), unique_size());
+    }
+
+    /**
+     * @brief rebuild the table from the surviving keys, right sized and without tombstones, and pack the value
+     *        vectors, which erase leaves with unused singleton slots and emptied multiple entry vectors.
+     *        iterators are invalidated.
+     */
+    void compact() {
+      ::fsc::sparsehash::compact_table(map);
+      size_t n1 = count_singles(map);
+
+      subcontainer_type new1(n1);
+      std::vector<subcontainer_type, vector_allocator_type> newX(map.size() - n1);
+      repack_impl(map, new1, 0, newX, 0);
+
+      vec1.swap(new1);
+      vecX.swap(newX);
+      deleted.reset();
+    }
+
     void resize(size_t const n) {
       map.resize(n );
     }
@@ -2271,6 +2566,7 @@ class densehash_multimap<Key, T, SpecialKeys, Transform, Hash, Equal, Allocator,
       if (first == last) return 0;
 
       size_t before = s;
+      size_t keys_before = map.size();
       size_t dist = 0;
       int64_t idx;
       // mark for erasure
@@ -2323,6 +2619,8 @@ class densehash_multimap<Key, T, SpecialKeys, Transform, Hash, Equal, Allocator,
 
       }
 
+      deleted.add(map, keys_before - map.size());
+
       return before - s;
     }
 
@@ -2334,6 +2632,7 @@ class densehash_multimap<Key, T, SpecialKeys, Transform, Hash, Equal, Allocator,
       if (first == last) return 0;
 
       size_t before = s;
+      size_t keys_before = map.size();
 
       int64_t idx;
       // mark for erasure
@@ -2358,6 +2657,8 @@ class densehash_multimap<Key, T, SpecialKeys, Transform, Hash, Equal, Allocator,
         map.erase(iter);
       }
 
+      deleted.add(map, keys_before - map.size());
+
       return before - s;
     }
 
@@ -2367,6 +2668,7 @@ class densehash_multimap<Key, T, SpecialKeys, Transform, Hash, Equal, Allocator,
       if (this->size() == 0) return 0;
 
       size_t before = s;
+      size_t keys_before = map.size();
       size_t dist = 0;
       int64_t idx;
 
@@ -2418,6 +2720,8 @@ class densehash_multimap<Key, T, SpecialKeys, Transform, Hash, Equal, Allocator,
         }
       }
 
+      deleted.add(map, keys_before - map.size());
+
       return before - s;
     }
 
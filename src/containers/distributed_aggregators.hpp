@@ -0,0 +1,111 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    distributed_aggregators.hpp
+ * @ingroup dsc::data_structures
+ * @author  agent <agent@local>
+ * @brief   reduction functors for aggregate queries on the distributed maps.
+ * @details an aggregator folds the values of matching entries at the owning process, then the partial
+ *          results are combined at the requesting process.  it provides:
+ *            result_type                       trivially copyable, so partials can be sent with mxx.
+ *            identity()                        the empty aggregate.
+ *            operator()(result_type, value)    fold one matching value into an aggregate.
+ *            combine(result_type, result_type) merge 2 partial aggregates.  associative and commutative.
+ */
+#ifndef BLISS_DISTRIBUTED_AGGREGATORS_HPP
+#define BLISS_DISTRIBUTED_AGGREGATORS_HPP
+
+#include <array>
+#include <limits>
+#include <algorithm>
+#include <cstddef>
+
+namespace dsc  // distributed std container
+{
+  namespace aggregate
+  {
+
+    /// number of matching entries.
+    template <typename R = size_t>
+    struct count {
+        using result_type = R;
+
+        R identity() const { return 0; }
+        template <typename V>
+        R operator()(R const & acc, V const &) const { return acc + 1; }
+        R combine(R const & x, R const & y) const { return x + y; }
+    };
+
+    /// sum of the matching values, e.g. total kmer count over a read.
+    template <typename R = size_t>
+    struct sum {
+        using result_type = R;
+
+        R identity() const { return 0; }
+        template <typename V>
+        R operator()(R const & acc, V const & v) const { return acc + static_cast<R>(v); }
+        R combine(R const & x, R const & y) const { return x + y; }
+    };
+
+    /// smallest matching value, e.g. min coverage over a read.  numeric_limits::max() if nothing matched.
+    template <typename R = size_t>
+    struct min {
+        using result_type = R;
+
+        R identity() const { return ::std::numeric_limits<R>::max(); }
+        template <typename V>
+        R operator()(R const & acc, V const & v) const { return ::std::min(acc, static_cast<R>(v)); }
+        R combine(R const & x, R const & y) const { return ::std::min(x, y); }
+    };
+
+    /// largest matching value.  numeric_limits::lowest() if nothing matched.
+    template <typename R = size_t>
+    struct max {
+        using result_type = R;
+
+        R identity() const { return ::std::numeric_limits<R>::lowest(); }
+        template <typename V>
+        R operator()(R const & acc, V const & v) const { return ::std::max(acc, static_cast<R>(v)); }
+        R combine(R const & x, R const & y) const { return ::std::max(x, y); }
+    };
+
+    /// histogram of integral matching values.  values >= Bins go into the last bin.
+    template <size_t Bins, typename R = size_t>
+    struct histogram {
+        static_assert(Bins > 0, "histogram needs at least 1 bin");
+        using result_type = ::std::array<R, Bins>;
+
+        result_type identity() const {
+          result_type h;
+          h.fill(0);
+          return h;
+        }
+        template <typename V>
+        result_type operator()(result_type acc, V const & v) const {
+          ++acc[::std::min(static_cast<size_t>(v), Bins - 1)];
+          return acc;
+        }
+        result_type combine(result_type x, result_type const & y) const {
+          for (size_t i = 0; i < Bins; ++i) x[i] += y[i];
+          return x;
+        }
+    };
+
+  } /* namespace aggregate */
+} /* namespace dsc */
+
+#endif // BLISS_DISTRIBUTED_AGGREGATORS_HPP
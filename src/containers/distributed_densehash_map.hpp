@@ -44,6 +44,7 @@
 
 
 #include <utility> 			  // for std::pair
+#include <unordered_map>  // for cache fill
 
 //#include <sparsehash/dense_hash_map>  // not a multimap, where we need it most.
 #include <functional> 		// for std::function and std::hash
@@ -60,6 +61,9 @@
 
 #include "containers/distributed_map_base.hpp"
 #include "containers/densehash_map.hpp"
+#include "containers/clock_cache.hpp"
+#include "containers/distributed_aggregators.hpp"
+#include "containers/distributed_spectrum.hpp"
 
 #include "utils/benchmark_utils.hpp"  // for timing.
 #include "utils/logging.h"
@@ -231,6 +235,61 @@ namespace dsc  // distributed std container
 
       mutable bool local_changed;
 
+      using CacheType = ::fsc::clock_cache<Key, ::std::vector<::std::pair<Key, T> >,
+          typename Base::StoreTransformedFarmHash, typename Base::StoreTransformedEqual>;
+
+      /// per process cache of find results for remote keys, for read-only phases.  capacity 0 (disabled) by default.
+      mutable CacheType cache;
+
+      /**
+       * @brief answer remote keys from the cache.
+       * @details  hits are removed from keys and their entries appended to cached.  remote misses are copied to misses.
+       *           keys must already be input transformed.  filtered finds are not cached.
+       */
+      template <typename Predicate>
+      void cache_lookup(::std::vector<Key> & keys, ::std::vector<::std::pair<Key, T> > & cached,
+                        ::std::vector<Key> & misses) const {
+        if (!cache.enabled() || (this->comm.size() == 1) ||
+            !::std::is_same<Predicate, ::bliss::filter::TruePredicate>::value) return;
+
+        int rank = this->comm.rank();
+        auto out = keys.begin();
+        for (auto it = keys.begin(); it != keys.end(); ++it) {
+          if (this->key_to_rank(*it) != rank) {
+            auto hit = cache.find(*it);
+            if (hit != nullptr) {
+              cached.insert(cached.end(), hit->begin(), hit->end());
+              continue;
+            }
+            misses.emplace_back(*it);
+          }
+          *out = *it;
+          ++out;
+        }
+        keys.erase(out, keys.end());
+      }
+
+      /// cache the entries found for the missed remote keys, including keys with no entries.
+      void cache_fill(::std::vector<Key> const & misses, ::std::vector<::std::pair<Key, T> > const & results) const {
+        if (misses.empty()) return;
+
+        // key -> (query multiplicity, entries)
+        ::std::unordered_map<Key, ::std::pair<size_t, ::std::vector<::std::pair<Key, T> > >,
+          typename Base::StoreTransformedFarmHash, typename Base::StoreTransformedEqual> found(misses.size());
+        for (auto const & k : misses) {
+          ++(found[k].first);
+        }
+        for (auto const & e : results) {
+          auto it = found.find(e.first);
+          if (it != found.end()) it->second.second.emplace_back(e);
+        }
+        for (auto & f : found) {
+          // a key queried m times got its entries m times, in order.  keep one copy.
+          f.second.second.resize(f.second.second.size() / f.second.first);
+          cache.insert(f.first, ::std::move(f.second.second));
+        }
+      }
+
       struct LocalCount {
           // filtered element-wise.
           template<class DB, typename Query, class OutputIter,
@@ -284,6 +343,9 @@ namespace dsc  // distributed std container
 
           size_t before = c.size();
 
+          // other processes' entries may have changed too.
+          cache.clear();
+
           BL_BENCH_START(local_insert);
           this->c.insert(input);
           BL_BENCH_END(local_insert, "insert", this->c.size());
@@ -303,6 +365,7 @@ namespace dsc  // distributed std container
        */
       template <class KT, class Predicate>
       size_t local_insert(std::vector<KT> & input, Predicate const &pred) {
+          cache.clear();
 
           if (input.size() == 0) return 0;
 
@@ -330,6 +393,7 @@ namespace dsc  // distributed std container
 				   bool sorted_input = false,
 				   Predicate const& pred = Predicate()) const {
           BL_BENCH_INIT(find);
+          ::plog::CommProfiler::scope comm_profile("find");
 
           ::std::vector<::std::pair<Key, T> > results;
 
@@ -352,16 +416,19 @@ namespace dsc  // distributed std container
   						typename Base::StoreTransformedEqual());
   		BL_BENCH_END(find, "unique", keys.size());
 
+          BL_BENCH_START(find);
+          ::std::vector<::std::pair<Key, T> > cached;
+          ::std::vector<Key> misses;
+          this->template cache_lookup<Predicate>(keys, cached, misses);
+          BL_BENCH_END(find, "cache_lookup", cached.size());
+
             if (this->comm.size() > 1) {
 
               BL_BENCH_COLLECTIVE_START(find, "dist_query", this->comm);
               // distribute (communication part)
               std::vector<size_t> recv_counts;
               {
-				  std::vector<size_t> i2o;
-				  std::vector<Key > buffer;
-				  ::imxx::distribute(keys, this->key_to_rank, recv_counts, i2o, buffer, this->comm);
-				  keys.swap(buffer);
+				  ::imxx::distribute(keys, this->key_to_rank, recv_counts, this->arena, this->comm);
 	  //            ::dsc::distribute_unique(keys, this->key_to_rank, sorted_input, this->comm,
 	  //            				typename Base::StoreTransformedFunc(),
 	  //            				typename Base::StoreTransformedEqual()).swap(recv_counts);
@@ -373,6 +440,7 @@ namespace dsc  // distributed std container
             // do for each src proc one at a time.
 
             BL_BENCH_START(find);
+            this->arena.acquire(::imxx::exchange_arena::RESULTS, results);
             results.reserve(keys.size());                   // TODO:  should estimate coverage.
             BL_BENCH_END(find, "reserve", results.capacity());
 
@@ -412,7 +480,7 @@ namespace dsc  // distributed std container
 
             BL_BENCH_COLLECTIVE_START(find, "a2a2", this->comm);
             // send back using the constructed recv count
-            mxx::all2allv(results, send_counts, this->comm).swap(results);
+            ::imxx::exchange(results, send_counts, this->arena, this->comm);
             BL_BENCH_END(find, "a2a2", results.size());
 
           } else {
@@ -441,6 +509,12 @@ namespace dsc  // distributed std container
 
           }
 
+          BL_BENCH_START(find);
+          this->cache_fill(misses, results);
+          results.insert(results.end(), cached.begin(), cached.end());
+          BL_BENCH_END(find, "cache_fill", misses.size());
+
+          this->account_results(results);
           BL_BENCH_REPORT_MPI_NAMED(find, "base_densehash:find", this->comm);
 
           return results;
@@ -461,6 +535,7 @@ namespace dsc  // distributed std container
       template <bool remove_duplicate = false, class LocalFind, typename Predicate = ::bliss::filter::TruePredicate>
       ::std::vector<::std::pair<Key, T> > find_overlap(LocalFind & find_element, ::std::vector<Key>& keys, bool sorted_input = false, Predicate const& pred = Predicate()) const {
           BL_BENCH_INIT(find);
+          ::plog::CommProfiler::scope comm_profile("find");
 
           ::std::vector<::std::pair<Key, T> > results;
 
@@ -482,16 +557,19 @@ namespace dsc  // distributed std container
 						typename Base::StoreTransformedEqual());
 		BL_BENCH_END(find, "unique", keys.size());
 
+          BL_BENCH_START(find);
+          ::std::vector<::std::pair<Key, T> > cached;
+          ::std::vector<Key> misses;
+          this->template cache_lookup<Predicate>(keys, cached, misses);
+          BL_BENCH_END(find, "cache_lookup", cached.size());
+
           if (this->comm.size() > 1) {
 
             BL_BENCH_COLLECTIVE_START(find, "dist_query", this->comm);
             // distribute (communication part)
             std::vector<size_t> recv_counts;
             {
-				std::vector<size_t> i2o;
-				std::vector<Key > buffer;
-				::imxx::distribute(keys, this->key_to_rank, recv_counts, i2o, buffer, this->comm);
-				keys.swap(buffer);
+				::imxx::distribute(keys, this->key_to_rank, recv_counts, this->arena, this->comm);
 	//            ::dsc::distribute_unique(keys, this->key_to_rank, sorted_input, this->comm,
 	//            				typename Base::StoreTransformedFunc(),
 	//            				typename Base::StoreTransformedEqual()).swap(recv_counts);
@@ -641,6 +719,12 @@ namespace dsc  // distributed std container
             BL_BENCH_END(find, "local_find", results.size());
           }
 
+          BL_BENCH_START(find);
+          this->cache_fill(misses, results);
+          results.insert(results.end(), cached.begin(), cached.end());
+          BL_BENCH_END(find, "cache_fill", misses.size());
+
+          this->account_results(results);
           BL_BENCH_REPORT_MPI_NAMED(find, "base_densehash:find_overlap", this->comm);
 
           return results;
@@ -666,6 +750,7 @@ namespace dsc  // distributed std container
 				   Predicate const & pred = Predicate(),
 				   Transform const & trans = Transform()) const {
           BL_BENCH_INIT(find);
+          ::plog::CommProfiler::scope comm_profile("find");
 
           ::std::vector<typename ::bliss::functional::function_traits<Transform, std::pair<Key, T> >::return_type > results;
 
@@ -698,10 +783,7 @@ namespace dsc  // distributed std container
                 // distribute (communication part)
                 std::vector<size_t> recv_counts;
                 {
-					std::vector<size_t> i2o;
-					std::vector<Key > buffer;
-					::imxx::distribute(keys, this->key_to_rank, recv_counts, i2o, buffer, this->comm);
-					keys.swap(buffer);
+					::imxx::distribute(keys, this->key_to_rank, recv_counts, this->arena, this->comm);
 		//            ::dsc::distribute_unique(keys, this->key_to_rank, sorted_input, this->comm,
 		//            				typename Base::StoreTransformedFunc(),
 		//            				typename Base::StoreTransformedEqual()).swap(recv_counts);
@@ -713,6 +795,7 @@ namespace dsc  // distributed std container
             // do for each src proc one at a time.
 
             BL_BENCH_START(find);
+            this->arena.acquire(::imxx::exchange_arena::RESULTS, results);
             results.reserve(keys.size());                   // TODO:  should estimate coverage.
             BL_BENCH_END(find, "reserve", results.capacity());
 
@@ -754,7 +837,7 @@ namespace dsc  // distributed std container
 
             BL_BENCH_COLLECTIVE_START(find, "a2a2", this->comm);
             // send back using the constructed recv count
-            mxx::all2allv(results, send_counts, this->comm).swap(results);
+            ::imxx::exchange(results, send_counts, this->arena, this->comm);
             BL_BENCH_END(find, "a2a2", results.size());
 
           } else {
@@ -784,6 +867,7 @@ namespace dsc  // distributed std container
 
           }
 
+          this->account_results(results);
           BL_BENCH_REPORT_MPI_NAMED(find, "base_densehash:find", this->comm);
 
           return results;
@@ -1054,12 +1138,14 @@ namespace dsc  // distributed std container
       /// clears the densehash_map and release memory
       virtual void local_reset() noexcept {
         c.reset();
+        cache.clear();
       }
 
 
       /// clears the densehash_map
       virtual void local_clear() noexcept {
         c.clear();
+        cache.clear();
       }
 
 
@@ -1085,6 +1171,53 @@ namespace dsc  // distributed std container
       local_container_type& get_local_container() { return c; }
       local_container_type const & get_local_container() const { return c; }
 
+      /**
+       * @brief  cache find results for up to capacity remote keys on this process.  0 disables.  not collective.
+       * @details  only misses go into the all2all.  the cache is cleared by every insert, erase, and clear,
+       *           so it is only effective during read-only phases such as graph traversal.
+       */
+      void set_cache_capacity(size_t const & capacity) {
+        cache.resize(capacity);
+      }
+      /// drop all cached results.  use if the map is changed other than through insert/erase/clear.
+      void invalidate_cache() {
+        cache.clear();
+      }
+      /// drop the cached results of some keys.
+      void invalidate_cache(::std::vector<Key> keys) {
+        this->transform_input(keys);
+        for (auto const & k : keys) cache.erase(k);
+      }
+      /// cache statistics: hits, misses, evictions, invalidations.
+      CacheType const & get_cache() const { return cache; }
+
+      /// estimated fraction of occupied local buckets that are tombstones left by erase.  not collective.
+      double local_tombstone_ratio() const {
+        return c.tombstone_ratio();
+      }
+
+      /// estimated fraction of occupied buckets over all processes that are tombstones left by erase.  collective.
+      double tombstone_ratio() const {
+        ::std::vector<size_t> counts{c.tombstones(), c.unique_size()};
+        if (this->comm.size() > 1)
+          counts = ::mxx::allreduce(counts, ::std::plus<size_t>(), this->comm);
+        return ::fsc::sparsehash::tombstone_ratio(counts[0], counts[1]);
+      }
+
+      /**
+       * @brief  rebuild the local tables from the surviving entries, right sized and without the tombstones that
+       *         erase leaves behind.  worthwhile after erasing a large fraction of the map, e.g. low count kmers.
+       * @details  not collective: each process decides from its own tombstone ratio.  contents are unchanged,
+       *           so the lookup cache stays valid.  peak memory is the old plus the new tables.
+       * @param min_ratio   compact only if the local tombstone ratio is at least this.
+       * @return  whether this process compacted.
+       */
+      bool local_compact(double const & min_ratio = 0.0) {
+        if (c.tombstone_ratio() < min_ratio) return false;
+        c.compact();
+        return true;
+      }
+
 //      const_iterator cbegin() const
 //      {
 //        return c.cbegin();
@@ -1123,6 +1256,7 @@ namespace dsc  // distributed std container
       ::std::vector<::std::pair<Key, size_type> > count(::std::vector<Key>& keys, bool sorted_input = false,
                                                         Predicate const& pred = Predicate() ) const {
           BL_BENCH_INIT(count);
+          ::plog::CommProfiler::scope comm_profile("count");
           ::std::vector<::std::pair<Key, size_type> > results;
 
           // process even if local container is empty.
@@ -1155,10 +1289,7 @@ namespace dsc  // distributed std container
             // distribute (communication part)
             std::vector<size_t> recv_counts;
             {
-            	std::vector<size_t> i2o;
-                std::vector<Key > buffer;
-                ::imxx::distribute(keys, this->key_to_rank, recv_counts, i2o, buffer, this->comm);
-                keys.swap(buffer);
+            	::imxx::distribute(keys, this->key_to_rank, recv_counts, this->arena, this->comm);
             }
 //            ::dsc::distribute_unique(keys, this->key_to_rank, sorted_input, this->comm,
 //            				typename Base::StoreTransformedFunc(),
@@ -1170,6 +1301,7 @@ namespace dsc  // distributed std container
             // local count. memory utilization a potential problem.
             // do for each src proc one at a time.
             BL_BENCH_START(count);
+            this->arena.acquire(::imxx::exchange_arena::RESULTS, results);
             results.reserve(keys.size() );                   // TODO:  should estimate coverage.
             BL_BENCH_END(count, "reserve", results.capacity());
 
@@ -1191,7 +1323,7 @@ namespace dsc  // distributed std container
 
             // send back using the constructed recv count
             BL_BENCH_COLLECTIVE_START(count, "a2a2", this->comm);
-            mxx::all2allv(results, recv_counts, this->comm).swap(results);
+            ::imxx::exchange(results, recv_counts, this->arena, this->comm);
             BL_BENCH_END(count, "a2a2", results.size());
 
 
@@ -1209,6 +1341,7 @@ namespace dsc  // distributed std container
             BL_BENCH_END(count, "local_count", results.size());
           }
 
+          this->account_results(results);
           BL_BENCH_REPORT_MPI_NAMED(count, "base_densehash:count", this->comm);
 
           return results;
@@ -1231,6 +1364,7 @@ namespace dsc  // distributed std container
       count_transform(::std::vector<Key>& keys, bool sorted_input = false,
                                                         Predicate const& pred = Predicate(), Transform const & trans = Transform() ) const {
           BL_BENCH_INIT(count);
+          ::plog::CommProfiler::scope comm_profile("count");
           ::std::vector<typename ::bliss::functional::function_traits<Transform, ::std::pair<Key, size_type> >::return_type> results;
 
           // process even if local container is empty.
@@ -1261,10 +1395,7 @@ namespace dsc  // distributed std container
               // distribute (communication part)
               std::vector<size_t> recv_counts;
               {
-				  std::vector<size_t> i2o;
-				  std::vector<Key > buffer;
-				  ::imxx::distribute(keys, this->key_to_rank, recv_counts, i2o, buffer, this->comm);
-				  keys.swap(buffer);
+				  ::imxx::distribute(keys, this->key_to_rank, recv_counts, this->arena, this->comm);
 	  //            ::dsc::distribute_unique(keys, this->key_to_rank, sorted_input, this->comm,
 	  //            				typename Base::StoreTransformedFunc(),
 	  //            				typename Base::StoreTransformedEqual()).swap(recv_counts);
@@ -1276,6 +1407,7 @@ namespace dsc  // distributed std container
             // local count. memory utilization a potential problem.
             // do for each src proc one at a time.
             BL_BENCH_START(count);
+            this->arena.acquire(::imxx::exchange_arena::RESULTS, results);
             results.reserve(keys.size() );                   // TODO:  should estimate coverage.
             BL_BENCH_END(count, "reserve", results.capacity());
 
@@ -1297,7 +1429,7 @@ namespace dsc  // distributed std container
 
             // send back using the constructed recv count
             BL_BENCH_COLLECTIVE_START(count, "a2a2", this->comm);
-            mxx::all2allv(results, recv_counts, this->comm).swap(results);
+            ::imxx::exchange(results, recv_counts, this->arena, this->comm);
             BL_BENCH_END(count, "a2a2", results.size());
           } else {
 
@@ -1313,6 +1445,7 @@ namespace dsc  // distributed std container
             BL_BENCH_END(count, "local_count", results.size());
           }
 
+          this->account_results(results);
           BL_BENCH_REPORT_MPI_NAMED(count, "base_densehash:count", this->comm);
 
           return results;
@@ -1390,6 +1523,22 @@ namespace dsc  // distributed std container
       }
 
 
+      /**
+       * @brief aggregate the values of groups of keys at the owning processes.  see map_base::aggregate_at_owners.
+       *           see containers/distributed_aggregators.hpp for sum, min, max, count and histogram.
+       * @param keys  content will be changed and reordered
+       * @return   one aggregate per group.  groups without matching entries get agg.identity().
+       */
+      template <typename Aggregator>
+      ::std::vector<typename Aggregator::result_type> aggregate(::std::vector<Key>& keys, ::std::vector<size_t> const & groups,
+                                                                size_t const & group_count,
+                                                                Aggregator const & agg = Aggregator()) const {
+          return this->aggregate_at_owners(keys, groups, group_count, agg, this->key_to_rank,
+                                           [this](Key const & k) { return this->c.equal_range(k); },
+                                           "base_densehash_map:aggregate");
+      }
+
+
 
 //      /**
 //       * @brief count elements with the specified keys in the distributed densehash_multimap.
@@ -1476,6 +1625,7 @@ namespace dsc  // distributed std container
 		exists(::std::vector<Key>& keys, bool sorted_input = false,
 				Predicate const& pred = Predicate() ) const {
 			BL_BENCH_INIT(exists);
+			::plog::CommProfiler::scope comm_profile("exists");
 			using result_type = std::vector<unsigned char >;
 			result_type results;
 
@@ -1498,9 +1648,9 @@ namespace dsc  // distributed std container
 //			std::cout << "rank " << this->comm.rank() << " keys2 size before " << keys2.size() << std::endl;
 
 //			std::vector<size_t> permute_map;
-			std::vector<size_t> i2o;
+			std::vector<size_t> & i2o = this->arena.template get<size_t>(::imxx::exchange_arena::I2O);
 			std::vector<size_t> recv_counts;
-			std::vector<Key> bucketed;
+			std::vector<Key> & bucketed = this->arena.template get<Key>(::imxx::exchange_arena::QUERY);
 
 			if (this->comm.size() > 1) {
 
@@ -1560,7 +1710,7 @@ namespace dsc  // distributed std container
 
 				// send back using the constructed recv count
 			  BL_BENCH_START(exists);
-			  auto tmp_results = mxx::all2allv(results, recv_counts, this->comm);
+			  auto tmp_results = ::imxx::exchange(results, recv_counts, this->comm);
 			  BL_BENCH_END(exists, "a2a2", results.size());
 
 //				std::cout << "rank " << this->comm.rank() << " exists. results size=" << results.size() << " keys2 " << keys2.size() << std::endl;
@@ -1587,6 +1737,7 @@ namespace dsc  // distributed std container
 //				}
 //			}
 
+			this->account_results(results);
 			BL_BENCH_REPORT_MPI_NAMED(exists, "base_densehash:exists", this->comm);
 
 			return results;
@@ -1604,7 +1755,11 @@ namespace dsc  // distributed std container
           // even if count is 0, still need to participate in mpi calls.  if (keys.size() == 0) return;
           size_t before = this->c.size();
 
+          // entries owned by other processes may be erased too.
+          cache.clear();
+
           BL_BENCH_INIT(erase);
+          ::plog::CommProfiler::scope comm_profile("erase");
 
           if (this->empty() || ::dsc::empty(keys, this->comm)) {
             BL_BENCH_REPORT_MPI_NAMED(erase, "base_densehash:erase", this->comm);
@@ -1622,11 +1777,8 @@ namespace dsc  // distributed std container
 //            BLISS_UNUSED(recv_counts);
             std::vector<size_t> recv_counts;
             {
-				std::vector<size_t> i2o;
-				std::vector<Key > buffer;
-				::imxx::distribute(keys, this->key_to_rank, recv_counts, i2o, buffer, this->comm);
+				::imxx::distribute(keys, this->key_to_rank, recv_counts, this->arena, this->comm);
 				//::imxx::destructive_distribute(input, this->key_to_rank, recv_counts, buffer, this->comm);
-				keys.swap(buffer);
             }
             BL_BENCH_END(erase, "dist_query", keys.size());
 
@@ -1667,6 +1819,7 @@ namespace dsc  // distributed std container
       size_t erase(Predicate const & pred = Predicate()) {
 
         size_t count = 0;
+        cache.clear();
 
         if (! this->local_empty()) {
           if (!::std::is_same<Predicate, ::bliss::filter::TruePredicate>::value) {
@@ -1911,6 +2064,7 @@ namespace dsc  // distributed std container
       size_t insert(std::vector<::std::pair<Key, T> >& input, bool sorted_input = false, Predicate const & pred = Predicate()) {
         // even if count is 0, still need to participate in mpi calls.  if (input.size() == 0) return;
         BL_BENCH_INIT(insert);
+        ::plog::CommProfiler::scope comm_profile("insert");
 
         if (::dsc::empty(input, this->comm)) {
           BL_BENCH_REPORT_MPI_NAMED(insert, "hashmap:insert", this->comm);
@@ -1929,10 +2083,7 @@ namespace dsc  // distributed std container
 //          auto recv_counts(::dsc::distribute(input, this->key_to_rank, sorted_input, this->comm));
 //          BLISS_UNUSED(recv_counts);
           std::vector<size_t> recv_counts;
-			  std::vector<size_t> i2o;
-			  std::vector<::std::pair<Key, T> > buffer;
-			  ::imxx::distribute(input, this->key_to_rank, recv_counts, i2o, buffer, this->comm);
-			  input.swap(buffer);
+			  ::imxx::distribute(input, this->key_to_rank, recv_counts, this->arena, this->comm);
           BL_BENCH_END(insert, "dist_data", input.size());
         }
 
@@ -1975,6 +2126,7 @@ namespace dsc  // distributed std container
       size_t update(std::vector<::std::pair<Key, V> >& input, bool sorted_input, Updater const & op ) {
         // even if count is 0, still need to participate in mpi calls.  if (input.size() == 0) return;
         BL_BENCH_INIT(update);
+        ::plog::CommProfiler::scope comm_profile("update");
 
         if (this->empty() || ::dsc::empty(input, this->comm)) {
           BL_BENCH_REPORT_MPI_NAMED(update, "hashmap:update", this->comm);
@@ -1994,10 +2146,7 @@ namespace dsc  // distributed std container
 			BL_BENCH_START(update);
 //			::dsc::distribute_bucketed(input, recv_counts, this->comm).swap(input);
 			std::vector<size_t> recv_counts;
-			  std::vector<size_t> i2o;
-			  std::vector<::std::pair<Key, V> > buffer;
-			  ::imxx::distribute(input, this->key_to_rank, recv_counts, i2o, buffer, this->comm);
-			  input.swap(buffer);
+			  ::imxx::distribute(input, this->key_to_rank, recv_counts, this->arena, this->comm);
 
 			BL_BENCH_END(update, "distribute_(localcnt)", recv_counts[this->comm.rank()]);
 
@@ -2005,7 +2154,8 @@ namespace dsc  // distributed std container
 
 
         BL_BENCH_START(update);
-        // local compute part.
+        // local compute part.  other processes' entries may have changed too.
+        this->cache.clear();
         size_t count = this->c.update(input, op);
         BL_BENCH_END(update, "update", count);
 
@@ -2019,6 +2169,7 @@ namespace dsc  // distributed std container
         BL_BENCH_INIT(update);
 
         BL_BENCH_START(update);
+        this->cache.clear();
         size_t count = this->c.update(fop, op);
         BL_BENCH_END(update, "update", count);
 
@@ -2330,6 +2481,7 @@ namespace dsc  // distributed std container
       size_t insert(std::vector<::std::pair<Key, T> >& input, bool sorted_input = false, Predicate const & pred = Predicate()) {
         // even if count is 0, still need to participate in mpi calls.  if (input.size() == 0) return;
         BL_BENCH_INIT(insert);
+        ::plog::CommProfiler::scope comm_profile("insert");
 
         if (::dsc::empty(input, this->comm)) {
           BL_BENCH_REPORT_MPI_NAMED(insert, "hash_multimap:insert", this->comm);
@@ -2352,10 +2504,7 @@ namespace dsc  // distributed std container
           // first remove duplicates.  sort, then get unique, finally remove the rest.  may not be needed
 
           std::vector<size_t> recv_counts;
-          std::vector<size_t> i2o;
-          std::vector<::std::pair<Key, T> > buffer;
-          ::imxx::distribute(input, this->key_to_rank, recv_counts, i2o, buffer, this->comm);
-          input.swap(buffer);
+          ::imxx::distribute(input, this->key_to_rank, recv_counts, this->arena, this->comm);
 
           //auto recv_counts = ::dsc::distribute(input, this->key_to_rank, sorted_input, this->comm);
           //BLISS_UNUSED(recv_counts);
@@ -2463,6 +2612,7 @@ namespace dsc  // distributed std container
       template <class InputIterator>
       size_t local_insert(InputIterator first, InputIterator last) {
           size_t before = this->c.size();
+          this->cache.clear();
 
           //this->local_reserve(before + ::std::distance(first, last));
 
@@ -2489,6 +2639,7 @@ namespace dsc  // distributed std container
       template <class InputIterator, class Predicate>
       size_t local_insert(InputIterator first, InputIterator last, Predicate const & pred) {
           size_t before = this->c.size();
+          this->cache.clear();
 
           //this->local_reserve(before + ::std::distance(first, last));
 
@@ -2566,6 +2717,7 @@ namespace dsc  // distributed std container
       size_t insert(std::vector<::std::pair<Key, T> >& input, bool sorted_input = false, Predicate const & pred = Predicate()) {
         // even if count is 0, still need to participate in mpi calls.  if (input.size() == 0) return;
         BL_BENCH_INIT(insert);
+        ::plog::CommProfiler::scope comm_profile("insert");
 
         if (::dsc::empty(input, this->comm)) {
           BL_BENCH_REPORT_MPI_NAMED(insert, "reduction_densehash:insert", this->comm);
@@ -2583,10 +2735,7 @@ namespace dsc  // distributed std container
           BL_BENCH_START(insert);
           // first remove duplicates.  sort, then get unique, finally remove the rest.  may not be needed
           std::vector<size_t> recv_counts;
-          std::vector<size_t> i2o;
-          std::vector<::std::pair<Key, T> > buffer;
-          ::imxx::distribute(input, this->key_to_rank, recv_counts, i2o, buffer, this->comm);
-          input.swap(buffer);
+          ::imxx::distribute(input, this->key_to_rank, recv_counts, this->arena, this->comm);
 
 //          auto recv_counts = ::dsc::distribute(input, this->key_to_rank, sorted_input, this->comm);
 //          BLISS_UNUSED(recv_counts);
@@ -2706,6 +2855,15 @@ namespace dsc  // distributed std container
       using Base::unique_size;
       using Base::update;
 
+      /**
+       * @brief  count histogram (kmer spectrum).  h[i] is the number of distinct keys with count i, counts >= bins - 1 in the last bin.
+       * @details  scans the local table in place and sums the fixed size histograms.  collective.
+       *           see ::dsc::spectrum::first_valley for the error/solid threshold.
+       */
+      ::std::vector<size_t> histogram(size_t const & bins = 256) const {
+        return ::dsc::spectrum::histogram(this->c.begin(), this->c.end(), bins, this->comm);
+      }
+
       /**
        * @brief insert new elements in the distributed densehash_multimap.
        * @param first
@@ -2715,6 +2873,7 @@ namespace dsc  // distributed std container
       size_t insert(std::vector< Key >& input, bool sorted_input = false, Predicate const &pred = Predicate()) {
         // even if count is 0, still need to participate in mpi calls.  if (input.size() == 0) return;
         BL_BENCH_INIT(insert);
+        ::plog::CommProfiler::scope comm_profile("insert");
 
         if (::dsc::empty(input, this->comm)) {
           BL_BENCH_REPORT_MPI_NAMED(insert, "count_densehash_map:insert", this->comm);
@@ -2774,10 +2933,7 @@ namespace dsc  // distributed std container
           BL_BENCH_START(insert);
           // first remove duplicates.  sort, then get unique, finally remove the rest.  may not be needed
           std::vector<size_t> recv_counts;
-          std::vector<size_t> i2o;
-          std::vector< Key > buffer;
-          ::imxx::distribute(input, this->key_to_rank, recv_counts, i2o, buffer, this->comm);
-          input.swap(buffer);
+          ::imxx::distribute(input, this->key_to_rank, recv_counts, this->arena, this->comm);
 
 //          auto recv_counts = ::dsc::distribute(input, this->key_to_rank, sorted_input, this->comm);
 //          BLISS_UNUSED(recv_counts);
@@ -2994,6 +3150,7 @@ namespace dsc  // distributed std container
       size_t insert(std::vector< Key >& input, bool sorted_input = false, Predicate const &pred = Predicate()) {
         // even if count is 0, still need to participate in mpi calls.  if (input.size() == 0) return;
         BL_BENCH_INIT(insert);
+        ::plog::CommProfiler::scope comm_profile("insert");
 
         if (::dsc::empty(input, this->comm)) {
           BL_BENCH_REPORT_MPI_NAMED(insert, "saturating_count_densehash_map:insert", this->comm);
@@ -3016,12 +3173,8 @@ namespace dsc  // distributed std container
           BL_BENCH_START(insert);
           // first remove duplicates.  sort, then get unique, finally remove the rest.  may not be needed
           std::vector<size_t> recv_counts;
-          std::vector<size_t> i2o;
-
-          std::vector<Key > buffer;
           //::imxx::destructive_distribute(input, this->key_to_rank, recv_counts, buffer, this->comm);
-          ::imxx::distribute(input, this->key_to_rank, recv_counts, i2o, buffer, this->comm);
-          input.swap(buffer);
+          ::imxx::distribute(input, this->key_to_rank, recv_counts, this->arena, this->comm);
 
 //          auto recv_counts = ::dsc::distribute(input, this->key_to_rank, sorted_input, this->comm);
 //          BLISS_UNUSED(recv_counts);
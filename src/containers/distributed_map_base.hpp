@@ -30,10 +30,15 @@
 #include <iterator>
 #include <vector>
 #include <unordered_set>
+#include <utility>
+#include <stdexcept>
 #include "containers/dsc_container_utils.hpp"
 #include <mxx/collective.hpp>
 
 #include "utils/benchmark_utils.hpp"
+#include "utils/comm_profiler.hpp"
+#include "io/exchange_arena.hpp"
+#include "io/incremental_mxx.hpp"
 
 
 
@@ -185,6 +190,121 @@ namespace dsc
       // communication stuff...
       const mxx::comm& comm;
 
+      /// transient buffers of distribute / exchange, kept between calls.  mutable since the queries are const.
+      mutable ::imxx::exchange_arena arena;
+
+      /// count a query's results towards the peak of the "results" category of plog::AllocTracker.  they belong to the caller afterwards.
+      template <typename R>
+      void account_results(::std::vector<R> const & results) const {
+        arena.account();
+        ::plog::AllocTracker::instance().transient(::plog::alloc_tag::results::name(), results.capacity() * sizeof(R));
+      }
+
+      /**
+       * @brief aggregate the values of groups of keys at the owning processes.  shared by the aggregate of the map bases.
+       * @details  keys[i] belongs to group groups[i], with groups numbered [0, group_count) on each process.
+       *           each owner folds the values of the matching entries into one partial aggregate per
+       *           (source process, group), and only the partials are sent back, i.e. O(groups) instead of O(matches).
+       *           a key repeated in a group is counted each time.  keys without entries contribute nothing.
+       * @param keys         content will be changed and reordered
+       * @param key_to_rank  owner of a key.  the subclass makes sure it is current.
+       * @param local_range  local_range(key) returns the [first, last) range of the local entries of key.
+       * @param name         benchmark report name.
+       * @return   one aggregate per group.  groups without matching entries get agg.identity().
+       */
+      template <typename Aggregator, typename ToRank, typename LocalRange>
+      ::std::vector<typename Aggregator::result_type> aggregate_at_owners(::std::vector<Key>& keys,
+                                                                         ::std::vector<size_t> const & groups,
+                                                                         size_t const & group_count,
+                                                                         Aggregator const & agg,
+                                                                         ToRank const & key_to_rank,
+                                                                         LocalRange const & local_range,
+                                                                         char const * name) const {
+          using R = typename Aggregator::result_type;
+
+          BL_BENCH_INIT(aggregate);
+          ::plog::CommProfiler::scope comm_profile("aggregate");
+          ::std::vector<R> results(group_count, agg.identity());
+
+          if (keys.size() != groups.size())
+            throw std::invalid_argument("aggregate: keys and groups need to have the same size");
+
+          if (this->empty() || ::dsc::empty(keys, this->comm)) {
+            BL_BENCH_REPORT_MPI_NAMED(aggregate, name, this->comm);
+            return results;
+          }
+
+          BL_BENCH_START(aggregate);
+          this->transform_input(keys);
+          ::std::vector<::std::pair<Key, size_t> > queries;
+          queries.reserve(keys.size());
+          for (size_t i = 0; i < keys.size(); ++i) {
+            if (groups[i] >= group_count)
+              throw std::invalid_argument("aggregate: group id needs to be less than group_count");
+            queries.emplace_back(keys[i], groups[i]);
+          }
+          ::std::vector<Key>().swap(keys);
+          BL_BENCH_END(aggregate, "transform_input", queries.size());
+
+          std::vector<size_t> recv_counts(1, queries.size());
+          if (this->comm.size() > 1) {
+            BL_BENCH_COLLECTIVE_START(aggregate, "dist_query", this->comm);
+            ::imxx::distribute(queries, key_to_rank, recv_counts, this->arena, this->comm);
+            BL_BENCH_END(aggregate, "dist_query", queries.size());
+          }
+
+          // fold locally, one partial per (source process, group).
+          BL_BENCH_START(aggregate);
+          ::std::vector<::std::pair<size_t, R> > partials;
+          std::vector<size_t> send_counts(recv_counts.size(), 0);
+          auto start = queries.begin();
+          auto end = start;
+          for (size_t i = 0; i < recv_counts.size(); ++i) {
+            ::std::advance(end, recv_counts[i]);
+
+            ::std::sort(start, end, [](::std::pair<Key, size_t> const & x, ::std::pair<Key, size_t> const & y) {
+              return x.second < y.second;
+            });
+
+            for (auto it = start; it != end; ) {
+              size_t g = it->second;
+              R acc = agg.identity();
+              bool matched = false;
+              for (; (it != end) && (it->second == g); ++it) {
+                auto range = local_range(it->first);
+                for (auto e = range.first; e != range.second; ++e) {
+                  acc = agg(acc, (*e).second);
+                  matched = true;
+                }
+              }
+              if (matched) {
+                partials.emplace_back(g, acc);
+                ++send_counts[i];
+              }
+            }
+
+            start = end;
+          }
+          BL_BENCH_END(aggregate, "local_aggregate", partials.size());
+
+          if (this->comm.size() > 1) {
+            BL_BENCH_COLLECTIVE_START(aggregate, "a2a2", this->comm);
+            ::imxx::exchange(partials, send_counts, this->comm).swap(partials);
+            BL_BENCH_END(aggregate, "a2a2", partials.size());
+          }
+
+          BL_BENCH_START(aggregate);
+          for (auto const & p : partials) {
+            results[p.first] = agg.combine(results[p.first], p.second);
+          }
+          BL_BENCH_END(aggregate, "combine", results.size());
+
+          this->account_results(results);
+          BL_BENCH_REPORT_MPI_NAMED(aggregate, name, this->comm);
+
+          return results;
+      }
+
       // ============= local modifiers.  not directly accessible publically.  meant to be called via collective calls.
 
       // abstract declarations - need to access the local containers, therefore override in subclases.
@@ -275,6 +395,16 @@ namespace dsc
 
       }
 
+      /// bytes of exchange buffers retained between calls on this process.
+      size_t buffer_bytes() const {
+        return arena.retained_bytes();
+      }
+
+      /// release the retained exchange buffers, down to keep_bytes on this process.  not collective.
+      void trim_buffers(size_t const & keep_bytes = 0) const {
+        arena.trim(keep_bytes);
+      }
+
       /// clears the distributed container.
       virtual void clear() {
         // clear + barrier.
@@ -0,0 +1,394 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    distributed_node_shared_map.hpp
+ * @ingroup dsc::data_structures
+ * @author  agent <agent@local>
+ * @brief   read-only distributed map whose local tables are shared by all processes on a node.
+ * @details the distributed maps give each process a distinct shard, and a query is sent to the process owning the key,
+ *          even if that process is on the same node.  for query heavy jobs with many processes per node,
+ *          most of that all-to-all traffic is between processes that could read each other's memory.
+ *
+ *          node_shared_map is a frozen snapshot of a distributed map's content.  the entries are redistributed by key to
+ *          nodes, and within a node to a "segment" per process.  each segment is a sorted array in an MPI-3
+ *          shared memory window, so any process on a node can search any segment of that node.
+ *          a query is answered in place if its key belongs to the local node.  otherwise it is sent to one process on
+ *          the owning node - chosen by local rank, so the load is spread across the node - and no intra-node messages are sent.
+ *
+ *          the table is sorted rather than hashed because it has to be position independent to live in shared memory.
+ *          Key and T must be trivially copyable.
+ *
+ *          construction and destruction are collective.  the shared memory is released at destruction.
+ */
+#ifndef BLISS_DISTRIBUTED_NODE_SHARED_MAP_HPP
+#define BLISS_DISTRIBUTED_NODE_SHARED_MAP_HPP
+
+#include <mpi.h>
+
+#include <vector>
+#include <utility>      // pair
+#include <functional>   // hash, less
+#include <algorithm>    // sort, equal_range
+#include <memory>       // uninitialized_copy
+#include <type_traits>
+#include <sstream>
+#include <stdexcept>
+
+#include <mxx/comm.hpp>
+#include <mxx/collective.hpp>
+#include <mxx/reduction.hpp>
+#include <mxx/algos.hpp>      // bucketing
+#include <mxx/benchmark.hpp>  // hybrid_comm
+
+#include "common/kmer.hpp"
+#include "index/kmer_hash.hpp"
+#include "containers/fsc_container_utils.hpp"
+#include "containers/distributed_map_base.hpp"
+#include "utils/benchmark_utils.hpp"
+#include "utils/exception_handling.hpp"
+#include "utils/logging.h"
+
+namespace dsc  // distributed std container
+{
+
+  /**
+   * @brief  read-only, node-shared snapshot of a distributed map or multimap.
+   * @details  entry for key k goes to node  (h(k) % nodes), and to segment  ((h(k) / nodes) % processes on that node),
+   *           with h the farm hash (std::hash for non-kmers) of the storage transformed key.
+   *           keys are compared with the storage transform and std::less, so keys that the source map
+   *           considers equal are grouped together.
+   *
+   * @tparam Key
+   * @tparam T
+   * @tparam MapParams  same as the source map.  InputTransform is applied to queries, StorageTransform to comparisons.
+   */
+  template<typename Key, typename T,
+  template <typename> class MapParams
+  >
+  class node_shared_map {
+
+    public:
+      using key_type              = Key;
+      using mapped_type           = T;
+      using value_type            = ::std::pair<Key, T>;
+      using size_type             = size_t;
+
+    protected:
+      using InputTransform = typename MapParams<Key>::InputTransform;
+
+      template <typename K>
+      using StoreTransform = typename MapParams<Key>::template StorageTransform<K>;
+
+      template <typename K>
+      using StoreFarmHash = typename ::std::conditional<::bliss::common::is_kmer<K>::value,
+          ::bliss::kmer::hash::farm<K, false>,
+           ::std::hash<K> >::type;
+
+      using StoreTransformedFarmHash = ::fsc::TransformedHash<Key, StoreFarmHash, StoreTransform>;
+      using StoreTransformedLess = ::fsc::TransformedComparator<Key, ::std::less, StoreTransform>;
+
+      /// a process's sorted table, in shared memory.
+      struct segment {
+          value_type const * data;
+          size_t size;
+      };
+
+      const mxx::comm& comm;
+
+      /// processes on the same node
+      ::mxx::comm local;
+
+      /// number of nodes, and node id
+      int node_count;
+      int node_id;
+
+      /// global ranks on each node, by local rank.
+      ::std::vector<::std::vector<int> > node_ranks;
+
+      /// shared window holding the segments of this node.
+      MPI_Win win;
+
+      /// segments of the processes on this node, by local rank.
+      ::std::vector<segment> segments;
+
+      StoreTransformedFarmHash hash;
+      StoreTransformedLess less;
+      InputTransform input_trans;
+
+      /// node of a key
+      inline int key_to_node(Key const & k) const {
+        return hash(k) % node_count;
+      }
+      /// segment of a key, on its node.
+      inline int key_to_segment(Key const & k, int const & node) const {
+        return (hash(k) / node_count) % node_ranks[node].size();
+      }
+      /// process that answers queries for a key from this process.  self if the key is on this node.
+      inline int query_target(Key const & k) const {
+        int n = key_to_node(k);
+        if (n == node_id) return comm.rank();
+        return node_ranks[n][local.rank() % node_ranks[n].size()];
+      }
+      /// process that stores the entry for key.
+      inline int store_target(Key const & k) const {
+        int n = key_to_node(k);
+        return node_ranks[n][key_to_segment(k, n)];
+      }
+
+      /// range of entries for key in this node's segments.  key must be on this node.
+      ::std::pair<value_type const *, value_type const *> local_equal_range(Key const & k) const {
+        segment const & s = segments[key_to_segment(k, node_id)];
+        return ::std::equal_range(s.data, s.data + s.size, k, less);
+      }
+
+      /**
+       * @brief  set up the node communicators and the key to node mapping.  collective
+       */
+      void init_topology() {
+        {
+          ::mxx::hybrid_comm hc(comm);
+          local = hc.local.copy();
+        }
+
+        // number the nodes by their leaders.
+        int is_leader = (local.rank() == 0) ? 1 : 0;
+        node_count = ::mxx::allreduce(is_leader, [](int const & x, int const & y){ return x + y; }, comm);
+        node_id = ::mxx::exscan(is_leader, [](int const & x, int const & y){ return x + y; }, comm);
+        if (comm.rank() == 0) node_id = 0;
+        MPI_Bcast(&node_id, 1, MPI_INT, 0, local);
+
+        // global ranks on each node, in local rank order.
+        ::std::vector<int> nodes = ::mxx::allgather(node_id, comm);
+        ::std::vector<int> local_ranks = ::mxx::allgather(local.rank(), comm);
+        node_ranks.assign(node_count, ::std::vector<int>());
+        for (int i = 0; i < comm.size(); ++i) {
+          if (node_ranks[nodes[i]].size() <= static_cast<size_t>(local_ranks[i]))
+            node_ranks[nodes[i]].resize(local_ranks[i] + 1, -1);
+          node_ranks[nodes[i]][local_ranks[i]] = i;
+        }
+      }
+
+      /**
+       * @brief  copy the sorted entries into this process's segment of the node window, and map the node's segments.  collective on the node.
+       */
+      void publish(::std::vector<value_type> const & entries) {
+        MPI_Aint bytes = static_cast<MPI_Aint>(entries.size() * sizeof(value_type));
+        value_type * base = nullptr;
+        int res = MPI_Win_allocate_shared(bytes, sizeof(value_type), MPI_INFO_NULL, local, &base, &win);
+        if (res != MPI_SUCCESS) {
+          std::stringstream ss;
+          ss << "ERROR: MPI_Win_allocate_shared: node_shared_map failed to allocate " << bytes << " bytes. error " << res;
+          throw ::bliss::utils::make_exception<std::runtime_error>(ss.str());
+        }
+
+        // passive target epoch for the lifetime of the window.
+        MPI_Win_lock_all(MPI_MODE_NOCHECK, win);
+
+        if (entries.size() > 0) ::std::uninitialized_copy(entries.begin(), entries.end(), base);
+
+        // make the writes visible to the node.
+        MPI_Win_sync(win);
+        local.barrier();
+        MPI_Win_sync(win);
+
+        segments.resize(local.size());
+        MPI_Aint qbytes;
+        int disp;
+        value_type * ptr;
+        for (int i = 0; i < local.size(); ++i) {
+          MPI_Win_shared_query(win, i, &qbytes, &disp, &ptr);
+          segments[i].data = ptr;
+          segments[i].size = qbytes / sizeof(value_type);
+        }
+      }
+
+    public:
+
+      /**
+       * @brief  snapshot a distributed map.  collective.
+       * @details  the source map is not modified, and may be destroyed afterwards.
+       * @param map    source map.  any dsc map with the same Key, T, and MapParams.
+       * @param _comm  the map's communicator.
+       */
+      template <class Alloc>
+      node_shared_map(::dsc::map_base<Key, T, MapParams, Alloc> const & map, const mxx::comm& _comm) :
+        comm(_comm), node_count(1), node_id(0), win(MPI_WIN_NULL) {
+
+        BL_BENCH_INIT(freeze);
+
+        BL_BENCH_START(freeze);
+        init_topology();
+        BL_BENCH_END(freeze, "topology", node_count);
+
+        BL_BENCH_START(freeze);
+        ::std::vector<value_type> entries;
+        map.to_vector(entries);
+        BL_BENCH_END(freeze, "to_vector", entries.size());
+
+        if (comm.size() > 1) {
+          BL_BENCH_START(freeze);
+          ::std::vector<size_t> send_counts =
+              ::mxx::bucketing(entries, [this](value_type const & x) { return this->store_target(x.first); }, comm.size());
+          ::mxx::all2allv(entries, send_counts, comm).swap(entries);
+          BL_BENCH_END(freeze, "distribute", entries.size());
+        }
+
+        BL_BENCH_START(freeze);
+        ::std::stable_sort(entries.begin(), entries.end(), less);
+        BL_BENCH_END(freeze, "sort", entries.size());
+
+        BL_BENCH_START(freeze);
+        this->publish(entries);
+        BL_BENCH_END(freeze, "publish", entries.size());
+
+        BL_BENCH_REPORT_MPI_NAMED(freeze, "node_shared_map:freeze", comm);
+      }
+
+      node_shared_map(node_shared_map const & other) = delete;
+      node_shared_map& operator=(node_shared_map const & other) = delete;
+
+      /// release the shared window.  collective on the node.
+      virtual ~node_shared_map() {
+        if (win != MPI_WIN_NULL) {
+          MPI_Win_unlock_all(win);
+          MPI_Win_free(&win);
+        }
+      }
+
+      /// number of entries in this process's segment.
+      size_t local_size() const {
+        return segments.empty() ? 0 : segments[local.rank()].size;
+      }
+
+      /// number of entries on this node.
+      size_t node_size() const {
+        size_t s = 0;
+        for (auto const & seg : segments) s += seg.size;
+        return s;
+      }
+
+      /// total number of entries.  collective
+      size_t size() const {
+        return (comm.size() == 1) ? local_size() : ::mxx::allreduce(local_size(), comm);
+      }
+
+      /// number of nodes
+      int get_node_count() const {
+        return node_count;
+      }
+
+      /// check if a key's entries are on this node, i.e. can be found without communication.
+      bool is_node_local(Key const & k) const {
+        return key_to_node(input_trans(k)) == node_id;
+      }
+
+      /**
+       * @brief  find the entries of the query keys.  collective.
+       * @details  queries for this node are answered from shared memory.  the rest are sent to one process on the owning node.
+       * @param keys  query keys.  transformed and reordered in place.
+       * @return      matching entries, grouped by the node that answered.
+       */
+      ::std::vector<value_type> find(::std::vector<Key> & keys) const {
+        BL_BENCH_INIT(find);
+
+        BL_BENCH_START(find);
+        ::std::transform(keys.begin(), keys.end(), keys.begin(), input_trans);
+        BL_BENCH_END(find, "transform_input", keys.size());
+
+        ::std::vector<size_t> recv_counts(1, keys.size());
+        if (comm.size() > 1) {
+          BL_BENCH_START(find);
+          ::std::vector<size_t> send_counts =
+              ::mxx::bucketing(keys, [this](Key const & x) { return this->query_target(x); }, comm.size());
+          recv_counts = ::mxx::all2all(send_counts, comm);
+          ::mxx::all2allv(keys, send_counts, comm).swap(keys);
+          BL_BENCH_END(find, "dist_query", keys.size());
+        }
+
+        // answer each source's queries in turn
+        BL_BENCH_START(find);
+        ::std::vector<value_type> results;
+        results.reserve(keys.size());
+        ::std::vector<size_t> resp_counts(recv_counts.size(), 0);
+        size_t q = 0;
+        for (size_t i = 0; i < recv_counts.size(); ++i) {
+          size_t before = results.size();
+          for (size_t j = 0; j < recv_counts[i]; ++j, ++q) {
+            auto range = this->local_equal_range(keys[q]);
+            results.insert(results.end(), range.first, range.second);
+          }
+          resp_counts[i] = results.size() - before;
+        }
+        BL_BENCH_END(find, "local_find", results.size());
+
+        if (comm.size() > 1) {
+          BL_BENCH_START(find);
+          ::mxx::all2allv(results, resp_counts, comm).swap(results);
+          BL_BENCH_END(find, "dist_result", results.size());
+        }
+
+        BL_BENCH_REPORT_MPI_NAMED(find, "node_shared_map:find", comm);
+        return results;
+      }
+
+      /**
+       * @brief  count the entries of the query keys.  collective.
+       * @param keys  query keys.  transformed and reordered in place.
+       * @return      (key, count) for each query, grouped by the node that answered.
+       */
+      ::std::vector<::std::pair<Key, size_type> > count(::std::vector<Key> & keys) const {
+        BL_BENCH_INIT(count);
+
+        BL_BENCH_START(count);
+        ::std::transform(keys.begin(), keys.end(), keys.begin(), input_trans);
+        BL_BENCH_END(count, "transform_input", keys.size());
+
+        ::std::vector<size_t> send_counts(1, keys.size());
+        if (comm.size() > 1) {
+          BL_BENCH_START(count);
+          send_counts = ::mxx::bucketing(keys, [this](Key const & x) { return this->query_target(x); }, comm.size());
+          ::mxx::all2allv(keys, send_counts, comm).swap(keys);
+          BL_BENCH_END(count, "dist_query", keys.size());
+        }
+
+        BL_BENCH_START(count);
+        ::std::vector<::std::pair<Key, size_type> > results;
+        results.reserve(keys.size());
+        for (auto const & k : keys) {
+          auto range = this->local_equal_range(k);
+          results.emplace_back(k, ::std::distance(range.first, range.second));
+        }
+        BL_BENCH_END(count, "local_count", results.size());
+
+        // one response per query, so the response counts are the query counts.
+        if (comm.size() > 1) {
+          BL_BENCH_START(count);
+          ::std::vector<size_t> recv_counts = ::mxx::all2all(send_counts, comm);
+          ::mxx::all2allv(results, recv_counts, comm).swap(results);
+          BL_BENCH_END(count, "dist_result", results.size());
+        }
+
+        BL_BENCH_REPORT_MPI_NAMED(count, "node_shared_map:count", comm);
+        return results;
+      }
+  };
+
+
+} /* namespace dsc */
+
+
+#endif // BLISS_DISTRIBUTED_NODE_SHARED_MAP_HPP
@@ -0,0 +1,313 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    distributed_query_batcher.hpp
+ * @ingroup dsc::data_structures
+ * @author  agent <agent@local>
+ * @brief   coalesce many small find/count calls into fewer, larger collective rounds.
+ * @details each find or count on a distributed map is a full collective round: count exchange,
+ *          all2allv of the queries, all2allv of the results.  for small queries the round is dominated by latency.
+ *
+ *          query_batcher buffers queries from any number of callers (threads) and returns futures.
+ *          progress() is collective.  it runs a round when the globally buffered queries reach the target round size,
+ *          or when a query on any process has waited longer than max_delay.  flush() runs a round unconditionally.
+ *
+ *          the round time is modeled as  t = latency + keys / bandwidth, fitted by least squares over recent rounds.
+ *          the target round size is the smallest at which the latency is at most (1 - efficiency) of the round time,
+ *          clamped to [min_batch, max_batch].  the fit uses the max time over processes, so all processes agree on the target.
+ *
+ *          results are matched back to the callers by the input-transformed key, so maps whose find reports
+ *          a differently transformed key (bimolecule storage transform) are not supported.
+ */
+#ifndef BLISS_DISTRIBUTED_QUERY_BATCHER_HPP
+#define BLISS_DISTRIBUTED_QUERY_BATCHER_HPP
+
+#include <vector>
+#include <deque>
+#include <utility>      // pair
+#include <functional>   // plus
+#include <algorithm>    // sort, lower_bound
+#include <future>
+#include <mutex>
+#include <chrono>
+
+#include <mxx/comm.hpp>
+#include <mxx/reduction.hpp>
+
+#include "utils/logging.h"
+
+namespace dsc  // distributed std container
+{
+
+  /**
+   * @brief  buffers queries against a distributed map and answers them in batched collective rounds.
+   * @details  submitting queries is thread safe and not collective.  progress() and flush() are collective.
+   *           the map must outlive the batcher, and must not be modified while queries are pending.
+   * @tparam MapType   distributed map or multimap, e.g. dsc::unordered_multimap.
+   */
+  template <typename MapType>
+  class query_batcher {
+    public:
+      using key_type = typename MapType::key_type;
+      using find_result_type = decltype(::std::declval<MapType const &>().find(::std::declval<::std::vector<key_type> &>()));
+      using count_result_type = decltype(::std::declval<MapType const &>().count(::std::declval<::std::vector<key_type> &>()));
+
+    protected:
+      using clock = ::std::chrono::steady_clock;
+
+      /// one caller's request.
+      template <typename R>
+      struct request {
+          ::std::vector<key_type> queries;
+          ::std::promise<R> result;
+      };
+
+      MapType const & map;
+      const mxx::comm& comm;
+
+      /// round size limits, in globally buffered keys
+      size_t min_batch;
+      size_t max_batch;
+      /// longest time a query waits before it forces a round
+      clock::duration max_delay;
+      /// target fraction of the round time not spent on latency
+      double efficiency;
+
+      /// current target round size
+      size_t target;
+
+      /// buffered requests, guarded by mutex
+      ::std::mutex mutex;
+      ::std::vector<request<find_result_type> > pending_find;
+      ::std::vector<request<count_result_type> > pending_count;
+      size_t pending_keys;
+      clock::time_point oldest;
+
+      /// recent (global keys, seconds) samples for the round time model
+      ::std::deque<::std::pair<double, double> > samples;
+      static constexpr size_t max_samples = 32;
+      double latency;
+      double bandwidth;
+
+      size_t rounds;
+
+      /// split round results back to the requests, in each request's query order.  results are sorted by key.
+      template <typename R>
+      static void distribute(R & results, ::std::vector<request<R> > & requests) {
+        using entry_type = typename R::value_type;
+        auto less = [](entry_type const & x, entry_type const & y) { return x.first < y.first; };
+        ::std::stable_sort(results.begin(), results.end(), less);
+
+        for (auto & r : requests) {
+          R out;
+          for (auto const & q : r.queries) {
+            auto it = ::std::lower_bound(results.begin(), results.end(), q,
+                                         [](entry_type const & x, key_type const & y) { return x.first < y; });
+            for (; (it != results.end()) && (it->first == q); ++it) {
+              out.emplace_back(*it);
+            }
+          }
+          r.result.set_value(::std::move(out));
+        }
+      }
+
+      /// concatenate the queries of the requests, input transformed in place so they match the result keys.
+      template <typename R>
+      ::std::vector<key_type> gather(::std::vector<request<R> > & requests) const {
+        size_t total = 0;
+        for (auto const & r : requests) total += r.queries.size();
+
+        ::std::vector<key_type> keys;
+        keys.reserve(total);
+        for (auto & r : requests) {
+          map.transform_input(r.queries);
+          keys.insert(keys.end(), r.queries.begin(), r.queries.end());
+        }
+        ::std::sort(keys.begin(), keys.end());
+        keys.erase(::std::unique(keys.begin(), keys.end()), keys.end());
+        return keys;
+      }
+
+      /// refit latency and bandwidth, and update the target round size.
+      void update_model(double const & keys, double const & seconds) {
+        samples.emplace_back(keys, seconds);
+        if (samples.size() > max_samples) samples.pop_front();
+        if (samples.size() < 2) return;
+
+        double mn = 0, mt = 0;
+        for (auto const & s : samples) {
+          mn += s.first;
+          mt += s.second;
+        }
+        mn /= samples.size();
+        mt /= samples.size();
+
+        double cov = 0, var = 0;
+        for (auto const & s : samples) {
+          cov += (s.first - mn) * (s.second - mt);
+          var += (s.first - mn) * (s.first - mn);
+        }
+        if ((var <= 0) || (cov <= 0)) return;   // all rounds the same size, or no measurable cost per key.
+
+        double seconds_per_key = cov / var;
+        latency = ::std::max(0.0, mt - seconds_per_key * mn);
+        bandwidth = 1.0 / seconds_per_key;
+
+        // latency / (latency + n / bandwidth) <= 1 - efficiency
+        double n = latency * bandwidth * efficiency / (1.0 - efficiency);
+        target = ::std::min(max_batch, ::std::max(min_batch, static_cast<size_t>(n)));
+      }
+
+      /// one collective round over everything buffered.  has_find and has_count must agree across processes.
+      void round(bool const & has_count, bool const & has_find, size_t const & global_keys) {
+        ::std::vector<request<find_result_type> > finds;
+        ::std::vector<request<count_result_type> > counts;
+        {
+          ::std::lock_guard<::std::mutex> lock(mutex);
+          // queries submitted after global_state() may be of an op not in this round.  keep those for the next one.
+          if (has_find) finds.swap(pending_find);
+          if (has_count) counts.swap(pending_count);
+          pending_keys = 0;
+          for (auto const & r : pending_find) pending_keys += r.queries.size();
+          for (auto const & r : pending_count) pending_keys += r.queries.size();
+          if ((pending_find.size() + pending_count.size()) > 0) oldest = clock::now();
+        }
+
+        auto start = clock::now();
+        if (has_count) {
+          auto keys = gather(counts);
+          auto results = map.count(keys);
+          distribute(results, counts);
+        }
+        if (has_find) {
+          auto keys = gather(finds);
+          auto results = map.find(keys);
+          distribute(results, finds);
+        }
+        double seconds = ::std::chrono::duration<double>(clock::now() - start).count();
+        if (comm.size() > 1)
+          seconds = ::mxx::allreduce(seconds, [](double const & x, double const & y){ return ::std::max(x, y); }, comm);
+
+        update_model(global_keys, seconds);
+        ++rounds;
+      }
+
+      /// global pending keys, then whether any process has a stale query, has count, has find queries.
+      ::std::vector<size_t> global_state() {
+        ::std::vector<size_t> state(4, 0);
+        {
+          ::std::lock_guard<::std::mutex> lock(mutex);
+          state[0] = pending_keys;
+          state[1] = ((pending_find.size() + pending_count.size()) > 0) && ((clock::now() - oldest) >= max_delay);
+          state[2] = pending_count.size() > 0;
+          state[3] = pending_find.size() > 0;
+        }
+        if (comm.size() > 1)
+          state = ::mxx::allreduce(state, ::std::plus<size_t>(), comm);
+        return state;
+      }
+
+      template <typename R>
+      ::std::future<R> submit(::std::vector<request<R> > & pending, ::std::vector<key_type> && queries) {
+        request<R> r;
+        r.queries = ::std::move(queries);
+        ::std::future<R> f = r.result.get_future();
+
+        ::std::lock_guard<::std::mutex> lock(mutex);
+        if ((pending_find.size() + pending_count.size()) == 0) oldest = clock::now();
+        pending_keys += r.queries.size();
+        pending.emplace_back(::std::move(r));
+        return f;
+      }
+
+    public:
+      /**
+       * @param _map          distributed map to query.
+       * @param _comm         communicator of the map
+       * @param _min_batch    smallest target round size, in keys summed over all processes
+       * @param _max_batch    largest target round size
+       * @param _max_delay_ms longest a query waits before progress() flushes it
+       * @param _efficiency   target fraction of a round not spent on latency, in (0, 1)
+       */
+      query_batcher(MapType const & _map, const mxx::comm& _comm,
+                    size_t const & _min_batch = 1024, size_t const & _max_batch = (1UL << 24),
+                    double const & _max_delay_ms = 5.0, double const & _efficiency = 0.9) :
+        map(_map), comm(_comm), min_batch(_min_batch), max_batch(::std::max(_min_batch, _max_batch)),
+        max_delay(::std::chrono::duration_cast<clock::duration>(::std::chrono::duration<double, ::std::milli>(_max_delay_ms))),
+        efficiency(::std::min(0.99, ::std::max(0.01, _efficiency))),
+        target(_min_batch), pending_keys(0), latency(0), bandwidth(0), rounds(0) {}
+
+      virtual ~query_batcher() {}
+
+      /// queue a find.  the future is ready after the round that includes it; entries are grouped by query, in query order.
+      ::std::future<find_result_type> find(::std::vector<key_type> queries) {
+        return submit(pending_find, ::std::move(queries));
+      }
+
+      /// queue a count.  one (key, count) per query, in query order.
+      ::std::future<count_result_type> count(::std::vector<key_type> queries) {
+        return submit(pending_count, ::std::move(queries));
+      }
+
+      /// run a round if the buffered queries reached the target size, or some query is too old.  collective.
+      /// @return whether a round ran.
+      bool progress() {
+        ::std::vector<size_t> state = global_state();
+        if ((state[0] < target) && (state[1] == 0)) return false;
+        if ((state[2] == 0) && (state[3] == 0)) return false;
+
+        round(state[2] > 0, state[3] > 0, state[0]);
+        return true;
+      }
+
+      /// answer everything buffered now.  collective.
+      void flush() {
+        ::std::vector<size_t> state = global_state();
+        if ((state[2] == 0) && (state[3] == 0)) return;
+
+        round(state[2] > 0, state[3] > 0, state[0]);
+      }
+
+      /// locally buffered keys
+      size_t pending() {
+        ::std::lock_guard<::std::mutex> lock(mutex);
+        return pending_keys;
+      }
+
+      /// current target round size, in keys summed over all processes
+      size_t get_target() const {
+        return target;
+      }
+
+      /// fitted per round latency in seconds.  0 until there are enough rounds of different sizes.
+      double get_latency() const {
+        return latency;
+      }
+
+      /// fitted keys per second.  0 until there are enough rounds of different sizes.
+      double get_bandwidth() const {
+        return bandwidth;
+      }
+
+      size_t get_rounds() const {
+        return rounds;
+      }
+  };
+
+} /* namespace dsc */
+
+#endif // BLISS_DISTRIBUTED_QUERY_BATCHER_HPP
@@ -0,0 +1,341 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    distributed_rma_map.hpp
+ * @ingroup dsc::data_structures
+ * @author  agent <agent@local>
+ * @brief   read-only distributed map with non-collective, one-sided lookups.
+ * @details find and count of the distributed maps are collectives: every process has to call them together.
+ *          rma_map is a frozen snapshot of a distributed map that can be queried by any process at any time.
+ *
+ *          each process owns the keys with  h(k) % p == rank.  its entries are stored in a fixed layout:
+ *            offsets:  bucket_count + 1 offsets into the entry array.  bucket of k is  (h(k) / p) % bucket_count
+ *            entries:  (key, value) pairs, grouped by bucket.
+ *          both arrays are exposed in MPI windows, in a passive target epoch for the lifetime of the map.
+ *          a lookup is 2 MPI_Gets to the owner: the bucket's 2 offsets, then the bucket's entries.
+ *          batched lookups issue all the offset gets, flush, then all the entry gets, so the latencies overlap.
+ *          lookups of local keys read the arrays directly.
+ *
+ *          construction and destruction are collective.  lookups are not, and the owner does not participate.
+ *          Key and T must be trivially copyable.  concurrent lookups from multiple threads require MPI_THREAD_MULTIPLE.
+ */
+#ifndef BLISS_DISTRIBUTED_RMA_MAP_HPP
+#define BLISS_DISTRIBUTED_RMA_MAP_HPP
+
+#include <mpi.h>
+
+#include <vector>
+#include <utility>      // pair
+#include <functional>   // hash, less
+#include <algorithm>    // transform
+#include <iterator>     // back_inserter
+#include <type_traits>
+#include <sstream>
+#include <stdexcept>
+
+#include <mxx/comm.hpp>
+#include <mxx/collective.hpp>
+#include <mxx/reduction.hpp>
+#include <mxx/algos.hpp>      // bucketing
+
+#include "common/kmer.hpp"
+#include "index/kmer_hash.hpp"
+#include "containers/fsc_container_utils.hpp"
+#include "containers/distributed_map_base.hpp"
+#include "utils/benchmark_utils.hpp"
+#include "utils/exception_handling.hpp"
+#include "utils/logging.h"
+
+namespace dsc  // distributed std container
+{
+
+  /**
+   * @brief  read-only snapshot of a distributed map or multimap, with one-sided lookups.
+   * @details  h is the farm hash (std::hash for non-kmers) of the storage transformed key.
+   *           keys are matched with the storage transformed equal of the source map.
+   *
+   * @tparam Key
+   * @tparam T
+   * @tparam MapParams  same as the source map.  InputTransform is applied to queries.
+   */
+  template<typename Key, typename T,
+  template <typename> class MapParams
+  >
+  class rma_map {
+
+    public:
+      using key_type              = Key;
+      using mapped_type           = T;
+      using value_type            = ::std::pair<Key, T>;
+      using size_type             = size_t;
+
+    protected:
+      using InputTransform = typename MapParams<Key>::InputTransform;
+
+      template <typename K>
+      using StoreTransform = typename MapParams<Key>::template StorageTransform<K>;
+
+      template <typename K>
+      using StoreFarmHash = typename ::std::conditional<::bliss::common::is_kmer<K>::value,
+          ::bliss::kmer::hash::farm<K, false>,
+           ::std::hash<K> >::type;
+
+      using StoreTransformedFarmHash = ::fsc::TransformedHash<Key, StoreFarmHash, StoreTransform>;
+      using StoreTransformedEqual = typename MapParams<Key>::StorageTransformedEqual;
+
+      const mxx::comm& comm;
+
+      /// bucket count of each process.
+      ::std::vector<size_t> bucket_counts;
+
+      /// local arrays.  exposed in the windows, so they are not resized after construction.
+      ::std::vector<size_t> offsets;
+      ::std::vector<value_type> entries;
+
+      MPI_Win offsets_win;
+      MPI_Win entries_win;
+
+      StoreTransformedFarmHash hash;
+      StoreTransformedEqual eq;
+      InputTransform input_trans;
+
+      /// process that owns key
+      inline int key_to_rank(Key const & k) const {
+        return hash(k) % comm.size();
+      }
+      /// bucket of key, on its owner
+      inline size_t key_to_bucket(Key const & k, int const & rank) const {
+        return (hash(k) / comm.size()) % bucket_counts[rank];
+      }
+
+      /// expose a local array in a window, and start the passive target epoch.
+      template <typename V>
+      void create_window(::std::vector<V> & data, MPI_Win & win) {
+        int res = MPI_Win_create(data.empty() ? nullptr : data.data(), static_cast<MPI_Aint>(data.size() * sizeof(V)),
+                                 sizeof(V), MPI_INFO_NULL, comm, &win);
+        if (res != MPI_SUCCESS) {
+          std::stringstream ss;
+          ss << "ERROR: MPI_Win_create: rma_map failed to expose " << (data.size() * sizeof(V)) << " bytes. error " << res;
+          throw ::bliss::utils::make_exception<std::runtime_error>(ss.str());
+        }
+        MPI_Win_lock_all(MPI_MODE_NOCHECK, win);
+      }
+
+      /// copy matching entries of a bucket to output.  returns number copied.
+      template <typename Iter, typename OutputIter>
+      size_t match(Key const & k, Iter first, Iter last, OutputIter & output) const {
+        size_t count = 0;
+        for (; first != last; ++first) {
+          if (eq(first->first, k)) {
+            *output = *first;
+            ++output;
+            ++count;
+          }
+        }
+        return count;
+      }
+
+    public:
+
+      /**
+       * @brief  snapshot a distributed map.  collective.
+       * @details  the source map is not modified, and may be destroyed afterwards.
+       * @param map    source map.  any dsc map with the same Key, T, and MapParams.
+       * @param _comm  the map's communicator.
+       */
+      template <class Alloc>
+      rma_map(::dsc::map_base<Key, T, MapParams, Alloc> const & map, const mxx::comm& _comm) :
+        comm(_comm), offsets_win(MPI_WIN_NULL), entries_win(MPI_WIN_NULL) {
+
+        BL_BENCH_INIT(freeze);
+
+        BL_BENCH_START(freeze);
+        map.to_vector(entries);
+        BL_BENCH_END(freeze, "to_vector", entries.size());
+
+        if (comm.size() > 1) {
+          BL_BENCH_START(freeze);
+          ::std::vector<size_t> send_counts =
+              ::mxx::bucketing(entries, [this](value_type const & x) { return this->key_to_rank(x.first); }, comm.size());
+          ::mxx::all2allv(entries, send_counts, comm).swap(entries);
+          BL_BENCH_END(freeze, "distribute", entries.size());
+        }
+
+        // about 2 entries per bucket.  multimap buckets are larger.
+        BL_BENCH_START(freeze);
+        size_t buckets = 1;
+        while ((buckets << 1) <= entries.size()) buckets <<= 1;
+        bucket_counts = ::mxx::allgather(buckets, comm);
+        BL_BENCH_END(freeze, "bucket_count", buckets);
+
+        // counting sort by bucket.
+        BL_BENCH_START(freeze);
+        int rank = comm.rank();
+        offsets.assign(buckets + 1, 0);
+        ::std::vector<size_t> bucket_ids(entries.size());
+        for (size_t i = 0; i < entries.size(); ++i) {
+          bucket_ids[i] = this->key_to_bucket(entries[i].first, rank);
+          ++offsets[bucket_ids[i] + 1];
+        }
+        for (size_t b = 1; b <= buckets; ++b) {
+          offsets[b] += offsets[b - 1];
+        }
+        {
+          ::std::vector<size_t> pos(offsets.begin(), offsets.end() - 1);
+          ::std::vector<value_type> sorted(entries.size());
+          for (size_t i = 0; i < entries.size(); ++i) {
+            sorted[pos[bucket_ids[i]]++] = entries[i];
+          }
+          entries.swap(sorted);
+        }
+        BL_BENCH_END(freeze, "bucket_sort", entries.size());
+
+        BL_BENCH_START(freeze);
+        this->create_window(offsets, offsets_win);
+        this->create_window(entries, entries_win);
+        comm.barrier();
+        BL_BENCH_END(freeze, "expose", entries.size());
+
+        BL_BENCH_REPORT_MPI_NAMED(freeze, "rma_map:freeze", comm);
+      }
+
+      rma_map(rma_map const & other) = delete;
+      rma_map& operator=(rma_map const & other) = delete;
+
+      /// release the windows.  collective.
+      virtual ~rma_map() {
+        if (entries_win != MPI_WIN_NULL) {
+          MPI_Win_unlock_all(entries_win);
+          MPI_Win_free(&entries_win);
+        }
+        if (offsets_win != MPI_WIN_NULL) {
+          MPI_Win_unlock_all(offsets_win);
+          MPI_Win_free(&offsets_win);
+        }
+      }
+
+      /// number of entries owned by this process.
+      size_t local_size() const {
+        return entries.size();
+      }
+
+      /// total number of entries.  collective
+      size_t size() const {
+        return (comm.size() == 1) ? local_size() : ::mxx::allreduce(local_size(), comm);
+      }
+
+      /**
+       * @brief  find the entries of 1 key.  not collective.
+       * @param key     query
+       * @param output  output iterator for matching entries.
+       * @return        number of entries found.
+       */
+      template <typename OutputIter>
+      size_t find(Key const & key, OutputIter output) const {
+        Key k = input_trans(key);
+        int r = key_to_rank(k);
+        size_t b = key_to_bucket(k, r);
+
+        if (r == comm.rank()) {
+          return this->match(k, entries.begin() + offsets[b], entries.begin() + offsets[b + 1], output);
+        }
+
+        size_t range[2];
+        MPI_Get(range, 2 * sizeof(size_t), MPI_BYTE, r, b, 2 * sizeof(size_t), MPI_BYTE, offsets_win);
+        MPI_Win_flush(r, offsets_win);
+        if (range[1] == range[0]) return 0;
+
+        ::std::vector<value_type> bucket(range[1] - range[0]);
+        MPI_Get(bucket.data(), bucket.size() * sizeof(value_type), MPI_BYTE, r, range[0],
+                bucket.size() * sizeof(value_type), MPI_BYTE, entries_win);
+        MPI_Win_flush(r, entries_win);
+
+        return this->match(k, bucket.begin(), bucket.end(), output);
+      }
+
+      /**
+       * @brief  find the entries of a batch of keys.  not collective.
+       * @details  all offset gets are issued before the first flush, then all entry gets, so each phase costs about 1 latency.
+       * @param keys    queries
+       * @return        matching entries, in query order.
+       */
+      ::std::vector<value_type> find(::std::vector<Key> const & keys) const {
+        ::std::vector<value_type> results;
+        if (keys.empty()) return results;
+
+        ::fsc::back_emplace_iterator<::std::vector<value_type> > output(results);
+
+        // transformed keys, owners, and bucket ranges.
+        ::std::vector<Key> ks(keys.size());
+        ::std::transform(keys.begin(), keys.end(), ks.begin(), input_trans);
+        ::std::vector<int> ranks(ks.size());
+        ::std::vector<size_t> ranges(2 * ks.size());
+
+        bool remote = false;
+        for (size_t i = 0; i < ks.size(); ++i) {
+          ranks[i] = key_to_rank(ks[i]);
+          size_t b = key_to_bucket(ks[i], ranks[i]);
+          if (ranks[i] == comm.rank()) {
+            ranges[2 * i] = offsets[b];
+            ranges[2 * i + 1] = offsets[b + 1];
+          } else {
+            MPI_Get(&(ranges[2 * i]), 2 * sizeof(size_t), MPI_BYTE, ranks[i], b, 2 * sizeof(size_t), MPI_BYTE, offsets_win);
+            remote = true;
+          }
+        }
+        if (remote) MPI_Win_flush_all(offsets_win);
+
+        // fetch remote buckets into 1 buffer.
+        ::std::vector<size_t> starts(ks.size() + 1, 0);
+        for (size_t i = 0; i < ks.size(); ++i) {
+          starts[i + 1] = starts[i] + ((ranks[i] == comm.rank()) ? 0 : (ranges[2 * i + 1] - ranges[2 * i]));
+        }
+        ::std::vector<value_type> buckets(starts.back());
+        if (remote) {
+          for (size_t i = 0; i < ks.size(); ++i) {
+            size_t n = starts[i + 1] - starts[i];
+            if (n == 0) continue;
+            MPI_Get(&(buckets[starts[i]]), n * sizeof(value_type), MPI_BYTE, ranks[i], ranges[2 * i],
+                    n * sizeof(value_type), MPI_BYTE, entries_win);
+          }
+          MPI_Win_flush_all(entries_win);
+        }
+
+        for (size_t i = 0; i < ks.size(); ++i) {
+          if (ranks[i] == comm.rank()) {
+            this->match(ks[i], entries.begin() + ranges[2 * i], entries.begin() + ranges[2 * i + 1], output);
+          } else {
+            this->match(ks[i], buckets.begin() + starts[i], buckets.begin() + starts[i + 1], output);
+          }
+        }
+        return results;
+      }
+
+      /**
+       * @brief  count the entries of 1 key.  not collective.
+       */
+      size_t count(Key const & key) const {
+        ::std::vector<value_type> found;
+        return this->find(key, ::std::back_inserter(found));
+      }
+  };
+
+
+} /* namespace dsc */
+
+
+#endif // BLISS_DISTRIBUTED_RMA_MAP_HPP
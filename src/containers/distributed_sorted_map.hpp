@@ -65,6 +65,8 @@
 #include "containers/distributed_map_base.hpp"
 #include "common/kmer_transform.hpp"
 #include "containers/dsc_container_utils.hpp"
+#include "containers/distributed_aggregators.hpp"
+#include "containers/distributed_spectrum.hpp"
 #include "io/incremental_mxx.hpp"
 
 
@@ -496,6 +498,7 @@ using SortedMapParams = ::dsc::DistributedMapParams<
       ::std::vector<::std::pair<Key, T> > find_overlap(LocalFind & lf, ::std::vector<Key>& keys, bool sorted_input = false,
           Predicate const& pred = Predicate() ) const {
           BL_BENCH_INIT(find);
+          ::plog::CommProfiler::scope comm_profile("find");
           ::std::vector<::std::pair<Key, T> > results;
 
           if (this->empty() || ::dsc::empty(keys, this->comm)) {
@@ -526,10 +529,7 @@ using SortedMapParams = ::dsc::DistributedMapParams<
             // distribute (communication part)
             std::vector<size_t> recv_counts;
             {
-				std::vector<size_t> i2o;
-				std::vector<Key > buffer;
-				::imxx::distribute(keys, this->key_to_rank, recv_counts, i2o, buffer, this->comm);
-				keys.swap(buffer);
+				::imxx::distribute(keys, this->key_to_rank, recv_counts, this->arena, this->comm);
 //      		  ::dsc::distribute_sorted_unique(keys, this->key_to_rank, sorted_input, this->comm,
 //      				  typename Base::StoreTransformedFunc(),
 //      				  typename Base::StoreTransformedEqual()).swap(recv_counts);
@@ -692,6 +692,7 @@ using SortedMapParams = ::dsc::DistributedMapParams<
 
           }
 
+          this->account_results(results);
           BL_BENCH_REPORT_MPI_NAMED(find, "base_sorted_map:find_overlap", this->comm);
 
           return results;
@@ -709,6 +710,7 @@ using SortedMapParams = ::dsc::DistributedMapParams<
     		  Predicate const& pred = Predicate() ) const {
 
           BL_BENCH_INIT(find);
+          ::plog::CommProfiler::scope comm_profile("find");
           ::std::vector<::std::pair<Key, T> > results;
 
           if (this->empty() || ::dsc::empty(keys, this->comm)) {
@@ -740,10 +742,7 @@ using SortedMapParams = ::dsc::DistributedMapParams<
             // distribute (communication part)
             std::vector<size_t> recv_counts;
             {
-				std::vector<size_t> i2o;
-				std::vector<Key > buffer;
-				::imxx::distribute(keys, this->key_to_rank, recv_counts, i2o, buffer, this->comm);
-				keys.swap(buffer);
+				::imxx::distribute(keys, this->key_to_rank, recv_counts, this->arena, this->comm);
 //      		  ::dsc::distribute_sorted_unique(keys, this->key_to_rank, sorted_input, this->comm,
 //      				  typename Base::StoreTransformedFunc(),
 //      				  typename Base::StoreTransformedEqual()).swap(recv_counts);
@@ -755,6 +754,7 @@ using SortedMapParams = ::dsc::DistributedMapParams<
             BL_BENCH_START(find);
             float multi = this->get_multiplicity();
             if (this->comm.rank() == 0) printf("rank %d multiplicity %f\n", this->comm.rank(), multi);
+            this->arena.acquire(::imxx::exchange_arena::RESULTS, results);
             results.reserve(keys.size() * multi);                   // TODO:  should estimate coverage.
             BL_BENCH_END(find, "reserve", results.capacity());
 
@@ -796,7 +796,7 @@ using SortedMapParams = ::dsc::DistributedMapParams<
 
             // send back using the constructed recv count
             BL_BENCH_COLLECTIVE_START(find, "a2a2", this->comm);
-            mxx::all2allv(results, send_counts, this->comm).swap(results);
+            ::imxx::exchange(results, send_counts, this->arena, this->comm);
             BL_BENCH_END(find, "a2a2", results.size());
 
           } else {
@@ -850,6 +850,7 @@ using SortedMapParams = ::dsc::DistributedMapParams<
 
           }
 
+          this->account_results(results);
           BL_BENCH_REPORT_MPI_NAMED(find, "base_sorted_map:find", this->comm);
 
           return results;
@@ -1011,6 +1012,7 @@ using SortedMapParams = ::dsc::DistributedMapParams<
 
 
         BL_BENCH_INIT(count);
+        ::plog::CommProfiler::scope comm_profile("count");
 
         // still process - one input, one output
         if (::dsc::empty(keys, this->comm)) {
@@ -1049,10 +1051,7 @@ using SortedMapParams = ::dsc::DistributedMapParams<
           // distribute (communication part)
           std::vector<size_t> recv_counts;
           {
-				std::vector<size_t> i2o;
-				std::vector<Key > buffer;
-				::imxx::distribute(keys, this->key_to_rank, recv_counts, i2o, buffer, this->comm);
-				keys.swap(buffer);
+				::imxx::distribute(keys, this->key_to_rank, recv_counts, this->arena, this->comm);
 //      		  ::dsc::distribute_sorted_unique(keys, this->key_to_rank, sorted_input, this->comm,
 //      				  typename Base::StoreTransformedFunc(),
 //      				  typename Base::StoreTransformedEqual()).swap(recv_counts);
@@ -1063,6 +1062,7 @@ using SortedMapParams = ::dsc::DistributedMapParams<
           BL_BENCH_START(count);
           // local find. memory utilization a potential problem.
           // do for each src proc one at a time.
+          this->arena.acquire(::imxx::exchange_arena::RESULTS, results);
           results.reserve(keys.size());                   // TODO:  should estimate coverage.
           BL_BENCH_END(count, "reserve", results.capacity());
 
@@ -1085,7 +1085,7 @@ using SortedMapParams = ::dsc::DistributedMapParams<
 
           BL_BENCH_COLLECTIVE_START(count, "a2a2", this->comm);
           // send back using the constructed recv count
-          mxx::all2allv(results, recv_counts, this->comm).swap(results);
+          ::imxx::exchange(results, recv_counts, this->arena, this->comm);
           BL_BENCH_END(count, "a2a2", results.size());
 
 
@@ -1118,6 +1118,7 @@ using SortedMapParams = ::dsc::DistributedMapParams<
           BL_BENCH_END(count, "local_count", results.size());
 
         }
+        this->account_results(results);
         BL_BENCH_REPORT_MPI_NAMED(count, "base_sorted_map:count", this->comm);
 
         return results;
@@ -1148,6 +1149,27 @@ using SortedMapParams = ::dsc::DistributedMapParams<
         return results;
       }
 
+      /**
+       * @brief aggregate the values of groups of keys at the owning processes.  see map_base::aggregate_at_owners.
+       *           see containers/distributed_aggregators.hpp for sum, min, max, count and histogram.
+       * @param keys  content will be changed and reordered
+       * @return   one aggregate per group.  groups without matching entries get agg.identity().
+       */
+      template <typename Aggregator>
+      ::std::vector<typename Aggregator::result_type> aggregate(::std::vector<Key>& keys, ::std::vector<size_t> const & groups,
+                                                                size_t const & group_count,
+                                                                Aggregator const & agg = Aggregator()) const {
+          // ensure that the container splitters are setup properly, and load balanced.
+          if (this->comm.size() > 1) this->redistribute();
+          else this->local_sort();
+
+          return this->aggregate_at_owners(keys, groups, group_count, agg, this->key_to_rank,
+                                           [this](Key const & k) {
+                                             return ::std::equal_range(this->c.begin(), this->c.end(), k,
+                                                                       typename Base::StoreTransformedFunc());
+                                           }, "base_sorted_map:aggregate");
+      }
+
 
 //      /**
 //       * @brief insert new elements in the distributed sorted_multimap.  example use: stop inserting if more than x entries.
@@ -1242,6 +1264,7 @@ using SortedMapParams = ::dsc::DistributedMapParams<
       size_t erase(::std::vector<Key>& keys, bool sorted_input = false, Predicate const & pred = Predicate() ) {
         // even if count is 0, still need to participate in mpi calls.  if (keys.size() == 0) return;
           BL_BENCH_INIT(erase);
+          ::plog::CommProfiler::scope comm_profile("erase");
 
           if (this->empty() || ::dsc::empty(keys, this->comm)) {
             BL_BENCH_REPORT_MPI_NAMED(erase, "base_sorted_map:erase", this->comm);
@@ -1265,11 +1288,8 @@ using SortedMapParams = ::dsc::DistributedMapParams<
 //            BLISS_UNUSED(recv_counts);
           std::vector<size_t> recv_counts;
           {
-				std::vector<size_t> i2o;
-				std::vector<Key > buffer;
-				::imxx::distribute(keys, this->key_to_rank, recv_counts, i2o, buffer, this->comm);
+				::imxx::distribute(keys, this->key_to_rank, recv_counts, this->arena, this->comm);
 				//::imxx::destructive_distribute(input, this->key_to_rank, recv_counts, buffer, this->comm);
-				keys.swap(buffer);
           }
           BL_BENCH_END(erase, "dist_query", keys.size());
 
@@ -2226,6 +2246,7 @@ using SortedMapParams = ::dsc::DistributedMapParams<
       size_t update(std::vector<::std::pair<Key, V> >& input, bool sorted_input, Updater const & op ) {
         // even if count is 0, still need to participate in mpi calls.  if (input.size() == 0) return;
         BL_BENCH_INIT(update);
+        ::plog::CommProfiler::scope comm_profile("update");
 
         if (this->empty() || ::dsc::empty(input, this->comm)) {
           BL_BENCH_REPORT_MPI_NAMED(update, "sortedmap:update", this->comm);
@@ -2245,10 +2266,7 @@ using SortedMapParams = ::dsc::DistributedMapParams<
           BL_BENCH_START(update);
     //      ::dsc::distribute_bucketed(input, recv_counts, this->comm).swap(input);
             std::vector<size_t> recv_counts;
-            std::vector<size_t> i2o;
-            std::vector<::std::pair<Key, V> > buffer;
-            ::imxx::distribute(input, this->key_to_rank, recv_counts, i2o, buffer, this->comm);
-            input.swap(buffer);
+            ::imxx::distribute(input, this->key_to_rank, recv_counts, this->arena, this->comm);
 
           BL_BENCH_END(update, "distribute", input.size());
 
@@ -2503,7 +2521,7 @@ using SortedMapParams = ::dsc::DistributedMapParams<
 
           BL_BENCH_COLLECTIVE_START(rehash, "a2a", this->comm);
           // TODO: readjust boundaries using all2all.  is it better to move the deltas ourselves?
-          mxx::all2allv(this->c, send_counts, this->comm).swap(this->c);
+          ::imxx::exchange(this->c, send_counts, this->comm).swap(this->c);
           BL_BENCH_END(rehash, "a2a", this->c.size());
 
         } else {
@@ -2850,6 +2868,17 @@ using SortedMapParams = ::dsc::DistributedMapParams<
       using Base::count;
       using Base::find;
 
+      /**
+       * @brief  count histogram (kmer spectrum).  h[i] is the number of distinct keys with count i, counts >= bins - 1 in the last bin.
+       * @details  redistributes first so that each key has a single, fully reduced entry, then scans the local
+       *           vector in place and sums the fixed size histograms.  collective.
+       *           see ::dsc::spectrum::first_valley for the error/solid threshold.
+       */
+      ::std::vector<size_t> histogram(size_t const & bins = 256) const {
+        this->redistribute();
+        return ::dsc::spectrum::histogram(this->c.begin(), this->c.end(), bins, this->comm);
+      }
+
       /**
        * @brief insert new elements in the distributed sorted_multimap.  convert from Key to Key-count pair.  LOCAL INSERT
        * @param first
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    distributed_spectrum.hpp
+ * @ingroup dsc::data_structures
+ * @author  agent <agent@local>
+ * @brief   count histogram (kmer spectrum) of counting maps, and the error/solid threshold estimate.
+ * @details the histogram has a fixed number of bins:  h[i] is the number of distinct keys with count i,
+ *          and the last bin collects all counts >= bins - 1.  local tables are scanned in place, and the
+ *          fixed size local histograms are summed with an allreduce, so memory does not depend on the table size.
+ *
+ *          in a kmer spectrum, erroneous kmers form a peak at low counts that decays quickly, and solid kmers
+ *          form a second peak around the coverage.  the first valley between the two is the usual threshold
+ *          for filtering out erroneous kmers.
+ */
+#ifndef BLISS_DISTRIBUTED_SPECTRUM_HPP
+#define BLISS_DISTRIBUTED_SPECTRUM_HPP
+
+#include <vector>
+#include <functional>   // plus
+#include <algorithm>    // min
+#include <cstddef>
+
+#include <mxx/comm.hpp>
+#include <mxx/reduction.hpp>
+
+namespace dsc  // distributed std container
+{
+  namespace spectrum
+  {
+
+    /// histogram of the counts (pair second) in [begin, end).  counts >= bins - 1 go in the last bin.
+    template <typename Iter>
+    ::std::vector<size_t> local_histogram(Iter begin, Iter end, size_t const & bins) {
+      ::std::vector<size_t> h(bins, 0);
+      if (bins == 0) return h;
+
+      for (auto it = begin; it != end; ++it) {
+        ++h[::std::min(static_cast<size_t>((*it).second), bins - 1)];
+      }
+      return h;
+    }
+
+    /// global histogram of the counts of all processes' [begin, end).  collective.
+    template <typename Iter>
+    ::std::vector<size_t> histogram(Iter begin, Iter end, size_t const & bins, mxx::comm const & comm) {
+      ::std::vector<size_t> h = local_histogram(begin, end, bins);
+      if ((comm.size() > 1) && (bins > 0))
+        h = ::mxx::allreduce(h, ::std::plus<size_t>(), comm);
+      return h;
+    }
+
+    /**
+     * @brief  estimate the error/solid threshold as the first valley of the spectrum.
+     * @details  the histogram is smoothed with a moving average of 2 * half_window + 1 bins.  starting at count 1,
+     *           the first count whose smoothed frequency is lower than both neighbors' is the valley.
+     *           the overflow (last) bin is not considered.
+     * @return   the valley count, i.e. keep keys with count >= the returned value.  0 if there is no valley.
+     */
+    inline size_t first_valley(::std::vector<size_t> const & h, size_t const & half_window = 1) {
+      if (h.size() < 4) return 0;
+      size_t last = h.size() - 1;   // overflow bin excluded.
+
+      ::std::vector<double> s(last, 0.0);
+      for (size_t i = 1; i < last; ++i) {
+        size_t lo = (i > half_window) ? i - half_window : 1;
+        size_t hi = ::std::min(last - 1, i + half_window);
+        double total = 0;
+        for (size_t j = lo; j <= hi; ++j) total += h[j];
+        s[i] = total / static_cast<double>(hi - lo + 1);
+      }
+
+      for (size_t i = 2; i + 1 < last; ++i) {
+        if ((s[i] < s[i - 1]) && (s[i] <= s[i + 1])) return i;
+      }
+      return 0;
+    }
+
+  } /* namespace spectrum */
+} /* namespace dsc */
+
+#endif // BLISS_DISTRIBUTED_SPECTRUM_HPP
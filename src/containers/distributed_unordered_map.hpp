@@ -54,6 +54,7 @@
 #include <cstdint>  // for uint8, etc.
 
 #include <type_traits>
+#include <stdexcept>
 
 #include <mxx/collective.hpp>
 #include <mxx/reduction.hpp>
@@ -68,6 +69,9 @@
 #include "common/kmer_transform.hpp"
 
 #include "containers/dsc_container_utils.hpp"
+#include "containers/posting_list_map.hpp"
+#include "containers/distributed_aggregators.hpp"
+#include "containers/distributed_spectrum.hpp"
 
 #include "io/incremental_mxx.hpp"
 
@@ -365,6 +369,7 @@ namespace dsc  // distributed std container
       template <class LocalFind, typename Predicate = ::bliss::filter::TruePredicate>
       ::std::vector<::std::pair<Key, T> > find_overlap(LocalFind & find_element, ::std::vector<Key>& keys, bool sorted_input = false, Predicate const& pred = Predicate()) const {
           BL_BENCH_INIT(find);
+          ::plog::CommProfiler::scope comm_profile("find");
 
           ::std::vector<::std::pair<Key, T> > results;
 
@@ -392,10 +397,7 @@ namespace dsc  // distributed std container
               // distribute (communication part)
               std::vector<size_t> recv_counts;
               {
-  				std::vector<size_t> i2o;
-  				std::vector<Key > buffer;
-  				::imxx::distribute(keys, this->key_to_rank, recv_counts, i2o, buffer, this->comm);
-  				keys.swap(buffer);
+  				::imxx::distribute(keys, this->key_to_rank, recv_counts, this->arena, this->comm);
   	//            ::dsc::distribute_unique(keys, this->key_to_rank, sorted_input, this->comm,
   	//            				typename Base::StoreTransformedFunc(),
   	//            				typename Base::StoreTransformedEqual()).swap(recv_counts);
@@ -549,6 +551,7 @@ namespace dsc  // distributed std container
             BL_BENCH_END(find, "local_find", results.size());
           }
 
+          this->account_results(results);
           BL_BENCH_REPORT_MPI_NAMED(find, "base_hashmap:find_overlap", this->comm);
 
           return results;
@@ -564,6 +567,7 @@ namespace dsc  // distributed std container
       template <class LocalFind, typename Predicate = ::bliss::filter::TruePredicate>
       ::std::vector<::std::pair<Key, T> > find(LocalFind & find_element, ::std::vector<Key>& keys, bool sorted_input = false, Predicate const& pred = Predicate()) const {
           BL_BENCH_INIT(find);
+          ::plog::CommProfiler::scope comm_profile("find");
 
           ::std::vector<::std::pair<Key, T> > results;
 
@@ -590,10 +594,7 @@ namespace dsc  // distributed std container
                 // distribute (communication part)
                 std::vector<size_t> recv_counts;
                 {
-  				  std::vector<size_t> i2o;
-  				  std::vector<Key > buffer;
-  				  ::imxx::distribute(keys, this->key_to_rank, recv_counts, i2o, buffer, this->comm);
-  				  keys.swap(buffer);
+  				  ::imxx::distribute(keys, this->key_to_rank, recv_counts, this->arena, this->comm);
   	  //            ::dsc::distribute_unique(keys, this->key_to_rank, sorted_input, this->comm,
   	  //            				typename Base::StoreTransformedFunc(),
   	  //            				typename Base::StoreTransformedEqual()).swap(recv_counts);
@@ -605,6 +606,7 @@ namespace dsc  // distributed std container
             // do for each src proc one at a time.
 
             BL_BENCH_START(find);
+            this->arena.acquire(::imxx::exchange_arena::RESULTS, results);
             results.reserve(keys.size() * 10);                   // TODO:  should estimate coverage.
             BL_BENCH_END(find, "reserve", results.capacity());
 
@@ -644,7 +646,7 @@ namespace dsc  // distributed std container
 
             BL_BENCH_COLLECTIVE_START(find, "a2a2", this->comm);
             // send back using the constructed recv count
-            mxx::all2allv(results, send_counts, this->comm).swap(results);
+            ::imxx::exchange(results, send_counts, this->arena, this->comm);
             BL_BENCH_END(find, "a2a2", results.size());
 
           } else {
@@ -680,6 +682,7 @@ namespace dsc  // distributed std container
 
           }
 
+          this->account_results(results);
           BL_BENCH_REPORT_MPI_NAMED(find, "base_hashmap:find", this->comm);
 
           return results;
@@ -721,6 +724,7 @@ namespace dsc  // distributed std container
           // even if count is 0, still need to participate in mpi calls.  if (keys.size() == 0) return;
           size_t before = this->c.size();
           BL_BENCH_INIT(erase);
+          ::plog::CommProfiler::scope comm_profile("erase");
 
           if (this->empty() || ::dsc::empty(keys, this->comm)) {
             BL_BENCH_REPORT_MPI_NAMED(erase, "base_unordered_map:erase", this->comm);
@@ -738,11 +742,8 @@ namespace dsc  // distributed std container
   //            BLISS_UNUSED(recv_counts);
               std::vector<size_t> recv_counts;
               {
-  				std::vector<size_t> i2o;
-  				std::vector<Key > buffer;
-  				::imxx::distribute(keys, this->key_to_rank, recv_counts, i2o, buffer, this->comm);
+  				::imxx::distribute(keys, this->key_to_rank, recv_counts, this->arena, this->comm);
   				//::imxx::destructive_distribute(input, this->key_to_rank, recv_counts, buffer, this->comm);
-  				keys.swap(buffer);
               }
               BL_BENCH_END(erase, "dist_query", keys.size());
 
@@ -881,6 +882,7 @@ namespace dsc  // distributed std container
       ::std::vector<::std::pair<Key, size_type> > count(::std::vector<Key>& keys, bool sorted_input = false,
                                                         Predicate const& pred = Predicate() ) const {
           BL_BENCH_INIT(count);
+          ::plog::CommProfiler::scope comm_profile("count");
           ::std::vector<::std::pair<Key, size_type> > results;
 
           if (::dsc::empty(keys, this->comm)) {
@@ -917,10 +919,7 @@ namespace dsc  // distributed std container
               // distribute (communication part)
               std::vector<size_t> recv_counts;
               {
-				  std::vector<size_t> i2o;
-				  std::vector<Key > buffer;
-				  ::imxx::distribute(keys, this->key_to_rank, recv_counts, i2o, buffer, this->comm);
-				  keys.swap(buffer);
+				  ::imxx::distribute(keys, this->key_to_rank, recv_counts, this->arena, this->comm);
 	  //            ::dsc::distribute_unique(keys, this->key_to_rank, sorted_input, this->comm,
 	  //            				typename Base::StoreTransformedFunc(),
 	  //            				typename Base::StoreTransformedEqual()).swap(recv_counts);
@@ -931,6 +930,7 @@ namespace dsc  // distributed std container
             // local count. memory utilization a potential problem.
             // do for each src proc one at a time.
             BL_BENCH_START(count);
+            this->arena.acquire(::imxx::exchange_arena::RESULTS, results);
             results.reserve(keys.size() );                   // TODO:  should estimate coverage.
             BL_BENCH_END(count, "reserve", results.capacity());
 
@@ -952,7 +952,7 @@ namespace dsc  // distributed std container
 
             // send back using the constructed recv count
             BL_BENCH_COLLECTIVE_START(count, "a2a2", this->comm);
-            mxx::all2allv(results, recv_counts, this->comm).swap(results);
+            ::imxx::exchange(results, recv_counts, this->arena, this->comm);
             BL_BENCH_END(count, "a2a2", results.size());
           } else {
 
@@ -976,6 +976,7 @@ namespace dsc  // distributed std container
             BL_BENCH_END(count, "local_count", results.size());
           }
 
+          this->account_results(results);
           BL_BENCH_REPORT_MPI_NAMED(count, "base_hashmap:count", this->comm);
 
           return results;
@@ -1002,6 +1003,22 @@ namespace dsc  // distributed std container
       }
 
 
+      /**
+       * @brief aggregate the values of groups of keys at the owning processes.  see map_base::aggregate_at_owners.
+       *           see containers/distributed_aggregators.hpp for sum, min, max, count and histogram.
+       * @param keys  content will be changed and reordered
+       * @return   one aggregate per group.  groups without matching entries get agg.identity().
+       */
+      template <typename Aggregator>
+      ::std::vector<typename Aggregator::result_type> aggregate(::std::vector<Key>& keys, ::std::vector<size_t> const & groups,
+                                                                size_t const & group_count,
+                                                                Aggregator const & agg = Aggregator()) const {
+          return this->aggregate_at_owners(keys, groups, group_count, agg, this->key_to_rank,
+                                           [this](Key const & k) { return this->c.equal_range(k); },
+                                           "base_unordered_map:aggregate");
+      }
+
+
 
       /**
        * @brief erase elements with the specified keys in the distributed unordered_multimap.
@@ -1186,6 +1203,7 @@ namespace dsc  // distributed std container
       size_t insert(std::vector<::std::pair<Key, T> >& input, bool sorted_input = false, Predicate const & pred = Predicate()) {
         // even if count is 0, still need to participate in mpi calls.  if (input.size() == 0) return;
         BL_BENCH_INIT(insert);
+        ::plog::CommProfiler::scope comm_profile("insert");
 
         if (::dsc::empty(input, this->comm)) {
           BL_BENCH_REPORT_MPI_NAMED(insert, "hashmap:insert", this->comm);
@@ -1204,10 +1222,7 @@ namespace dsc  // distributed std container
 //          auto recv_counts(::dsc::distribute(input, this->key_to_rank, sorted_input, this->comm));
 //          BLISS_UNUSED(recv_counts);
           std::vector<size_t> recv_counts;
-			  std::vector<size_t> i2o;
-			  std::vector<::std::pair<Key, T> > buffer;
-			  ::imxx::distribute(input, this->key_to_rank, recv_counts, i2o, buffer, this->comm);
-			  input.swap(buffer);
+			  ::imxx::distribute(input, this->key_to_rank, recv_counts, this->arena, this->comm);
           BL_BENCH_END(insert, "dist_data", input.size());
         }
 
@@ -1258,14 +1273,16 @@ namespace dsc  // distributed std container
    * @tparam Hash   hash function for local and distribution.  requires a template arugment (Key), and a bool (prefix, chooses the MSBs of hash instead of LSBs)
    * @tparam Equal   default to ::std::equal_to<Key>   equal function for the local storage.
    * @tparam Alloc  default to ::std::allocator< ::std::pair<const Key, T> >    allocator for local storage.
+   * @tparam Container  default to ::std::unordered_multimap.  local multimap storage.
    */
   template<typename Key, typename T,
   template <typename> class MapParams,
-  class Alloc = ::std::allocator< ::std::pair<const Key, T> >
+  class Alloc = ::std::allocator< ::std::pair<const Key, T> >,
+  template <typename, typename, typename, typename, typename...> class Container = ::std::unordered_multimap
   >
-  class unordered_multimap : public unordered_map_base<Key, T, ::std::unordered_multimap, MapParams, Alloc> {
+  class unordered_multimap : public unordered_map_base<Key, T, Container, MapParams, Alloc> {
     protected:
-      using Base = unordered_map_base<Key, T, ::std::unordered_multimap, MapParams, Alloc>;
+      using Base = unordered_map_base<Key, T, Container, MapParams, Alloc>;
 
 
     public:
@@ -1467,6 +1484,7 @@ namespace dsc  // distributed std container
       size_t insert(std::vector<::std::pair<Key, T> >& input, bool sorted_input = false, Predicate const & pred = Predicate()) {
         // even if count is 0, still need to participate in mpi calls.  if (input.size() == 0) return;
         BL_BENCH_INIT(insert);
+        ::plog::CommProfiler::scope comm_profile("insert");
 
         if (::dsc::empty(input, this->comm)) {
           BL_BENCH_REPORT_MPI_NAMED(insert, "hash_multimap:insert", this->comm);
@@ -1489,10 +1507,7 @@ namespace dsc  // distributed std container
           // first remove duplicates.  sort, then get unique, finally remove the rest.  may not be needed
 
           std::vector<size_t> recv_counts;
-          std::vector<size_t> i2o;
-          std::vector<::std::pair<Key, T> > buffer;
-          ::imxx::distribute(input, this->key_to_rank, recv_counts, i2o, buffer, this->comm);
-          input.swap(buffer);
+          ::imxx::distribute(input, this->key_to_rank, recv_counts, this->arena, this->comm);
 
           //auto recv_counts = ::dsc::distribute(input, this->key_to_rank, sorted_input, this->comm);
           //BLISS_UNUSED(recv_counts);
@@ -1534,6 +1549,88 @@ namespace dsc  // distributed std container
 
 
 
+  /**
+   * @brief  distributed multimap with compressed posting lists as local storage.
+   * @details  local storage is ::fsc::posting_list_multimap:  each unique key is stored once, and its values are
+   *           sorted and delta/varint encoded in a byte arena.  T must be integral, or have an integral "id" member.
+   *           intended for position indices, where values per key are many and close together.
+   *
+   *           inserts are staged and encoded on the first query, so build with few large inserts.
+   *           values within a key's range are returned in ascending order.
+   *
+   * @tparam Key
+   * @tparam T
+   * @tparam MapParams  see unordered_multimap
+   * @tparam Alloc  unused by the local storage.  kept for interface compatibility.
+   */
+  template<typename Key, typename T,
+  template <typename> class MapParams,
+  class Alloc = ::std::allocator< ::std::pair<const Key, T> >
+  >
+  class posting_list_multimap : public unordered_multimap<Key, T, MapParams, Alloc, ::fsc::posting_list_multimap> {
+    protected:
+      using Base = unordered_multimap<Key, T, MapParams, Alloc, ::fsc::posting_list_multimap>;
+
+      /// erase via the posting list's in-place erase.  posting list iterators are read only.
+      struct LocalErase {
+          template<class DB, typename Query, class OutputIter>
+          size_t operator()(DB &db, Query const &v, OutputIter &) {
+              return db.erase(v);
+          }
+          template<class DB, typename Query, class OutputIter, class Predicate = ::bliss::filter::TruePredicate>
+          size_t operator()(DB &db, Query const &v, OutputIter &,
+                            Predicate const & pred) {
+              auto range = (const_cast<DB const &>(db)).equal_range(v);
+              if (!pred(range.first, range.second)) return 0;
+
+              return db.erase(v, [&pred](typename DB::value_type const & x) { return pred(x); });
+          }
+      } posting_erase_element;
+
+      /// reserve staging space.  buckets are sized at compaction.
+      virtual void local_reserve( size_t n) {
+        this->c.reserve(n);
+      }
+
+    public:
+      using local_container_type = typename Base::local_container_type;
+
+      posting_list_multimap(const mxx::comm& _comm) : Base(_comm) {}
+
+      virtual ~posting_list_multimap() {}
+
+      using Base::count;
+      using Base::find;
+      using Base::unique_size;
+      using Base::keys;
+
+      template <class Predicate = ::bliss::filter::TruePredicate>
+      size_t erase(::std::vector<Key>& keys, bool sorted_input = false, Predicate const& pred = Predicate() ) {
+          return Base::erase(posting_erase_element, keys, sorted_input, pred);
+      }
+      template <typename Predicate = ::bliss::filter::TruePredicate>
+      size_t erase(Predicate const & pred = Predicate()) {
+        return Base::erase(posting_erase_element, pred);
+      }
+
+      /// encode staged entries now, e.g. before timing queries or querying from multiple threads.  local only.
+      void compact() const {
+        this->c.compact();
+      }
+
+      /// extract the unique keys of a map.
+      virtual void keys(std::vector<Key> & result) const {
+        this->c.keys(result);
+      }
+
+      /// get the size of unique keys in the current local container.
+      virtual size_t local_unique_size() const {
+        return this->c.unique_size();
+      }
+  };
+
+
+
   /**
    * @brief  distributed unordered reduction map following std unordered map's interface.  Insertion applies the binary reduction operator between the existing and inserted element (in that order).
    * @details   This class is modeled after the std::unordered_map, but allows a binary reduction operator to be used during insertion.
@@ -1698,6 +1795,7 @@ namespace dsc  // distributed std container
       size_t insert(std::vector<::std::pair<Key, T> >& input, bool sorted_input = false, Predicate const & pred = Predicate()) {
         // even if count is 0, still need to participate in mpi calls.  if (input.size() == 0) return;
         BL_BENCH_INIT(insert);
+        ::plog::CommProfiler::scope comm_profile("insert");
 
         if (::dsc::empty(input, this->comm)) {
           BL_BENCH_REPORT_MPI_NAMED(insert, "reduction_hashmap:insert", this->comm);
@@ -1715,10 +1813,7 @@ namespace dsc  // distributed std container
           BL_BENCH_START(insert);
           // first remove duplicates.  sort, then get unique, finally remove the rest.  may not be needed
           std::vector<size_t> recv_counts;
-          std::vector<size_t> i2o;
-          std::vector<::std::pair<Key, T> > buffer;
-          ::imxx::distribute(input, this->key_to_rank, recv_counts, i2o, buffer, this->comm);
-          input.swap(buffer);
+          ::imxx::distribute(input, this->key_to_rank, recv_counts, this->arena, this->comm);
 
 //          auto recv_counts = ::dsc::distribute(input, this->key_to_rank, sorted_input, this->comm);
 //          BLISS_UNUSED(recv_counts);
@@ -1818,6 +1913,15 @@ namespace dsc  // distributed std container
       using Base::erase;
       using Base::unique_size;
 
+      /**
+       * @brief  count histogram (kmer spectrum).  h[i] is the number of distinct keys with count i, counts >= bins - 1 in the last bin.
+       * @details  scans the local table in place and sums the fixed size histograms.  collective.
+       *           see ::dsc::spectrum::first_valley for the error/solid threshold.
+       */
+      ::std::vector<size_t> histogram(size_t const & bins = 256) const {
+        return ::dsc::spectrum::histogram(this->c.begin(), this->c.end(), bins, this->comm);
+      }
+
       /**
        * @brief insert new elements in the distributed unordered_multimap.
        * @param first
@@ -1827,6 +1931,7 @@ namespace dsc  // distributed std container
       size_t insert(std::vector< Key >& input, bool sorted_input = false, Predicate const &pred = Predicate()) {
         // even if count is 0, still need to participate in mpi calls.  if (input.size() == 0) return;
         BL_BENCH_INIT(insert);
+        ::plog::CommProfiler::scope comm_profile("insert");
 
         if (::dsc::empty(input, this->comm)) {
           BL_BENCH_REPORT_MPI_NAMED(insert, "count_hashmap:insert", this->comm);
@@ -1845,10 +1950,7 @@ namespace dsc  // distributed std container
           BL_BENCH_START(insert);
           // first remove duplicates.  sort, then get unique, finally remove the rest.  may not be needed
           std::vector<size_t> recv_counts;
-          std::vector<size_t> i2o;
-          std::vector< Key > buffer;
-          ::imxx::distribute(input, this->key_to_rank, recv_counts, i2o, buffer, this->comm);
-          input.swap(buffer);
+          ::imxx::distribute(input, this->key_to_rank, recv_counts, this->arena, this->comm);
 
           BL_BENCH_END(insert, "dist_data", input.size());
         }
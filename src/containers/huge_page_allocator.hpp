@@ -0,0 +1,240 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    huge_page_allocator.hpp
+ * @ingroup fsc::data_structures
+ * @author  agent <agent@local>
+ * @brief   allocator that backs large arrays with 2MB pages and places them by NUMA policy.
+ * @details random probes into a multi-GB hash table miss the dTLB on almost every access with 4KB pages, and a table
+ *          filled by one thread lands entirely on that thread's socket.  huge_page_allocator maps each allocation of at
+ *          least 2MB separately, 2MB aligned, and
+ *            THP:      madvise(MADV_HUGEPAGE), for transparent huge pages.  the default.
+ *            HUGETLB:  MAP_HUGETLB from the reserved pool (vm.nr_hugepages), falling back to THP if the pool is short.
+ *            SMALL:    madvise(MADV_NOHUGEPAGE), the 4KB baseline.
+ *          then applies the NUMA policy with mbind before the pages are touched:
+ *            FIRST_TOUCH:  kernel default.
+ *            INTERLEAVE:   round robin over all online nodes.
+ *            BIND:         on one node.
+ *          smaller allocations go to std::allocator.  mbind failures (no NUMA support, or forbidden in a container)
+ *          are counted and otherwise ignored.
+ *
+ *          the allocator is stateless, so it can be the Alloc parameter of the fsc/dsc containers, e.g.
+ *            fsc::densehash_map<Kmer, size_t, SpecialKeys, Transform, Hash, Equal, fsc::huge_page_allocator<std::pair<const Kmer, size_t> > >
+ *          the page and NUMA modes are process wide:  huge_page_options::instance(), or the environment variables
+ *            BL_HUGEPAGE=thp|hugetlb|small     BL_NUMA=first_touch|interleave|bind:<node>
+ *
+ *          linux only.
+ */
+#ifndef BLISS_HUGE_PAGE_ALLOCATOR_HPP
+#define BLISS_HUGE_PAGE_ALLOCATOR_HPP
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <memory>     // std::allocator
+#include <new>        // bad_alloc
+#include <atomic>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <cstdlib>    // getenv
+#include <cstdint>
+
+#ifndef MAP_HUGETLB
+#define MAP_HUGETLB 0x40000
+#endif
+#ifndef MADV_HUGEPAGE
+#define MADV_HUGEPAGE 14
+#endif
+#ifndef MADV_NOHUGEPAGE
+#define MADV_NOHUGEPAGE 15
+#endif
+
+namespace fsc  // fast standard container
+{
+
+  /// process wide page and NUMA modes of huge_page_allocator, and counts of what the allocations got.
+  class huge_page_options {
+    public:
+      enum page_mode { THP, HUGETLB, SMALL };
+      enum numa_mode { FIRST_TOUCH, INTERLEAVE, BIND };
+
+      static constexpr size_t page_size = 2UL << 20;
+
+      page_mode pages;
+      numa_mode numa;
+      int node;                           // for BIND
+
+      std::atomic<size_t> hugetlb_maps;   // mappings from the MAP_HUGETLB pool
+      std::atomic<size_t> thp_maps;       // mappings advised for THP, including HUGETLB fallbacks
+      std::atomic<size_t> small_maps;
+      std::atomic<size_t> mbind_failures;
+
+      static huge_page_options & instance() {
+        static huge_page_options opts;
+        return opts;
+      }
+
+      /// "thp", "hugetlb" or "small"
+      void set_pages(std::string const & s) {
+        if (s == "thp") pages = THP;
+        else if (s == "hugetlb") pages = HUGETLB;
+        else if (s == "small") pages = SMALL;
+        else throw std::invalid_argument("huge pages:  expected thp, hugetlb or small, got " + s);
+      }
+      /// "first_touch", "interleave" or "bind:<node>"
+      void set_numa(std::string const & s) {
+        if (s == "first_touch") numa = FIRST_TOUCH;
+        else if (s == "interleave") numa = INTERLEAVE;
+        else if (s.compare(0, 5, "bind:") == 0) { numa = BIND; node = std::stoi(s.substr(5)); }
+        else throw std::invalid_argument("numa:  expected first_touch, interleave or bind:<node>, got " + s);
+      }
+
+      void reset_counts() {
+        hugetlb_maps = 0;  thp_maps = 0;  small_maps = 0;  mbind_failures = 0;
+      }
+
+      /// online NUMA nodes as a bit mask, from /sys.  node 0 only if unknown.
+      static std::vector<unsigned long> online_nodes() {
+        std::vector<unsigned long> mask(1, 1UL);
+        std::ifstream f("/sys/devices/system/node/online");
+        std::string ranges;
+        if (!(f >> ranges)) return mask;
+
+        mask[0] = 0;
+        std::stringstream ss(ranges);
+        std::string r;
+        while (std::getline(ss, r, ',')) {
+          size_t dash = r.find('-');
+          int lo = std::stoi(r.substr(0, dash));
+          int hi = (dash == std::string::npos) ? lo : std::stoi(r.substr(dash + 1));
+          for (int n = lo; n <= hi; ++n) {
+            size_t w = n / (8 * sizeof(unsigned long));
+            if (mask.size() <= w) mask.resize(w + 1, 0);
+            mask[w] |= 1UL << (n % (8 * sizeof(unsigned long)));
+          }
+        }
+        return mask;
+      }
+
+      /// apply the NUMA policy to a fresh mapping.  false if mbind failed.
+      bool place(void * p, size_t const & bytes) {
+        if (numa == FIRST_TOUCH) return true;
+
+        // linux mempolicy modes, without requiring numaif.h / libnuma.
+        const int MPOL_BIND_ = 2, MPOL_INTERLEAVE_ = 3;
+        std::vector<unsigned long> mask;
+        if (numa == INTERLEAVE) {
+          mask = online_nodes();
+        } else {
+          mask.resize(node / (8 * sizeof(unsigned long)) + 1, 0);
+          mask.back() |= 1UL << (node % (8 * sizeof(unsigned long)));
+        }
+        long ret = syscall(SYS_mbind, p, bytes, (numa == INTERLEAVE) ? MPOL_INTERLEAVE_ : MPOL_BIND_,
+                           mask.data(), mask.size() * 8 * sizeof(unsigned long) + 1, 0);
+        if (ret != 0) ++mbind_failures;
+        return ret == 0;
+      }
+
+      /// map bytes (a multiple of page_size), page_size aligned, with the current modes.
+      void * map(size_t const & bytes) {
+        void * p = MAP_FAILED;
+        if (pages == HUGETLB) {
+          p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+          if (p != MAP_FAILED) ++hugetlb_maps;
+        }
+
+        if (p == MAP_FAILED) {
+          // over map by one page, then trim to a page_size aligned range.
+          char * raw = static_cast<char *>(mmap(nullptr, bytes + page_size, PROT_READ | PROT_WRITE,
+                                                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+          if (raw == MAP_FAILED) throw std::bad_alloc();
+          char * aligned = reinterpret_cast<char *>((reinterpret_cast<uintptr_t>(raw) + page_size - 1) & ~(page_size - 1));
+          if (aligned > raw) munmap(raw, aligned - raw);
+          munmap(aligned + bytes, (raw + bytes + page_size) - (aligned + bytes));
+          p = aligned;
+
+          if (pages == SMALL) {
+            madvise(p, bytes, MADV_NOHUGEPAGE);
+            ++small_maps;
+          } else {
+            madvise(p, bytes, MADV_HUGEPAGE);
+            ++thp_maps;
+          }
+        }
+
+        place(p, bytes);
+        return p;
+      }
+
+    protected:
+      huge_page_options() : pages(THP), numa(FIRST_TOUCH), node(0) {
+        reset_counts();
+        const char * s = std::getenv("BL_HUGEPAGE");
+        if (s != nullptr) set_pages(s);
+        s = std::getenv("BL_NUMA");
+        if (s != nullptr) set_numa(s);
+      }
+  };
+
+
+  /// std::allocator that maps allocations of 2MB or more as huge pages, with the NUMA policy in huge_page_options.
+  template <typename T>
+  class huge_page_allocator : public std::allocator<T> {
+      using base = std::allocator<T>;
+      static constexpr size_t page_size = huge_page_options::page_size;
+
+      static size_t mapped_bytes(size_t const & n) {
+        return (n * sizeof(T) + page_size - 1) & ~(page_size - 1);
+      }
+
+    public:
+      using value_type = T;
+      using pointer = T *;
+      using size_type = size_t;
+
+      template <typename U>
+      struct rebind {
+          using other = huge_page_allocator<U>;
+      };
+
+      huge_page_allocator() noexcept {}
+      huge_page_allocator(huge_page_allocator const &) noexcept : base() {}
+      template <typename U>
+      huge_page_allocator(huge_page_allocator<U> const &) noexcept {}
+
+      pointer allocate(size_type n, const void * = nullptr) {
+        if (n * sizeof(T) < page_size) return base::allocate(n);
+        return static_cast<pointer>(huge_page_options::instance().map(mapped_bytes(n)));
+      }
+      void deallocate(pointer p, size_type n) {
+        if (n * sizeof(T) < page_size) base::deallocate(p, n);
+        else munmap(p, mapped_bytes(n));
+      }
+  };
+
+  template <typename T, typename U>
+  bool operator==(huge_page_allocator<T> const &, huge_page_allocator<U> const &) { return true; }
+  template <typename T, typename U>
+  bool operator!=(huge_page_allocator<T> const &, huge_page_allocator<U> const &) { return false; }
+
+} // namespace fsc
+
+#endif // BLISS_HUGE_PAGE_ALLOCATOR_HPP
@@ -0,0 +1,617 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    posting_list_map.hpp
+ * @ingroup fsc::data_structures
+ * @author  agent <agent@local>
+ * @brief   multimap with compressed, per key posting lists.
+ * @details a position index stores one (kmer, id) pair per kmer occurrence.  the kmer is repeated for each occurrence,
+ *          and the id is 64 bit even though ids of the same kmer are close to each other in sorted order.
+ *
+ *          posting_list_multimap stores each unique key once.  its values are sorted, delta encoded,
+ *          and written as LEB128 varints into a single byte arena.  a key's list is
+ *             varint(count), varint(v_0), varint(v_1 - v_0), ..., varint(v_n-1 - v_n-2)
+ *
+ *          the keys are kept in a flat array ordered by hash bucket, with a bucket start array, so a lookup
+ *          hashes the key once and compares against the (typically 1) key in the bucket.
+ *
+ *          memory: U keys and N values take  U * (sizeof(Key) + 8) + B * 8 + N * (1 to 3) bytes, with B ~ U buckets.
+ *          compare to N * sizeof(pair<Key, T>) / load_factor for the hashed multimaps.
+ *
+ *          build:  inserted entries are staged in a vector.  they are merged by the first query after an insert, which
+ *          decodes and re-encodes any existing content, so insert in bulk.  merging is not thread safe; queries from
+ *          multiple threads should be preceded by an explicit compact().
+ *
+ *          query:  iterators decode lazily, one value per increment.  values of a key are returned in ascending order.
+ *          values are immutable.  erase(key) and erase(key, pred) rewrite the list in place - a filtered list never
+ *          encodes longer than the original.  a list emptied by erase stays as a tombstone (count 0) that lookups skip;
+ *          tombstones and freed bytes are reclaimed by an explicit compact() or by the next merge of staged inserts.
+ *
+ *          alternative considered: Elias-Fano.  for the short lists typical of kmer positions (coverage-sized),
+ *          delta varint is within a few bits per value of Elias-Fano and is simpler to stream and to rewrite in place.
+ */
+#ifndef POSTING_LIST_MAP_HPP_
+#define POSTING_LIST_MAP_HPP_
+
+#include <vector>
+#include <utility>      // pair
+#include <iterator>
+#include <algorithm>
+#include <functional>   // hash, equal_to
+#include <type_traits>
+#include <cstdint>
+#include <limits>
+
+#include "utils/logging.h"
+
+namespace fsc {  // fast standard container
+
+  /**
+   * @brief  converts a posting list value to and from uint64_t.
+   * @details  integral types convert directly.  types with an integral "id" member,
+   *           e.g. ShortSequenceKmerId and LongSequenceKmerId, convert via that member.
+   *           specialize for other value types.
+   */
+  template <typename T, typename Enable = void>
+  struct posting_value_traits;
+
+  template <typename T>
+  struct posting_value_traits<T, typename ::std::enable_if<::std::is_integral<T>::value>::type> {
+      static inline uint64_t to_uint(T const & v) { return static_cast<uint64_t>(v); }
+      static inline T from_uint(uint64_t const & v) { return static_cast<T>(v); }
+  };
+
+  template <typename T>
+  struct posting_value_traits<T, typename ::std::enable_if<::std::is_integral<decltype(::std::declval<T>().id)>::value>::type> {
+      static inline uint64_t to_uint(T const & v) { return static_cast<uint64_t>(v.id); }
+      static inline T from_uint(uint64_t const & v) {
+        T out;
+        out.id = v;
+        return out;
+      }
+  };
+
+
+  /**
+   * @brief  multimap with each key's values stored as a compressed posting list.
+   * @details  implements the subset of the std::unordered_multimap interface used by the distributed maps.
+   *           see file description for the layout.
+   *
+   *           keys that compare equal with Equal are grouped, and the first key inserted is the one stored.
+   */
+  template <typename Key,
+  typename T,
+  typename Hash = ::std::hash<Key>,
+  typename Equal = ::std::equal_to<Key>,
+  typename Allocator = ::std::allocator<::std::pair<const Key, T> >
+  >
+  class posting_list_multimap {
+
+    protected:
+      using value_traits = posting_value_traits<T>;
+
+      /// write v as LEB128 varint
+      static inline void write_varint(uint64_t v, ::std::vector<uint8_t> & out) {
+        while (v >= 0x80) {
+          out.push_back(static_cast<uint8_t>(v) | 0x80);
+          v >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(v));
+      }
+      /// write v as LEB128 varint to ptr.  returns pointer past the written bytes.
+      static inline uint8_t* write_varint(uint64_t v, uint8_t * ptr) {
+        while (v >= 0x80) {
+          *ptr = static_cast<uint8_t>(v) | 0x80;
+          ++ptr;
+          v >>= 7;
+        }
+        *ptr = static_cast<uint8_t>(v);
+        return ++ptr;
+      }
+      /// read LEB128 varint from ptr and advance ptr.
+      static inline uint64_t read_varint(const uint8_t* & ptr) {
+        uint64_t v = 0;
+        unsigned int shift = 0;
+        uint8_t b;
+        do {
+          b = *ptr;
+          ++ptr;
+          v |= static_cast<uint64_t>(b & 0x7F) << shift;
+          shift += 7;
+        } while (b & 0x80);
+        return v;
+      }
+
+      /// entries inserted since the last compact().
+      mutable ::std::vector<::std::pair<Key, T> > staged;
+
+      /// unique keys, ordered by bucket.
+      mutable ::std::vector<Key> keys_;
+      /// byte offset of each key's posting list in arena.
+      mutable ::std::vector<size_t> offsets;
+      /// index of the first key of each bucket in keys_.  size is bucket count + 1
+      mutable ::std::vector<size_t> bucket_starts;
+      /// encoded posting lists.
+      mutable ::std::vector<uint8_t> arena;
+
+      /// number of values, including staged
+      size_t s;
+      /// number of keys with non-empty lists.  keys_.size() - nkeys lists are tombstones left by erase.
+      mutable size_t nkeys;
+      /// minimum number of buckets for the next compact().
+      size_t min_buckets;
+
+      Hash hash_fn;
+      Equal eq;
+
+      /// find the key's index in keys_.  returns keys_.size() if not found.
+      size_t find_key(Key const & key) const {
+        merge_staged();
+        if (keys_.empty()) return 0;
+
+        size_t b = hash_fn(key) & (bucket_starts.size() - 2);
+        for (size_t i = bucket_starts[b], max = bucket_starts[b + 1]; i < max; ++i) {
+          if (eq(keys_[i], key)) return i;
+        }
+        return keys_.size();
+      }
+
+      /// merge the staged entries, if any.  lists emptied by erase alone do not trigger a rewrite.
+      void merge_staged() const {
+        if (!staged.empty()) compact();
+      }
+
+      /// decode posting list i into values.
+      void decode_list(size_t const & i, ::std::vector<uint64_t> & values) const {
+        const uint8_t* ptr = arena.data() + offsets[i];
+        size_t n = read_varint(ptr);
+        values.clear();
+        values.reserve(n);
+        uint64_t v = 0;
+        for (size_t j = 0; j < n; ++j) {
+          v += read_varint(ptr);
+          values.emplace_back(v);
+        }
+      }
+
+      /// encode sorted values as posting list at ptr.  returns pointer past the written bytes.
+      static uint8_t* encode_list(::std::vector<uint64_t> const & values, uint8_t* ptr) {
+        ptr = write_varint(values.size(), ptr);
+        uint64_t prev = 0;
+        for (auto v : values) {
+          ptr = write_varint(v - prev, ptr);
+          prev = v;
+        }
+        return ptr;
+      }
+
+
+      /**
+       * @brief  forward iterator over the entries of a range of posting lists.  decodes one value per increment.
+       * @details  position is (key index, values remaining in list).  lists emptied by erase are skipped.
+       */
+      template <typename V>
+      class posting_iter : public ::std::iterator<::std::forward_iterator_tag, V> {
+
+        protected:
+          using type = posting_iter<V>;
+
+          posting_list_multimap const * map;
+          size_t kidx;
+          const uint8_t* ptr;
+          size_t left;
+          uint64_t curr;
+
+          /// position at the first value of list kidx or later.
+          void load() {
+            size_t nk = map->keys_.size();
+            while (kidx < nk) {
+              ptr = map->arena.data() + map->offsets[kidx];
+              left = read_varint(ptr);
+              if (left > 0) {
+                curr = read_varint(ptr);
+                return;
+              }
+              ++kidx;
+            }
+            left = 0;
+          }
+
+        public:
+          using value_type = typename ::std::remove_const<V>::type;
+
+          posting_iter() : map(nullptr), kidx(0), ptr(nullptr), left(0), curr(0) {}
+
+          /// iterator at start of list _kidx.  _kidx == number of keys gives the end iterator.
+          posting_iter(posting_list_multimap const * _map, size_t const & _kidx) :
+            map(_map), kidx(_kidx), ptr(nullptr), left(0), curr(0) {
+            load();
+          }
+
+          type& operator++() {
+            if (left == 0) return *this;
+
+            --left;
+            if (left > 0) {
+              curr += read_varint(ptr);
+            } else {
+              ++kidx;
+              load();
+            }
+            return *this;
+          }
+
+          type operator++(int) {
+            type output(*this);
+            this->operator++();
+            return output;
+          }
+
+          bool operator==(type const & other) const {
+            return (kidx == other.kidx) && (left == other.left);
+          }
+          bool operator!=(type const & other) const {
+            return !(this->operator==(other));
+          }
+
+          /// decoded entry.  returned by value since it is not stored.
+          value_type operator*() const {
+            return value_type(map->keys_[kidx], value_traits::from_uint(curr));
+          }
+      };
+
+
+    public:
+      using key_type              = Key;
+      using mapped_type           = T;
+      using value_type            = ::std::pair<const Key, T>;
+      using hasher                = Hash;
+      using key_equal             = Equal;
+      using allocator_type        = Allocator;
+      using reference             = value_type&;
+      using const_reference       = const value_type&;
+      using pointer               = typename ::std::allocator_traits<Allocator>::pointer;
+      using const_pointer         = typename ::std::allocator_traits<Allocator>::const_pointer;
+      using iterator              = posting_iter<const value_type>;
+      using const_iterator        = posting_iter<const value_type>;
+      using size_type             = size_t;
+      using difference_type       = ptrdiff_t;
+
+
+      posting_list_multimap(size_type bucket_count = 128,
+                            const Hash& hash = Hash(),
+                            const Equal& equal = Equal(),
+                            const Allocator& alloc = Allocator()) :
+                              s(0), nkeys(0), min_buckets(bucket_count), hash_fn(hash), eq(equal) {}
+
+      template<class InputIt>
+      posting_list_multimap(InputIt first, InputIt last,
+                            size_type bucket_count = 128,
+                            const Hash& hash = Hash(),
+                            const Equal& equal = Equal(),
+                            const Allocator& alloc = Allocator()) :
+                              posting_list_multimap(bucket_count, hash, equal, alloc) {
+        this->insert(first, last);
+      }
+
+      virtual ~posting_list_multimap() {};
+
+      void swap(posting_list_multimap & other) {
+        staged.swap(other.staged);
+        keys_.swap(other.keys_);
+        offsets.swap(other.offsets);
+        bucket_starts.swap(other.bucket_starts);
+        arena.swap(other.arena);
+        ::std::swap(s, other.s);
+        ::std::swap(nkeys, other.nkeys);
+        ::std::swap(min_buckets, other.min_buckets);
+        ::std::swap(hash_fn, other.hash_fn);
+        ::std::swap(eq, other.eq);
+      }
+
+
+      /**
+       * @brief  encode the staged entries, merging with the existing posting lists.
+       * @details  entries are grouped by full hash value, then by Equal within a hash value.
+       *           the groups are then ordered by bucket, and each group's values are sorted and encoded.
+       *           also drops the tombstones of erased lists.
+       */
+      void compact() const {
+        if (staged.empty() && (nkeys == keys_.size())) return;
+
+        // decode existing content into staged.
+        if (!keys_.empty()) {
+          staged.reserve(s);
+          ::std::vector<uint64_t> values;
+          for (size_t i = 0; i < keys_.size(); ++i) {
+            this->decode_list(i, values);
+            for (auto v : values) {
+              staged.emplace_back(keys_[i], value_traits::from_uint(v));
+            }
+          }
+          ::std::vector<Key>().swap(keys_);
+          ::std::vector<size_t>().swap(offsets);
+          ::std::vector<size_t>().swap(bucket_starts);
+          ::std::vector<uint8_t>().swap(arena);
+        }
+        nkeys = 0;
+        if (staged.empty()) return;
+
+        // order entries by hash value
+        size_t n = staged.size();
+        ::std::vector<::std::pair<size_t, size_t> > hashed;   // (hash, entry)
+        hashed.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+          hashed.emplace_back(hash_fn(staged[i].first), i);
+        }
+        ::std::sort(hashed.begin(), hashed.end());
+
+        // group by Equal within each hash value.  groups are (hash, first entry in order, count)
+        struct group {
+            size_t hash;
+            size_t first;
+            size_t count;
+        };
+        ::std::vector<group> groups;
+        ::std::vector<size_t> order(n);
+        size_t pos = 0;
+        for (size_t i = 0; i < n;) {
+          size_t j = i + 1;
+          while ((j < n) && (hashed[j].first == hashed[i].first)) ++j;
+
+          // hash collision of different keys is rare, so this is quadratic only in theory.
+          for (size_t k = i; k < j; ++k) {
+            if (hashed[k].second == ::std::numeric_limits<size_t>::max()) continue;
+            Key const & key = staged[hashed[k].second].first;
+
+            groups.push_back(group{hashed[k].first, pos, 0});
+            for (size_t l = k; l < j; ++l) {
+              if ((hashed[l].second != ::std::numeric_limits<size_t>::max()) && eq(staged[hashed[l].second].first, key)) {
+                order[pos] = hashed[l].second;
+                ++pos;
+                hashed[l].second = ::std::numeric_limits<size_t>::max();
+              }
+            }
+            groups.back().count = pos - groups.back().first;
+          }
+          i = j;
+        }
+        ::std::vector<::std::pair<size_t, size_t> >().swap(hashed);
+
+        // bucket count is a power of 2, at least the number of keys.
+        size_t nbuckets = 1;
+        while ((nbuckets < groups.size()) || (nbuckets < min_buckets)) nbuckets <<= 1;
+        size_t mask = nbuckets - 1;
+        ::std::stable_sort(groups.begin(), groups.end(), [&mask](group const & x, group const & y) {
+          return (x.hash & mask) < (y.hash & mask);
+        });
+
+        // encode
+        keys_.reserve(groups.size());
+        offsets.reserve(groups.size());
+        bucket_starts.assign(nbuckets + 1, 0);
+        ::std::vector<uint64_t> values;
+        for (auto const & g : groups) {
+          ++bucket_starts[(g.hash & mask) + 1];
+          keys_.emplace_back(staged[order[g.first]].first);
+          offsets.emplace_back(arena.size());
+
+          values.clear();
+          for (size_t k = g.first; k < g.first + g.count; ++k) {
+            values.emplace_back(value_traits::to_uint(staged[order[k]].second));
+          }
+          ::std::sort(values.begin(), values.end());
+
+          write_varint(values.size(), arena);
+          uint64_t prev = 0;
+          for (auto v : values) {
+            write_varint(v - prev, arena);
+            prev = v;
+          }
+        }
+        for (size_t b = 1; b <= nbuckets; ++b) {
+          bucket_starts[b] += bucket_starts[b - 1];
+        }
+        nkeys = keys_.size();
+
+        ::std::vector<::std::pair<Key, T> >().swap(staged);
+        arena.shrink_to_fit();
+      }
+
+
+      iterator begin() const {
+        merge_staged();
+        return iterator(this, 0);
+      }
+      const_iterator cbegin() const {
+        return begin();
+      }
+      iterator end() const {
+        merge_staged();
+        return iterator(this, keys_.size());
+      }
+      const_iterator cend() const {
+        return end();
+      }
+
+
+      bool empty() const {
+        return s == 0;
+      }
+
+      size_type size() const {
+        return s;
+      }
+
+      /// number of keys with at least 1 value.
+      size_type unique_size() const {
+        merge_staged();
+        return nkeys;
+      }
+
+      void clear() {
+        ::std::vector<::std::pair<Key, T> >().swap(staged);
+        ::std::vector<Key>().swap(keys_);
+        ::std::vector<size_t>().swap(offsets);
+        ::std::vector<size_t>().swap(bucket_starts);
+        ::std::vector<uint8_t>().swap(arena);
+        s = 0;
+        nkeys = 0;
+      }
+
+      /// sets the minimum bucket count for the next compact().
+      void rehash(size_type count) {
+        min_buckets = ::std::max(min_buckets, count);
+      }
+
+      /// reserve staging space for count entries in total.
+      void reserve(size_type count) {
+        if (count > s) staged.reserve(staged.size() + count - s);
+      }
+
+      size_type bucket_count() const {
+        return (bucket_starts.size() > 1) ? (bucket_starts.size() - 1) : min_buckets;
+      }
+
+      /// buckets are for unique keys.
+      float max_load_factor() const {
+        return 1.0f;
+      }
+
+
+      template <typename... Args>
+      void emplace(Args&&... args) {
+        staged.emplace_back(::std::forward<Args>(args)...);
+        ++s;
+      }
+
+      void insert(value_type const & value) {
+        staged.emplace_back(value.first, value.second);
+        ++s;
+      }
+
+      template <class InputIt>
+      void insert(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+          staged.emplace_back(first->first, first->second);
+          ++s;
+        }
+      }
+
+
+      size_type count(Key const & key) const {
+        size_t i = find_key(key);
+        if (i >= keys_.size()) return 0;
+
+        const uint8_t* ptr = arena.data() + offsets[i];
+        return read_varint(ptr);
+      }
+
+      ::std::pair<const_iterator, const_iterator> equal_range(Key const & key) const {
+        size_t i = find_key(key);
+        if (i >= keys_.size()) return ::std::make_pair(this->cend(), this->cend());
+
+        return ::std::make_pair(const_iterator(this, i), const_iterator(this, i + 1));
+      }
+
+      /// decode the values of key, in ascending order, to output.  returns number of values.
+      template <typename OutputIterator>
+      size_t find_values(Key const & key, OutputIterator output) const {
+        size_t i = find_key(key);
+        if (i >= keys_.size()) return 0;
+
+        const uint8_t* ptr = arena.data() + offsets[i];
+        size_t n = read_varint(ptr);
+        uint64_t v = 0;
+        for (size_t j = 0; j < n; ++j, ++output) {
+          v += read_varint(ptr);
+          *output = value_traits::from_uint(v);
+        }
+        return n;
+      }
+
+      /// remove all values of key.  returns number removed.
+      size_t erase(Key const & key) {
+        size_t i = find_key(key);
+        if (i >= keys_.size()) return 0;
+
+        const uint8_t* ptr = arena.data() + offsets[i];
+        size_t n = read_varint(ptr);
+        if (n == 0) return 0;
+
+        write_varint(0, arena.data() + offsets[i]);
+        s -= n;
+        --nkeys;
+        return n;
+      }
+
+      /// remove the values of key for which pred(value_type) is true.  returns number removed.
+      template <typename Pred>
+      size_t erase(Key const & key, Pred const & pred) {
+        size_t i = find_key(key);
+        if (i >= keys_.size()) return 0;
+
+        ::std::vector<uint64_t> values;
+        this->decode_list(i, values);
+        size_t before = values.size();
+        if (before == 0) return 0;
+
+        Key const & k = keys_[i];
+        values.erase(::std::remove_if(values.begin(), values.end(), [&pred, &k](uint64_t const & v) {
+          return pred(value_type(k, value_traits::from_uint(v)));
+        }), values.end());
+
+        size_t removed = before - values.size();
+        if (removed == 0) return 0;
+
+        // a subsequence never encodes longer: count shrinks, and varint(a + b) <= varint(a) + varint(b)
+        encode_list(values, arena.data() + offsets[i]);
+        s -= removed;
+        if (values.empty()) --nkeys;
+        return removed;
+      }
+
+      /// unique keys
+      void keys(::std::vector<Key> & result) const {
+        merge_staged();
+        result.clear();
+        result.reserve(nkeys);
+        for (size_t i = 0; i < keys_.size(); ++i) {
+          const uint8_t* ptr = arena.data() + offsets[i];
+          if (read_varint(ptr) > 0) result.emplace_back(keys_[i]);
+        }
+      }
+
+      /// bytes used by the compacted storage, excluding staged entries.
+      size_t memory_usage() const {
+        return keys_.capacity() * sizeof(Key) + offsets.capacity() * sizeof(size_t) +
+            bucket_starts.capacity() * sizeof(size_t) + arena.capacity();
+      }
+
+      void report() const {
+        merge_staged();
+        BL_INFOF("posting list map bucket count: %lu", bucket_count());
+        BL_INFOF("posting list map unique entries: %lu", nkeys);
+        BL_INFOF("posting list map total entries: %lu", s);
+        BL_INFOF("posting list map arena bytes: %lu", arena.size());
+        BL_INFOF("posting list map bytes per entry: %f", (s == 0) ? 0.0 : static_cast<double>(memory_usage()) / static_cast<double>(s));
+      }
+  };
+
+} // namespace fsc
+
+#endif /* POSTING_LIST_MAP_HPP_ */
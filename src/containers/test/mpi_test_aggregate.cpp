@@ -0,0 +1,198 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * mpi_test_aggregate.cpp
+ *
+ * aggregate queries should match reducing the find results at the requester.
+ */
+
+// include google test
+#include <gtest/gtest.h>
+#include "bliss-config.hpp"
+
+#if defined(USE_MPI)
+#include "mxx/env.hpp"
+#include "mxx/comm.hpp"
+
+#include <cstdint>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <utility>
+#include <unordered_map>
+
+#include "common/kmer.hpp"
+#include "common/alphabets.hpp"
+#include "index/kmer_hash.hpp"
+#include "containers/distributed_unordered_map.hpp"
+#include "containers/distributed_densehash_map.hpp"
+#include "containers/distributed_sorted_map.hpp"
+#include "containers/distributed_aggregators.hpp"
+
+
+using KmerType = ::bliss::common::Kmer<21, ::bliss::common::DNA, uint64_t>;
+
+template <typename Key>
+using DistHash = ::bliss::kmer::hash::farm<Key, true>;
+template <typename Key>
+using StoreHash = ::bliss::kmer::hash::farm<Key, false>;
+
+template <typename Key>
+using MapParams = ::dsc::HashMapParams<Key,
+    ::bliss::transform::identity, ::bliss::transform::identity, DistHash, ::std::equal_to,
+    ::bliss::transform::identity, StoreHash, ::std::equal_to>;
+
+template <typename Key>
+using SortParams = ::dsc::SortedMapParams<Key,
+    ::bliss::transform::identity, ::bliss::transform::identity, ::std::less, ::std::equal_to>;
+
+using SpecialKeys = ::bliss::kmer::hash::sparsehash::special_keys<KmerType, false>;
+
+
+template <typename MapType>
+class AggregateTest : public ::testing::Test {
+  protected:
+    ::mxx::comm comm;
+    MapType map;
+
+    std::vector<KmerType> keys;
+    std::vector<size_t> groups;
+    size_t group_count;
+
+    /// key -> values, for all keys that any local group queries.
+    std::unordered_multimap<uint64_t, size_t> found;
+
+    AggregateTest() : map(comm), group_count(0) {}
+
+    virtual void SetUp() {
+      std::default_random_engine generator(comm.rank() + 1);
+      std::uniform_int_distribution<uint64_t> distribution(0, 3000);
+      std::uniform_int_distribution<size_t> values(0, 20);
+
+      std::vector<std::pair<KmerType, size_t> > entries;
+      for (size_t i = 0; i < 20000; ++i) {
+        KmerType k;
+        k.getDataRef()[0] = distribution(generator);
+        entries.emplace_back(k, values(generator));
+      }
+      map.insert(entries);
+
+      // groups of 30 consecutive kmers, like the kmers of a read.  some repeat, some are absent.
+      group_count = 100 + comm.rank();
+      for (size_t g = 0; g < group_count; ++g) {
+        uint64_t first = (g * 37 + comm.rank() * 11) % 3500;
+        for (uint64_t j = 0; j < 30; ++j) {
+          KmerType k;
+          k.getDataRef()[0] = first + (j % 25);
+          keys.push_back(k);
+          groups.push_back(g);
+        }
+      }
+
+      // unique queries:  find may return the matches once per repeat of a query.
+      std::vector<KmerType> q = keys;
+      std::sort(q.begin(), q.end());
+      q.erase(std::unique(q.begin(), q.end()), q.end());
+      for (auto const & e : map.find(q)) {
+        found.emplace(e.first.getData()[0], e.second);
+      }
+    }
+
+    /// reduce found values per group at the requester.
+    template <typename Aggregator>
+    std::vector<typename Aggregator::result_type> gold(Aggregator const & agg) {
+      std::vector<typename Aggregator::result_type> results(group_count, agg.identity());
+      for (size_t i = 0; i < keys.size(); ++i) {
+        auto range = found.equal_range(keys[i].getData()[0]);
+        for (auto it = range.first; it != range.second; ++it) {
+          results[groups[i]] = agg(results[groups[i]], it->second);
+        }
+      }
+      return results;
+    }
+
+    template <typename Aggregator>
+    void check(Aggregator const & agg) {
+      std::vector<KmerType> q = keys;
+      auto test = map.aggregate(q, groups, group_count, agg);
+      auto expected = gold(agg);
+      ASSERT_EQ(expected.size(), test.size());
+      EXPECT_TRUE(std::equal(expected.begin(), expected.end(), test.begin()));
+    }
+};
+
+
+using AggregateTestTypes = ::testing::Types<
+    ::dsc::unordered_multimap<KmerType, size_t, MapParams>,
+    ::dsc::densehash_multimap<KmerType, size_t, MapParams, SpecialKeys>,
+    ::dsc::sorted_multimap<KmerType, size_t, SortParams> >;
+TYPED_TEST_CASE(AggregateTest, AggregateTestTypes);
+
+
+TYPED_TEST(AggregateTest, sum)
+{
+  this->check(::dsc::aggregate::sum<size_t>());
+}
+
+TYPED_TEST(AggregateTest, count)
+{
+  this->check(::dsc::aggregate::count<size_t>());
+}
+
+TYPED_TEST(AggregateTest, min)
+{
+  this->check(::dsc::aggregate::min<size_t>());
+}
+
+TYPED_TEST(AggregateTest, max)
+{
+  this->check(::dsc::aggregate::max<size_t>());
+}
+
+TYPED_TEST(AggregateTest, histogram)
+{
+  this->check(::dsc::aggregate::histogram<8, size_t>());
+}
+
+TYPED_TEST(AggregateTest, empty)
+{
+  std::vector<KmerType> q;
+  std::vector<size_t> g;
+  auto test = this->map.aggregate(q, g, 5, ::dsc::aggregate::sum<size_t>());
+  ASSERT_EQ(5UL, test.size());
+  for (auto x : test) EXPECT_EQ(0UL, x);
+}
+
+#endif
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+#if defined(USE_MPI)
+  ::mxx::env e(argc, argv);
+  ::mxx::comm comm;
+
+  result = RUN_ALL_TESTS();
+
+  comm.barrier();
+#endif
+
+  return result;
+}
@@ -0,0 +1,217 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * mpi_test_densehash_cache.cpp
+ *
+ * find through the remote lookup cache should return the same as find without it, and inserts should invalidate it.
+ */
+
+// include google test
+#include <gtest/gtest.h>
+#include "bliss-config.hpp"
+
+#if defined(USE_MPI)
+#include "mxx/env.hpp"
+#include "mxx/comm.hpp"
+#include "mxx/reduction.hpp"
+
+#include <cstdint>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <utility>
+
+#include "common/kmer.hpp"
+#include "common/alphabets.hpp"
+#include "index/kmer_hash.hpp"
+#include "containers/distributed_densehash_map.hpp"
+
+
+using KmerType = ::bliss::common::Kmer<21, ::bliss::common::DNA, uint64_t>;
+
+template <typename Key>
+using DistHash = ::bliss::kmer::hash::farm<Key, true>;
+template <typename Key>
+using StoreHash = ::bliss::kmer::hash::farm<Key, false>;
+
+template <typename Key>
+using MapParams = ::dsc::HashMapParams<Key,
+    ::bliss::transform::identity, ::bliss::transform::identity, DistHash, ::std::equal_to,
+    ::bliss::transform::identity, StoreHash, ::std::equal_to>;
+
+using SpecialKeys = ::bliss::kmer::hash::sparsehash::special_keys<KmerType, false>;
+
+using MultimapType = ::dsc::densehash_multimap<KmerType, size_t, MapParams, SpecialKeys>;
+using MapType = ::dsc::densehash_map<KmerType, size_t, MapParams, SpecialKeys>;
+
+using EntryType = ::std::pair<KmerType, size_t>;
+
+
+template <typename M>
+class DensehashCacheTest : public ::testing::Test {
+  protected:
+    ::mxx::comm comm;
+
+    std::vector<EntryType> make_entries(size_t const & count, size_t const & seed) {
+      std::default_random_engine generator(comm.rank() + seed);
+      std::uniform_int_distribution<uint64_t> distribution(1, 5000);
+
+      std::vector<EntryType> entries;
+      for (size_t i = 0; i < count; ++i) {
+        KmerType k;
+        k.getDataRef()[0] = distribution(generator);
+        entries.emplace_back(k, comm.rank() * count + i);
+      }
+      return entries;
+    }
+
+    /// includes repeated and absent keys.
+    std::vector<KmerType> make_queries() {
+      std::vector<KmerType> queries;
+      for (uint64_t i = 1 + comm.rank(); i < 6000; i += 5) {
+        KmerType k;
+        k.getDataRef()[0] = i;
+        queries.push_back(k);
+        if (i % 7 == 0) queries.push_back(k);
+      }
+      return queries;
+    }
+
+    static std::vector<EntryType> sorted(std::vector<EntryType> v) {
+      std::sort(v.begin(), v.end(), [](EntryType const & x, EntryType const & y){
+        return (x.first < y.first) || ((x.first == y.first) && (x.second < y.second));
+      });
+      return v;
+    }
+};
+
+// indicate this is a typed test
+TYPED_TEST_CASE_P(DensehashCacheTest);
+
+
+TYPED_TEST_P(DensehashCacheTest, find)
+{
+  TypeParam map(this->comm);
+  auto entries = this->make_entries(20000, 1);
+  map.insert(entries);
+
+  auto q = this->make_queries();
+  auto gold = this->sorted(map.find(q));
+
+  map.set_cache_capacity(100000);
+
+  q = this->make_queries();
+  auto first = this->sorted(map.find(q));
+  q = this->make_queries();
+  auto second = this->sorted(map.find(q));
+
+  EXPECT_EQ(gold, first);
+  EXPECT_EQ(gold, second);
+
+  if (this->comm.size() > 1) {
+    EXPECT_GT(mxx::allreduce(map.get_cache().get_hits(), this->comm), 0UL);
+  }
+
+  // insert invalidates: new entries must be visible.
+  entries = this->make_entries(5000, 100);
+  map.insert(entries);
+  EXPECT_EQ(0UL, map.get_cache().size());
+
+  map.set_cache_capacity(0);
+  q = this->make_queries();
+  gold = this->sorted(map.find(q));
+
+  map.set_cache_capacity(16);   // smaller than the working set: evictions.
+  q = this->make_queries();
+  first = this->sorted(map.find(q));
+  q = this->make_queries();
+  second = this->sorted(map.find(q));
+  EXPECT_EQ(gold, first);
+  EXPECT_EQ(gold, second);
+
+  // erase invalidates.
+  q = this->make_queries();
+  map.erase(q);
+  q = this->make_queries();
+  EXPECT_EQ(0UL, mxx::allreduce(map.find(q).size(), this->comm));
+}
+
+REGISTER_TYPED_TEST_CASE_P(DensehashCacheTest, find);
+
+typedef ::testing::Types<MapType, MultimapType> DensehashCacheTestTypes;
+INSTANTIATE_TYPED_TEST_CASE_P(Bliss, DensehashCacheTest, DensehashCacheTestTypes);
+
+
+class DensehashCacheUpdateTest : public DensehashCacheTest<MapType> {};
+
+TEST_F(DensehashCacheUpdateTest, update)
+{
+  MapType map(this->comm);
+  auto entries = this->make_entries(20000, 1);
+  map.insert(entries);
+  map.set_cache_capacity(100000);
+
+  // fill the cache.
+  auto q = this->make_queries();
+  auto before = this->sorted(map.find(q));
+  ASSERT_GT(mxx::allreduce(before.size(), this->comm), 0UL);
+
+  // update by key:  add 1000000 to the values of the queried keys.
+  std::vector<EntryType> upd;
+  for (auto const & e : before) upd.emplace_back(e.first, 1000000UL);
+  map.update(upd, false, [](size_t & stored, size_t const & v) { stored += v; return 1UL; });
+  EXPECT_EQ(0UL, map.get_cache().size());
+
+  q = this->make_queries();
+  auto after = this->sorted(map.find(q));
+  ASSERT_EQ(before.size(), after.size());
+  for (size_t i = 0; i < after.size(); ++i) {
+    EXPECT_EQ(before[i].first, after[i].first);
+    EXPECT_GE(after[i].second, 1000000UL);
+  }
+
+  // update by filter:  reset all values.
+  q = this->make_queries();
+  map.find(q);
+  map.update([](EntryType const &) { return true; }, [](size_t & stored) { stored = 7; return 1UL; });
+  EXPECT_EQ(0UL, map.get_cache().size());
+
+  q = this->make_queries();
+  after = map.find(q);
+  ASSERT_EQ(before.size(), after.size());
+  for (auto const & e : after) EXPECT_EQ(7UL, e.second);
+}
+
+#endif
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+#if defined(USE_MPI)
+  ::mxx::env e(argc, argv);
+  ::mxx::comm comm;
+
+  result = RUN_ALL_TESTS();
+
+  comm.barrier();
+#endif
+
+  return result;
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * mpi_test_node_shared_map.cpp
+ *
+ * node shared snapshot should answer find and count the same as the distributed map it was built from.
+ */
+
+// include google test
+#include <gtest/gtest.h>
+#include "bliss-config.hpp"
+
+#if defined(USE_MPI)
+#include "mxx/env.hpp"
+#include "mxx/comm.hpp"
+#include "mxx/reduction.hpp"
+
+#include <cstdint>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <utility>
+
+#include "common/kmer.hpp"
+#include "common/alphabets.hpp"
+#include "index/kmer_hash.hpp"
+#include "containers/distributed_unordered_map.hpp"
+#include "containers/distributed_node_shared_map.hpp"
+
+
+using KmerType = ::bliss::common::Kmer<21, ::bliss::common::DNA, uint64_t>;
+
+template <typename Key>
+using DistHash = ::bliss::kmer::hash::farm<Key, true>;
+template <typename Key>
+using StoreHash = ::bliss::kmer::hash::farm<Key, false>;
+
+template <typename Key>
+using MapParams = ::dsc::HashMapParams<Key,
+    ::bliss::transform::identity, ::bliss::transform::identity, DistHash, ::std::equal_to,
+    ::bliss::transform::identity, StoreHash, ::std::equal_to>;
+
+using MapType = ::dsc::unordered_multimap<KmerType, size_t, MapParams>;
+using SharedMapType = ::dsc::node_shared_map<KmerType, size_t, MapParams>;
+
+using EntryType = ::std::pair<KmerType, size_t>;
+
+
+class NodeSharedMapTest : public ::testing::Test {
+  protected:
+    ::mxx::comm comm;
+
+    /// random kmers from a small key space, so keys repeat and queries hit.  values are globally unique.
+    std::vector<EntryType> make_entries(size_t const & count) {
+      std::default_random_engine generator(comm.rank() + 1);
+      std::uniform_int_distribution<uint64_t> distribution(0, 10000);
+
+      std::vector<EntryType> entries;
+      entries.reserve(count);
+      for (size_t i = 0; i < count; ++i) {
+        KmerType k;
+        k.getDataRef()[0] = distribution(generator);
+        entries.emplace_back(k, comm.rank() * count + i);
+      }
+      return entries;
+    }
+
+    std::vector<KmerType> make_queries() {
+      std::vector<KmerType> queries;
+      for (uint64_t i = comm.rank(); i < 12000; i += 3 * comm.size()) {
+        KmerType k;
+        k.getDataRef()[0] = i;
+        queries.push_back(k);
+      }
+      return queries;
+    }
+
+    static void sort_entries(std::vector<EntryType> & v) {
+      std::sort(v.begin(), v.end(), [](EntryType const & x, EntryType const & y){
+        return (x.first < y.first) || ((x.first == y.first) && (x.second < y.second));
+      });
+    }
+};
+
+
+TEST_F(NodeSharedMapTest, find_and_count)
+{
+  MapType map(comm);
+  std::vector<EntryType> entries = make_entries(20000);
+  map.insert(entries);
+
+  SharedMapType shared(map, comm);
+  EXPECT_EQ(map.size(), shared.size());
+
+  std::vector<KmerType> queries = make_queries();
+  std::vector<KmerType> q1 = queries, q2 = queries, q3 = queries;
+
+  std::vector<EntryType> gold = map.find(q1);
+  std::vector<EntryType> test = shared.find(q2);
+  sort_entries(gold);
+  sort_entries(test);
+
+  ASSERT_EQ(gold.size(), test.size());
+  EXPECT_TRUE(std::equal(gold.begin(), gold.end(), test.begin()));
+
+  // one count per query, and they add up to the found entries.
+  std::vector<std::pair<KmerType, size_t> > counts = shared.count(q3);
+  EXPECT_EQ(queries.size(), counts.size());
+  size_t total = 0;
+  for (auto const & c : counts) total += c.second;
+  EXPECT_EQ(test.size(), total);
+}
+
+TEST_F(NodeSharedMapTest, empty)
+{
+  MapType map(comm);
+
+  SharedMapType shared(map, comm);
+  EXPECT_EQ(0UL, shared.size());
+
+  std::vector<KmerType> queries = make_queries();
+  EXPECT_EQ(0UL, mxx::allreduce(shared.find(queries).size(), comm));
+}
+
+#endif
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+#if defined(USE_MPI)
+  ::mxx::env e(argc, argv);
+  ::mxx::comm comm;
+
+  result = RUN_ALL_TESTS();
+
+  comm.barrier();
+#endif
+
+  return result;
+}
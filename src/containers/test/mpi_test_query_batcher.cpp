@@ -0,0 +1,185 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * mpi_test_query_batcher.cpp
+ *
+ * batched queries should return the same results as direct find and count on the map.
+ */
+
+// include google test
+#include <gtest/gtest.h>
+#include "bliss-config.hpp"
+
+#if defined(USE_MPI)
+#include "mxx/env.hpp"
+#include "mxx/comm.hpp"
+#include "mxx/reduction.hpp"
+
+#include <cstdint>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <utility>
+#include <future>
+
+#include "common/kmer.hpp"
+#include "common/alphabets.hpp"
+#include "index/kmer_hash.hpp"
+#include "containers/distributed_unordered_map.hpp"
+#include "containers/distributed_query_batcher.hpp"
+
+
+using KmerType = ::bliss::common::Kmer<21, ::bliss::common::DNA, uint64_t>;
+
+template <typename Key>
+using DistHash = ::bliss::kmer::hash::farm<Key, true>;
+template <typename Key>
+using StoreHash = ::bliss::kmer::hash::farm<Key, false>;
+
+template <typename Key>
+using MapParams = ::dsc::HashMapParams<Key,
+    ::bliss::transform::identity, ::bliss::transform::identity, DistHash, ::std::equal_to,
+    ::bliss::transform::identity, StoreHash, ::std::equal_to>;
+
+using MapType = ::dsc::unordered_multimap<KmerType, size_t, MapParams>;
+using BatcherType = ::dsc::query_batcher<MapType>;
+
+using EntryType = ::std::pair<KmerType, size_t>;
+
+
+class QueryBatcherTest : public ::testing::Test {
+  protected:
+    ::mxx::comm comm;
+
+    void build(MapType & map) {
+      std::default_random_engine generator(comm.rank() + 1);
+      std::uniform_int_distribution<uint64_t> distribution(0, 2000);
+
+      std::vector<EntryType> entries;
+      for (size_t i = 0; i < 10000; ++i) {
+        KmerType k;
+        k.getDataRef()[0] = distribution(generator);
+        entries.emplace_back(k, comm.rank() * 10000 + i);
+      }
+      map.insert(entries);
+    }
+
+    /// caller c's queries.  different sizes per caller and process.
+    std::vector<KmerType> make_queries(int const & c) {
+      std::vector<KmerType> queries;
+      for (uint64_t i = c + comm.rank(); i < 2400; i += 11 + c) {
+        KmerType k;
+        k.getDataRef()[0] = i;
+        queries.push_back(k);
+      }
+      return queries;
+    }
+
+    static void sort_entries(std::vector<EntryType> & v) {
+      std::sort(v.begin(), v.end(), [](EntryType const & x, EntryType const & y){
+        return (x.first < y.first) || ((x.first == y.first) && (x.second < y.second));
+      });
+    }
+};
+
+
+TEST_F(QueryBatcherTest, find_and_count)
+{
+  MapType map(comm);
+  build(map);
+
+  BatcherType batcher(map, comm, 16, 1UL << 20, 1.0);
+
+  const int ncallers = 8;
+  std::vector<std::future<BatcherType::find_result_type> > finds;
+  std::vector<std::future<BatcherType::count_result_type> > counts;
+  for (int c = 0; c < ncallers; ++c) {
+    finds.emplace_back(batcher.find(make_queries(c)));
+    counts.emplace_back(batcher.count(make_queries(c)));
+  }
+  batcher.flush();
+  EXPECT_EQ(0UL, batcher.pending());
+
+  for (int c = 0; c < ncallers; ++c) {
+    std::vector<KmerType> q = make_queries(c);
+    std::vector<KmerType> q2 = q;
+
+    std::vector<EntryType> gold = map.find(q);
+    std::vector<EntryType> test = finds[c].get();
+    sort_entries(gold);
+    sort_entries(test);
+    ASSERT_EQ(gold.size(), test.size());
+    EXPECT_TRUE(std::equal(gold.begin(), gold.end(), test.begin()));
+
+    // one count per query, in query order.
+    std::vector<std::pair<KmerType, size_t> > test_counts = counts[c].get();
+    ASSERT_EQ(q2.size(), test_counts.size());
+    size_t total = 0;
+    for (size_t i = 0; i < q2.size(); ++i) {
+      EXPECT_EQ(q2[i], test_counts[i].first);
+      total += test_counts[i].second;
+    }
+    EXPECT_EQ(gold.size(), total);
+  }
+}
+
+TEST_F(QueryBatcherTest, progress)
+{
+  MapType map(comm);
+  build(map);
+
+  BatcherType batcher(map, comm, 64, 1UL << 20, 1.0);
+
+  // many small rounds, driven by progress only.
+  for (int iter = 0; iter < 50; ++iter) {
+    std::vector<KmerType> q = make_queries(iter % 7);
+    q.resize(std::min(q.size(), static_cast<size_t>(1 + iter)));
+
+    auto f = batcher.find(q);
+    // progress is collective: keep calling it until no process has pending queries.
+    while (mxx::any_of(batcher.pending() > 0, comm)) batcher.progress();
+    ASSERT_EQ(std::future_status::ready, f.wait_for(std::chrono::seconds(0)));
+
+    std::vector<EntryType> test = f.get();
+    for (auto const & e : test) {
+      EXPECT_TRUE(std::find(q.begin(), q.end(), e.first) != q.end());
+    }
+  }
+
+  EXPECT_GE(batcher.get_rounds(), 50UL);
+  EXPECT_GE(batcher.get_target(), 64UL);
+}
+
+#endif
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+#if defined(USE_MPI)
+  ::mxx::env e(argc, argv);
+  ::mxx::comm comm;
+
+  result = RUN_ALL_TESTS();
+
+  comm.barrier();
+#endif
+
+  return result;
+}
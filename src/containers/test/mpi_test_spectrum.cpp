@@ -0,0 +1,135 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/**
+ * mpi_test_spectrum.cpp
+ *
+ * count histograms of the counting maps should match the histogram of the known counts.
+ */
+
+// include google test
+#include <gtest/gtest.h>
+#include "bliss-config.hpp"
+
+#if defined(USE_MPI)
+#include "mxx/env.hpp"
+#include "mxx/comm.hpp"
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+#include "common/kmer.hpp"
+#include "common/alphabets.hpp"
+#include "index/kmer_hash.hpp"
+#include "containers/distributed_unordered_map.hpp"
+#include "containers/distributed_sorted_map.hpp"
+#include "containers/distributed_spectrum.hpp"
+
+
+using KmerType = ::bliss::common::Kmer<21, ::bliss::common::DNA, uint64_t>;
+
+template <typename Key>
+using DistHash = ::bliss::kmer::hash::farm<Key, true>;
+template <typename Key>
+using StoreHash = ::bliss::kmer::hash::farm<Key, false>;
+
+template <typename Key>
+using HashParams = ::dsc::HashMapParams<Key,
+    ::bliss::transform::identity, ::bliss::transform::identity, DistHash, ::std::equal_to,
+    ::bliss::transform::identity, StoreHash, ::std::equal_to>;
+
+template <typename Key>
+using SortParams = ::dsc::SortedMapParams<Key,
+    ::bliss::transform::identity, ::bliss::transform::identity, ::std::less, ::std::equal_to>;
+
+
+/// every process inserts key k (k % 13) + 1 times, so the global count of k is p * ((k % 13) + 1).
+template <typename MapType>
+class SpectrumTest : public ::testing::Test {
+  protected:
+    const size_t distinct = 2600;
+    const size_t bins = 20;
+
+    ::mxx::comm comm;
+    MapType map;
+
+    SpectrumTest() : map(comm) {}
+
+    virtual void SetUp() {
+      std::vector<KmerType> input;
+      for (size_t k = 0; k < distinct; ++k) {
+        KmerType km;
+        km.getDataRef()[0] = k;
+        for (size_t j = 0; j <= (k % 13); ++j) input.push_back(km);
+      }
+      std::random_shuffle(input.begin(), input.end());
+      map.insert(input);
+    }
+
+    std::vector<size_t> gold() const {
+      std::vector<size_t> h(bins, 0);
+      for (size_t k = 0; k < distinct; ++k) {
+        ++h[std::min(comm.size() * ((k % 13) + 1), bins - 1)];
+      }
+      return h;
+    }
+};
+
+using SpectrumTestTypes = ::testing::Types<
+    ::dsc::counting_unordered_map<KmerType, uint32_t, HashParams>,
+    ::dsc::counting_sorted_map<KmerType, uint32_t, SortParams> >;
+TYPED_TEST_CASE(SpectrumTest, SpectrumTestTypes);
+
+
+TYPED_TEST(SpectrumTest, histogram)
+{
+  auto h = this->map.histogram(this->bins);
+  auto expected = this->gold();
+
+  ASSERT_EQ(expected.size(), h.size());
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), h.begin()));
+}
+
+TYPED_TEST(SpectrumTest, repeat)
+{
+  // scanning in place does not change the map.
+  auto first = this->map.histogram(this->bins);
+  auto second = this->map.histogram(this->bins);
+  EXPECT_TRUE(std::equal(first.begin(), first.end(), second.begin()));
+  EXPECT_EQ(this->distinct, this->map.size());
+}
+
+#endif
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+#if defined(USE_MPI)
+  ::mxx::env e(argc, argv);
+  ::mxx::comm comm;
+
+  result = RUN_ALL_TESTS();
+
+  comm.barrier();
+#endif
+
+  return result;
+}
@@ -0,0 +1,193 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * mpi_test_tracked_buffers.cpp
+ *
+ * the exchange buffers and the results of distributed queries are charged to the "buffer" and "results" categories
+ * of plog::AllocTracker, and a local table with a tracking_allocator to its tag.
+ */
+
+// include google test
+#include <gtest/gtest.h>
+#include "bliss-config.hpp"
+
+#if defined(USE_MPI)
+#include "mxx/env.hpp"
+#include "mxx/comm.hpp"
+#include "mxx/reduction.hpp"
+
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <utility>
+
+#include "common/kmer.hpp"
+#include "common/alphabets.hpp"
+#include "index/kmer_hash.hpp"
+#include "containers/distributed_densehash_map.hpp"
+#include "utils/tracking_allocator.hpp"
+
+
+using KmerType = ::bliss::common::Kmer<21, ::bliss::common::DNA, uint64_t>;
+
+template <typename Key>
+using DistHash = ::bliss::kmer::hash::farm<Key, true>;
+template <typename Key>
+using StoreHash = ::bliss::kmer::hash::farm<Key, false>;
+
+template <typename Key>
+using MapParams = ::dsc::HashMapParams<Key,
+    ::bliss::transform::identity, ::bliss::transform::identity, DistHash, ::std::equal_to,
+    ::bliss::transform::identity, StoreHash, ::std::equal_to>;
+
+using SpecialKeys = ::bliss::kmer::hash::sparsehash::special_keys<KmerType, false>;
+
+using MapType = ::dsc::densehash_map<KmerType, size_t, MapParams, SpecialKeys>;
+
+using TrackedCountType = ::dsc::counting_densehash_map<KmerType, uint32_t, MapParams, SpecialKeys,
+    ::plog::tracking_allocator<std::pair<const KmerType, uint32_t>, ::plog::alloc_tag::table> >;
+
+using EntryType = ::std::pair<KmerType, size_t>;
+
+
+static int64_t live_of(std::string const & name) {
+  ::plog::AllocTracker & t = ::plog::AllocTracker::instance();
+  std::vector<std::string> cats = t.categories();
+  size_t c = std::distance(cats.begin(), std::find(cats.begin(), cats.end(), name));
+  return (c < cats.size()) ? t.live()[c] : 0;
+}
+
+static int64_t peak_of(::plog::AllocTracker::window const & w, std::string const & name) {
+  std::vector<std::string> cats = ::plog::AllocTracker::instance().categories();
+  size_t c = std::distance(cats.begin(), std::find(cats.begin(), cats.end(), name));
+  std::vector<int64_t> peaks = w.peak();
+  return (c < peaks.size()) ? peaks[c] : 0;
+}
+
+
+class TrackedBuffersTest : public ::testing::Test {
+  protected:
+    ::mxx::comm comm;
+
+    std::vector<EntryType> make_entries(size_t const & count) {
+      std::default_random_engine generator(comm.rank() + 1);
+      std::uniform_int_distribution<uint64_t> distribution(1, 5000);
+
+      std::vector<EntryType> entries;
+      for (size_t i = 0; i < count; ++i) {
+        KmerType k;
+        k.getDataRef()[0] = distribution(generator);
+        entries.emplace_back(k, i);
+      }
+      return entries;
+    }
+
+    std::vector<KmerType> make_queries() {
+      std::vector<KmerType> queries;
+      for (uint64_t i = 1 + comm.rank(); i < 6000; i += 3) {
+        KmerType k;
+        k.getDataRef()[0] = i;
+        queries.push_back(k);
+      }
+      return queries;
+    }
+};
+
+
+TEST_F(TrackedBuffersTest, find)
+{
+  MapType map(this->comm);
+  auto entries = this->make_entries(20000);
+  map.insert(entries);
+
+  ::plog::AllocTracker::window w;
+  auto q = this->make_queries();
+  auto results = map.find(q);
+  ASSERT_GT(results.size(), 0UL);
+
+  // the results returned count towards the peak.
+  EXPECT_GE(peak_of(w, "results"), static_cast<int64_t>(results.capacity() * sizeof(EntryType)));
+  // a single process does not exchange.
+  if (this->comm.size() > 1) {
+    EXPECT_GT(peak_of(w, "buffer"), 0);
+  }
+
+  // the retained buffers stay charged, the results returned do not.
+  EXPECT_EQ(static_cast<int64_t>(map.buffer_bytes()), live_of("buffer") + live_of("results"));
+
+  w.reset();
+  q = this->make_queries();
+  auto counts = map.count(q);
+  EXPECT_GE(peak_of(w, "results"), static_cast<int64_t>(counts.capacity() * sizeof(counts[0])));
+
+  map.trim_buffers();
+  EXPECT_EQ(0, live_of("buffer"));
+  EXPECT_EQ(0, live_of("results"));
+}
+
+TEST_F(TrackedBuffersTest, table)
+{
+  int64_t before = live_of("table");
+  {
+    TrackedCountType map(this->comm);
+
+    std::vector<KmerType> input;
+    for (auto const & e : this->make_entries(20000)) input.push_back(e.first);
+    map.insert(input);
+    int64_t small = live_of("table");
+    // the table is charged, at least for the entries it holds.
+    EXPECT_GE(small - before, static_cast<int64_t>(map.local_size() * sizeof(std::pair<const KmerType, uint32_t>)));
+
+    // more distinct kmers grow the table.
+    input.clear();
+    for (uint64_t i = 0; i < 50000; ++i) {
+      KmerType k;
+      k.getDataRef()[0] = 10000 + i * this->comm.size() + this->comm.rank();
+      input.push_back(k);
+    }
+    map.insert(input);
+    EXPECT_GT(live_of("table"), small);
+
+    auto q = this->make_queries();
+    auto counts = map.count(q);
+    EXPECT_EQ(q.size(), counts.size());
+  }
+  // and released with the map.
+  EXPECT_EQ(before, live_of("table"));
+}
+
+#endif
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+#if defined(USE_MPI)
+  ::mxx::env e(argc, argv);
+  ::mxx::comm comm;
+
+  result = RUN_ALL_TESTS();
+
+  comm.barrier();
+#endif
+
+  return result;
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// include google test
+#include <gtest/gtest.h>
+#include "containers/clock_cache.hpp"
+
+#include <vector>
+
+
+TEST(ClockCache, Disabled)
+{
+  ::fsc::clock_cache<int, int> cache;
+  EXPECT_FALSE(cache.enabled());
+
+  cache.insert(1, 2);
+  EXPECT_EQ(0UL, cache.size());
+  EXPECT_TRUE(cache.find(1) == nullptr);
+  EXPECT_EQ(1UL, cache.get_misses());
+}
+
+TEST(ClockCache, HitAndMiss)
+{
+  ::fsc::clock_cache<int, std::vector<int> > cache(10);
+
+  for (int i = 0; i < 10; ++i) {
+    cache.insert(i, std::vector<int>(i, i));
+  }
+  EXPECT_EQ(10UL, cache.size());
+
+  for (int i = 0; i < 10; ++i) {
+    auto v = cache.find(i);
+    ASSERT_TRUE(v != nullptr);
+    EXPECT_EQ(static_cast<size_t>(i), v->size());
+  }
+  EXPECT_TRUE(cache.find(10) == nullptr);
+
+  EXPECT_EQ(10UL, cache.get_hits());
+  EXPECT_EQ(1UL, cache.get_misses());
+  EXPECT_EQ(0UL, cache.get_evictions());
+
+  // replace.
+  cache.insert(3, std::vector<int>(1, 42));
+  EXPECT_EQ(10UL, cache.size());
+  EXPECT_EQ(42, cache.find(3)->front());
+}
+
+TEST(ClockCache, Eviction)
+{
+  ::fsc::clock_cache<int, int> cache(4);
+  for (int i = 0; i < 4; ++i) cache.insert(i, i);
+
+  // reference 0 and 1: they get a second chance.
+  cache.find(0);
+  cache.find(1);
+
+  cache.insert(4, 4);
+  cache.insert(5, 5);
+  EXPECT_EQ(4UL, cache.size());
+  EXPECT_EQ(2UL, cache.get_evictions());
+
+  EXPECT_TRUE(cache.find(0) != nullptr);
+  EXPECT_TRUE(cache.find(1) != nullptr);
+  EXPECT_TRUE(cache.find(2) == nullptr);
+  EXPECT_TRUE(cache.find(3) == nullptr);
+  EXPECT_TRUE(cache.find(4) != nullptr);
+  EXPECT_TRUE(cache.find(5) != nullptr);
+
+  // many more than capacity.
+  for (int i = 0; i < 1000; ++i) cache.insert(i, i);
+  EXPECT_EQ(4UL, cache.size());
+  for (int i = 996; i < 1000; ++i) {
+    auto v = cache.find(i);
+    ASSERT_TRUE(v != nullptr);
+    EXPECT_EQ(i, *v);
+  }
+}
+
+TEST(ClockCache, Invalidate)
+{
+  ::fsc::clock_cache<int, int> cache(8);
+  for (int i = 0; i < 8; ++i) cache.insert(i, i);
+
+  EXPECT_TRUE(cache.erase(3));
+  EXPECT_FALSE(cache.erase(3));
+  EXPECT_TRUE(cache.find(3) == nullptr);
+  EXPECT_EQ(7UL, cache.size());
+
+  // freed slot is reused before anything is evicted.
+  cache.insert(100, 100);
+  EXPECT_EQ(8UL, cache.size());
+  EXPECT_EQ(0UL, cache.get_evictions());
+
+  cache.clear();
+  EXPECT_EQ(0UL, cache.size());
+  EXPECT_EQ(9UL, cache.get_invalidations());
+  for (int i = 0; i < 8; ++i) EXPECT_TRUE(cache.find(i) == nullptr);
+
+  cache.insert(1, 1);
+  EXPECT_EQ(1, *(cache.find(1)));
+}
@@ -61,6 +61,59 @@
 	static constexpr bool need_to_split = true;
   };
 
+  /// erase predicate for the compaction tests:  entries with odd values.
+  struct odd_value {
+      template <typename K, typename V>
+      bool operator()(::std::pair<K, V> const & x) const {
+        return (x.second & 1) == 1;
+      }
+  };
+
+  /// erase the entries with odd values, compact, then reinsert them.  compare to gold after each step.
+  template <typename MAP, typename T, typename Gold>
+  void check_compact(::std::vector<::std::pair<T, T> > const & input, Gold const & gold) {
+    auto less = [](::std::pair<T, T> const & x, ::std::pair<T, T> const & y) {
+      return (x.first == y.first) ? (x.second < y.second) : (x.first < y.first);
+    };
+
+    ::std::vector<::std::pair<T, T> > even, odd;
+    for (auto const & x : gold) {
+      if (odd_value()(x)) odd.emplace_back(x);
+      else even.emplace_back(x);
+    }
+    ::std::sort(even.begin(), even.end(), less);
+
+    MAP test(input.begin(), input.end());
+    size_t keys_before = test.unique_size();
+    EXPECT_EQ(0UL, test.tombstones());
+
+    EXPECT_EQ(odd.size(), test.erase(odd_value()));
+    EXPECT_EQ(keys_before - test.unique_size(), test.tombstones());
+    if (test.tombstones() > 0) EXPECT_LT(0.0, test.tombstone_ratio());
+
+    test.compact();
+    EXPECT_EQ(0UL, test.tombstones());
+    EXPECT_EQ(0.0, test.tombstone_ratio());
+    EXPECT_EQ(even.size(), test.size());
+
+    ::std::vector<::std::pair<T, T> > test_vals = test.to_vector();
+    ::std::sort(test_vals.begin(), test_vals.end(), less);
+    ASSERT_EQ(even.size(), test_vals.size());
+    EXPECT_TRUE(::std::equal(test_vals.begin(), test_vals.end(), even.begin()));
+
+    // the packed layout must still accept inserts.
+    test.insert(odd.begin(), odd.end());
+    ::std::vector<::std::pair<T, T> > gold_vals(gold.begin(), gold.end());
+    ::std::sort(gold_vals.begin(), gold_vals.end(), less);
+    test_vals = test.to_vector();
+    ::std::sort(test_vals.begin(), test_vals.end(), less);
+    ASSERT_EQ(gold_vals.size(), test_vals.size());
+    EXPECT_TRUE(::std::equal(test_vals.begin(), test_vals.end(), gold_vals.begin()));
+    for (auto const & x : gold) {
+      EXPECT_EQ(gold.count(x.first), test.count(x.first));
+    }
+  }
+
 /*
  * test class holding some information.  Also, needed for the typed tests
  */
@@ -212,8 +265,13 @@ TYPED_TEST_P(DenseHashMapPartialTest, count_partial)
     }
 }
 
+TYPED_TEST_P(DenseHashMapPartialTest, compact_partial)
+{
+  check_compact<::fsc::densehash_map<TypeParam, TypeParam>>(this->temp, this->gold);
+}
+
 // now register the test cases
-REGISTER_TYPED_TEST_CASE_P(DenseHashMapPartialTest, insert_partial, equal_range_partial, count_partial);
+REGISTER_TYPED_TEST_CASE_P(DenseHashMapPartialTest, insert_partial, equal_range_partial, count_partial, compact_partial);
 
 
 //////////////////// RUN the tests with different types.
@@ -391,8 +449,13 @@ TYPED_TEST_P(DenseHashMapFullTest, count_full)
 
 
 
+TYPED_TEST_P(DenseHashMapFullTest, compact_full)
+{
+  check_compact<::fsc::densehash_map<TypeParam, TypeParam, full_special_keys<TypeParam> >>(this->temp, this->gold);
+}
+
 // now register the test cases
-REGISTER_TYPED_TEST_CASE_P(DenseHashMapFullTest, insert_full, equal_range_full, count_full);
+REGISTER_TYPED_TEST_CASE_P(DenseHashMapFullTest, insert_full, equal_range_full, count_full, compact_full);
 
 
 //////////////////// RUN the tests with different types.
@@ -571,8 +634,13 @@ TYPED_TEST_P(DenseHashMultimapPartialTest, count_partial)
 
 
 
+TYPED_TEST_P(DenseHashMultimapPartialTest, compact_partial)
+{
+  check_compact<::fsc::densehash_multimap<TypeParam, TypeParam>>(this->temp, this->gold);
+}
+
 // now register the test cases
-REGISTER_TYPED_TEST_CASE_P(DenseHashMultimapPartialTest, insert_partial, equal_range_partial, count_partial);
+REGISTER_TYPED_TEST_CASE_P(DenseHashMultimapPartialTest, insert_partial, equal_range_partial, count_partial, compact_partial);
 
 
 //////////////////// RUN the tests with different types.
@@ -751,8 +819,13 @@ TYPED_TEST_P(DenseHashMultimapFullTest, count_full)
 
 
 
+TYPED_TEST_P(DenseHashMultimapFullTest, compact_full)
+{
+  check_compact<::fsc::densehash_multimap<TypeParam, TypeParam, full_special_keys<TypeParam> >>(this->temp, this->gold);
+}
+
 // now register the test cases
-REGISTER_TYPED_TEST_CASE_P(DenseHashMultimapFullTest, insert_full, equal_range_full, count_full);
+REGISTER_TYPED_TEST_CASE_P(DenseHashMultimapFullTest, insert_full, equal_range_full, count_full, compact_full);
 
 
 //////////////////// RUN the tests with different types.
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// include google test
+#include <gtest/gtest.h>
+#include "containers/huge_page_allocator.hpp"
+
+#include <vector>
+#include <unordered_map>
+#include <numeric>   // iota
+#include <stdexcept>
+#include <cstdint>
+
+
+// huge pages and NUMA placement depend on the machine.  these check that the memory is usable and accounted,
+// whichever mode the kernel grants.
+
+class HugePageAllocatorTest : public ::testing::Test {
+  protected:
+    virtual void SetUp() {
+      ::fsc::huge_page_options & opts = ::fsc::huge_page_options::instance();
+      opts.reset_counts();
+      opts.set_pages("thp");
+      opts.set_numa("first_touch");
+    }
+    virtual void TearDown() { SetUp(); }
+};
+
+static void fill_and_check(::fsc::huge_page_options::page_mode const & mode, std::string const & numa) {
+  ::fsc::huge_page_options & opts = ::fsc::huge_page_options::instance();
+  opts.pages = mode;
+  opts.set_numa(numa);
+
+  std::vector<uint64_t, ::fsc::huge_page_allocator<uint64_t> > v(3UL << 20);   // 24MB
+  EXPECT_EQ(0UL, reinterpret_cast<uintptr_t>(v.data()) & (::fsc::huge_page_options::page_size - 1));
+  std::iota(v.begin(), v.end(), 0);
+  uint64_t sum = 0;
+  for (size_t i = 0; i < v.size(); i += 4099) sum += v[i] - i;
+  EXPECT_EQ(0UL, sum);
+}
+
+TEST_F(HugePageAllocatorTest, thp)
+{
+  fill_and_check(::fsc::huge_page_options::THP, "first_touch");
+  EXPECT_EQ(1UL, ::fsc::huge_page_options::instance().thp_maps.load());
+}
+
+TEST_F(HugePageAllocatorTest, hugetlb_or_fallback)
+{
+  fill_and_check(::fsc::huge_page_options::HUGETLB, "first_touch");
+  ::fsc::huge_page_options & opts = ::fsc::huge_page_options::instance();
+  EXPECT_EQ(1UL, opts.hugetlb_maps.load() + opts.thp_maps.load());
+}
+
+TEST_F(HugePageAllocatorTest, small_pages)
+{
+  fill_and_check(::fsc::huge_page_options::SMALL, "first_touch");
+  EXPECT_EQ(1UL, ::fsc::huge_page_options::instance().small_maps.load());
+}
+
+TEST_F(HugePageAllocatorTest, numa)
+{
+  // node 0 always exists.  mbind may be refused, which is counted.
+  fill_and_check(::fsc::huge_page_options::THP, "interleave");
+  fill_and_check(::fsc::huge_page_options::THP, "bind:0");
+  EXPECT_LE(::fsc::huge_page_options::instance().mbind_failures.load(), 2UL);
+  EXPECT_NE(0UL, ::fsc::huge_page_options::online_nodes()[0] & 1UL);
+
+  EXPECT_THROW(::fsc::huge_page_options::instance().set_numa("bind"), std::invalid_argument);
+  EXPECT_THROW(::fsc::huge_page_options::instance().set_pages("1g"), std::invalid_argument);
+}
+
+TEST_F(HugePageAllocatorTest, small_allocations)
+{
+  // below 2MB, and the nodes of node based containers, come from std::allocator.
+  std::unordered_map<int, int, std::hash<int>, std::equal_to<int>,
+    ::fsc::huge_page_allocator<std::pair<const int, int> > > m;
+  for (int i = 0; i < 10000; ++i) m[i] = i;
+  EXPECT_EQ(10000UL, m.size());
+  EXPECT_EQ(9999, m[9999]);
+
+  ::fsc::huge_page_options & opts = ::fsc::huge_page_options::instance();
+  EXPECT_EQ(0UL, opts.hugetlb_maps.load() + opts.thp_maps.load() + opts.small_maps.load());
+}
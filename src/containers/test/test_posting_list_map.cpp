@@ -0,0 +1,292 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// include google test
+#include <gtest/gtest.h>
+#include "containers/posting_list_map.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <random>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+// include files to test
+#include "utils/logging.h"
+
+/*
+ * test class holding some information.  Also, needed for the typed tests
+ */
+template<typename T>
+class PostingListMultimapTest : public ::testing::Test
+{
+  protected:
+    using valType = ::std::pair<T, T>;
+
+    ::std::unordered_multimap<T, T> gold;
+    ::fsc::posting_list_multimap<T, T> test;
+
+    size_t iters = 100000;
+
+    virtual void SetUp()
+    { // generate some inputs
+      std::default_random_engine generator;
+      std::uniform_int_distribution<T> distribution(0,99);
+
+      for (size_t i=0; i< iters; ++i) {
+        T key = distribution(generator);
+        T val = distribution(generator);
+        test.emplace(key, val);
+        gold.emplace(key, val);
+      }
+    }
+
+    static bool less(valType const &x, valType const &y) {
+      return (x.first == y.first) ? (x.second < y.second) : (x.first < y.first);
+    }
+
+    /// all entries of test and gold, sorted.
+    void check_all() {
+      ::std::vector<valType> test_vals(this->test.begin(), this->test.end());
+      ::std::vector<valType> gold_vals(this->gold.begin(), this->gold.end());
+
+      EXPECT_EQ(gold_vals.size(), test_vals.size());
+      EXPECT_EQ(this->gold.size(), this->test.size());
+
+      ::std::sort(test_vals.begin(), test_vals.end(), less);
+      ::std::sort(gold_vals.begin(), gold_vals.end(), less);
+
+      EXPECT_TRUE(::std::equal(test_vals.begin(), test_vals.end(), gold_vals.begin()));
+    }
+
+    /// values of key i are the same, and are in ascending order.
+    void check_key(T const & i) {
+      auto test_range = this->test.equal_range(i);
+      auto gold_range = this->gold.equal_range(i);
+
+      ::std::vector<T> test_vals;
+      ::std::vector<T> gold_vals;
+      for (auto it = test_range.first; it != test_range.second; ++it) {
+        EXPECT_EQ(i, (*it).first);
+        test_vals.push_back((*it).second);
+      }
+      for (auto it = gold_range.first; it != gold_range.second; ++it) {
+        gold_vals.push_back(it->second);
+      }
+
+      EXPECT_TRUE(::std::is_sorted(test_vals.begin(), test_vals.end()));
+      EXPECT_EQ(gold_vals.size(), test_vals.size());
+      ::std::sort(gold_vals.begin(), gold_vals.end());
+      EXPECT_TRUE(::std::equal(test_vals.begin(), test_vals.end(), gold_vals.begin()));
+
+      EXPECT_EQ(this->gold.count(i), this->test.count(i));
+    }
+};
+
+// indicate this is a typed test
+TYPED_TEST_CASE_P(PostingListMultimapTest);
+
+TYPED_TEST_P(PostingListMultimapTest, insert)
+{
+  ::fsc::posting_list_multimap<TypeParam, TypeParam> test2(this->gold.begin(), this->gold.end());
+  this->test.swap(test2);
+
+  this->check_all();
+}
+
+TYPED_TEST_P(PostingListMultimapTest, iterator)
+{
+  this->check_all();
+}
+
+TYPED_TEST_P(PostingListMultimapTest, equal_range)
+{
+  for (int i = 0; i < 101; ++i) {
+    this->check_key(i);
+  }
+}
+
+TYPED_TEST_P(PostingListMultimapTest, find_values)
+{
+  for (int i = 0; i < 101; ++i) {
+    ::std::vector<TypeParam> test_vals;
+    size_t n = this->test.find_values(i, ::std::back_inserter(test_vals));
+    EXPECT_EQ(this->gold.count(i), n);
+    EXPECT_EQ(n, test_vals.size());
+    EXPECT_TRUE(::std::is_sorted(test_vals.begin(), test_vals.end()));
+  }
+}
+
+TYPED_TEST_P(PostingListMultimapTest, keys)
+{
+  ::std::vector<TypeParam> test_keys;
+  this->test.keys(test_keys);
+  EXPECT_EQ(100UL, this->test.unique_size());
+  EXPECT_EQ(100UL, test_keys.size());
+
+  ::std::sort(test_keys.begin(), test_keys.end());
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(i, test_keys[i]);
+  }
+}
+
+TYPED_TEST_P(PostingListMultimapTest, erase)
+{
+  // whole keys
+  for (int i = 0; i < 100; i += 3) {
+    EXPECT_EQ(this->gold.erase(i), this->test.erase(i));
+  }
+  // again.  nothing left
+  EXPECT_EQ(0UL, this->test.erase(0));
+
+  // by value
+  auto pred = [](::std::pair<const TypeParam, TypeParam> const & x) { return (x.second % 2) == 0; };
+  for (int i = 1; i < 100; i += 3) {
+    size_t removed = 0;
+    auto range = this->gold.equal_range(i);
+    for (auto it = range.first; it != range.second;) {
+      if (pred(*it)) {
+        it = this->gold.erase(it);
+        ++removed;
+      } else ++it;
+    }
+    EXPECT_EQ(removed, this->test.erase(i, pred));
+  }
+
+  EXPECT_EQ(100UL - 34UL, this->test.unique_size());
+  for (int i = 0; i < 100; ++i) {
+    this->check_key(i);
+  }
+  this->check_all();
+}
+
+TYPED_TEST_P(PostingListMultimapTest, reinsert)
+{
+  // erase, then insert more.  compaction should merge with existing lists and drop erased ones.
+  for (int i = 0; i < 100; i += 2) {
+    this->gold.erase(i);
+    this->test.erase(i);
+  }
+  this->check_all();
+
+  std::default_random_engine generator(17);
+  std::uniform_int_distribution<TypeParam> distribution(0,120);
+  for (size_t i=0; i< 1000; ++i) {
+    TypeParam key = distribution(generator);
+    TypeParam val = distribution(generator);
+    this->test.emplace(key, val);
+    this->gold.emplace(key, val);
+  }
+  this->test.compact();
+
+  for (int i = 0; i < 121; ++i) {
+    this->check_key(i);
+  }
+  this->check_all();
+}
+
+TYPED_TEST_P(PostingListMultimapTest, tombstones)
+{
+  this->test.unique_size();
+  size_t bytes = this->test.memory_usage();
+
+  // emptied lists are skipped by queries, without rewriting the table.
+  for (int i = 0; i < 100; i += 3) {
+    this->gold.erase(i);
+    this->test.erase(i);
+    this->check_key(i);
+    this->check_key(i + 1);
+  }
+  EXPECT_EQ(100UL - 34UL, this->test.unique_size());
+  EXPECT_EQ(bytes, this->test.memory_usage());
+  this->check_all();
+
+  // explicit compact reclaims them.
+  this->test.compact();
+  EXPECT_GT(bytes, this->test.memory_usage());
+  EXPECT_EQ(100UL - 34UL, this->test.unique_size());
+  for (int i = 0; i < 101; ++i) {
+    this->check_key(i);
+  }
+  this->check_all();
+}
+
+REGISTER_TYPED_TEST_CASE_P(PostingListMultimapTest, insert, iterator, equal_range, find_values, keys, erase, reinsert, tombstones);
+
+//////////////////// RUN the tests with different types.
+
+typedef ::testing::Types<int16_t, int32_t,
+    int64_t, uint64_t> PostingListMultimapTestTypes;
+INSTANTIATE_TYPED_TEST_CASE_P(Bliss, PostingListMultimapTest, PostingListMultimapTestTypes);
+
+
+/// value type with an id member, as in the position index.
+struct PostingTestId {
+    size_t id;
+    bool operator==(PostingTestId const & other) const { return id == other.id; }
+};
+
+TEST(PostingListMultimap, IdValues)
+{
+  ::fsc::posting_list_multimap<int, PostingTestId> test;
+  ::std::unordered_multimap<int, size_t> gold;
+
+  // large, sparse ids: deltas take several bytes.
+  std::default_random_engine generator;
+  std::uniform_int_distribution<size_t> distribution(0, 1UL << 40);
+  for (size_t i = 0; i < 10000; ++i) {
+    int key = i % 37;
+    PostingTestId val;
+    val.id = distribution(generator);
+    test.emplace(key, val);
+    gold.emplace(key, val.id);
+  }
+  EXPECT_EQ(gold.size(), test.size());
+
+  for (int i = 0; i < 38; ++i) {
+    ::std::vector<size_t> test_vals, gold_vals;
+    auto range = test.equal_range(i);
+    for (auto it = range.first; it != range.second; ++it) test_vals.push_back((*it).second.id);
+    auto grange = gold.equal_range(i);
+    for (auto it = grange.first; it != grange.second; ++it) gold_vals.push_back(it->second);
+
+    ::std::sort(gold_vals.begin(), gold_vals.end());
+    EXPECT_EQ(gold_vals, test_vals);
+  }
+
+  EXPECT_EQ(0UL, test.count(100));
+  auto range = test.equal_range(100);
+  EXPECT_TRUE(range.first == range.second);
+}
+
+TEST(PostingListMultimap, Empty)
+{
+  ::fsc::posting_list_multimap<int, int> test;
+  EXPECT_TRUE(test.empty());
+  EXPECT_TRUE(test.begin() == test.end());
+  EXPECT_EQ(0UL, test.count(1));
+  EXPECT_EQ(0UL, test.erase(1));
+  auto range = test.equal_range(1);
+  EXPECT_TRUE(range.first == range.second);
+
+  test.emplace(1, 2);
+  EXPECT_EQ(1UL, test.count(1));
+  test.clear();
+  EXPECT_EQ(0UL, test.size());
+  EXPECT_EQ(0UL, test.count(1));
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// include google test
+#include <gtest/gtest.h>
+#include "containers/distributed_spectrum.hpp"
+
+#include <vector>
+#include <utility>
+#include <random>
+#include <cmath>
+
+
+TEST(Spectrum, LocalHistogram)
+{
+  std::vector<std::pair<int, size_t> > counts;
+  for (size_t i = 0; i < 100; ++i) {
+    counts.emplace_back(i, i % 10);
+  }
+
+  auto h = ::dsc::spectrum::local_histogram(counts.begin(), counts.end(), 8);
+  ASSERT_EQ(8UL, h.size());
+  for (size_t i = 0; i < 7; ++i) {
+    EXPECT_EQ(10UL, h[i]);
+  }
+  // 7, 8, 9 in the overflow bin.
+  EXPECT_EQ(30UL, h[7]);
+
+  auto empty = ::dsc::spectrum::local_histogram(counts.begin(), counts.begin(), 4);
+  EXPECT_EQ(std::vector<size_t>(4, 0), empty);
+}
+
+TEST(Spectrum, FirstValley)
+{
+  // error peak decaying from count 1, solid peak around 30.
+  std::vector<size_t> h(64, 0);
+  for (size_t i = 1; i < 63; ++i) {
+    double error = 100000.0 * std::exp(-1.0 * static_cast<double>(i));
+    double solid = 5000.0 * std::exp(-0.5 * std::pow((static_cast<double>(i) - 30.0) / 5.0, 2));
+    h[i] = static_cast<size_t>(error + solid);
+  }
+  h[63] = 1000000;   // overflow bin is ignored.
+
+  size_t v = ::dsc::spectrum::first_valley(h);
+  EXPECT_GT(v, 5UL);
+  EXPECT_LT(v, 20UL);
+
+  // a bump on the error slope stops the unsmoothed search early, but not the smoothed one.
+  std::vector<size_t> noisy = h;
+  noisy[3] = noisy[4] - 1;
+  EXPECT_EQ(3UL, ::dsc::spectrum::first_valley(noisy, 0));
+  size_t sv = ::dsc::spectrum::first_valley(noisy, 2);
+  EXPECT_GT(sv, 5UL);
+  EXPECT_LT(sv, 20UL);
+}
+
+TEST(Spectrum, NoValley)
+{
+  std::vector<size_t> h(32, 0);
+  for (size_t i = 1; i < 32; ++i) h[i] = 1000 / i;
+  EXPECT_EQ(0UL, ::dsc::spectrum::first_valley(h));
+
+  EXPECT_EQ(0UL, ::dsc::spectrum::first_valley(std::vector<size_t>(3, 1)));
+}
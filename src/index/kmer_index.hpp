@@ -112,6 +112,14 @@ public:
 
 	using KmerParserType = KmerParser;
 
+protected:
+	/// canonicalize queries when the parser emits canonical kmers, since the map may then skip its own input transform.
+	void canonicalize_query(std::vector<KmerType> &query) const {
+		if (KmerParserType::is_canonical)
+			std::transform(query.begin(), query.end(), query.begin(), ::bliss::kmer::transform::lex_less<KmerType>());
+	}
+
+public:
 	Index(const mxx::comm& _comm) : map(_comm), comm(_comm) {
 	}
 
@@ -124,6 +132,12 @@ public:
 		return map;
 	}
 
+	/// transform queries to the form the map reports in find/count results, so callers can match results to queries.
+	void transform_query(std::vector<KmerType> &query) const {
+		canonicalize_query(query);
+		map.transform_input(query);
+	}
+
 
 
 //	std::vector<TupleType> find_overlap(std::vector<KmerType> &query) const {
@@ -131,6 +145,7 @@ public:
 //	}
 	auto find(std::vector<KmerType> &query) const
 		-> decltype(::std::declval<MapType>().find(::std::declval<std::vector<KmerType> &>())) {
+		canonicalize_query(query);
 		return map.find(query);
 	}
 //	std::vector<TupleType> find_collective(std::vector<KmerType> &query) const {
@@ -141,13 +156,23 @@ public:
 //  }
 	auto count(std::vector<KmerType> &query) const
 	-> decltype(::std::declval<MapType>().count(::std::declval<std::vector<KmerType> &>())){
+		canonicalize_query(query);
 		return map.count(query);
 	}
 
 	void erase(std::vector<KmerType> &query) {
+		canonicalize_query(query);
 		map.erase(query);
 	}
 
+	/// reduce the values of each group of query kmers (e.g. the kmers of a read) at the owners.  see dsc::aggregate.
+	template <typename Aggregator>
+	std::vector<typename Aggregator::result_type> aggregate(std::vector<KmerType> &query, std::vector<size_t> const & groups,
+			size_t const & group_count, Aggregator const & agg = Aggregator()) const {
+		canonicalize_query(query);
+		return map.aggregate(query, groups, group_count, agg);
+	}
+
 
 //	template <typename Predicate>
 //	std::vector<TupleType> find_if_overlap(std::vector<KmerType> &query, Predicate const &pred) const {
@@ -156,6 +181,7 @@ public:
 	template <typename Predicate>
 	auto find_if(std::vector<KmerType> &query, Predicate const &pred) const
 	-> decltype(::std::declval<MapType>().find(::std::declval<std::vector<KmerType> &>())) {
+		canonicalize_query(query);
 		return map.find(query, false, pred);
 	}
 //	template <typename Predicate>
@@ -174,6 +200,7 @@ public:
 	template <typename Predicate>
 	auto count_if(std::vector<KmerType> &query, Predicate const &pred) const
 	-> decltype(::std::declval<MapType>().find(::std::declval<std::vector<KmerType> &>())) {
+		canonicalize_query(query);
 		return map.count(query, false, pred);
 	}
 
@@ -185,6 +212,7 @@ public:
 
 	template <typename Predicate>
 	void erase_if(std::vector<KmerType> &query, Predicate const &pred) {
+		canonicalize_query(query);
 		map.erase(query, false, pred);
 	}
 
@@ -372,6 +400,93 @@ public:
 		 }
 
 
+	 /**
+	  * @brief convenience function for building index from a FASTQ file in chunks.
+	  * @details  the next chunk is read in the background while the current one is parsed and inserted,
+	  *           and only 1 chunk of kmers is held at a time.  see KmerFileHelper::read_file_chunked.
+	  * @param chunk_bytes  bytes of the file per rank per insert.
+	  */
+	 template <template <typename> class SeqParser, template <typename,  template <typename> class> class SeqIterType>
+	 void build_chunked(const std::string & filename, MPI_Comm comm, size_t const & chunk_bytes = (64UL << 20)) {
+
+		 // file extension determines SeqParserType
+		 std::string extension = ::bliss::utils::file::get_file_extension(filename);
+		 std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+		 if (extension.compare("fastq") != 0) {
+			 throw std::invalid_argument("input filename extension is not supported for chunked build.  use fastq.");
+		 }
+
+		 BL_BENCH_INIT(build);
+
+		 BL_BENCH_START(build);
+		 auto insert_chunk = [this](::std::vector<typename KmerParser::value_type> & temp) {
+			 this->insert(temp);
+		 };
+		 auto read = bliss::io::KmerFileHelper::template read_file_chunked<KmerParser, SeqParser, SeqIterType>(filename, insert_chunk, comm, chunk_bytes);
+		 BL_BENCH_END(build, "read_insert", read.second);
+
+		 BL_BENCH_REPORT_MPI_NAMED(build, "index:build_chunked", this->comm);
+	 }
+
+
+
+
+	 /**
+	  * @brief convenience function for building index from a list of files, with a single distribution phase.
+	  * @details  files are assigned to processes by size.  the file's index in the list is used as its file_id.
+	  *           see KmerFileHelper::read_files
+	  * @tparam FileType  parallel file type, e.g. partitioned_file or mpiio_file
+	  */
+	 template <typename FileType, template <typename> class SeqParser, template <typename,  template <typename> class> class SeqIterType>
+	 void build_files(const std::vector<std::string> & filenames, MPI_Comm comm) {
+
+		 for (auto filename : filenames) {
+			 // file extension determines SeqParserType
+			 std::string extension = ::bliss::utils::file::get_file_extension(filename);
+			 std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+			 if ((extension.compare("fastq") != 0) && (extension.compare("fasta") != 0) && (extension.compare("fa") != 0)) {
+				 throw std::invalid_argument("input filename extension is not supported.");
+			 }
+
+			 // check to make sure that the file parser will work
+			 if ((extension.compare("fastq") == 0) && (!std::is_same<SeqParser<char*>, ::bliss::io::FASTQParser<char*> >::value)) {
+				 throw std::invalid_argument("Specified File Parser template parameter does not support files with fastq extension.");
+			 } else if (((extension.compare("fasta") == 0) || (extension.compare("fa") == 0)) && (!std::is_same<SeqParser<char*>, ::bliss::io::FASTAParser<char*> >::value)) {
+				 throw std::invalid_argument("Specified File Parser template parameter does not support files with fasta extension.");
+			 }
+		 }
+		 BL_BENCH_INIT(build);
+
+		 // proceed
+		 BL_BENCH_START(build);
+		 ::std::vector<typename KmerParser::value_type> temp;
+		 bliss::io::KmerFileHelper::template read_files<FileType, KmerParser, SeqParser, SeqIterType>(filenames, temp, comm);
+		 BL_BENCH_END(build, "read", temp.size());
+
+		 BL_BENCH_START(build);
+		 this->insert(temp);
+		 BL_BENCH_END(build, "insert", temp.size());
+
+		 BL_BENCH_REPORT_MPI_NAMED(build, "index:build_files", this->comm);
+	 }
+
+	 /// convenience function for building index from a list of files, via mpiio.
+	 template <template <typename> class SeqParser, template <typename,  template <typename> class> class SeqIterType>
+	 void build_mpiio(const std::vector<std::string> & filenames, MPI_Comm comm) {
+		 this->template build_files<::bliss::io::parallel::mpiio_file<SeqParser>, SeqParser, SeqIterType>(filenames, comm);
+	 }
+
+	 /// convenience function for building index from a list of files, via mmap.
+	 template <template <typename> class SeqParser, template <typename,  template <typename> class> class SeqIterType>
+	 void build_mmap(const std::vector<std::string> & filenames, MPI_Comm comm) {
+		 this->template build_files<::bliss::io::parallel::partitioned_file<::bliss::io::mmap_file, SeqParser>, SeqParser, SeqIterType>(filenames, comm);
+	 }
+
+	 /// convenience function for building index from a list of files, via posix.
+	 template <template <typename> class SeqParser, template <typename,  template <typename> class> class SeqIterType>
+	 void build_posix(const std::vector<std::string> & filenames, MPI_Comm comm) {
+		 this->template build_files<::bliss::io::parallel::partitioned_file<::bliss::io::posix_file, SeqParser>, SeqParser, SeqIterType>(filenames, comm);
+	 }
 
 
    typename MapType::const_iterator cbegin() const
@@ -410,6 +525,22 @@ using CountIndex = Index<MapType, KmerCountTupleParser<std::pair<typename MapTyp
 template <typename MapType>
 using CountIndex2 = Index<MapType, KmerParser<typename MapType::key_type> >;
 
+// canonical variants:  kmers are canonicalized during generation.  pair with Precanonicalized*MapParams so the map does not repeat the reverse complement.
+template <typename MapType>
+using CanonicalKmerIndex = Index<MapType, KmerParser<typename MapType::key_type, true> >;
+
+template <typename MapType>
+using CanonicalPositionIndex = Index<MapType, KmerPositionTupleParser<std::pair<typename MapType::key_type, typename MapType::mapped_type>, true > >;
+
+template <typename MapType>
+using CanonicalPositionQualityIndex = Index<MapType, KmerPositionQualityTupleParser<std::pair<typename MapType::key_type, typename MapType::mapped_type>,
+		bliss::index::Illumina18QualityScoreCodec, true > >;
+
+template <typename MapType>
+using CanonicalCountIndex = Index<MapType, KmerCountTupleParser<std::pair<typename MapType::key_type, typename MapType::mapped_type>, true > >;
+template <typename MapType>
+using CanonicalCountIndex2 = Index<MapType, KmerParser<typename MapType::key_type, true> >;
+
 // template aliases for hash to be used as distribution hash
 template <typename Key>
 using DistHashFarm = ::bliss::kmer::hash::farm<Key, true>;
@@ -465,6 +596,22 @@ using CanonicalHashMapParams = ::dsc::HashMapParams<
 		    ::std::equal_to
 		  >;
 
+/// for input that is already canonical (e.g. from Canonical*Index parsers).  query canonicalization is done by the Index.
+template <typename Key,
+	template <typename> class DistHash  = DistHashMurmur,
+	template <typename> class StoreHash = StoreHashMurmur
+>
+using PrecanonicalizedHashMapParams = ::dsc::HashMapParams<
+		Key,
+		::bliss::transform::identity,  // precanonalizer - input already canonical
+		 ::bliss::transform::identity,
+		  DistHash,
+		  ::std::equal_to,
+		   ::bliss::transform::identity,
+		    StoreHash,
+		    ::std::equal_to
+		  >;
+
 template <typename Key,
 	template <typename> class DistHash  = DistHashMurmur,
 	template <typename> class StoreHash = StoreHashMurmur
@@ -550,6 +697,18 @@ using CanonicalSortedMapParams = ::dsc::SortedMapParams<
 		    ::std::equal_to
 		  >;
 
+/// for input that is already canonical (e.g. from Canonical*Index parsers).  query canonicalization is done by the Index.
+template <typename Key,
+			template <typename> class Less = ::std::less
+>
+using PrecanonicalizedSortedMapParams = ::dsc::SortedMapParams<
+		Key,
+		::bliss::transform::identity,  // precanonalizer - input already canonical
+		 ::bliss::transform::identity,
+		    Less,
+		    ::std::equal_to
+		  >;
+
 template <typename Key,
 			template <typename> class Less = ::std::less
 >
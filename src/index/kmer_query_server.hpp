@@ -0,0 +1,447 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    kmer_query_server.hpp
+ * @ingroup index
+ * @brief   serve kmer queries against a resident distributed index to local clients over a unix domain socket.
+ * @details the index is built once and kept in memory by all ranks.  rank 0 listens on a unix socket,
+ *          accepts batched count/find requests from local client processes, and coalesces the requests
+ *          that arrive within a short window into a single collective count and/or find round.
+ *          results are split back out and returned to each client in the order of its queries.
+ *
+ *          wire protocol, native byte order since clients are on the same node:
+ *            request:  QueryHeader{magic, op, n}, then n raw kmers.
+ *            COUNT response: QueryHeader{magic, COUNT, n}, then n uint64_t counts.
+ *            FIND response:  QueryHeader{magic, FIND, m}, then n uint64_t counts, then m raw values,
+ *                            grouped by query in query order.
+ *            SHUTDOWN: header only, no response.  the server completes pending requests, then all ranks return.
+ *
+ *          find results are matched back to the queries by equality of the input-transformed kmer (e.g. canonical),
+ *          so maps whose storage transform reports a different key (bimolecule) are not supported.
+ *
+ *          ranks other than 0 wait in a broadcast between rounds.
+ */
+#ifndef KMER_QUERY_SERVER_HPP_
+#define KMER_QUERY_SERVER_HPP_
+
+#include "bliss-config.hpp"
+#include "mpi.h"
+
+#include <poll.h>
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <utility>
+
+#include <mxx/comm.hpp>
+
+#include "io/unix_domain_socket.h"
+#include "io/io_exception.hpp"
+#include "utils/logging.h"
+
+namespace bliss
+{
+namespace index
+{
+namespace kmer
+{
+
+  /// frame header for query server requests and responses.
+  struct QueryHeader {
+      static constexpr uint32_t MAGIC = 0x424b5153;  // "BKQS"
+
+      enum : uint32_t { COUNT = 1, FIND = 2, SHUTDOWN = 3 };
+
+      uint32_t magic;
+      uint32_t op;
+      uint64_t count;
+  };
+
+
+  /**
+   * @brief persistent query front end for a distributed kmer index.
+   * @details   serve() is collective.  construct on all ranks after the index is built.
+   * @tparam IndexType    kmer index, e.g. ::bliss::index::kmer::Index.  needs KmerType, ValueType, count, find, and transform_query.
+   */
+  template <typename IndexType>
+  class QueryServer {
+    public:
+      using KmerType = typename IndexType::KmerType;
+      using ValueType = typename IndexType::ValueType;
+
+    protected:
+
+      /// a request pending in the current coalescing window.
+      struct Request {
+          int fd;
+          uint32_t op;
+          std::vector<KmerType> queries;
+      };
+
+      /// control message broadcast by rank 0 at the start of each round.
+      enum { HAS_COUNT = 0, HAS_FIND = 1, STOP = 2 };
+
+      IndexType & index;
+      const ::mxx::comm & comm;
+
+      std::string path;
+
+      /// keys queued before a round is started regardless of the window.
+      size_t max_batch;
+      /// time a pending request waits for others to join its round.
+      int batch_ms;
+      /// largest number of kmers accepted in one request.
+      size_t max_request;
+
+      int listen_fd;
+      std::vector<int> clients;
+
+      std::vector<Request> pending;
+      size_t pending_keys;
+
+      size_t rounds;
+      size_t served;
+
+      void close_client(int const & fd) {
+        close(fd);
+        clients.erase(std::remove(clients.begin(), clients.end(), fd), clients.end());
+        // drop its pending requests.  nobody to answer.
+        for (auto & r : pending) {
+          if (r.fd == fd) r.fd = -1;
+        }
+      }
+
+      /// read one request from a client.  returns false if the client should be dropped.
+      bool read_request(int const & fd, bool & stop) {
+        QueryHeader h;
+        if (!::bliss::io::util::read_fully(fd, &h, sizeof(QueryHeader))) return false;
+        if (h.magic != QueryHeader::MAGIC) return false;
+
+        if (h.op == QueryHeader::SHUTDOWN) {
+          stop = true;
+          return true;
+        }
+        if ((h.op != QueryHeader::COUNT) && (h.op != QueryHeader::FIND)) return false;
+        if (h.count > max_request) return false;
+
+        Request r;
+        r.fd = fd;
+        r.op = h.op;
+        r.queries.resize(h.count);
+        if ((h.count > 0) && !::bliss::io::util::read_fully(fd, r.queries.data(), h.count * sizeof(KmerType)))
+          return false;
+
+        pending_keys += h.count;
+        pending.emplace_back(std::move(r));
+        return true;
+      }
+
+      /// gather the transformed, unique keys of all pending requests of one op.
+      std::vector<KmerType> collect(uint32_t const & op) {
+        std::vector<KmerType> keys;
+        for (auto & r : pending) {
+          if ((r.fd < 0) || (r.op != op)) continue;
+          index.transform_query(r.queries);
+          keys.insert(keys.end(), r.queries.begin(), r.queries.end());
+        }
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        return keys;
+      }
+
+      void send_or_close(int const & fd, std::vector<char> const & buffer) {
+        if (!::bliss::io::util::write_fully(fd, buffer.data(), buffer.size())) close_client(fd);
+      }
+
+      template <typename T>
+      static void append(std::vector<char> & buffer, T const * data, size_t const & count) {
+        const char * ptr = reinterpret_cast<const char *>(data);
+        buffer.insert(buffer.end(), ptr, ptr + count * sizeof(T));
+      }
+
+      /// answer the pending count requests.  results are sorted by kmer.
+      void reply_count(std::vector<std::pair<KmerType, size_t> > & results) {
+        std::sort(results.begin(), results.end(),
+                  [](std::pair<KmerType, size_t> const & x, std::pair<KmerType, size_t> const & y) {
+          return x.first < y.first;
+        });
+
+        std::vector<char> buffer;
+        std::vector<uint64_t> counts;
+        for (auto & r : pending) {
+          if ((r.fd < 0) || (r.op != QueryHeader::COUNT)) continue;
+
+          counts.resize(r.queries.size());
+          for (size_t i = 0; i < r.queries.size(); ++i) {
+            auto it = std::lower_bound(results.begin(), results.end(), r.queries[i],
+                                       [](std::pair<KmerType, size_t> const & x, KmerType const & y){
+              return x.first < y;
+            });
+            counts[i] = ((it != results.end()) && (it->first == r.queries[i])) ? it->second : 0;
+          }
+
+          QueryHeader h{QueryHeader::MAGIC, QueryHeader::COUNT, counts.size()};
+          buffer.clear();
+          append(buffer, &h, 1);
+          append(buffer, counts.data(), counts.size());
+          send_or_close(r.fd, buffer);
+          served += r.queries.size();
+        }
+      }
+
+      /// answer the pending find requests.  results are sorted by kmer.
+      void reply_find(std::vector<std::pair<KmerType, ValueType> > & results) {
+        std::stable_sort(results.begin(), results.end(),
+                  [](std::pair<KmerType, ValueType> const & x, std::pair<KmerType, ValueType> const & y) {
+          return x.first < y.first;
+        });
+
+        std::vector<char> buffer;
+        std::vector<uint64_t> counts;
+        std::vector<ValueType> values;
+        for (auto & r : pending) {
+          if ((r.fd < 0) || (r.op != QueryHeader::FIND)) continue;
+
+          counts.resize(r.queries.size());
+          values.clear();
+          for (size_t i = 0; i < r.queries.size(); ++i) {
+            auto it = std::lower_bound(results.begin(), results.end(), r.queries[i],
+                                       [](std::pair<KmerType, ValueType> const & x, KmerType const & y){
+              return x.first < y;
+            });
+            size_t c = 0;
+            for (; (it != results.end()) && (it->first == r.queries[i]); ++it, ++c) {
+              values.emplace_back(it->second);
+            }
+            counts[i] = c;
+          }
+
+          QueryHeader h{QueryHeader::MAGIC, QueryHeader::FIND, values.size()};
+          buffer.clear();
+          append(buffer, &h, 1);
+          append(buffer, counts.data(), counts.size());
+          append(buffer, values.data(), values.size());
+          send_or_close(r.fd, buffer);
+          served += r.queries.size();
+        }
+      }
+
+      /// one collective round.  rank 0 supplies the queries, the other ranks only participate.  returns false on stop.
+      bool round(bool const & stop) {
+        int control[3] = {0, 0, 0};
+        if (comm.rank() == 0) {
+          for (auto const & r : pending) {
+            if (r.fd < 0) continue;
+            if (r.op == QueryHeader::COUNT) control[HAS_COUNT] = 1;
+            if (r.op == QueryHeader::FIND) control[HAS_FIND] = 1;
+          }
+          control[STOP] = stop ? 1 : 0;
+        }
+        if (comm.size() > 1)
+          MPI_Bcast(control, 3, MPI_INT, 0, comm);
+
+        if (control[HAS_COUNT]) {
+          std::vector<KmerType> keys;
+          if (comm.rank() == 0) keys = collect(QueryHeader::COUNT);
+          auto results = index.count(keys);
+          if (comm.rank() == 0) reply_count(results);
+        }
+        if (control[HAS_FIND]) {
+          std::vector<KmerType> keys;
+          if (comm.rank() == 0) keys = collect(QueryHeader::FIND);
+          auto results = index.find(keys);
+          if (comm.rank() == 0) reply_find(results);
+        }
+
+        if (control[HAS_COUNT] || control[HAS_FIND]) ++rounds;
+        pending.clear();
+        pending_keys = 0;
+
+        return control[STOP] == 0;
+      }
+
+      /// rank 0: accept clients and requests until a round is due.
+      bool wait_for_round(bool & stop) {
+        using clock = std::chrono::steady_clock;
+        clock::time_point deadline;
+
+        while (true) {
+          int timeout = -1;
+          if (!pending.empty()) {
+            timeout = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - clock::now()).count();
+            if (timeout <= 0) return true;
+          }
+
+          std::vector<struct pollfd> fds(clients.size() + 1);
+          fds[0].fd = listen_fd;
+          fds[0].events = POLLIN;
+          for (size_t i = 0; i < clients.size(); ++i) {
+            fds[i + 1].fd = clients[i];
+            fds[i + 1].events = POLLIN;
+          }
+
+          int ready = poll(fds.data(), fds.size(), timeout);
+          if (ready < 0) {
+            if (errno == EINTR) continue;
+            throw ::bliss::io::IOException("ERROR: poll failed on query server socket");
+          }
+
+          for (size_t i = 1; i < fds.size(); ++i) {
+            if (fds[i].revents == 0) continue;
+
+            bool was_empty = pending.empty();
+            if (!read_request(fds[i].fd, stop)) close_client(fds[i].fd);
+            else if (was_empty && !pending.empty()) deadline = clock::now() + std::chrono::milliseconds(batch_ms);
+          }
+
+          if (fds[0].revents & POLLIN) {
+            int fd = accept(listen_fd, NULL, NULL);
+            if (fd >= 0) clients.push_back(fd);
+          }
+
+          if (stop || (pending_keys >= max_batch)) return true;
+        }
+      }
+
+    public:
+      /**
+       * @param _index        a built index.  must outlive the server.
+       * @param _comm         communicator the index was built with
+       * @param _path         file system path of the unix socket, created by rank 0
+       * @param _max_batch    number of queued kmers that triggers a round before the window closes
+       * @param _batch_ms     coalescing window in milliseconds
+       */
+      QueryServer(IndexType & _index, const ::mxx::comm & _comm, std::string const & _path,
+                  size_t const & _max_batch = (1UL << 20), int const & _batch_ms = 5) :
+        index(_index), comm(_comm), path(_path), max_batch(_max_batch), batch_ms(_batch_ms),
+        max_request(1UL << 28), listen_fd(-1), pending_keys(0), rounds(0), served(0) {
+
+        if (comm.rank() == 0) {
+          listen_fd = ::bliss::io::util::create_stream_listener(path);
+        }
+      }
+
+      virtual ~QueryServer() {
+        for (int fd : clients) close(fd);
+        if (listen_fd >= 0) {
+          close(listen_fd);
+          unlink(path.c_str());
+        }
+      }
+
+      /// serve until a client sends SHUTDOWN.  collective.
+      void serve() {
+        if (comm.rank() == 0) {
+          BL_INFOF("query server listening on %s\n", path.c_str());
+        }
+
+        bool stop = false;
+        bool running = true;
+        while (running) {
+          if (comm.rank() == 0) wait_for_round(stop);
+          running = round(stop);
+        }
+
+        if (comm.rank() == 0) {
+          BL_INFOF("query server stopped after %lu rounds, %lu queries\n", rounds, served);
+        }
+      }
+
+      size_t get_rounds() const {
+        return rounds;
+      }
+
+      size_t get_served() const {
+        return served;
+      }
+  };
+
+
+  /**
+   * @brief client side of the query server protocol.  synchronous, one request in flight.
+   * @tparam KmerType     kmer type of the served index
+   * @tparam ValueType    mapped type of the served index
+   */
+  template <typename KmerType, typename ValueType>
+  class QueryClient {
+    protected:
+      int fd;
+
+      void request(uint32_t const & op, std::vector<KmerType> const & queries) {
+        QueryHeader h{QueryHeader::MAGIC, op, queries.size()};
+        if (!::bliss::io::util::write_fully(fd, &h, sizeof(QueryHeader)) ||
+            !::bliss::io::util::write_fully(fd, queries.data(), queries.size() * sizeof(KmerType)))
+          throw ::bliss::io::IOException("ERROR: query server connection lost while sending");
+      }
+
+      uint64_t response(uint32_t const & op) {
+        QueryHeader h;
+        if (!::bliss::io::util::read_fully(fd, &h, sizeof(QueryHeader)))
+          throw ::bliss::io::IOException("ERROR: query server connection lost while receiving");
+        if ((h.magic != QueryHeader::MAGIC) || (h.op != op))
+          throw ::bliss::io::IOException("ERROR: malformed query server response");
+        return h.count;
+      }
+
+      template <typename T>
+      void receive(std::vector<T> & output, size_t const & count) {
+        output.resize(count);
+        if ((count > 0) && !::bliss::io::util::read_fully(fd, output.data(), count * sizeof(T)))
+          throw ::bliss::io::IOException("ERROR: query server connection lost while receiving");
+      }
+
+    public:
+      QueryClient(std::string const & path) : fd(::bliss::io::util::connect_stream(path)) {}
+
+      ~QueryClient() {
+        if (fd >= 0) close(fd);
+      }
+
+      QueryClient(QueryClient const & other) = delete;
+      QueryClient & operator=(QueryClient const & other) = delete;
+
+      /// occurrence count of each query, in query order.
+      std::vector<uint64_t> count(std::vector<KmerType> const & queries) {
+        request(QueryHeader::COUNT, queries);
+        std::vector<uint64_t> counts;
+        receive(counts, response(QueryHeader::COUNT));
+        return counts;
+      }
+
+      /// values of each query.  counts[i] values belong to queries[i], in query order.
+      void find(std::vector<KmerType> const & queries, std::vector<uint64_t> & counts, std::vector<ValueType> & values) {
+        request(QueryHeader::FIND, queries);
+        size_t total = response(QueryHeader::FIND);
+        receive(counts, queries.size());
+        receive(values, total);
+      }
+
+      /// ask the server to finish pending requests and stop.
+      void shutdown_server() {
+        QueryHeader h{QueryHeader::MAGIC, QueryHeader::SHUTDOWN, 0};
+        if (!::bliss::io::util::write_fully(fd, &h, sizeof(QueryHeader)))
+          throw ::bliss::io::IOException("ERROR: query server connection lost while sending");
+      }
+  };
+
+} // namespace kmer
+} // namespace index
+} // namespace bliss
+
+#endif /* KMER_QUERY_SERVER_HPP_ */
@@ -28,6 +28,8 @@
 #define BLISS_INDEX_QUALITY_SCORE_ITERATOR_HPP
 
 #include <vector>
+#include <cmath>
+#include <iterator>
 
 #include "index/quality_scores.hpp"
 #include "iterators/sliding_window_iterator.hpp"
@@ -173,6 +175,103 @@ public:
   }
 };
 
+
+/**
+ * @brief Computes the quality scores of all k-mers in a read in one call.
+ *
+ * @details
+ *
+ * Produces the same values as `QualityScoreSlidingWindow`, but for a whole
+ * read at a time, as a few passes over flat arrays.  Each pass is free of branches
+ * and loop carried dependencies except the prefix sum, so the compiler can vectorize them:
+ *
+ *   1. decode: look up log2(p_correct) for each quality char in `Encoder::DecodeLUT`.
+ *      bases with zero probability of being correct contribute 0 to the sum and 1 to the incorrect count.
+ *   2. prefix sum of the log probabilities and of the incorrect counts.
+ *   3. window: kmer j's log probability is `S[j+k] - S[j]`; its score is 0 if `B[j+k] - B[j] > 0`.
+ *
+ * The prefix sums are kept in double even for a float `Encoder`, so that
+ * differences of large sums near the end of long reads stay accurate.
+ *
+ * The input has to be contiguous quality characters with EOL already removed.
+ * Scratch buffers are kept between calls, so reuse one instance per thread.
+ *
+ * @tparam KMER_SIZE   k
+ * @tparam Encoder     quality score codec, as in `QualityScoreSlidingWindow`.
+ */
+template <unsigned int KMER_SIZE,
+          typename Encoder = bliss::index::Illumina18QualityScoreCodec<double> >
+class QualityScoreBlockKernel
+{
+  public:
+    /// type of the output kmer scores, same as QualityScoreSlidingWindow.
+    typedef typename Encoder::value_type QualityType;
+
+  protected:
+    /// prefix sums of the log2 probabilities, length n + 1
+    std::vector<double> log_sums;
+    /// prefix counts of incorrect bases, length n + 1
+    std::vector<unsigned int> bad_counts;
+
+  public:
+
+    /**
+     * @brief compute the scores of all kmers in the quality string [first, last).
+     * @param first   pointer to first quality char
+     * @param last    pointer to one past last quality char
+     * @param out     output.  resized to the number of kmers, `max(0, n - k + 1)`.
+     * @return        number of kmers.
+     */
+    size_t operator()(const unsigned char* first, const unsigned char* last, std::vector<QualityType> & out) {
+      size_t n = std::distance(first, last);
+      if (n < KMER_SIZE) {
+        out.clear();
+        return 0;
+      }
+      size_t nkmers = n - KMER_SIZE + 1;
+
+      log_sums.resize(n + 1);
+      bad_counts.resize(n + 1);
+      out.resize(nkmers);
+
+      double * S = log_sums.data();
+      unsigned int * B = bad_counts.data();
+      QualityType * O = out.data();
+
+      constexpr QualityType lo = Encoder::DecodeLUT[0];
+      constexpr QualityType hi = Encoder::DecodeLUT[95];
+
+      // decode into the shifted slots of the prefix arrays
+      S[0] = 0.0;
+      B[0] = 0;
+      for (size_t i = 0; i < n; ++i) {
+        QualityType v = Encoder::decode(first[i]);
+        bool good = (v > lo) && (v < hi);
+        S[i + 1] = good ? static_cast<double>(v) : 0.0;
+        B[i + 1] = good ? 0 : 1;
+      }
+
+      // inclusive scan.
+      for (size_t i = 1; i <= n; ++i) {
+        S[i] += S[i - 1];
+        B[i] += B[i - 1];
+      }
+
+      // windows
+      for (size_t j = 0; j < nkmers; ++j) {
+        QualityType p = static_cast<QualityType>(std::exp2(S[j + KMER_SIZE] - S[j]));
+        O[j] = (B[j + KMER_SIZE] == B[j]) ? p : static_cast<QualityType>(0.0);
+      }
+
+      return nkmers;
+    }
+
+    /// overload for char data
+    size_t operator()(const char* first, const char* last, std::vector<QualityType> & out) {
+      return this->operator()(reinterpret_cast<const unsigned char*>(first), reinterpret_cast<const unsigned char*>(last), out);
+    }
+};
+
 // /**
 //  * compute kmer quality based on phred quality score.
 //  *
@@ -33,6 +33,7 @@
 #include <array>
 #include <limits>
 #include <algorithm>
+#include <type_traits>
 
 #include "utils/constexpr_array.hpp"
 
@@ -547,6 +548,88 @@ using Illumina15QualityScoreCodec = QualityScoreCodec<OutT, 64, 126, 3>;  // spe
 
 
 
+/**
+ * @class QualityPayloadCodec, converts a kmer's probability of being correct, [0, 1], to the type stored and sent with the kmer.
+ * @details  floating point payloads store the probability directly.
+ *
+ *  unsigned integral payloads (uint8_t, uint16_t) store the probability in fixed point, as round(p * max), saturating at 0 and max.
+ *  the resolution is 1/255 for 8 bit and 1/65535 for 16 bit.  this is coarser than the decoded phred score
+ *  but adequate for thresholding kmers, and it shrinks the quality field in each tuple 4 to 8 fold.
+ *
+ *  encode() is used as the transform functor by the kmer parsers, decode() by consumers of the stored payload.
+ *
+ * @tparam PayloadT   stored type: float, double, or an unsigned integral type.
+ * @tparam ScoreT     floating point type of the probability being encoded.
+ */
+template <typename PayloadT, typename ScoreT = double, typename Enable = void>
+struct QualityPayloadCodec;
+
+/// floating point payload: identity.
+template <typename PayloadT, typename ScoreT>
+struct QualityPayloadCodec<PayloadT, ScoreT, typename std::enable_if<std::is_floating_point<PayloadT>::value>::type>
+{
+    static_assert(std::is_floating_point<ScoreT>::value, "Quality score needs to be floating point type");
+
+    /// type of the stored payload
+    typedef PayloadT value_type;
+    /// smallest probability difference the payload distinguishes.
+    static constexpr ScoreT resolution = std::numeric_limits<PayloadT>::epsilon();
+
+    inline static constexpr PayloadT encode(const ScoreT p) {
+      return static_cast<PayloadT>(p);
+    }
+    inline static constexpr ScoreT decode(const PayloadT q) {
+      return static_cast<ScoreT>(q);
+    }
+
+    /// functor form, for use with transform_iterator.
+    inline PayloadT operator()(const ScoreT p) const {
+      return encode(p);
+    }
+};
+
+/// unsigned integral payload: fixed point probability.
+template <typename PayloadT, typename ScoreT>
+struct QualityPayloadCodec<PayloadT, ScoreT, typename std::enable_if<std::is_integral<PayloadT>::value>::type>
+{
+    static_assert(std::is_unsigned<PayloadT>::value, "Fixed point quality payload needs to be unsigned");
+    static_assert(sizeof(PayloadT) < sizeof(ScoreT), "Fixed point quality payload should be smaller than the score type");
+    static_assert(std::is_floating_point<ScoreT>::value, "Quality score needs to be floating point type");
+
+    /// type of the stored payload
+    typedef PayloadT value_type;
+    /// fixed point value of probability 1.0
+    static constexpr ScoreT scale = static_cast<ScoreT>(std::numeric_limits<PayloadT>::max());
+    /// smallest probability difference the payload distinguishes.
+    static constexpr ScoreT resolution = static_cast<ScoreT>(1.0) / scale;
+
+    /// probability to fixed point.  out of range (and NaN) values saturate to 0 or max.
+    inline static PayloadT encode(const ScoreT p) {
+      return (p > static_cast<ScoreT>(0.0)) ?
+          ((p < static_cast<ScoreT>(1.0)) ?
+              static_cast<PayloadT>(p * scale + static_cast<ScoreT>(0.5)) :
+              std::numeric_limits<PayloadT>::max()) :
+          static_cast<PayloadT>(0);
+    }
+    inline static constexpr ScoreT decode(const PayloadT q) {
+      return static_cast<ScoreT>(q) / scale;
+    }
+
+    /// functor form, for use with transform_iterator.
+    inline PayloadT operator()(const ScoreT p) const {
+      return encode(p);
+    }
+};
+
+template <typename PayloadT, typename ScoreT>
+constexpr ScoreT QualityPayloadCodec<PayloadT, ScoreT, typename std::enable_if<std::is_floating_point<PayloadT>::value>::type>::resolution;
+template <typename PayloadT, typename ScoreT>
+constexpr ScoreT QualityPayloadCodec<PayloadT, ScoreT, typename std::enable_if<std::is_integral<PayloadT>::value>::type>::scale;
+template <typename PayloadT, typename ScoreT>
+constexpr ScoreT QualityPayloadCodec<PayloadT, ScoreT, typename std::enable_if<std::is_integral<PayloadT>::value>::type>::resolution;
+
+
+
 } // namespace index
 } // namespace bliss
 
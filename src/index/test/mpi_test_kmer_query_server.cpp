@@ -0,0 +1,186 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * mpi_test_kmer_query_server.cpp
+ *
+ * query server should answer socket clients the same as collective count and find on the index.
+ */
+
+// include google test
+#include <gtest/gtest.h>
+#include "bliss-config.hpp"
+
+#if defined(USE_MPI)
+#include "mxx/env.hpp"
+#include "mxx/comm.hpp"
+
+#include <cstdint>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <utility>
+#include <thread>
+#include <sstream>
+#include <unistd.h>
+
+#include "common/kmer.hpp"
+#include "common/alphabets.hpp"
+#include "index/kmer_index.hpp"
+#include "index/kmer_query_server.hpp"
+
+
+using KmerType = ::bliss::common::Kmer<21, ::bliss::common::DNA, uint64_t>;
+
+template <typename Key>
+using MapParams = ::bliss::index::kmer::SingleStrandHashMapParams<Key, ::bliss::index::kmer::DistHashFarm, ::bliss::index::kmer::StoreHashFarm>;
+
+using MapType = ::dsc::unordered_multimap<KmerType, size_t, MapParams>;
+using IndexType = ::bliss::index::kmer::KmerIndex<MapType>;
+using ClientType = ::bliss::index::kmer::QueryClient<KmerType, size_t>;
+
+
+class KmerQueryServerTest : public ::testing::Test {
+  protected:
+    ::mxx::comm comm;
+
+    /// socket path unique to this job, known to all ranks.
+    std::string socket_path() {
+      int pid = getpid();
+      MPI_Bcast(&pid, 1, MPI_INT, 0, comm);
+      std::stringstream ss;
+      ss << "/tmp/bliss_query_server_test." << pid;
+      return ss.str();
+    }
+
+    /// random kmers from a small key space, so keys repeat and queries hit.
+    void build(IndexType & idx) {
+      std::default_random_engine generator(comm.rank() + 1);
+      std::uniform_int_distribution<uint64_t> distribution(0, 1000);
+
+      std::vector<std::pair<KmerType, size_t> > entries;
+      for (size_t i = 0; i < 5000; ++i) {
+        KmerType k;
+        k.getDataRef()[0] = distribution(generator);
+        entries.emplace_back(k, comm.rank() * 5000 + i);
+      }
+      idx.insert(entries);
+    }
+
+    static std::vector<KmerType> make_queries(int const & client) {
+      std::vector<KmerType> queries;
+      for (uint64_t i = client; i < 1200; i += 7) {
+        KmerType k;
+        k.getDataRef()[0] = i;
+        queries.push_back(k);
+      }
+      return queries;
+    }
+};
+
+
+TEST_F(KmerQueryServerTest, count_and_find)
+{
+  IndexType idx(comm);
+  build(idx);
+
+  std::string path = socket_path();
+  const int nclients = 4;
+
+  // gold, from collective queries issued by rank 0 only.
+  std::vector<std::vector<size_t> > gold_counts(nclients);
+  for (int c = 0; c < nclients; ++c) {
+    std::vector<KmerType> q;
+    if (comm.rank() == 0) q = make_queries(c);
+    auto counts = idx.count(q);
+    std::sort(counts.begin(), counts.end(), [](std::pair<KmerType, size_t> const & x, std::pair<KmerType, size_t> const & y){
+      return x.first < y.first;
+    });
+    if (comm.rank() == 0) {
+      for (auto const & k : make_queries(c)) {
+        auto it = std::lower_bound(counts.begin(), counts.end(), k, [](std::pair<KmerType, size_t> const & x, KmerType const & y){
+          return x.first < y;
+        });
+        gold_counts[c].push_back(((it != counts.end()) && (it->first == k)) ? it->second : 0);
+      }
+    }
+  }
+
+  ::bliss::index::kmer::QueryServer<IndexType> server(idx, comm, path, 1UL << 20, 20);
+
+  std::vector<int> errors(nclients, 0);
+  std::thread clients;
+  if (comm.rank() == 0) {
+    clients = std::thread([&](){
+      std::vector<std::thread> ts;
+      for (int c = 0; c < nclients; ++c) {
+        ts.emplace_back([&, c](){
+          ClientType client(path);
+          std::vector<KmerType> q = make_queries(c);
+
+          std::vector<uint64_t> counts = client.count(q);
+          if (counts.size() != q.size()) { ++errors[c]; return; }
+          for (size_t i = 0; i < q.size(); ++i) {
+            if (counts[i] != gold_counts[c][i]) ++errors[c];
+          }
+
+          std::vector<uint64_t> found_counts;
+          std::vector<size_t> values;
+          client.find(q, found_counts, values);
+          if (found_counts != counts) ++errors[c];
+          size_t total = 0;
+          for (auto x : found_counts) total += x;
+          if (total != values.size()) ++errors[c];
+        });
+      }
+      for (auto & t : ts) t.join();
+
+      ClientType(path).shutdown_server();
+    });
+  }
+
+  server.serve();
+
+  if (comm.rank() == 0) {
+    clients.join();
+    for (int c = 0; c < nclients; ++c) {
+      EXPECT_EQ(0, errors[c]) << "client " << c;
+    }
+    size_t total = 0;
+    for (int c = 0; c < nclients; ++c) total += 2 * make_queries(c).size();
+    EXPECT_EQ(total, server.get_served());
+  }
+}
+
+#endif
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+#if defined(USE_MPI)
+  ::mxx::env e(argc, argv);
+  ::mxx::comm comm;
+
+  result = RUN_ALL_TESTS();
+
+  comm.barrier();
+#endif
+
+  return result;
+}
@@ -33,6 +33,9 @@
 #include <vector>
 #include <algorithm>
 #include <cassert>
+#include <cstdlib>
+#include <cstdint>
+#include <limits>
 #include "utils/logging.h"
 
 //// Usable AlmostEqual function
@@ -227,6 +230,14 @@ void codec_decode(const std::vector<unsigned char> & data, // quality score valu
 }
 
 
+// templated test function
+template<typename CODEC, unsigned int K>
+void block_decode(const std::vector<unsigned char> & data, // quality score value
+                           std::vector<typename CODEC::value_type>& output) {
+
+  bliss::index::QualityScoreBlockKernel<K, CODEC> kernel;
+  kernel(data.data(), data.data() + data.size(), output);
+}
 
 
 template<typename OT, unsigned char MinInput, unsigned char MaxInput, char MinScore, unsigned int K>
@@ -337,6 +348,23 @@ void testQualityIterator(const std::string & strdata) {
   EXPECT_TRUE(same);
 
 
+  std::vector<OT> blockDecoded;
+  block_decode< Encoder, K >(gold, blockDecoded);
+  same = compare_vectors<OT>(blockDecoded, goldDecoded);
+
+  if (!same) {
+    BL_ERROR( "block decode: result not same" << std::endl );
+
+    BL_ERROR( "GOLD decoded: size: " << goldDecoded.size() );
+    std::copy(goldDecoded.begin() , goldDecoded.end(), std::ostream_iterator<OT>(std::cout, ","));
+    std::cout << std::endl;
+    BL_ERROR( "block decoded: size: " << blockDecoded.size());
+    std::copy(blockDecoded.begin() , blockDecoded.end(), std::ostream_iterator<OT>(std::cout, ","));
+    std::cout << std::endl;
+  }
+
+  EXPECT_TRUE(same);
+
 }
 
 
@@ -405,6 +433,67 @@ TEST(QualityScoreGenerationIteratorTest, TestIllunima18QualityScoreFloat)
 }
 
 
+/**
+ * block kernel on a long read with typical quality values, against the sliding window iterator.
+ */
+TEST(QualityScoreGenerationIteratorTest, TestBlockKernelLongRead)
+{
+  using Encoder = bliss::index::Illumina18QualityScoreCodec<double>;
+
+  std::vector<unsigned char> data(1000);
+  srand(23);
+  for (size_t i = 0; i < data.size(); ++i) {
+    // mostly 2 to 41, with occasional 0.
+    data[i] = (rand() % 50 == 0) ? '!' : ('#' + rand() % 40);
+  }
+
+  std::vector<double> iterDecoded, blockDecoded;
+  iter_decode<Encoder, 31>(data, iterDecoded);
+  block_decode<Encoder, 31>(data, blockDecoded);
+  // both accumulate rounding errors over the read, differently.
+  ASSERT_EQ(iterDecoded.size(), blockDecoded.size());
+  for (size_t i = 0; i < iterDecoded.size(); ++i) {
+    EXPECT_NEAR(iterDecoded[i], blockDecoded[i], 1.0e-12) << " kmer " << i;
+  }
+
+  // too short for a kmer
+  data.resize(30);
+  block_decode<Encoder, 31>(data, blockDecoded);
+  EXPECT_EQ(0UL, blockDecoded.size());
+}
+
+
+/**
+ * fixed point payload round trip.
+ */
+template <typename PayloadT>
+void testQualityPayload() {
+  using Codec = bliss::index::QualityPayloadCodec<PayloadT, double>;
+
+  EXPECT_EQ(0, Codec::encode(0.0));
+  EXPECT_EQ(0, Codec::encode(-1.0));
+  EXPECT_EQ(0, Codec::encode(std::numeric_limits<double>::quiet_NaN()));
+  EXPECT_EQ(std::numeric_limits<PayloadT>::max(), Codec::encode(1.0));
+  EXPECT_EQ(std::numeric_limits<PayloadT>::max(), Codec::encode(2.0));
+  EXPECT_EQ(1.0, Codec::decode(std::numeric_limits<PayloadT>::max()));
+
+  for (int i = 0; i <= 1000; ++i) {
+    double p = static_cast<double>(i) / 1000.0;
+    EXPECT_NEAR(p, Codec::decode(Codec::encode(p)), 0.5 * Codec::resolution + 1.0e-12);
+  }
+}
+
+TEST(QualityScoreGenerationIteratorTest, TestFixedPointPayload)
+{
+  testQualityPayload<uint8_t>();
+  testQualityPayload<uint16_t>();
+
+  using Codec = bliss::index::QualityPayloadCodec<float, double>;
+  EXPECT_EQ(0.25f, Codec::encode(0.25));
+  EXPECT_EQ(0.25, Codec::decode(0.25f));
+}
+
+
 //
 //
 ///**
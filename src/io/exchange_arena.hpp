@@ -0,0 +1,165 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    exchange_arena.hpp
+ * @ingroup
+ * @author  agent <agent@local>
+ * @brief   reusable buffers for the transient vectors of distribute / exchange.
+ * @details every distributed insert/find/count builds an i2o mapping, a bucketed send buffer and a local result vector of
+ *          the size of the query, then frees them.  repeated query rounds therefore fault in and release the same GBs each
+ *          time.  an exchange_arena keeps those vectors between calls:  a buffer is identified by its element type and a
+ *          slot, and keeps the largest capacity it has seen (high water mark) until trim() is called.
+ *
+ *          two ways to use a buffer:
+ *            get<T>(slot)             the retained vector itself, emptied.  valid until the next get of the same slot.
+ *            acquire(slot, v) / release(slot, v)
+ *                                     swap the retained storage into a caller's vector (e.g. one that an iterator is bound to),
+ *                                     and hand the larger storage back afterwards.
+ *
+ *          the distributed maps own one arena each (dsc::map_base::arena), so steady state query rounds only allocate the
+ *          vectors that are returned to the caller.  an arena is not thread safe, same as the maps.
+ *
+ *          the retained bytes are charged to the plog::AllocTracker categories "results" (slot RESULTS) and "buffer" (the
+ *          other slots), updated by each call to the arena and by account().
+ */
+#ifndef IMXX_EXCHANGE_ARENA_HPP
+#define IMXX_EXCHANGE_ARENA_HPP
+
+#include <vector>
+#include <memory>       // unique_ptr
+#include <typeindex>
+#include <typeinfo>
+#include <algorithm>    // find_if
+#include <cstddef>
+
+#include "utils/tracking_allocator.hpp"
+
+namespace imxx
+{
+
+  class exchange_arena {
+    public:
+      /// slots for the transient vectors of one distributed operation.
+      enum slot : int { QUERY = 0, I2O, RESULTS, BUCKET_ASSIGN, TEMP };
+
+    protected:
+      struct holder_base {
+          virtual ~holder_base() {}
+          virtual size_t bytes() const = 0;
+          virtual void trim() = 0;
+      };
+
+      template <typename T>
+      struct holder : public holder_base {
+          std::vector<T> v;
+          virtual size_t bytes() const { return v.capacity() * sizeof(T); }
+          virtual void trim() { std::vector<T>().swap(v); }
+      };
+
+      struct entry {
+          std::type_index type;
+          int slot;
+          std::unique_ptr<holder_base> buf;
+      };
+
+      std::vector<entry> entries;
+
+      ::plog::AllocTracker::charge buffer_charge{::plog::alloc_tag::buffer::name()};
+      ::plog::AllocTracker::charge results_charge{::plog::alloc_tag::results::name()};
+
+      /// lookup, or create, the retained vector for (T, slot).  linear search:  there are only a handful.
+      template <typename T>
+      std::vector<T> & buffer(int const & s) {
+        std::type_index t(typeid(T));
+        auto it = std::find_if(entries.begin(), entries.end(),
+                               [&t, &s](entry const & e){ return (e.slot == s) && (e.type == t); });
+        if (it == entries.end()) {
+          entries.emplace_back(entry{t, s, std::unique_ptr<holder_base>(new holder<T>())});
+          it = entries.end() - 1;
+        }
+        return static_cast<holder<T> *>(it->buf.get())->v;
+      }
+
+    public:
+      exchange_arena() = default;
+      /// retained buffers are not copied.
+      exchange_arena(exchange_arena const &) {}
+      exchange_arena & operator=(exchange_arena const &) { return *this; }
+      exchange_arena(exchange_arena &&) = default;
+      exchange_arena & operator=(exchange_arena &&) = default;
+
+      /// the retained vector of (T, slot), emptied.  its capacity is kept.
+      template <typename T>
+      std::vector<T> & get(int const & s) {
+        std::vector<T> & v = buffer<T>(s);
+        v.clear();
+        account();
+        return v;
+      }
+
+      /// swap the retained storage of (T, slot) into v if it is larger than v's own.  v is emptied.
+      template <typename T>
+      void acquire(int const & s, std::vector<T> & v) {
+        std::vector<T> & b = buffer<T>(s);
+        b.clear();
+        v.clear();
+        if (b.capacity() > v.capacity()) v.swap(b);
+        account();
+      }
+
+      /// retain v's storage for (T, slot), if larger than what is retained.  v is left empty.
+      template <typename T>
+      void release(int const & s, std::vector<T> & v) {
+        std::vector<T> & b = buffer<T>(s);
+        v.clear();
+        if (v.capacity() > b.capacity()) b.swap(v);
+        std::vector<T>().swap(v);
+        account();
+      }
+
+      /// bytes held by the retained vectors.
+      size_t retained_bytes() const {
+        size_t total = 0;
+        for (auto const & e : entries) total += e.buf->bytes();
+        return total;
+      }
+
+      /// release retained vectors, largest first, until at most keep_bytes remain.  trim() releases all.
+      void trim(size_t const & keep_bytes = 0) {
+        size_t total = retained_bytes();
+        while (total > keep_bytes) {
+          auto it = std::max_element(entries.begin(), entries.end(),
+                                     [](entry const & x, entry const & y){ return x.buf->bytes() < y.buf->bytes(); });
+          if (it == entries.end() || it->buf->bytes() == 0) break;
+          total -= it->buf->bytes();
+          it->buf->trim();
+        }
+        account();
+      }
+
+      /// charge the retained bytes to the tracker, e.g. after a vector from get() has grown.
+      void account() {
+        size_t results = 0, others = 0;
+        for (auto const & e : entries) (e.slot == RESULTS ? results : others) += e.buf->bytes();
+        results_charge.set(results);
+        buffer_charge.set(others);
+      }
+  };
+
+} // namespace imxx
+
+#endif // IMXX_EXCHANGE_ARENA_HPP
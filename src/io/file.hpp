@@ -56,6 +56,9 @@
 // mxx
 #include <mxx/collective.hpp>
 #include <mxx/shift.hpp>
+#if defined(USE_MPI)
+#include <mxx/benchmark.hpp>  // hybrid_comm
+#endif
 
 #include <io/io_exception.hpp>
 
@@ -125,6 +128,7 @@
 //    1 proc per node open file.  then
 //        1. share file descriptor, or
 //        2. mmap cache/fread on 1 and share (require contiguous, and idle C-1 cores, communication at worst shared mem at best)
+//            available as parallel::node_aggregated_file, via MPI-3 shared memory window.
 //        3. don't open file multiple times.
 //        4. serialize/space out file open over time.
 //            delay,
@@ -138,6 +142,8 @@
 //
 
 // DONE:  open/lseek/read instead of fopen/fseek/fread
+// DONE:  overlap reading with parsing for chunked builds.  see io/file_prefetcher.hpp.
+//          access pattern hints exposed as access_hint, via posix_fadvise for fds and madvise for mappings.
 // DONE:  refactored mmap_file with a mapped_data object
 // DONE:  remove 1 extra mmap from FASTQParser partitioned_file
 // TODO:  move file open/close to closer to actual reading
@@ -221,6 +227,97 @@ struct file_data {
 };
 
 
+/**
+ * @brief file data that resides in memory owned by someone else, e.g. a node shared memory window.
+ * @details  same ranges and accessors as file_data, so it can be used as the BlockType for parsing,
+ *           but there is no container.  data points to the start of in_mem_range_bytes.
+ * @note     valid only for the lifetime of the owning object.
+ */
+struct shared_file_data {
+  using iterator = const unsigned char *;
+  using const_iterator = const unsigned char *;
+
+  // type of ranges
+  using range_type = ::bliss::partition::range<size_t>;
+
+  // range from which the data came
+  range_type parent_range_bytes;
+
+  // range loaded in memory.  INCLUDES OVERLAP
+  range_type in_mem_range_bytes;
+
+  // valid range for this.  EXCLUDES OVERLAP
+  range_type valid_range_bytes;
+
+  // start of the in memory range.  not owned.
+  const unsigned char * data;
+
+  shared_file_data() : data(nullptr) {};
+
+  /// beginning of the valid range
+  const_iterator begin() const {
+    return data + valid_range_bytes.start - in_mem_range_bytes.start;
+  }
+  /// end of valid range
+  const_iterator end() const {
+    return data + valid_range_bytes.end - in_mem_range_bytes.start;
+  }
+  /// beginning of the valid range
+  const_iterator cbegin() const {
+    return begin();
+  }
+  /// end of valid range
+  const_iterator cend() const {
+    return end();
+  }
+
+  /// start of inmem range
+  const_iterator in_mem_cbegin() const {
+    return data;
+  }
+  /// end of in mem range
+  const_iterator in_mem_cend() const {
+    return data + in_mem_range_bytes.size();
+  }
+
+  range_type getRange() const {
+    return valid_range_bytes;
+  }
+};
+
+
+
+/// access pattern hints.  translated to posix_fadvise for file descriptors and to madvise for mapped regions.
+enum class access_hint : int {
+  normal = 0,
+  sequential = 1,
+  random = 2,
+  willneed = 3,
+  dontneed = 4
+};
+
+/// convert access hint to posix_fadvise advice
+inline int to_fadvise(access_hint const & hint) {
+  switch (hint) {
+    case access_hint::sequential: return POSIX_FADV_SEQUENTIAL;
+    case access_hint::random: return POSIX_FADV_RANDOM;
+    case access_hint::willneed: return POSIX_FADV_WILLNEED;
+    case access_hint::dontneed: return POSIX_FADV_DONTNEED;
+    default: return POSIX_FADV_NORMAL;
+  }
+}
+
+/// convert access hint to madvise advice
+inline int to_madvise(access_hint const & hint) {
+  switch (hint) {
+    case access_hint::sequential: return MADV_SEQUENTIAL;
+    case access_hint::random: return MADV_RANDOM;
+    case access_hint::willneed: return MADV_WILLNEED;
+    case access_hint::dontneed: return MADV_DONTNEED;
+    default: return MADV_NORMAL;
+  }
+}
+
 
 /**
  * mmapped data.  wrapper for moving it around.
@@ -359,6 +456,32 @@ class mapped_data {
       return page_size;
     }
 
+    /**
+     * @brief give the kernel an access pattern hint for part of the mapped region.
+     * @param target   range in file coordinates.  clipped to the mapped range and aligned to page.
+     */
+    void advise(range_type const & target, access_hint const & hint) {
+      range_type r = range_type::intersect(target, range_bytes);
+      if ((data == nullptr) || (r.size() == 0)) return;
+
+      r.start = range_type::align_to_page(r, page_size);
+      if (r.start < range_bytes.start) r.start = range_bytes.start;
+
+      int madv_result = madvise(data + (r.start - range_bytes.start), r.size(), to_madvise(hint));
+      if ( madv_result == -1 ) {
+        std::stringstream ss;
+        int myerr = errno;
+        ss << "ERROR in madvise: " << myerr << ": " << strerror(myerr);
+
+        throw ::bliss::utils::make_exception<bliss::io::IOException>(ss.str());
+      }
+    }
+
+    /// give the kernel an access pattern hint for the whole mapped region.
+    void advise(access_hint const & hint) {
+      this->advise(range_bytes, hint);
+    }
+
 
 };
 
@@ -542,6 +665,24 @@ public:
 
 	/// get file name
 	::std::string const & get_filename() const { return filename; };
+
+	/**
+	 * @brief  give the kernel an access pattern hint for a range of the file, via posix_fadvise.
+	 * @note   willneed starts asynchronous readahead into the page cache, so a later read_range on the range does not block on disk.
+	 */
+	void advise(range_type const & range_bytes, access_hint const & hint) {
+	  if (this->fd == -1) return;
+
+	  range_type target = range_type::intersect(this->file_range_bytes, range_bytes);
+	  if (target.size() == 0) return;
+
+	  int res = posix_fadvise64(this->fd, target.start, target.size(), to_fadvise(hint));
+	  if (res != 0) {
+	    std::stringstream ss;
+	    ss << "ERROR in posix_fadvise: file " << this->filename << " error " << res << ": " << strerror(res);
+	    throw ::bliss::utils::make_exception<::bliss::io::IOException>(ss.str());
+	  }
+	}
 };
 
 
@@ -846,8 +987,8 @@ public:
 
     //std::cout << "curr pos in fd is " << lseek64(this->fd, 0, SEEK_CUR) << ::std::endl;
 
-    // resize output's capacity
-    if (output.capacity() < target.size()) output.resize(target.size());
+    // resize output.  the output vector may be reused with a different size.
+    output.resize(target.size());
 
     size_t s = 0;
     long count;
@@ -864,6 +1005,7 @@ public:
 
           throw ::bliss::utils::make_exception<bliss::io::IOException>(ss.str());
         }
+        if (count == 0) break;  // file truncated.  reported below.
 
     	s += count;
     }
@@ -2187,6 +2329,347 @@ public:
 };
 
 
+
+/**
+ * @brief  node aggregated file io.  1 process per node reads, all processes on the node parse from shared memory.
+ * @details  the local leader (local rank 0 of mxx::hybrid_comm) opens the file and streams the node's contiguous extent
+ *           into an MPI-3 shared memory window with large preads.  the other processes on the node do not touch the
+ *           file system at all - they query the window and parse their partitions in place, without copying.
+ *           the file is block partitioned first by node, then by local rank.  the processes are renumbered in
+ *           that order (get_comm()), so parsers that communicate with neighbors see partitions in file order.
+ *
+ *           the shared memory is released when this object is destroyed, so the shared_file_data from read_file
+ *           is valid only for the lifetime of this object.  construction and destruction are collective.
+ */
+class node_shared_base_file : public ::bliss::io::parallel::base_file {
+protected:
+  using BASE = ::bliss::io::parallel::base_file;
+
+  using range_type = typename BASE::range_type;
+
+  /// processes on the same node
+  ::mxx::comm local;
+
+  /// all processes, renumbered so that processes on the same node are contiguous
+  ::mxx::comm ordered;
+
+  /// number of nodes, and node id
+  int node_count;
+  int node_id;
+
+  /// overlap amount
+  const size_t overlap;
+
+  /// shared memory window for the node.
+  MPI_Win win;
+
+  /// start of node's in memory range, in the shared window
+  unsigned char * window;
+
+  /// range of the file that is in the window
+  range_type node_range_bytes;
+
+  /// block partition a range, and get the i-th part.
+  static range_type get_block(range_type const & r, size_t const & parts, size_t const & id) {
+    if (parts == 1) return r;
+
+    ::bliss::partition::BlockPartitioner<range_type> partitioner;
+    partitioner.configure(r, parts);
+    return partitioner.getNext(id);
+  }
+
+  /// this node's portion of the file, before alignment or overlap
+  range_type get_node_block() const {
+    return get_block(this->file_range_bytes, node_count, node_id);
+  }
+
+  /// this process's portion of a node's range, before alignment or overlap
+  range_type get_local_block(range_type const & node_block) const {
+    return get_block(node_block, local.size(), local.rank());
+  }
+
+  /// read a range of the file into memory with pread.  called only by the node leader
+  void read_extent(unsigned char * out, range_type const & target) {
+    size_t s = 0;
+    long count;
+
+    for (; s < target.size(); ) {
+      //pread64 can only read 2GB at a time
+      count = pread64(this->fd, out + s, std::min(1UL << 30, target.size() - s),
+                      static_cast<__off64_t>(target.start + s));
+
+      if (count < 0) {
+        std::stringstream ss;
+        int myerr = errno;
+        ss << "ERROR: pread64: file " << this->filename << " error " << myerr << ": " << strerror(myerr);
+
+        throw ::bliss::utils::make_exception<bliss::io::IOException>(ss.str());
+      }
+      if (count == 0) break;
+
+      s += count;
+    }
+
+    if (s != target.size()) {
+      std::stringstream ss;
+      ss << "ERROR: pread64: file " << this->filename << " read " << s << " less than range: " << target.size();
+      throw ::bliss::utils::make_exception<bliss::io::IOException>(ss.str());
+    }
+  }
+
+  /**
+   * @brief allocate the node's shared window, and have the leader read the range into it.  collective on the node.
+   * @param target  node's in memory range.  only the value on the leader is used.
+   */
+  void load_node_range(range_type const & target) {
+    node_range_bytes = target;
+    MPI_Bcast(&(node_range_bytes.start), 1, MPI_UNSIGNED_LONG, 0, local);
+    MPI_Bcast(&(node_range_bytes.end), 1, MPI_UNSIGNED_LONG, 0, local);
+
+    // leader allocates all of the memory
+    MPI_Aint bytes = (local.rank() == 0) ? static_cast<MPI_Aint>(node_range_bytes.size()) : 0;
+    unsigned char * base = nullptr;
+    int res = MPI_Win_allocate_shared(bytes, 1, MPI_INFO_NULL, local, &base, &win);
+    if (res != MPI_SUCCESS) {
+      std::stringstream ss;
+      ss << "ERROR: MPI_Win_allocate_shared: file " << this->filename << " failed to allocate " << node_range_bytes.size() << " bytes. error " << res;
+      throw ::bliss::utils::make_exception<bliss::io::IOException>(ss.str());
+    }
+
+    // everyone gets the leader's address.
+    MPI_Aint qbytes;
+    int disp;
+    MPI_Win_shared_query(win, 0, &qbytes, &disp, &window);
+
+    // passive target epoch for the lifetime of the window, so the leader can write and the rest can read.
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, win);
+
+    if ((local.rank() == 0) && (node_range_bytes.size() > 0)) {
+      read_extent(window, node_range_bytes);
+    }
+    // done with the file.  not using close_file, which also resets the file size.
+    if (this->fd >= 0) {
+      close(this->fd);
+      this->fd = -1;
+    }
+
+    // make the leader's writes visible.
+    MPI_Win_sync(win);
+    local.barrier();
+    MPI_Win_sync(win);
+  }
+
+  /**
+   * @brief constructor.  computes the file size on 1 process and opens the file on the node leaders only.
+   * @note  _comm could be a temporary constructed from MPI_Comm.  same as for parallel::base_file.
+   */
+  node_shared_base_file(std::string const & _filename, size_t const & _overlap = 0UL, ::mxx::comm const & _comm = ::mxx::comm()) :
+    ::bliss::io::parallel::base_file(_comm), node_count(1), node_id(0), overlap(_overlap),
+    win(MPI_WIN_NULL), window(nullptr), node_range_bytes(0, 0) {
+
+    this->filename = _filename;
+    this->file_range_bytes.end = this->BASE::get_file_size();
+
+    {
+      ::mxx::hybrid_comm hc(this->comm);
+      local = hc.local.copy();
+    }
+
+    // number the nodes by their leaders.
+    int is_leader = (local.rank() == 0) ? 1 : 0;
+    node_count = ::mxx::allreduce(is_leader, [](int const & x, int const & y){ return x + y; }, this->comm);
+    node_id = ::mxx::exscan(is_leader, [](int const & x, int const & y){ return x + y; }, this->comm);
+    if (this->comm.rank() == 0) node_id = 0;
+    MPI_Bcast(&node_id, 1, MPI_INT, 0, local);
+
+    // renumber so that the processes on a node are contiguous, in node order.
+    ordered = this->comm.split(0, node_id * this->comm.size() + local.rank());
+
+    if (local.rank() == 0) this->::bliss::io::base_file::open_file();
+  }
+
+public:
+
+  // this is needed to prevent overload name hiding.  see http://stackoverflow.com/questions/888235/overriding-a-bases-overloaded-function-in-c/888337#888337
+  using BASE::read_range;
+
+  /// not supported.  the data is parsed in place via read_file.
+  virtual range_type read_range(typename ::bliss::io::file_data::container & output, range_type const & range_bytes) {
+    throw ::bliss::utils::make_exception<std::logic_error>("ERROR: node_aggregated_file does not support read_range.  use read_file.");
+  }
+
+  /// destructor.  collective on the node.
+  virtual ~node_shared_base_file() {
+    if (win != MPI_WIN_NULL) {
+      MPI_Win_unlock_all(win);
+      MPI_Win_free(&win);
+    }
+  };
+
+  /// communicator in file partition order.  use this for parsing the data from read_file.
+  ::mxx::comm const & get_comm() const {
+    return ordered;
+  }
+
+  /// range of the file loaded on this node.
+  range_type const & get_node_range() const {
+    return node_range_bytes;
+  }
+
+  // this is needed to prevent overload name hiding.  see http://stackoverflow.com/questions/888235/overriding-a-bases-overloaded-function-in-c/888337#888337
+  using BASE::read_file;
+
+  /// not supported.  use the shared_file_data version.
+  virtual void read_file(::bliss::io::file_data & output) {
+    throw ::bliss::utils::make_exception<std::logic_error>("ERROR: node_aggregated_file does not copy into file_data.  use read_file(shared_file_data &).");
+  }
+
+  /// get this process's partition.  no copy.
+  virtual void read_file(::bliss::io::shared_file_data & output) = 0;
+
+};
+
+
+/**
+ * @brief node aggregated file io with block partitioning and overlap.  FASTA and generic parsers
+ * @details  each process gets a block of its node's block.  the node extent includes 2x overlap at the end,
+ *           which is trimmed by the parser's find_overlap_end, same as partitioned_file<..., FASTAParser>.
+ */
+template <template <typename> class FileParser = ::bliss::io::BaseFileParser >
+class node_aggregated_file : public ::bliss::io::parallel::node_shared_base_file {
+
+protected:
+  using BASE = ::bliss::io::parallel::node_shared_base_file;
+  using FileParserType = FileParser<typename ::bliss::io::shared_file_data::const_iterator>;
+  using range_type = typename BASE::range_type;
+
+public:
+
+  node_aggregated_file(std::string const & _filename, size_t const & _overlap = 0UL, ::mxx::comm const & _comm = ::mxx::comm()) :
+    BASE(_filename, _overlap, _comm) {
+
+    range_type node_block = this->get_node_block();
+    node_block.end += 2 * this->overlap;
+    node_block.intersect(this->file_range_bytes);
+
+    this->load_node_range(node_block);
+  };
+
+  virtual ~node_aggregated_file() {};
+
+  // this is needed to prevent overload name hiding.  see http://stackoverflow.com/questions/888235/overriding-a-bases-overloaded-function-in-c/888337#888337
+  using BASE::read_file;
+
+  /**
+   * @brief  get this process's partition, in place in the node's shared memory.
+   * @param output    ranges and pointer to data.
+   */
+  virtual void read_file(::bliss::io::shared_file_data & output) {
+    output.parent_range_bytes = this->file_range_bytes;
+
+    output.valid_range_bytes = this->get_local_block(this->get_node_block());
+
+    output.in_mem_range_bytes = output.valid_range_bytes;
+    output.in_mem_range_bytes.end += 2 * this->overlap;
+    output.in_mem_range_bytes.intersect(this->node_range_bytes);
+
+    output.data = this->window + (output.in_mem_range_bytes.start - this->node_range_bytes.start);
+
+    // trim the overlap.
+    FileParserType parser;
+    output.in_mem_range_bytes.end = parser.find_overlap_end(output.in_mem_cbegin(), output.parent_range_bytes,
+        output.in_mem_range_bytes, output.valid_range_bytes.end, this->overlap);
+  }
+};
+
+
+/**
+ * @brief node aggregated file io.  FASTQParser, with record aligned partitions.
+ * @details  node extents start and end at record boundaries.  the leader finds its node's boundaries by probing the
+ *           file with small preads, so the nodes do not need to exchange data.  each process then aligns its block
+ *           of the node's extent in the shared memory.  adjacent processes (and nodes) compute the same boundary,
+ *           so the valid ranges do not overlap and cover the file.  valid range == in memory range.
+ */
+template <>
+class node_aggregated_file<::bliss::io::FASTQParser> : public ::bliss::io::parallel::node_shared_base_file {
+
+protected:
+  using BASE = ::bliss::io::parallel::node_shared_base_file;
+  using FileParserType = ::bliss::io::FASTQParser<typename ::bliss::io::shared_file_data::const_iterator>;
+  using range_type = typename BASE::range_type;
+
+  /// initial probe size for finding record boundaries
+  static constexpr size_t probe_bytes = 65536;
+
+  /// find the first record at or after pos by reading from the file.  called by the leader only.
+  size_t probe_record_start(size_t const & pos) {
+    if ((pos == this->file_range_bytes.start) || (pos >= this->file_range_bytes.end))
+      return ::std::min(pos, this->file_range_bytes.end);
+
+    std::vector<unsigned char> buffer;
+    ::bliss::io::FASTQParser<const unsigned char *> parser;
+    for (size_t bytes = probe_bytes; ; bytes <<= 1) {
+      range_type probe(pos, ::std::min(pos + bytes, this->file_range_bytes.end));
+      buffer.resize(probe.size());
+      this->read_extent(buffer.data(), probe);
+
+      size_t start = parser.find_first_record(buffer.data(), this->file_range_bytes, probe, probe);
+
+      // probe end is returned when the probe did not see enough lines.  unless it's the file end, try bigger.
+      if ((start < probe.end) || (probe.end == this->file_range_bytes.end)) return start;
+    }
+  }
+
+  /// find the first record at or after pos in the node's shared memory
+  size_t find_record_start(size_t const & pos) const {
+    if (pos <= this->node_range_bytes.start) return this->node_range_bytes.start;
+    if (pos >= this->node_range_bytes.end) return this->node_range_bytes.end;
+
+    FileParserType parser;
+    return parser.find_first_record(this->window, this->file_range_bytes, this->node_range_bytes,
+                                    range_type(pos, this->node_range_bytes.end));
+  }
+
+public:
+
+  node_aggregated_file(std::string const & _filename, size_t const & _overlap = 0UL, ::mxx::comm const & _comm = ::mxx::comm()) :
+    BASE(_filename, _overlap, _comm) {
+
+    range_type node_block = this->get_node_block();
+    if (this->local.rank() == 0) {
+      node_block.start = probe_record_start(node_block.start);
+      node_block.end = ::std::max(node_block.start, probe_record_start(node_block.end));
+    }
+
+    this->load_node_range(node_block);
+  };
+
+  virtual ~node_aggregated_file() {};
+
+  // this is needed to prevent overload name hiding.  see http://stackoverflow.com/questions/888235/overriding-a-bases-overloaded-function-in-c/888337#888337
+  using BASE::read_file;
+
+  /**
+   * @brief  get this process's partition, in place in the node's shared memory.  partition is record aligned.
+   * @param output    ranges and pointer to data.
+   */
+  virtual void read_file(::bliss::io::shared_file_data & output) {
+    output.parent_range_bytes = this->file_range_bytes;
+
+    range_type block = this->get_local_block(this->node_range_bytes);
+
+    output.valid_range_bytes.start = (this->local.rank() == 0) ?
+        this->node_range_bytes.start : find_record_start(block.start);
+    output.valid_range_bytes.end = (this->local.rank() == (this->local.size() - 1)) ?
+        this->node_range_bytes.end : find_record_start(block.end);
+    output.valid_range_bytes.end = ::std::max(output.valid_range_bytes.start, output.valid_range_bytes.end);
+
+    output.in_mem_range_bytes = output.valid_range_bytes;
+    output.data = this->window + (output.in_mem_range_bytes.start - this->node_range_bytes.start);
+  }
+};
+
+
 }  // namespace parallel
 #endif  // USE_MPI
 
@@ -41,6 +41,7 @@
 #include <exception>    // ioexception
 #include <sstream>      // stringstream
 #include <memory>
+#include <iterator>     // ostream_iterator
 
 #include <unistd.h>     // sysconf
 #include <sys/stat.h>   // block size.
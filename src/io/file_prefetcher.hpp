@@ -0,0 +1,246 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    file_prefetcher.hpp
+ * @ingroup io
+ * @author  agent <agent@local>
+ * @brief   asynchronous, double buffered chunk reader.
+ * @details posix_file and mmap_file load a range synchronously, so parsing starts only after the read returns.
+ *          for chunked builds, chunk_prefetcher reads the next chunk with pread64 on a background thread
+ *          while the caller parses and inserts the current one.  at most one chunk is waiting in the
+ *          hand-off slot, so memory use is bounded by 3 chunk buffers (caller, slot, reader).
+ *          buffers are swapped, not copied, and are reused across chunks.
+ *
+ *          the reader issues posix_fadvise(WILLNEED) for the chunk after the one being read, so the kernel
+ *          readahead runs ahead of the pread as well.
+ *
+ *          each chunk is returned as a file_data: valid range is the nominal chunk, in memory range extends
+ *          by overlap (clipped at file end) so the caller can complete records or kmers that cross chunk boundaries.
+ */
+#ifndef FILE_PREFETCHER_HPP_
+#define FILE_PREFETCHER_HPP_
+
+#include "bliss-config.hpp"
+
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>    // exception_ptr
+#include <stdexcept>
+#include <algorithm>    // min
+#include <utility>      // swap
+
+#include "io/file.hpp"
+#include "partition/range.hpp"
+
+namespace bliss
+{
+namespace io
+{
+
+  /**
+   * @brief  reads a range of a file in fixed size chunks on a background thread, one chunk ahead of the consumer.
+   * @details  usage:
+   *             chunk_prefetcher prefetch(filename, range, chunk_bytes, overlap);
+   *             file_data chunk;
+   *             while (prefetch.next(chunk)) { parse(chunk); }
+   *           errors on the reader thread are rethrown from next().
+   * @note   not copyable or movable, since the reader thread holds a pointer to this.
+   */
+  class chunk_prefetcher {
+
+    public:
+      using range_type = ::bliss::partition::range<size_t>;
+
+    protected:
+      /// underlying reader.  pread64 does not move the file offset, so it is safe to use from the reader thread.
+      ::bliss::io::posix_file file;
+
+      /// range of the whole file
+      range_type file_range_bytes;
+
+      /// range to stream, in chunks
+      range_type range_bytes;
+
+      /// nominal chunk size
+      const size_t chunk_bytes;
+
+      /// extra bytes to read after each chunk's nominal end
+      const size_t overlap;
+
+      /// number of chunks in range_bytes
+      size_t chunk_count;
+
+      /// hand-off between reader thread and consumer.
+      std::mutex mtx;
+      std::condition_variable cv;
+      ::bliss::io::file_data slot;
+      bool slot_full;
+      bool stopping;
+      bool finished;
+      std::exception_ptr error;
+
+      /// reader thread.  declared last so it starts after everything else is initialized.
+      std::thread reader;
+
+      /// load chunk i into buf.  buf's vector is reused.
+      void fill(::bliss::io::file_data & buf, size_t const & i) {
+        buf.valid_range_bytes = this->get_chunk_range(i);
+        buf.parent_range_bytes = file_range_bytes;
+
+        range_type in_mem = buf.valid_range_bytes;
+        in_mem.end += overlap;
+        in_mem.intersect(file_range_bytes);
+
+        buf.in_mem_range_bytes = file.read_range(buf.data, in_mem);
+      }
+
+      /// reader thread body
+      void run() {
+        ::bliss::io::file_data buf;
+
+        try {
+          for (size_t i = 0; i < chunk_count; ++i) {
+            // start kernel readahead for the chunk after this one.
+            if ((i + 1) < chunk_count) {
+              range_type ahead = this->get_chunk_range(i + 1);
+              ahead.end += overlap;
+              file.advise(ahead, ::bliss::io::access_hint::willneed);
+            }
+
+            this->fill(buf, i);
+
+            {
+              std::unique_lock<std::mutex> lock(mtx);
+              cv.wait(lock, [this]{ return !slot_full || stopping; });
+              if (stopping) break;
+
+              // buf gets the buffer the consumer returned last time, if any.
+              std::swap(slot, buf);
+              slot_full = true;
+            }
+            cv.notify_all();
+          }
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(mtx);
+          error = std::current_exception();
+        }
+
+        {
+          std::lock_guard<std::mutex> lock(mtx);
+          finished = true;
+        }
+        cv.notify_all();
+      }
+
+    public:
+
+      /**
+       * @brief  open file and start reading the first chunk in the background.
+       * @param _filename     file to read
+       * @param _range        range of file to stream.  clipped to the file.
+       * @param _chunk_bytes  nominal size of each chunk.  the last chunk may be smaller.
+       * @param _overlap      bytes to read past each chunk's end.
+       * @param hint          access pattern hint for the whole range, applied before reading.
+       */
+      chunk_prefetcher(std::string const & _filename, range_type const & _range,
+                       size_t const & _chunk_bytes, size_t const & _overlap = 0,
+                       ::bliss::io::access_hint const & hint = ::bliss::io::access_hint::sequential) :
+        file(_filename),
+        file_range_bytes(0, file.size()),
+        range_bytes(range_type::intersect(_range, file_range_bytes)),
+        chunk_bytes(_chunk_bytes), overlap(_overlap), chunk_count(0),
+        slot_full(false), stopping(false), finished(false) {
+
+        if (chunk_bytes == 0) {
+          throw std::invalid_argument("ERROR: chunk_prefetcher: chunk size is 0");
+        }
+
+        chunk_count = (range_bytes.size() + chunk_bytes - 1) / chunk_bytes;
+
+        file.advise(range_bytes, hint);
+
+        reader = std::thread(&chunk_prefetcher::run, this);
+      }
+
+      chunk_prefetcher(chunk_prefetcher const & other) = delete;
+      chunk_prefetcher& operator=(chunk_prefetcher const & other) = delete;
+
+      /// stop the reader thread.  chunks not yet consumed are discarded.
+      ~chunk_prefetcher() {
+        {
+          std::lock_guard<std::mutex> lock(mtx);
+          stopping = true;
+        }
+        cv.notify_all();
+        if (reader.joinable()) reader.join();
+      }
+
+      /**
+       * @brief  get the next chunk, blocking until it is read.
+       * @param out   receives the chunk.  its previous buffer is handed back to the reader for reuse.
+       * @return      false if there are no more chunks.
+       * @throws      the reader thread's exception, if reading failed.
+       */
+      bool next(::bliss::io::file_data & out) {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [this]{ return slot_full || finished; });
+
+        if (slot_full) {
+          std::swap(out, slot);
+          slot_full = false;
+          lock.unlock();
+          cv.notify_all();
+          return true;
+        }
+
+        if (error) {
+          std::exception_ptr e = error;
+          error = nullptr;
+          std::rethrow_exception(e);
+        }
+        return false;
+      }
+
+      /// nominal range of chunk i, without overlap.
+      range_type get_chunk_range(size_t const & i) const {
+        size_t s = std::min(range_bytes.start + i * chunk_bytes, range_bytes.end);
+        return range_type(s, std::min(s + chunk_bytes, range_bytes.end));
+      }
+
+      /// number of chunks
+      size_t size() const {
+        return chunk_count;
+      }
+
+      /// range being streamed.
+      range_type const & get_range() const {
+        return range_bytes;
+      }
+
+      /// range of the whole file
+      range_type const & get_file_range() const {
+        return file_range_bytes;
+      }
+  };
+
+
+} /* namespace io */
+} /* namespace bliss */
+
+#endif /* FILE_PREFETCHER_HPP_ */
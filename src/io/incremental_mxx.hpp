@@ -34,9 +34,12 @@
 #include <mxx/samplesort.hpp>
 
 #include "utils/benchmark_utils.hpp"
+#include "utils/comm_profiler.hpp"
+#include "utils/net_delay.hpp"
 #include "utils/function_traits.hpp"
 
 #include "containers/fsc_container_utils.hpp"
+#include "io/exchange_arena.hpp"
 
 namespace imxx
 {
@@ -163,7 +166,8 @@ namespace imxx
                            std::vector<SIZE> & bucket_sizes,
 						   std::vector<T> & results,
                            size_t first = 0,
-                           size_t last = std::numeric_limits<size_t>::max()) {
+                           size_t last = std::numeric_limits<size_t>::max(),
+                           ::imxx::exchange_arena * arena = nullptr) {
 
       static_assert(::std::is_integral<ASSIGN_TYPE>::value, "ASSIGN_TYPE should be integral, preferably unsigned");
   	assert(((input.size() == 0) || (input.data() != results.data())) &&
@@ -198,7 +202,9 @@ namespace imxx
       }
 
       // output to input mapping
-      std::vector<ASSIGN_TYPE> i2o;
+      std::vector<ASSIGN_TYPE> local_i2o;
+      std::vector<ASSIGN_TYPE> & i2o = (arena == nullptr) ? local_i2o :
+          arena->template get<ASSIGN_TYPE>(::imxx::exchange_arena::BUCKET_ASSIGN);
       i2o.reserve(len);
 
       // [1st pass]: compute bucket counts and input to bucket assignment.
@@ -1084,7 +1090,9 @@ namespace imxx
     // distribute (communication part)
     BL_BENCH_START(distribute);
     recv_counts.resize(_comm.size());
+    auto prof_t0 = ::plog::CommProfiler::clock::now();
     mxx::all2all(send_counts.data(), 1, recv_counts.data(), _comm);
+    auto prof_t1 = ::plog::CommProfiler::clock::now();
     size_t total = std::accumulate(recv_counts.begin(), recv_counts.end(), static_cast<size_t>(0));
     BL_BENCH_COLLECTIVE_END(distribute, "a2a_count", recv_counts.size(), _comm);
 
@@ -1095,7 +1103,11 @@ namespace imxx
     BL_BENCH_COLLECTIVE_END(distribute, "realloc_out", output.size(), _comm);
 
     BL_BENCH_START(distribute);
+    auto prof_t2 = ::plog::CommProfiler::clock::now();
     mxx::all2allv(input.data(), send_counts, output.data(), recv_counts, _comm);
+    ::plog::NetDelay::instance().inject(send_counts, recv_counts, sizeof(V), _comm);
+    ::plog::CommProfiler::instance().record(send_counts, recv_counts, sizeof(V),
+                                            prof_t0, prof_t1, prof_t2, ::plog::CommProfiler::clock::now());
     BL_BENCH_END(distribute, "a2a", output.size());
 
     if (preserve_input) {
@@ -1108,11 +1120,15 @@ namespace imxx
 
   }
 
+  /**
+   * @brief distribute function, single pass bucketing.  input's storage holds the bucketed send buffer afterwards, output the entries received.
+   * @details  with an arena, the bucket assignment is the arena's retained buffer (slot BUCKET_ASSIGN).
+   */
   template <typename V, typename ToRank, typename SIZE>
   void distribute(::std::vector<V>& input, ToRank const & to_rank,
                   ::std::vector<SIZE> & recv_counts,
                   ::std::vector<V>& output,
-                  ::mxx::comm const &_comm) {
+                  ::mxx::comm const &_comm, ::imxx::exchange_arena * arena = nullptr) {
     BL_BENCH_INIT(distribute);
 
     BL_BENCH_COLLECTIVE_START(distribute, "empty", _comm);
@@ -1140,13 +1156,13 @@ namespace imxx
     BL_BENCH_START(distribute);
     size_t comm_size = _comm.size();
     if (comm_size <= std::numeric_limits<uint8_t>::max()) {
-      imxx::local::bucketing_impl(output, to_rank, static_cast< uint8_t>(comm_size), send_counts, input, 0, output.size());
+      imxx::local::bucketing_impl(output, to_rank, static_cast< uint8_t>(comm_size), send_counts, input, 0, output.size(), arena);
     } else if (comm_size <= std::numeric_limits<uint16_t>::max()) {
-      imxx::local::bucketing_impl(output, to_rank, static_cast<uint16_t>(comm_size), send_counts, input, 0, output.size());
+      imxx::local::bucketing_impl(output, to_rank, static_cast<uint16_t>(comm_size), send_counts, input, 0, output.size(), arena);
     } else if (comm_size <= std::numeric_limits<uint32_t>::max()) {
-      imxx::local::bucketing_impl(output, to_rank, static_cast<uint32_t>(comm_size), send_counts, input, 0, output.size());
+      imxx::local::bucketing_impl(output, to_rank, static_cast<uint32_t>(comm_size), send_counts, input, 0, output.size(), arena);
     } else {
-      imxx::local::bucketing_impl(output, to_rank, static_cast<uint64_t>(comm_size), send_counts, input, 0, output.size());
+      imxx::local::bucketing_impl(output, to_rank, static_cast<uint64_t>(comm_size), send_counts, input, 0, output.size(), arena);
     }
     BL_BENCH_COLLECTIVE_END(distribute, "bucket", input.size(), _comm);
 
@@ -1154,7 +1170,9 @@ namespace imxx
     // distribute (communication part)
     BL_BENCH_START(distribute);
     recv_counts.resize(_comm.size());
+    auto prof_t0 = ::plog::CommProfiler::clock::now();
     mxx::all2all(send_counts.data(), 1, recv_counts.data(), _comm);
+    auto prof_t1 = ::plog::CommProfiler::clock::now();
     size_t total = std::accumulate(recv_counts.begin(), recv_counts.end(), static_cast<size_t>(0));
     BL_BENCH_COLLECTIVE_END(distribute, "a2a_count", recv_counts.size(), _comm);
 
@@ -1165,7 +1183,11 @@ namespace imxx
     BL_BENCH_COLLECTIVE_END(distribute, "realloc_out", output.size(), _comm);
 
     BL_BENCH_START(distribute);
+    auto prof_t2 = ::plog::CommProfiler::clock::now();
     mxx::all2allv(input.data(), send_counts, output.data(), recv_counts, _comm);
+    ::plog::NetDelay::instance().inject(send_counts, recv_counts, sizeof(V), _comm);
+    ::plog::CommProfiler::instance().record(send_counts, recv_counts, sizeof(V),
+                                            prof_t0, prof_t1, prof_t2, ::plog::CommProfiler::clock::now());
     BL_BENCH_END(distribute, "a2a", output.size());
 
     BL_BENCH_REPORT_MPI_NAMED(distribute, "imxx:distribute_bucket", _comm);
@@ -1193,7 +1215,9 @@ namespace imxx
 
     BL_BENCH_START(undistribute);
     std::vector<size_t> send_counts(recv_counts.size());
+    auto prof_t0 = ::plog::CommProfiler::clock::now();
     mxx::all2all(recv_counts.data(), 1, send_counts.data(), _comm);
+    auto prof_t1 = ::plog::CommProfiler::clock::now();
     size_t total = std::accumulate(send_counts.begin(), send_counts.end(), static_cast<size_t>(0));
     BL_BENCH_END(undistribute, "recv_counts", input.size());
 
@@ -1203,7 +1227,11 @@ namespace imxx
     BL_BENCH_COLLECTIVE_END(undistribute, "realloc_out", output.size(), _comm);
 
     BL_BENCH_START(undistribute);
+    auto prof_t2 = ::plog::CommProfiler::clock::now();
     mxx::all2allv(input.data(), recv_counts, output.data(), send_counts, _comm);
+    ::plog::NetDelay::instance().inject(recv_counts, send_counts, sizeof(V), _comm);
+    ::plog::CommProfiler::instance().record(recv_counts, send_counts, sizeof(V),
+                                            prof_t0, prof_t1, prof_t2, ::plog::CommProfiler::clock::now());
     BL_BENCH_END(undistribute, "a2av", input.size());
 
     if (restore_order) {
@@ -1217,6 +1245,68 @@ namespace imxx
 
   }
 
+  /**
+   * @brief all2allv of a bucketed vector, e.g. the responses to distributed queries.
+   * @details  same as mxx::all2allv(input, send_counts, comm), but the exchange is recorded when the comm profiler is on,
+   *           and delayed when the synthetic network delay is on.  the output has the input's allocator, so containers
+   *           with a custom allocator (e.g. plog::tracking_allocator) can be exchanged in place.
+   */
+  template <typename V, typename Alloc>
+  ::std::vector<V, Alloc> exchange(::std::vector<V, Alloc> const & input, ::std::vector<size_t> const & send_counts,
+                                   ::mxx::comm const &_comm) {
+    auto prof_t0 = ::plog::CommProfiler::clock::now();
+    std::vector<size_t> recv_counts = mxx::all2all(send_counts, _comm);
+    auto prof_t1 = ::plog::CommProfiler::clock::now();
+
+    ::std::vector<V, Alloc> output(std::accumulate(recv_counts.begin(), recv_counts.end(), static_cast<size_t>(0)),
+                                   V(), input.get_allocator());
+
+    auto prof_t2 = ::plog::CommProfiler::clock::now();
+    mxx::all2allv(input.data(), send_counts, output.data(), recv_counts, _comm);
+    ::plog::NetDelay::instance().inject(send_counts, recv_counts, sizeof(V), _comm);
+    ::plog::CommProfiler::instance().record(send_counts, recv_counts, sizeof(V),
+                                            prof_t0, prof_t1, prof_t2, ::plog::CommProfiler::clock::now());
+
+    return output;
+  }
+
+  /**
+   * @brief exchange a bucketed vector in place, e.g. the local results of a query.
+   * @details  input receives a newly allocated vector (which usually is returned to the caller), and its old storage is
+   *           retained by the arena (slot RESULTS), where the next call can acquire it for its local results.
+   */
+  template <typename V>
+  void exchange(::std::vector<V> & input, ::std::vector<size_t> const & send_counts,
+                ::imxx::exchange_arena & arena, ::mxx::comm const &_comm) {
+    ::std::vector<V> output = ::imxx::exchange(input, send_counts, _comm);
+    // the local and the received results, at the peak.  the received ones go to the caller.
+    ::plog::AllocTracker::instance().transient(::plog::alloc_tag::results::name(),
+                                               (input.capacity() + output.capacity()) * sizeof(V));
+    input.swap(output);
+    arena.release(::imxx::exchange_arena::RESULTS, output);
+  }
+
+  /**
+   * @brief distribute with the arena's buffers.  input is replaced by the entries received, grouped by source rank.
+   * @details  same as the single pass distribute(input, to_rank, recv_counts, output, _comm), with the bucket assignment
+   *           and output from the arena (slots BUCKET_ASSIGN and QUERY).  input's storage holds the received entries, and the
+   *           arena keeps the send buffer, so repeated calls of similar sizes do not allocate.  the order within each bucket is
+   *           kept, same as with the i2o version.
+   */
+  template <typename V, typename ToRank>
+  void distribute(::std::vector<V>& input, ToRank const & to_rank,
+                  ::std::vector<size_t> & recv_counts,
+                  ::imxx::exchange_arena & arena,
+                  ::mxx::comm const &_comm) {
+    ::std::vector<V> & buffer = arena.template get<V>(::imxx::exchange_arena::QUERY);
+    ::imxx::distribute(input, to_rank, recv_counts, buffer, _comm, &arena);
+    // the send buffer, the bucket assignment and the received entries, at the peak.
+    arena.account();
+    ::plog::AllocTracker::instance().transient(::plog::alloc_tag::buffer::name(), input.capacity() * sizeof(V));
+    input.swap(buffer);
+    arena.account();
+  }
+
   /**
    * @brief distribute function.  input is transformed, but remains the original input with original order.  buffer is used for output.
    *
@@ -51,11 +51,16 @@
 #include <tuple>        // tuple and utility functions
 #include <utility>      // pair and utility functions.
 #include <type_traits>
+#include <numeric>      // accumulate
+#include <algorithm>    // stable_sort, min_element
+#include <limits>
 #include <cctype>       // tolower.
 
 #include "io/file.hpp"
+#include "io/file_prefetcher.hpp"
 #include "io/fastq_loader.hpp"
 #include "io/fasta_loader.hpp"
+#include "io/packed_read_file.hpp"
 //#include "io/fasta_iterator.hpp"
 
 #include "iterators/container_concatenating_iterator.hpp"
@@ -90,6 +95,98 @@ namespace io
 
 
 
+/**
+ * @brief assignment of a list of files to processes, balanced by total file size.
+ * @details  each file f is read by the contiguous processes [first_rank[f], first_rank[f] + rank_count[f]).
+ *           files larger than the average per-process share are read in parallel, by a group of
+ *           floor(size / share) processes.  the groups are disjoint, so a process belongs to at most 1 group.
+ *           the remaining files are assigned whole to a single process, largest first, to the least loaded
+ *           process (LPT scheduling), so many small files do not need any collective operations.
+ *           empty files are not assigned (rank_count == 0).
+ *           deterministic, so all processes compute the same assignment.
+ */
+struct multi_file_assignment {
+    std::vector<int> first_rank;
+    std::vector<int> rank_count;
+
+    multi_file_assignment(std::vector<size_t> const & sizes, int const & nprocs) :
+      first_rank(sizes.size(), 0), rank_count(sizes.size(), 0) {
+
+      if (nprocs < 1) throw std::invalid_argument("multi_file_assignment: number of processes must be positive.");
+
+      size_t total = std::accumulate(sizes.begin(), sizes.end(), 0UL);
+      size_t share = (total + nprocs - 1) / nprocs;
+
+      // files in decreasing size order.  stable so ties are in input order.
+      std::vector<size_t> order(sizes.size());
+      for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+      std::stable_sort(order.begin(), order.end(), [&sizes](size_t const & x, size_t const & y){
+        return sizes[x] > sizes[y];
+      });
+
+      // load per process.
+      std::vector<size_t> loads(nprocs, 0);
+
+      // first the large files, by groups of processes.  sum of the group sizes is at most nprocs.
+      int next_rank = 0;
+      for (auto f : order) {
+        if (sizes[f] == 0) continue;
+        int group = static_cast<int>(sizes[f] / share);
+        if (group < 2) continue;   // whole file, by a single process.
+
+        first_rank[f] = next_rank;
+        rank_count[f] = group;
+        for (int r = next_rank; r < next_rank + group; ++r) {
+          loads[r] = sizes[f] / group;
+        }
+        next_rank += group;
+      }
+
+      // then the whole files, to the least loaded process.  ties go to the lowest rank.
+      for (auto f : order) {
+        if ((sizes[f] == 0) || (rank_count[f] > 0)) continue;
+
+        int target = std::min_element(loads.begin(), loads.end()) - loads.begin();
+        first_rank[f] = target;
+        rank_count[f] = 1;
+        loads[target] += sizes[f];
+      }
+    }
+
+    /// index of the file that is read in parallel by a group including rank, or -1 if none.
+    int get_group(int const & rank) const {
+      for (size_t f = 0; f < first_rank.size(); ++f) {
+        if ((rank_count[f] > 1) && (first_rank[f] <= rank) && (rank < first_rank[f] + rank_count[f])) return f;
+      }
+      return -1;
+    }
+
+    /// indices of the files to be read whole by rank.
+    std::vector<size_t> get_whole_files(int const & rank) const {
+      std::vector<size_t> files;
+      for (size_t f = 0; f < first_rank.size(); ++f) {
+        if ((rank_count[f] == 1) && (first_rank[f] == rank)) files.push_back(f);
+      }
+      return files;
+    }
+};
+
+
+/**
+ * @brief whether a parsed value stores the id of its file, e.g. pair<Kmer, ShortSequenceKmerId>, or a pair nesting one.
+ * @details  kmer and kmer+count values do not, so they are not limited by the width of the stored file id.
+ */
+template <typename T, typename = void>
+struct carries_file_id : public std::false_type {};
+
+template <typename T>
+struct carries_file_id<T, decltype(void(std::declval<T const &>().get_file_id()))> : public std::true_type {};
+
+template <typename A, typename B>
+struct carries_file_id<std::pair<A, B>, void> :
+  public std::integral_constant<bool, carries_file_id<A>::value || carries_file_id<B>::value> {};
+
+
 /**
  * @tparam MapType    container type
  * @tparam KmerParser   functor to generate kmer (tuple) from input.  specified here so we specialize for different index.  note KmerParser needs to be supplied with a data type.
@@ -106,11 +203,13 @@ struct KmerFileHelper {
    * @tparam BlockType    input partition type, supports in memory (vector) vs memmapped.
    * @param partition
    * @param result        output vector.  should be pre allocated.
+   * @param file_id       id of the file, stored in the sequence ids (and therefore the kmer positions).
    */
   template <typename KmerParser, template <typename> class SeqParser, template <typename,  template <typename> class> class SeqIterType, typename BlockType>
   static std::pair<size_t, size_t> read_block_old(BlockType const & partition,
       SeqParser<typename BlockType::iterator> const &seq_parser,
-      std::vector<typename KmerParser::value_type>& result) {
+      std::vector<typename KmerParser::value_type>& result,
+      uint16_t const & file_id = 0) {
 
     // from FileLoader type, get the block iter type and range type
     using CharIterType = typename BlockType::const_iterator;
@@ -137,6 +236,7 @@ struct KmerFileHelper {
     {
       auto seq = *seqs_start;
       if (seq.seq_size() == 0) continue;
+      seq.id.file_id = file_id;
       //      std::cout << "** seq: " << (*seqs_start).id.id << ", ";
       //      ostream_iterator<typename std::iterator_traits<typename SeqType::IteratorType>::value_type> osi(std::cout);
       //      std::copy((*seqs_start).seq_begin, (*seqs_start).seq_end, osi);
@@ -433,6 +533,100 @@ struct KmerFileHelper {
   }
 
 
+  /**
+   * @brief parse the reads of a (mapped) packed read file slice into kmers.
+   * @details  packed reads are already split into records, and each slice contains whole reads, so
+   *           the parser's valid range is just the slice's base range, and no overlap is needed.
+   * @return   number of reads, number of kmers generated.
+   */
+  template <typename KmerParser>
+  static std::pair<size_t, size_t> parse_packed_data(const ::bliss::io::packed_reads_file & packed,
+                         std::vector<typename KmerParser::value_type>& result) {
+      constexpr size_t kmer_size = KmerParser::window_size;
+
+      auto read_range = packed.get_read_range();
+      auto base_range = packed.get_base_range();
+
+      // estimate capacity: at most one kmer per base.
+      size_t est_size = (base_range.size() < read_range.size() * (kmer_size - 1)) ? 0 :
+          (base_range.size() - read_range.size() * (kmer_size - 1));
+      result.reserve(result.size() + est_size);
+
+      KmerParser kmer_parser(base_range);
+      ::fsc::back_emplace_iterator<std::vector<typename KmerParser::value_type> > emplace_iter(result);
+
+      size_t before = result.size();
+      for (size_t i = read_range.start; i < read_range.end; ++i) {
+        auto seq = packed.get_sequence(i);
+        if (seq.seq_size() < kmer_size) continue;
+        emplace_iter = kmer_parser(seq, emplace_iter);
+      }
+
+      return std::make_pair(read_range.size(), result.size() - before);
+  }
+
+  /**
+   * @brief read a packed read file (see packed_read_file.hpp) and generate kmers, place in a vector as return result.
+   * @note  static so can be used without instantiating a internal map.
+   * @tparam KmerParser   parser type for generating Kmer.  supports kmer, kmer+pos, kmer+count, kmer+pos/qual.
+   */
+  template <typename KmerParser>
+  static std::pair<size_t, size_t> read_file_packed(const std::string & filename,
+                         std::vector<typename KmerParser::value_type>& result) {
+
+      std::pair<size_t, size_t> read = {0, 0};
+
+      BL_BENCH_INIT(file);
+      {  // ensure that file is closed at the end.
+
+        BL_BENCH_START(file);
+        ::bliss::io::packed_reads_file packed(filename);
+        BL_BENCH_END(file, "open", packed.get_base_range().size());
+
+        BL_BENCH_START(file);
+        read = parse_packed_data<KmerParser>(packed, result);
+        BL_BENCH_END(file, "read_kmers", read.second);
+      }
+
+      BL_BENCH_REPORT_NAMED(file, "io:read_file_packed");
+      return read;
+  }
+
+
+  /**
+   * @brief  move a chunk's valid range to FASTQ record boundaries, and trim the in memory range to the valid end.
+   * @details  the start and the end are each the first record found by searching forward from the nominal boundary
+   *           to the end of the chunk in memory.  adjacent chunks (on the same or adjacent ranks) search from the same
+   *           boundary, so they agree on where it is and every record is parsed exactly once, without communication.
+   * @throws IOException  if the overlap does not reach the next record start.
+   */
+  static void align_chunk_to_records(::bliss::io::file_data & chunk) {
+    using range_type = typename ::bliss::io::file_data::range_type;
+
+    ::bliss::io::FASTQParser<typename ::bliss::io::file_data::const_iterator> parser;
+    range_type const & in_mem = chunk.in_mem_range_bytes;
+    range_type aligned = chunk.valid_range_bytes;
+
+    aligned.start = parser.find_first_record(chunk.in_mem_cbegin(), chunk.parent_range_bytes, in_mem,
+                                             range_type(aligned.start, in_mem.end));
+    aligned.end = (aligned.end == chunk.parent_range_bytes.end) ? aligned.end :
+        parser.find_first_record(chunk.in_mem_cbegin(), chunk.parent_range_bytes, in_mem,
+                                 range_type(aligned.end, in_mem.end));
+
+    if ((aligned.end == in_mem.end) && (in_mem.end != chunk.parent_range_bytes.end)) {
+      std::stringstream ss;
+      ss << "ERROR: chunk " << chunk.valid_range_bytes << " in memory " << in_mem << " does not contain the next record start. increase the overlap.";
+      throw ::bliss::utils::make_exception<::bliss::io::IOException>(ss.str());
+    }
+    if (aligned.start > aligned.end) aligned.start = aligned.end;  // chunk smaller than a record.
+
+    // drop the partial record after the end, since the sequence iterator parses to the end of the in memory data.
+    chunk.data.resize(aligned.end - in_mem.start);
+    chunk.in_mem_range_bytes.end = aligned.end;
+    chunk.valid_range_bytes = aligned;
+  }
+
+
 #if defined(USE_MPI)
 
   /**
@@ -440,7 +634,8 @@ struct KmerFileHelper {
    */
   template <typename KmerParser, template <typename> class SeqParser, template <typename,  template <typename> class> class SeqIterType, typename BlockType>
   static  ::std::pair<size_t, size_t> parse_file_data_old(const BlockType & partition,
-                         std::vector<typename KmerParser::value_type>& result, const mxx::comm & _comm) {
+                         std::vector<typename KmerParser::value_type>& result, const mxx::comm & _comm,
+                         uint16_t const & file_id = 0) {
       ::std::pair<size_t, size_t> read = {0,0};
 
      constexpr int kmer_size = KmerParser::window_size;
@@ -470,7 +665,7 @@ struct KmerFileHelper {
         BL_BENCH_START(file);
         //=== copy into array
         if (partition.getRange().size() > 0) {
-          read = read_block_old<KmerParser, SeqParser, SeqIterType>(partition, seq_parser, result);
+          read = read_block_old<KmerParser, SeqParser, SeqIterType>(partition, seq_parser, result, file_id);
         }
         BL_BENCH_END(file, "read_seqs", read.first);
         // std::cout << "Last: pos - kmer " << result.back() << std::endl;
@@ -533,7 +728,7 @@ struct KmerFileHelper {
         // file extension determines SeqParserType
         std::string extension = ::bliss::utils::file::get_file_extension(filename);
         std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
-        if ((extension.compare("fastq") != 0) && (extension.compare("fasta") != 0)) {
+        if ((extension.compare("fastq") != 0) && (extension.compare("fasta") != 0) && (extension.compare("fa") != 0)) {
           throw std::invalid_argument("input filename extension is not supported.");
         }
 
@@ -550,7 +745,8 @@ struct KmerFileHelper {
   template <typename FileType, typename KmerParser, template <typename> class SeqParser, template <typename,  template <typename> class> class SeqIterType>
   static  ::std::pair<size_t, size_t> read_file(const std::string & filename,
                          std::vector<typename KmerParser::value_type>& result,
-                         const mxx::comm & _comm) {
+                         const mxx::comm & _comm,
+                         uint16_t const & file_id = 0) {
 
       ::std::pair<size_t, size_t> read = {0, 0};
 
@@ -568,7 +764,7 @@ struct KmerFileHelper {
 
         // not reusing the SeqParser in loader.  instead, reinitializing one.
         BL_BENCH_START(file);
-        read = parse_file_data_old<KmerParser, SeqParser, SeqIterType>(partition, result, _comm);
+        read = parse_file_data_old<KmerParser, SeqParser, SeqIterType>(partition, result, _comm, file_id);
         BL_BENCH_END(file, "read_kmers", read.second);
         // std::cout << "Last: pos - kmer " << result.back() << std::endl;
       }
@@ -631,6 +827,304 @@ struct KmerFileHelper {
           KmerParser, SeqParser, SeqIterType>(filename, result, _comm);
 
   }
+
+  /**
+   * @brief read a file's content and generate kmers, place in a vector as return result.
+   * @details  1 process per node reads the node's portion of the file into shared memory, and all processes on the
+   *           node parse their partitions from it without copying.  see parallel::node_aggregated_file.
+   *           reduces the file system metadata and I/O request load at scale.
+   * @note  static so can be used wihtout instantiating a internal map.
+   * @tparam SeqParser    parser type for extracting sequences.  supports FASTQ and FASTA.   template template parameter, param is iterator
+   * @tparam KmerParser   parser type for generating Kmer.  supports kmer, kmer+pos, kmer+count, kmer+pos/qual.
+   */
+  template <typename KmerParser, template <typename> class SeqParser, template <typename,  template <typename> class> class SeqIterType>
+  static ::std::pair<size_t, size_t> read_file_node_aggregated(const std::string & filename,
+                         std::vector<typename KmerParser::value_type>& result,
+                         const mxx::comm & _comm,
+                         uint16_t const & file_id = 0) {
+      // file extension determines SeqParserType
+      std::string extension = ::bliss::utils::file::get_file_extension(filename);
+      std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+      if ((extension.compare("fastq") != 0) && (extension.compare("fasta") != 0) && (extension.compare("fa") != 0)) {
+        throw std::invalid_argument("input filename extension is not supported.");
+      }
+
+      ::std::pair<size_t, size_t> read = {0, 0};
+
+      constexpr int kmer_size = KmerParser::window_size;
+
+      BL_BENCH_INIT(file);
+      {  // ensure that the shared memory is released at the end.
+
+        BL_BENCH_START(file);
+        ::bliss::io::parallel::node_aggregated_file<SeqParser> fobj(filename, kmer_size - 1, _comm);
+        ::bliss::io::shared_file_data partition;
+        fobj.read_file(partition);
+        BL_BENCH_END(file, "open", partition.getRange().size());
+
+        // parse with the renumbered communicator, so neighbors in the communicator have adjacent partitions.
+        BL_BENCH_START(file);
+        read = parse_file_data_old<KmerParser, SeqParser, SeqIterType>(partition, result, fobj.get_comm(), file_id);
+        BL_BENCH_END(file, "read_kmers", read.second);
+      }
+
+      BL_BENCH_REPORT_MPI_NAMED(file, "io:read_file_node_aggregated", _comm);
+      return read;
+  }
+
+  /**
+   * @brief read a FASTQ file chunk by chunk and generate kmers, passing each chunk's kmers to a callback.
+   * @details  each rank streams its block partition of the file through a chunk_prefetcher, so the next chunk is read
+   *           from disk while the current one is parsed and handed to the callback, e.g. an index insert.
+   *           chunks are aligned to records locally (see align_chunk_to_records).
+   *           the callback is invoked the same number of times on every rank, with an empty vector once a rank has
+   *           no more chunks, so it may be collective.
+   * @note  FASTQ only.  FASTA sequence ids and offsets depend on header positions across the whole partition
+   *        (FASTAParser::init_parser), which a single chunk does not have.
+   * @tparam Callback     callable as callback(std::vector<typename KmerParser::value_type> &).
+   * @param chunk_bytes   nominal chunk size per rank.
+   * @param overlap       bytes read past each chunk end to find the next record start.  must hold at least 1 record.
+   * @return number of sequences and number of kmers read by this process.
+   */
+  template <typename KmerParser, template <typename> class SeqParser, template <typename,  template <typename> class> class SeqIterType, typename Callback>
+  static ::std::pair<size_t, size_t> read_file_chunked(const std::string & filename,
+                         Callback & callback,
+                         const mxx::comm & _comm,
+                         size_t const & chunk_bytes = (64UL << 20),
+                         size_t const & overlap = (1UL << 20),
+                         uint16_t const & file_id = 0) {
+      static_assert(::std::is_same<SeqParser<typename ::bliss::io::file_data::const_iterator>,
+                                   ::bliss::io::FASTQParser<typename ::bliss::io::file_data::const_iterator> >::value,
+                    "read_file_chunked supports FASTQ files only.");
+
+      using range_type = typename ::bliss::io::file_data::range_type;
+
+      ::std::pair<size_t, size_t> read = {0, 0};
+
+      BL_BENCH_INIT(file);
+
+      BL_BENCH_START(file);
+      // file size from rank 0 only, to avoid metadata storms on parallel file systems.
+      size_t file_size = 0;
+      if (_comm.rank() == 0) {
+        struct stat filestat;
+        if (stat(filename.c_str(), &filestat) != 0) {
+          std::stringstream ss;
+          int myerr = errno;
+          ss << "ERROR in read_file_chunked: stat file " << filename << " error " << myerr << ": " << strerror(myerr);
+          throw ::bliss::utils::make_exception<::bliss::io::IOException>(ss.str());
+        }
+        file_size = filestat.st_size;
+      }
+      ::mxx::bcast(file_size, 0, _comm);
+
+      range_type partition(0, file_size);
+      if (_comm.size() > 1) {
+        ::bliss::partition::BlockPartitioner<range_type> partitioner;
+        partitioner.configure(partition, _comm.size());
+        partition = partitioner.getNext(_comm.rank());
+      }
+
+      ::bliss::io::chunk_prefetcher prefetcher(filename, partition, chunk_bytes, overlap);
+      size_t rounds = ::mxx::allreduce(prefetcher.size(), [](size_t const & x, size_t const & y){ return ::std::max(x, y); }, _comm);
+      BL_BENCH_END(file, "open", rounds);
+
+      ::bliss::io::file_data chunk;
+      ::std::vector<typename KmerParser::value_type> result;
+
+      BL_BENCH_LOOP_START(file, 0);
+      BL_BENCH_LOOP_START(file, 1);
+      BL_BENCH_LOOP_START(file, 2);
+      for (size_t i = 0; i < rounds; ++i) {
+        result.clear();
+
+        BL_BENCH_LOOP_RESUME(file, 0);
+        bool has_chunk = prefetcher.next(chunk);
+        BL_BENCH_LOOP_PAUSE(file, 0);
+
+        BL_BENCH_LOOP_RESUME(file, 1);
+        if (has_chunk) {
+          align_chunk_to_records(chunk);
+
+          if (chunk.getRange().size() > 0) {
+            SeqParser<typename ::bliss::io::file_data::const_iterator> seq_parser;
+            seq_parser.init_parser(chunk.in_mem_cbegin(), chunk.parent_range_bytes, chunk.in_mem_range_bytes, chunk.getRange());
+
+            auto r = read_block_old<KmerParser, SeqParser, SeqIterType>(chunk, seq_parser, result, file_id);
+            read.first += r.first;
+            read.second += r.second;
+          }
+        }
+        BL_BENCH_LOOP_PAUSE(file, 1);
+
+        BL_BENCH_LOOP_RESUME(file, 2);
+        callback(result);
+        BL_BENCH_LOOP_PAUSE(file, 2);
+      }
+      BL_BENCH_LOOP_END(file, 0, "wait_io", rounds);
+      BL_BENCH_LOOP_END(file, 1, "read_kmers", read.second);
+      BL_BENCH_LOOP_END(file, 2, "callback", read.second);
+
+      BL_BENCH_REPORT_MPI_NAMED(file, "io:read_file_chunked", _comm);
+      return read;
+  }
+
+  /**
+   * @brief read and parse a whole file on a single process.  for use with many small files, so no benchmark report.
+   * @param _comm   communicator containing only this process.
+   */
+  template <typename FileType, typename KmerParser, template <typename> class SeqParser, template <typename,  template <typename> class> class SeqIterType>
+  static  ::std::pair<size_t, size_t> read_whole_file(const std::string & filename,
+                         std::vector<typename KmerParser::value_type>& result,
+                         const mxx::comm & _comm,
+                         uint16_t const & file_id) {
+      ::bliss::io::file_data partition = open_file<FileType>(filename, KmerParser::window_size - 1, _comm);
+      if (partition.getRange().size() == 0) return ::std::make_pair(0UL, 0UL);
+
+      SeqParser<typename ::bliss::io::file_data::const_iterator> seq_parser;
+      seq_parser.init_parser(partition.in_mem_cbegin(), partition.parent_range_bytes, partition.in_mem_range_bytes, partition.getRange(), _comm);
+
+      return read_block_old<KmerParser, SeqParser, SeqIterType>(partition, seq_parser, result, file_id);
+  }
+
+  /**
+   * @brief read a list of files and generate kmers, place in a vector as return result.
+   * @details  files are assigned to processes by size (see multi_file_assignment).  large files are read
+   *           in parallel by a group of processes, small files are read whole by a single process without
+   *           communication.  the index of the file in the list is stored as file_id in the sequence ids,
+   *           so position indices can identify the source file.
+   *           the result contains kmers from all assigned files, so a single distribution phase can follow.
+   *           at most 65536 files (16 bit SequenceId::file_id).  if the parsed values store the file id
+   *           (see carries_file_id), at most 256:  Short/LongSequenceKmerId keep only 8 bits of it.
+   * @note  file sizes are obtained by rank 0 only then broadcast, to avoid metadata storms on parallel file systems.
+   * @tparam FileType     parallel file type, e.g. partitioned_file or mpiio_file
+   * @return number of sequences and number of kmers read by this process.
+   */
+  template <typename FileType, typename KmerParser, template <typename> class SeqParser, template <typename,  template <typename> class> class SeqIterType>
+  static  ::std::pair<size_t, size_t> read_files(const std::vector<std::string> & filenames,
+                         std::vector<typename KmerParser::value_type>& result,
+                         const mxx::comm & _comm) {
+
+      ::std::pair<size_t, size_t> read = {0, 0};
+      if (filenames.size() == 0) return read;
+      if (filenames.size() > (static_cast<size_t>(std::numeric_limits<uint16_t>::max()) + 1)) {
+        throw std::invalid_argument("read_files: too many files for 16 bit file ids.");
+      }
+      if (carries_file_id<typename KmerParser::value_type>::value &&
+          (filenames.size() > (static_cast<size_t>(std::numeric_limits<uint8_t>::max()) + 1))) {
+        throw std::invalid_argument("read_files: at most 256 files when the kmer ids store the file id (8 bits).");
+      }
+
+      BL_BENCH_INIT(files);
+
+      BL_BENCH_START(files);
+      std::vector<size_t> sizes(filenames.size(), 0);
+      // sizes, then the index of the first file that cannot be stat'ed (or filenames.size()).
+      sizes.push_back(filenames.size());
+      int myerr = 0;
+      if (_comm.rank() == 0) {
+        struct stat filestat;
+        for (size_t i = 0; i < filenames.size(); ++i) {
+          if (stat(filenames[i].c_str(), &filestat) != 0) {
+            myerr = errno;
+            sizes.back() = i;
+            break;
+          }
+          sizes[i] = filestat.st_size;
+        }
+      }
+      ::mxx::bcast(sizes.data(), sizes.size(), 0, _comm);
+      // all processes throw, so none is left waiting in a collective.
+      if (sizes.back() < filenames.size()) {
+        ::mxx::bcast(myerr, 0, _comm);
+        std::stringstream ss;
+        ss << "ERROR in read_files: stat file " << filenames[sizes.back()] << " error " << myerr << ": " << strerror(myerr);
+        throw ::bliss::utils::make_exception<::bliss::io::IOException>(ss.str());
+      }
+      sizes.pop_back();
+
+      multi_file_assignment assignment(sizes, _comm.size());
+      int group = assignment.get_group(_comm.rank());
+      std::vector<size_t> whole_files = assignment.get_whole_files(_comm.rank());
+
+      // collective.  color 0 for processes not in any group.
+      ::mxx::comm group_comm = _comm.split(group + 1);
+      ::mxx::comm self_comm = _comm.split(_comm.rank());
+      BL_BENCH_END(files, "assign", whole_files.size());
+
+      BL_BENCH_START(files);
+      if (group >= 0) {
+        read = read_file<FileType, KmerParser, SeqParser, SeqIterType>(filenames[group], result, group_comm, group);
+      }
+      BL_BENCH_END(files, "read_parallel", read.second);
+
+      BL_BENCH_START(files);
+      for (auto f : whole_files) {
+        auto r = read_whole_file<FileType, KmerParser, SeqParser, SeqIterType>(filenames[f], result, self_comm, f);
+        read.first += r.first;
+        read.second += r.second;
+      }
+      BL_BENCH_END(files, "read_whole", result.size());
+
+      BL_BENCH_REPORT_MPI_NAMED(files, "io:read_files", _comm);
+      return read;
+  }
+
+  /// read a list of files via mmap.  see read_files.
+  template <typename KmerParser, template <typename> class SeqParser, template <typename,  template <typename> class> class SeqIterType>
+  static  ::std::pair<size_t, size_t> read_files_mmap(const std::vector<std::string> & filenames,
+                         std::vector<typename KmerParser::value_type>& result,
+                         const mxx::comm & _comm) {
+      return read_files<::bliss::io::parallel::partitioned_file<::bliss::io::mmap_file, SeqParser >,
+          KmerParser, SeqParser, SeqIterType>(filenames, result, _comm);
+  }
+
+  /// read a list of files via posix.  see read_files.
+  template <typename KmerParser, template <typename> class SeqParser, template <typename,  template <typename> class> class SeqIterType>
+  static  ::std::pair<size_t, size_t> read_files_posix(const std::vector<std::string> & filenames,
+                         std::vector<typename KmerParser::value_type>& result,
+                         const mxx::comm & _comm) {
+      return read_files<::bliss::io::parallel::partitioned_file<::bliss::io::posix_file, SeqParser >,
+          KmerParser, SeqParser, SeqIterType>(filenames, result, _comm);
+  }
+
+  /// read a list of files via mpiio.  see read_files.
+  template <typename KmerParser, template <typename> class SeqParser, template <typename,  template <typename> class> class SeqIterType>
+  static  ::std::pair<size_t, size_t> read_files_mpiio(const std::vector<std::string> & filenames,
+                         std::vector<typename KmerParser::value_type>& result,
+                         const mxx::comm & _comm) {
+      return read_files<::bliss::io::parallel::mpiio_file<SeqParser >,
+          KmerParser, SeqParser, SeqIterType>(filenames, result, _comm);
+  }
+
+  /**
+   * @brief read this rank's balanced slice of a packed read file and generate kmers, place in a vector as return result.
+   * @details  each rank maps its slice directly.  no record boundary search or communication is needed.
+   * @note  static so can be used wihtout instantiating a internal map.
+   * @tparam KmerParser   parser type for generating Kmer.  supports kmer, kmer+pos, kmer+count, kmer+pos/qual.
+   */
+  template <typename KmerParser>
+  static ::std::pair<size_t, size_t> read_file_packed(const std::string & filename,
+                         std::vector<typename KmerParser::value_type>& result,
+                         const mxx::comm & _comm) {
+
+      ::std::pair<size_t, size_t> read = {0, 0};
+
+      BL_BENCH_INIT(file);
+      {  // ensure that file is closed at the end.
+
+        BL_BENCH_START(file);
+        ::bliss::io::packed_reads_file packed(filename, _comm);
+        BL_BENCH_END(file, "open", packed.get_base_range().size());
+
+        BL_BENCH_START(file);
+        read = parse_packed_data<KmerParser>(packed, result);
+        BL_BENCH_END(file, "read_kmers", read.second);
+      }
+
+      BL_BENCH_REPORT_MPI_NAMED(file, "io:read_file_packed", _comm);
+      return read;
+  }
 #endif
 
 
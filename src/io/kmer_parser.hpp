@@ -44,6 +44,9 @@
 #include <utility>      // pair and utility functions.
 #include <type_traits>
 #include <cctype>       // tolower.
+#include <vector>
+#include <iterator>     // back_inserter
+#include <algorithm>    // copy_if
 
 #include "utils/logging.h"
 #include "utils/file_utils.hpp"
@@ -79,10 +82,20 @@ template <typename Iter>
 using NonEOLIter = bliss::iterator::filter_iterator<::bliss::utils::file::NotEOL, Iter>;
 
 
+/**
+ * @brief select kmer generation iterator type.  canonical generation maintains the reverse complement incrementally.
+ */
+template <typename BaseIter, typename KmerType, bool Canonical>
+using KmerGenIter = typename ::std::conditional<Canonical,
+    bliss::common::CanonicalKmerGenerationIterator<BaseIter, KmerType>,
+    bliss::common::KmerGenerationIterator<BaseIter, KmerType> >::type;
+
+
 /**
  * @tparam KmerType       output value type of this parser.  not necessarily the same as the map's final storage type.
+ * @tparam Canonical      generate canonical (lex_less) kmers directly, without per kmer reverse complement.
  */
-template <typename KmerType>
+template <typename KmerType, bool Canonical = false>
 class KmerParser {
 
 public:
@@ -90,6 +103,7 @@ public:
   using value_type = KmerType;
   using kmer_type = KmerType;
   static constexpr size_t window_size = kmer_type::size;
+  static constexpr bool is_canonical = Canonical;
 
 protected:
   using Alphabet = typename kmer_type::KmerAlphabet;
@@ -160,7 +174,7 @@ public:
 
   // kmer generation iterator
   template <typename SeqType>
-  using iterator_type = bliss::common::KmerGenerationIterator<BaseCharIterator<SeqType>, kmer_type>;
+  using iterator_type = KmerGenIter<BaseCharIterator<SeqType>, kmer_type, Canonical>;
 
 
   KmerParser(::bliss::partition::range<size_t> const & _valid_range) : valid_range(_valid_range) {};
@@ -293,14 +307,17 @@ public:
   }
 };
 
-template <typename KmerType>
-constexpr size_t KmerParser<KmerType>::window_size;
+template <typename KmerType, bool Canonical>
+constexpr size_t KmerParser<KmerType, Canonical>::window_size;
+template <typename KmerType, bool Canonical>
+constexpr bool KmerParser<KmerType, Canonical>::is_canonical;
 
 
 /**
  * @tparam TupleType       output value type of this parser.  not necessarily the same as the map's final storage type.
+ * @tparam Canonical      generate canonical (lex_less) kmers directly, without per kmer reverse complement.
  */
-template <typename TupleType>
+template <typename TupleType, bool Canonical = false>
 class KmerPositionTupleParser {
 
 public:
@@ -310,6 +327,7 @@ public:
   using kmer_type = typename ::std::tuple_element<0, value_type>::type;
   using IdType = typename std::tuple_element<1, value_type>::type;
   static constexpr size_t window_size = kmer_type::size;
+  static constexpr bool is_canonical = Canonical;
 
 
 protected:
@@ -325,7 +343,7 @@ protected:
 
   // kmer generation iterator
   template <typename SeqType>
-  using KmerIter = bliss::common::KmerGenerationIterator<BaseCharIterator<SeqType>, kmer_type>;
+  using KmerIter = KmerGenIter<BaseCharIterator<SeqType>, kmer_type, Canonical>;
 
   //== next figure out starting positions for the kmers, accounting for EOL char presenses.
   // kmer position iterator type
@@ -568,13 +586,20 @@ public:
 
 };
 
-template <typename TupleType>
-constexpr size_t KmerPositionTupleParser<TupleType>::window_size;
+template <typename TupleType, bool Canonical>
+constexpr size_t KmerPositionTupleParser<TupleType, Canonical>::window_size;
+template <typename TupleType, bool Canonical>
+constexpr bool KmerPositionTupleParser<TupleType, Canonical>::is_canonical;
 
 /**
+ * @details  the quality type (second element of the mapped pair) may be float, double, or uint8_t/uint16_t.
+ *           integral quality types store the kmer probability in fixed point (see QualityPayloadCodec),
+ *           which shrinks the tuples that are sent over the network.
  * @tparam TupleType       output value type of this parser.  not necessarily the same as the map's final storage type.
+ * @tparam QualityEncoder  quality score codec
+ * @tparam Canonical      generate canonical (lex_less) kmers directly, without per kmer reverse complement.
  */
-template <typename TupleType, template<typename> class QualityEncoder = bliss::index::Illumina18QualityScoreCodec>
+template <typename TupleType, template<typename> class QualityEncoder = bliss::index::Illumina18QualityScoreCodec, bool Canonical = false>
 class KmerPositionQualityTupleParser {
 
 public:
@@ -585,6 +610,7 @@ public:
   using IdType = typename std::tuple_element<0, mapped_type >::type;
   using QualType = typename std::tuple_element<1, mapped_type>::type;
   static constexpr size_t window_size = kmer_type::size;
+  static constexpr bool is_canonical = Canonical;
 
 protected:
   using Alphabet = typename kmer_type::KmerAlphabet;
@@ -601,7 +627,7 @@ protected:
 
   // kmer generation iterator
   template <typename SeqType>
-  using KmerIter = bliss::common::KmerGenerationIterator<BaseCharIterator<SeqType>, kmer_type>;
+  using KmerIter = KmerGenIter<BaseCharIterator<SeqType>, kmer_type, Canonical>;
 
   //== next figure out starting positions for the kmers, accounting for EOL char presenses.
   // kmer position iterator type
@@ -619,10 +645,19 @@ protected:
   using IdIter = bliss::iterator::AdvancingUnzipIterator<CharPosIter<SeqType>, 1>;
 
 
+  /// kmer scores are computed in floating point.  integral QualType is a fixed point payload, converted from the score.
+  using ScoreType = typename std::conditional<std::is_floating_point<QualType>::value, QualType, double>::type;
+  using PayloadCodec = bliss::index::QualityPayloadCodec<QualType, ScoreType>;
+
   // also remove eol from quality score
   template <typename SeqType>
-  using QualIterType =
-      bliss::index::QualityScoreGenerationIterator<NonEOLIter<typename SeqType::IteratorType>, kmer_type::size, QualityEncoder<QualType> >;
+  using QualScoreIterType =
+      bliss::index::QualityScoreGenerationIterator<NonEOLIter<typename SeqType::IteratorType>, kmer_type::size, QualityEncoder<ScoreType> >;
+
+  template <typename SeqType>
+  using QualIterType = typename std::conditional<std::is_floating_point<QualType>::value,
+      QualScoreIterType<SeqType>,
+      bliss::iterator::transform_iterator<QualScoreIterType<SeqType>, PayloadCodec> >::type;
 
   /// combine kmer iterator and position iterator to create an index iterator type.
   template <typename SeqType>
@@ -631,6 +666,29 @@ protected:
 
   ::bliss::partition::range<size_t> valid_range;
 
+  /// block kernel for the quality scores, used by operator().
+  bliss::index::QualityScoreBlockKernel<kmer_type::size, QualityEncoder<ScoreType> > qual_kernel;
+
+  /// non-EOL quality chars of the current read
+  std::vector<unsigned char> qual_chars;
+
+  /// kmer scores of the current read
+  std::vector<ScoreType> qual_scores;
+
+  /// construct the quality iterator, converting to the fixed point payload if needed.
+  template <typename SeqType>
+  static QualIterType<SeqType> make_qual_iter(QualScoreIterType<SeqType> const & it, std::true_type) {
+    return it;
+  }
+  template <typename SeqType>
+  static QualIterType<SeqType> make_qual_iter(QualScoreIterType<SeqType> const & it, std::false_type) {
+    return QualIterType<SeqType>(it, PayloadCodec());
+  }
+  template <typename SeqType>
+  static QualIterType<SeqType> make_qual_iter(QualScoreIterType<SeqType> const & it) {
+    return make_qual_iter<SeqType>(it, std::integral_constant<bool, std::is_floating_point<QualType>::value>());
+  }
+
 public:
   template <typename SeqType>
   using iterator_type = bliss::iterator::ZipIterator<KmerIter<SeqType>, KmerInfoIterType<SeqType> >;
@@ -688,7 +746,7 @@ public:
         		  CharIter<SeqType>(neol, seq_begin, seq_end),
     			  bliss::common::ASCII2<Alphabet>()), true);
           //CharPosIter<SeqType> cp_begin(neol, pp_begin, pp_end);
-          QualIterType<SeqType> qual_start(CharIter<SeqType>(neol, qual_begin, qual_end));
+          QualIterType<SeqType> qual_start = make_qual_iter<SeqType>(QualScoreIterType<SeqType>(CharIter<SeqType>(neol, qual_begin, qual_end)));
           KmerInfoIterType<SeqType> info_start(IdIter<SeqType>(std::make_shared<CharPosIter<SeqType> >(neol, pp_begin, pp_end) ), qual_start);
     	  return iterator_type<SeqType>(start, info_start);
       } else {
@@ -696,7 +754,7 @@ public:
         		  CharIter<SeqType>(neol, seq_end),
     			  bliss::common::ASCII2<Alphabet>()), false);
 //          CharPosIter<SeqType> cp_end(neol, pp_end);
-          QualIterType<SeqType> qual_end_iter(CharIter<SeqType>(neol, qual_end));
+          QualIterType<SeqType> qual_end_iter = make_qual_iter<SeqType>(QualScoreIterType<SeqType>(CharIter<SeqType>(neol, qual_end)));
           KmerInfoIterType<SeqType> info_end(IdIter<SeqType>(std::make_shared<CharPosIter<SeqType> >(neol, pp_end)), qual_end_iter);
           return iterator_type<SeqType>(end, info_end);
       }
@@ -749,7 +807,7 @@ public:
 
       // ==== quality scoring
       // filter eol and generate quality scores
-      QualIterType<SeqType> qual_end_iter(CharIter<SeqType>(neol, qual_end));
+      QualIterType<SeqType> qual_end_iter = make_qual_iter<SeqType>(QualScoreIterType<SeqType>(CharIter<SeqType>(neol, qual_end)));
 
       KmerInfoIterType<SeqType> info_end(IdIter<SeqType>(std::make_shared<CharPosIter<SeqType> >(neol, pp_end)), qual_end_iter);
 
@@ -762,6 +820,8 @@ public:
 
   /**
    * @brief generate kmer-position-quality pairs from 1 sequence.  result inserted into output_iter, which may be preallocated.
+   * @details quality scores are computed for the whole read by QualityScoreBlockKernel instead of the sliding window iterator.
+   *          values are the same as begin()/end() up to floating point rounding.
    * @param read          sequence object, which has pointers to the raw byte array.
    * @param output_iter   output iterator pointing to insertion point for underlying container.
    * @return new position for output_iter
@@ -891,22 +951,51 @@ public:
 //        return ::std::copy(index_start, index_end, output_iter);
 //    }
 
+    typename SeqType::IteratorType seq_begin;
+    typename SeqType::IteratorType seq_end;
+    bool has_window;
+
+    std::tie(seq_begin, seq_end, has_window) =
+        ::bliss::index::kmer::KmerParser<kmer_type>::get_valid_iterator_range(read, valid_range, window_size);
+    if (!has_window) return output_iter;
+
+    // ==== quality scores of all kmers in the read, computed as a block.
+    typename SeqType::IteratorType qual_begin = read.qual_begin;
+    std::advance(qual_begin, std::distance(read.seq_begin, seq_begin));
+    typename SeqType::IteratorType qual_end = qual_begin;
+    std::advance(qual_end, std::distance(seq_begin, seq_end));
+
+    bliss::utils::file::NotEOL neol;
+    qual_chars.clear();
+    std::copy_if(qual_begin, qual_end, std::back_inserter(qual_chars), neol);
+    size_t nkmers = qual_kernel(qual_chars.data(), qual_chars.data() + qual_chars.size(), qual_scores);
+
+    // ==== kmers and positions from the generating iterators.  the quality score iterator is not used.
     iterator_type<SeqType> istart = begin(read, window_size);
     iterator_type<SeqType> iend = end(read, window_size);
+    KmerIter<SeqType> kmer_it = istart.get_first_iterator();
+    KmerIter<SeqType> kmer_end = iend.get_first_iterator();
+    IdIter<SeqType> id_it = istart.get_second_iterator().get_first_iterator();
 
-    return std::copy(istart, iend, output_iter);
+    for (size_t j = 0; (j < nkmers) && (kmer_it != kmer_end); ++j, ++kmer_it, ++id_it, ++output_iter) {
+      *output_iter = value_type(*kmer_it, mapped_type(*id_it, PayloadCodec::encode(qual_scores[j])));
+    }
 
+    return output_iter;
   }
 };
 
-template <typename TupleType, template<typename> class QualityEncoder>
-constexpr size_t KmerPositionQualityTupleParser<TupleType, QualityEncoder>::window_size;
+template <typename TupleType, template<typename> class QualityEncoder, bool Canonical>
+constexpr size_t KmerPositionQualityTupleParser<TupleType, QualityEncoder, Canonical>::window_size;
+template <typename TupleType, template<typename> class QualityEncoder, bool Canonical>
+constexpr bool KmerPositionQualityTupleParser<TupleType, QualityEncoder, Canonical>::is_canonical;
 
 
 /**
  * @tparam TupleType       output value type of this parser.  not necessarily the same as the map's final storage type.
+ * @tparam Canonical      generate canonical (lex_less) kmers directly, without per kmer reverse complement.
  */
-template <typename TupleType>
+template <typename TupleType, bool Canonical = false>
 class KmerCountTupleParser {
 
 public:
@@ -915,6 +1004,7 @@ public:
   using kmer_type = typename ::std::tuple_element<0, value_type>::type;
   using mapped_type = typename ::std::tuple_element<1, value_type>::type;
   static constexpr size_t window_size = kmer_type::size;
+  static constexpr bool is_canonical = Canonical;
 
 protected:
   using Alphabet = typename kmer_type::KmerAlphabet;
@@ -929,7 +1019,7 @@ protected:
 
   // kmer generation iterator
   template <typename SeqType>
-  using KmerIterType = bliss::common::KmerGenerationIterator<BaseCharIterator<SeqType>, kmer_type>;
+  using KmerIterType = KmerGenIter<BaseCharIterator<SeqType>, kmer_type, Canonical>;
 
   /// kmer generation iterator
   using CountIterType = bliss::iterator::ConstantIterator<mapped_type>;
@@ -1081,8 +1171,10 @@ public:
   }
 
 };
-template <typename TupleType>
-constexpr size_t KmerCountTupleParser<TupleType>::window_size;
+template <typename TupleType, bool Canonical>
+constexpr size_t KmerCountTupleParser<TupleType, Canonical>::window_size;
+template <typename TupleType, bool Canonical>
+constexpr bool KmerCountTupleParser<TupleType, Canonical>::is_canonical;
 
 
 } /* namespace kmer */
@@ -0,0 +1,576 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    packed_read_file.hpp
+ * @ingroup io
+ * @author  agent <agent@local>
+ * @brief   preprocessed, 2-bit packed read container, with converter from FASTQ/FASTA and a sliced mmap reader.
+ * @details repeated index construction from the same FASTQ file pays for ascii parsing, record boundary detection,
+ *          and the parallel find_first_record communication every time.  packed_reads_converter does this once and
+ *          writes a binary file that packed_reads_file can mmap directly, one balanced slice per rank.
+ *
+ *          file layout (native endianness, all sections 8 byte aligned):
+ *            header    packed_reads_header, 64 bytes
+ *            offsets   uint64_t[read_count + 1], base offset of the start of each read.  last entry == base_count.
+ *            bases     PackedStringImpl<2> words.  DNA encoding, 32 bases per word.
+ *            nmask     PackedStringImpl<1> words.  bit is set for bases that are not ACGT (decoded as 'N').
+ *            quality   PackedStringImpl<3> words, optional.  quality scores quantized to 8 illumina style bins.
+ *
+ *          sections are packed as one contiguous stream across reads, so read boundaries do not waste bits.
+ *
+ *          the reader exposes each read as a FASTQSequence whose iterators decode ascii bases (and phred+33 quality chars)
+ *          on the fly, so the existing KmerParsers can be used unchanged.  the "file offset" of a read is its base offset
+ *          in the packed stream, and the read index is used as the sequence id.
+ */
+#ifndef PACKED_READ_FILE_HPP_
+#define PACKED_READ_FILE_HPP_
+
+#include "bliss-config.hpp"
+
+#include <unistd.h>     // pwrite, close
+#include <fcntl.h>      // open
+#include <cstring>      // strerror
+#include <cerrno>
+#include <string>
+#include <vector>
+#include <memory>       // unique_ptr
+#include <algorithm>    // lower_bound
+#include <iterator>
+#include <sstream>
+#include <type_traits>
+
+#if defined(USE_MPI)
+#include <mxx/comm.hpp>
+#endif
+
+#include "common/base_types.hpp"
+#include "common/alphabets.hpp"
+#include "common/packed_string.hpp"
+#include "common/sequence.hpp"
+#include "io/io_exception.hpp"
+#include "io/file.hpp"
+#include "io/fastq_loader.hpp"
+#include "io/sequence_iterator.hpp"
+#include "partition/range.hpp"
+#include "utils/exception_handling.hpp"
+#include "utils/file_utils.hpp"
+
+namespace bliss
+{
+namespace io
+{
+
+  /// dummy class to indicate packed read format.
+  struct PackedReads {
+
+  };
+
+  /**
+   * @brief on-disk header of a packed read file.  positions are absolute byte offsets in the file.
+   */
+  struct packed_reads_header {
+      /// "BLPREAD1"
+      static constexpr uint64_t MAGIC = 0x3144414552504C42ULL;
+      static constexpr uint32_t VERSION = 1;
+
+      /// flag bit indicating that the quality section is present.
+      static constexpr uint32_t HAS_QUALITY = 0x1;
+
+      uint64_t magic;
+      uint32_t version;
+      uint32_t flags;
+      uint64_t read_count;
+      uint64_t base_count;
+      uint64_t offsets_pos;
+      uint64_t bases_pos;
+      uint64_t nmask_pos;
+      uint64_t quality_pos;
+
+      packed_reads_header() : magic(MAGIC), version(VERSION), flags(0), read_count(0), base_count(0),
+          offsets_pos(0), bases_pos(0), nmask_pos(0), quality_pos(0) {}
+
+      bool has_quality() const { return (flags & HAS_QUALITY) != 0; }
+
+      /// compute the section positions from read and base counts.  returns the total file size.
+      size_t layout(size_t const & reads, size_t const & bases, bool const & with_quality);
+  };
+
+  /// packed storage for the bases, N mask, and quantized quality scores.
+  using packed_bases_type = ::bliss::common::PackedStringImpl<2>;
+  using packed_nmask_type = ::bliss::common::PackedStringImpl<1>;
+  using packed_quality_type = ::bliss::common::PackedStringImpl<3>;
+
+  inline size_t packed_reads_header::layout(size_t const & reads, size_t const & bases, bool const & with_quality) {
+    read_count = reads;
+    base_count = bases;
+    flags = with_quality ? HAS_QUALITY : 0;
+
+    offsets_pos = sizeof(packed_reads_header);
+    bases_pos = offsets_pos + (reads + 1) * sizeof(uint64_t);
+    nmask_pos = bases_pos + ((bases + packed_bases_type::chars_per_word - 1) / packed_bases_type::chars_per_word) * sizeof(WordType);
+    quality_pos = nmask_pos + ((bases + packed_nmask_type::chars_per_word - 1) / packed_nmask_type::chars_per_word) * sizeof(WordType);
+
+    if (!with_quality) return quality_pos;
+    return quality_pos + ((bases + packed_quality_type::chars_per_word - 1) / packed_quality_type::chars_per_word) * sizeof(WordType);
+  }
+
+
+  /**
+   * @brief quantize phred scores into 8 bins, following the illumina 8 level binning scheme.
+   * @details   bins:  0-1 -> 1, 2-9 -> 6, 10-19 -> 15, 20-24 -> 22, 25-29 -> 27, 30-34 -> 33, 35-39 -> 37, 40+ -> 40
+   *            input and output are phred+33 ascii chars.
+   */
+  struct BinnedQuality {
+      static constexpr uint8_t PHRED_OFFSET = 33;
+
+      static inline uint8_t encode(uint8_t const & c) {
+        uint8_t q = (c < PHRED_OFFSET) ? 0 : (c - PHRED_OFFSET);
+        return (q < 2) ? 0 :
+               (q < 10) ? 1 :
+               (q < 20) ? 2 :
+               (q < 25) ? 3 :
+               (q < 30) ? 4 :
+               (q < 35) ? 5 :
+               (q < 40) ? 6 : 7;
+      }
+
+      static inline uint8_t decode(uint8_t const & bin) {
+        static constexpr uint8_t reps[8] = {1, 6, 15, 22, 27, 33, 37, 40};
+        return reps[bin & 0x7] + PHRED_OFFSET;
+      }
+  };
+
+
+  /**
+   * @brief view over the (mapped) packed sections.  decodes one base or one quality char at a time.
+   * @details  each section pointer refers to the first mapped word, and *_first is the global char index of the
+   *           first char in that word, so global base positions can be used directly.
+   */
+  struct packed_reads_view {
+      const WordType * bases;
+      size_t bases_first;
+      const WordType * nmask;
+      size_t nmask_first;
+      const WordType * quality;
+      size_t quality_first;
+
+      packed_reads_view() : bases(nullptr), bases_first(0), nmask(nullptr), nmask_first(0), quality(nullptr), quality_first(0) {}
+
+      /// ascii base at global base position pos.
+      inline unsigned char base(size_t const & pos) const {
+        if (packed_nmask_type::unpackCharAt(nmask, pos - nmask_first) != 0) return 'N';
+        return ::bliss::common::DNA::TO_ASCII[packed_bases_type::unpackCharAt(bases, pos - bases_first)];
+      }
+
+      /// phred+33 quality char at global base position pos.  files without quality report the top bin.
+      inline unsigned char qual(size_t const & pos) const {
+        if (quality == nullptr) return BinnedQuality::decode(7);
+        return BinnedQuality::decode(packed_quality_type::unpackCharAt(quality, pos - quality_first));
+      }
+  };
+
+
+  /**
+   * @brief random access iterator that decodes ascii bases, or quality chars, from a packed_reads_view.
+   * @details  one iterator type for both so that it can be used as the iterator type of a FASTQSequence.
+   */
+  class PackedReadsIterator : public std::iterator<std::random_access_iterator_tag, unsigned char, std::ptrdiff_t, const unsigned char *, unsigned char>
+  {
+    protected:
+      using D = std::ptrdiff_t;
+
+      /// the view to decode from.
+      const packed_reads_view * view;
+
+      /// global base position
+      size_t pos;
+
+      /// true if iterating quality chars, false for bases
+      bool quality;
+
+    public:
+      PackedReadsIterator() : view(nullptr), pos(0), quality(false) {}
+
+      PackedReadsIterator(const packed_reads_view * _view, size_t const & _pos, bool const & _quality = false) :
+        view(_view), pos(_pos), quality(_quality) {}
+
+      PackedReadsIterator(PackedReadsIterator const & other) = default;
+      PackedReadsIterator& operator=(PackedReadsIterator const & other) = default;
+
+      /// global base position this iterator points to.
+      size_t get_pos() const { return pos; }
+
+      unsigned char operator*() const {
+        return quality ? view->qual(pos) : view->base(pos);
+      }
+
+      unsigned char operator[](D const & i) const {
+        return quality ? view->qual(pos + i) : view->base(pos + i);
+      }
+
+      PackedReadsIterator& operator++() { ++pos; return *this; }
+      PackedReadsIterator operator++(int) { PackedReadsIterator out(*this); ++pos; return out; }
+      PackedReadsIterator& operator--() { --pos; return *this; }
+      PackedReadsIterator operator--(int) { PackedReadsIterator out(*this); --pos; return out; }
+
+      PackedReadsIterator& operator+=(D const & diff) { pos += diff; return *this; }
+      PackedReadsIterator& operator-=(D const & diff) { pos -= diff; return *this; }
+      PackedReadsIterator operator+(D const & diff) const { return PackedReadsIterator(view, pos + diff, quality); }
+      PackedReadsIterator operator-(D const & diff) const { return PackedReadsIterator(view, pos - diff, quality); }
+      friend PackedReadsIterator operator+(D const & diff, PackedReadsIterator const & it) { return it + diff; }
+
+      D operator-(PackedReadsIterator const & other) const {
+        return static_cast<D>(pos) - static_cast<D>(other.pos);
+      }
+
+      bool operator==(PackedReadsIterator const & other) const { return pos == other.pos; }
+      bool operator!=(PackedReadsIterator const & other) const { return pos != other.pos; }
+      bool operator<(PackedReadsIterator const & other) const { return pos < other.pos; }
+      bool operator>(PackedReadsIterator const & other) const { return pos > other.pos; }
+      bool operator<=(PackedReadsIterator const & other) const { return pos <= other.pos; }
+      bool operator>=(PackedReadsIterator const & other) const { return pos >= other.pos; }
+  };
+
+
+  /**
+   * @brief converts a FASTQ or FASTA file into the packed read format.
+   * @details  2 passes over the memory mapped input.  the first pass collects the record offsets and counts the bases,
+   *           so the section positions are known.  the second pass packs the bases, N mask, and qualities
+   *           in chunks (aligned to whole storage words for all 3 sections) and writes them with pwrite.
+   *           FASTA records are stored as 1 read each, with EOL characters removed.
+   *           This is an offline, serial operation.
+   */
+  class packed_reads_converter {
+
+    protected:
+      /// chunk size in bases.  multiple of the chars per word of all 3 packed sections (lcm(32, 64, 21) = 1344)
+      static constexpr size_t chunk_size = 1344UL * 1024UL;
+
+      using range_type = ::bliss::partition::range<size_t>;
+
+      int fd;
+      std::string filename;
+      packed_reads_header header;
+
+      /// unpacked chunk buffers
+      std::vector<uint8_t> bases;
+      std::vector<uint8_t> nmask;
+      std::vector<uint8_t> quality;
+
+      /// number of bases written so far.
+      size_t written;
+
+      void write_bytes(const void * data, size_t const & bytes, size_t const & pos) {
+        const char * ptr = reinterpret_cast<const char *>(data);
+        size_t done = 0;
+        while (done < bytes) {
+          ssize_t res = pwrite(fd, ptr + done, bytes - done, pos + done);
+          if (res < 0) {
+            std::stringstream ss;
+            int myerr = errno;
+            ss << "ERROR in packed_reads_converter pwrite: file " << filename << " error " << myerr << ": " << strerror(myerr);
+            throw ::bliss::utils::make_exception<::bliss::io::IOException>(ss.str());
+          }
+          done += res;
+        }
+      }
+
+      template <typename Packed>
+      void write_section(std::vector<uint8_t> const & chars, size_t const & count, size_t const & section_pos) {
+        if (count == 0) return;
+        Packed packed(chars.begin(), chars.begin() + count);
+        write_bytes(packed.data(), packed.word_count() * sizeof(WordType),
+                    section_pos + (written / Packed::chars_per_word) * sizeof(WordType));
+      }
+
+      /// pack and write the first count entries of the buffers.  count is a multiple of chunk_size except for the last flush.
+      void flush(size_t const & count) {
+        write_section<packed_bases_type>(bases, count, header.bases_pos);
+        write_section<packed_nmask_type>(nmask, count, header.nmask_pos);
+        if (header.has_quality()) write_section<packed_quality_type>(quality, count, header.quality_pos);
+        written += count;
+
+        bases.erase(bases.begin(), bases.begin() + count);
+        nmask.erase(nmask.begin(), nmask.begin() + count);
+        quality.erase(quality.begin(), quality.begin() + std::min(count, quality.size()));
+      }
+
+      /// append the quality chars of a FASTQ record.
+      template <typename Iter>
+      void append_quality(::bliss::io::FASTQSequence<Iter, true> const & seq) {
+        for (auto it = seq.qual_begin; it != seq.qual_end; ++it) {
+          quality.push_back(BinnedQuality::encode(*it));
+        }
+      }
+      /// no quality in other record types.
+      template <typename SeqType>
+      void append_quality(SeqType const &) {}
+
+      template <typename SeqType>
+      void append(SeqType const & seq) {
+        ::bliss::utils::file::NotEOL not_eol;
+        for (auto it = seq.seq_begin; it != seq.seq_end; ++it) {
+          if (!not_eol(*it)) continue;
+          uint8_t c = *it;
+          uint8_t v = ::bliss::common::DNA::FROM_ASCII[c];
+          bases.push_back(v);
+          // non-ACGT characters are masked.
+          nmask.push_back(::bliss::common::DNA::TO_ASCII[v] != (c & 0xDF) ? 1 : 0);
+        }
+        if (header.has_quality()) append_quality(seq);
+
+        if (bases.size() >= chunk_size) flush((bases.size() / chunk_size) * chunk_size);
+      }
+
+      template <typename SeqType>
+      static size_t count_bases(SeqType const & seq) {
+        ::bliss::utils::file::NotEOL not_eol;
+        size_t count = 0;
+        for (auto it = seq.seq_begin; it != seq.seq_end; ++it) {
+          if (not_eol(*it)) ++count;
+        }
+        return count;
+      }
+
+      packed_reads_converter(std::string const & _filename) : fd(-1), filename(_filename), written(0) {}
+
+      ~packed_reads_converter() {
+        if (fd != -1) close(fd);
+      }
+
+    public:
+
+      /**
+       * @brief convert a FASTQ or FASTA file into packed read format.
+       * @tparam SeqParser   FASTQParser or FASTAParser
+       * @param input         input sequence file name
+       * @param output        output packed read file name
+       * @param keep_quality  store quantized quality scores.  ignored for FASTA.
+       * @return  number of reads and number of bases written.
+       */
+      template <template <typename> class SeqParser>
+      static std::pair<size_t, size_t> convert(std::string const & input, std::string const & output, bool keep_quality = true) {
+        using CharIterType = unsigned char *;
+        using SeqIterType = ::bliss::io::SequencesIterator<CharIterType, SeqParser>;
+
+        ::bliss::io::mmap_file fobj(input);
+        range_type file_range(0, fobj.size());
+        if (file_range.size() == 0) throw std::invalid_argument("input file is empty.");
+
+        ::bliss::io::mapped_data md = fobj.map(file_range);
+        CharIterType data = md.get_data();
+
+        SeqParser<CharIterType> seq_parser;
+        size_t offset = seq_parser.init_parser(data, file_range, file_range, file_range);
+
+        //==== pass 1: record offsets and base count.
+        std::vector<uint64_t> offsets;
+        size_t base_count = 0;
+        {
+          SeqIterType seqs_start(seq_parser, data + offset, data + file_range.end, offset);
+          SeqIterType seqs_end(data + file_range.end);
+          for (; seqs_start != seqs_end; ++seqs_start) {
+            offsets.push_back(base_count);
+            base_count += count_bases(*seqs_start);
+          }
+        }
+        offsets.push_back(base_count);
+
+        packed_reads_converter conv(output);
+        bool with_quality = keep_quality &&
+            std::is_same<SeqParser<CharIterType>, ::bliss::io::FASTQParser<CharIterType> >::value;
+        conv.header.layout(offsets.size() - 1, base_count, with_quality);
+
+        conv.fd = open(output.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+        if (conv.fd == -1) {
+          std::stringstream ss;
+          int myerr = errno;
+          ss << "ERROR in packed_reads_converter open: file " << output << " error " << myerr << ": " << strerror(myerr);
+          throw ::bliss::utils::make_exception<::bliss::io::IOException>(ss.str());
+        }
+
+        conv.write_bytes(&(conv.header), sizeof(packed_reads_header), 0);
+        conv.write_bytes(offsets.data(), offsets.size() * sizeof(uint64_t), conv.header.offsets_pos);
+
+        //==== pass 2: pack the bases.
+        conv.bases.reserve(2 * chunk_size);
+        conv.nmask.reserve(2 * chunk_size);
+        if (with_quality) conv.quality.reserve(2 * chunk_size);
+        {
+          SeqIterType seqs_start(seq_parser, data + offset, data + file_range.end, offset);
+          SeqIterType seqs_end(data + file_range.end);
+          for (; seqs_start != seqs_end; ++seqs_start) {
+            conv.append(*seqs_start);
+          }
+        }
+        conv.flush(conv.bases.size());
+
+        if (conv.written != base_count) {
+          throw ::bliss::utils::make_exception<std::logic_error>("ERROR: packed_reads_converter wrote different number of bases than counted.");
+        }
+
+        return std::make_pair(offsets.size() - 1, base_count);
+      }
+  };
+
+
+  /**
+   * @brief reader for packed read files.  memory maps the slice of reads assigned to this process.
+   * @details  reads are partitioned so that each slice has approximately base_count / slice_count bases,
+   *           and each read is assigned to the slice containing its first base.  Slices are computed from the
+   *           record offset index alone, so no communication is required.
+   */
+  class packed_reads_file {
+    public:
+      using range_type = ::bliss::partition::range<size_t>;
+      using iterator = PackedReadsIterator;
+      using sequence_type = ::bliss::io::FASTQSequence<iterator>;
+
+    protected:
+      ::bliss::io::mmap_file fobj;
+
+      packed_reads_header header;
+
+      /// mapped record offsets (whole section), bases, nmask, and quality (slice only)
+      std::unique_ptr<::bliss::io::mapped_data> offsets_md;
+      std::unique_ptr<::bliss::io::mapped_data> bases_md;
+      std::unique_ptr<::bliss::io::mapped_data> nmask_md;
+      std::unique_ptr<::bliss::io::mapped_data> quality_md;
+
+      const uint64_t * offsets;
+
+      /// decoder for the mapped sections.
+      packed_reads_view view;
+
+      /// reads in this slice
+      range_type read_range;
+      /// bases in this slice
+      range_type base_range;
+
+      /// map a section, return pointer to byte "target.start".
+      const unsigned char * map_section(std::unique_ptr<::bliss::io::mapped_data> & md, range_type const & target) {
+        if (target.size() == 0) return nullptr;
+        md.reset(new ::bliss::io::mapped_data(fobj.map(target)));
+        return md->get_data() + (target.start - md->get_range().start);
+      }
+
+      /// map the words covering [base_range) of a section with Packed layout.  return pointer to first word, and set first char index.
+      template <typename Packed>
+      const WordType * map_packed(std::unique_ptr<::bliss::io::mapped_data> & md, size_t const & section_pos, size_t & first) {
+        size_t word_start = base_range.start / Packed::chars_per_word;
+        size_t word_end = (base_range.end + Packed::chars_per_word - 1) / Packed::chars_per_word;
+        first = word_start * Packed::chars_per_word;
+        return reinterpret_cast<const WordType *>(
+            map_section(md, range_type(section_pos + word_start * sizeof(WordType), section_pos + word_end * sizeof(WordType))));
+      }
+
+      void init(int const & slice_id, int const & slice_count) {
+        if (fobj.size() < sizeof(packed_reads_header)) {
+          throw ::bliss::utils::make_exception<::bliss::io::IOException>("ERROR: packed read file is too small: " + fobj.get_filename());
+        }
+
+        {
+          ::bliss::io::mapped_data md = fobj.map(range_type(0, sizeof(packed_reads_header)));
+          memcpy(&header, md.get_data(), sizeof(packed_reads_header));
+        }
+        if ((header.magic != packed_reads_header::MAGIC) || (header.version != packed_reads_header::VERSION)) {
+          throw ::bliss::utils::make_exception<::bliss::io::IOException>("ERROR: not a packed read file, or unsupported version: " + fobj.get_filename());
+        }
+        packed_reads_header expected;
+        if (expected.layout(header.read_count, header.base_count, header.has_quality()) > fobj.size()) {
+          throw ::bliss::utils::make_exception<::bliss::io::IOException>("ERROR: packed read file is truncated: " + fobj.get_filename());
+        }
+
+        // map the offset index.  the binary search only touches a few pages.
+        offsets = reinterpret_cast<const uint64_t *>(map_section(offsets_md,
+            range_type(header.offsets_pos, header.offsets_pos + (header.read_count + 1) * sizeof(uint64_t))));
+
+        // balanced partition by base count.  a read goes to the slice where it starts.
+        auto slice_start = [this, &slice_count](int const & i) -> size_t {
+          size_t target = (header.base_count / slice_count) * i + std::min(static_cast<size_t>(i), header.base_count % slice_count);
+          return std::lower_bound(offsets, offsets + header.read_count, target) - offsets;
+        };
+        read_range.start = slice_start(slice_id);
+        read_range.end = (slice_id + 1 >= slice_count) ? header.read_count : slice_start(slice_id + 1);
+        base_range.start = offsets[read_range.start];
+        base_range.end = offsets[read_range.end];
+
+        view.bases = map_packed<packed_bases_type>(bases_md, header.bases_pos, view.bases_first);
+        view.nmask = map_packed<packed_nmask_type>(nmask_md, header.nmask_pos, view.nmask_first);
+        if (header.has_quality())
+          view.quality = map_packed<packed_quality_type>(quality_md, header.quality_pos, view.quality_first);
+      }
+
+    public:
+
+      /**
+       * @brief open a packed read file and map the slice_id-th of slice_count balanced slices.
+       */
+      packed_reads_file(std::string const & _filename, int const & slice_id = 0, int const & slice_count = 1) :
+        fobj(_filename), offsets(nullptr) {
+        if ((slice_count < 1) || (slice_id < 0) || (slice_id >= slice_count)) throw std::invalid_argument("invalid packed read slice id or count");
+        init(slice_id, slice_count);
+      }
+
+#if defined(USE_MPI)
+      /**
+       * @brief open a packed read file and map this rank's slice.
+       */
+      packed_reads_file(std::string const & _filename, const mxx::comm & _comm) :
+        packed_reads_file(_filename, _comm.rank(), _comm.size()) {}
+#endif
+
+      // the view is referenced by the iterators, so no copy or move.
+      packed_reads_file(packed_reads_file const & other) = delete;
+      packed_reads_file& operator=(packed_reads_file const & other) = delete;
+
+      /// header of the file
+      packed_reads_header const & get_header() const { return header; }
+
+      /// range of read indices in this slice
+      range_type const & get_read_range() const { return read_range; }
+
+      /// range of global base positions in this slice.  use as the valid range for kmer parsers.
+      range_type const & get_base_range() const { return base_range; }
+
+      /// total number of reads in the file
+      size_t read_count() const { return header.read_count; }
+
+      /// total number of bases in the file
+      size_t base_count() const { return header.base_count; }
+
+      /// true if the file contains quantized quality scores
+      bool has_quality() const { return header.has_quality(); }
+
+      /**
+       * @brief get the i-th read in the file.  i has to be in get_read_range().
+       * @details  the sequence id uses the read's base offset as file position, and i as the sequence id.
+       */
+      sequence_type get_sequence(size_t const & i) const {
+        size_t start = offsets[i];
+        size_t end = offsets[i + 1];
+        return sequence_type(typename sequence_type::IdType(start, i), end - start, 0,
+                             iterator(&view, start, false), iterator(&view, end, false),
+                             iterator(&view, start, true), iterator(&view, end, true));
+      }
+  };
+
+
+} /* namespace io */
+} /* namespace bliss */
+
+#endif /* PACKED_READ_FILE_HPP_ */
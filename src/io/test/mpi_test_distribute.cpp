@@ -522,6 +522,40 @@ TEST_P(DistributeTest, distribute_rt)
   imxx::undistribute(distributed, recv_counts, mapping, this->roundtripped, comm, true);
 }
 
+TEST_P(DistributeTest, distribute_arena)
+{
+
+  ::mxx::comm comm;
+
+  this->init(comm);
+
+  // distribute
+  int p = comm.size();
+  std::vector<size_t> recv_counts;
+  imxx::exchange_arena arena;
+
+  // repeated rounds reuse the arena's send buffer and mapping.
+  size_t bytes = 0;
+  for (int round = 0; round < 3; ++round) {
+    this->distributed.assign(this->data.begin(), this->data.end());
+    imxx::distribute(this->distributed, [&p](T const & x ){ return x.first % p; },
+                     recv_counts, arena, comm);
+    if (round == 0) bytes = arena.retained_bytes();
+  }
+  EXPECT_EQ(bytes, arena.retained_bytes());
+  for (auto const & x : this->distributed) EXPECT_EQ(comm.rank(), static_cast<int>(x.first % p));
+
+  if (this->data.size() == 0) return;
+
+  // exchange the distributed entries back.  the local storage goes to the arena.
+  std::vector<T> back(this->distributed);
+  imxx::exchange(back, recv_counts, arena, comm);
+  EXPECT_EQ(this->data.size(), back.size());
+  EXPECT_EQ(bytes + this->distributed.size() * sizeof(T), arena.retained_bytes());
+
+  this->roundtripped.clear();
+}
+
 TEST_P(DistributeTest, scatter_compute_gather)
 {
 
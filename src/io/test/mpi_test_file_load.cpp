@@ -356,6 +356,66 @@ INSTANTIATE_TYPED_TEST_CASE_P(Bliss, FASTQMPILoadTest, FASTQMPILoadTestTypes);
 
 
 
+/// check node aggregated partitions:  non-overlapping valid ranges that cover the file, and data same as in file.
+template <template <typename> class FileParser>
+void check_node_aggregated(std::string const & fileName, size_t const & overlap) {
+  ::mxx::comm comm;
+
+  ::bliss::io::parallel::node_aggregated_file<FileParser> fobj(fileName, overlap, comm);
+  ::bliss::io::shared_file_data fdata;
+  fobj.read_file(fdata);
+
+  ::mxx::comm const & ordered = fobj.get_comm();
+
+  ASSERT_TRUE(fobj.size() > 0);
+  ASSERT_EQ(fdata.parent_range_bytes.end, fobj.size());
+
+  // in memory data is in the node's shared memory
+  ASSERT_TRUE(fobj.get_node_range().contains(fdata.in_mem_range_bytes));
+  ASSERT_TRUE(fdata.in_mem_range_bytes.start <= fdata.valid_range_bytes.start);
+  ASSERT_TRUE(fdata.in_mem_range_bytes.end >= fdata.valid_range_bytes.end);
+
+  // partitions are in order in the renumbered communicator and cover the file.
+  std::vector<size_t> begins = mxx::allgather(fdata.valid_range_bytes.start, ordered);
+  std::vector<size_t> ends = mxx::allgather(fdata.valid_range_bytes.end, ordered);
+
+  ASSERT_EQ(begins.front(), 0UL);
+  ASSERT_EQ(ends.back(), fobj.size());
+  for (int i = 1; i < ordered.size(); ++i) {
+    ASSERT_EQ(ends[i-1], begins[i]);
+  }
+
+  if (fdata.in_mem_range_bytes.size() > 0) {
+    std::vector<unsigned char> gold(fdata.in_mem_range_bytes.size());
+    int fd = open(fileName.c_str(), O_RDONLY);
+    ASSERT_EQ(static_cast<long>(gold.size()), pread(fd, gold.data(), gold.size(), fdata.in_mem_range_bytes.start));
+    close(fd);
+
+    ASSERT_TRUE(std::equal(gold.begin(), gold.end(), fdata.in_mem_cbegin()));
+  }
+
+  comm.barrier();
+}
+
+TEST(NodeAggregatedFileTest, read_fasta)
+{
+  std::string fileName(PROJ_SRC_DIR);
+  fileName.append("/test/data/test.medium.fasta");
+
+  check_node_aggregated<::bliss::io::BaseFileParser>(fileName, 0);
+  check_node_aggregated<::bliss::io::FASTAParser>(fileName, 30);
+}
+
+TEST(NodeAggregatedFileTest, read_fastq)
+{
+  std::string fileName(PROJ_SRC_DIR);
+  fileName.append("/test/data/test.medium.fastq");
+
+  check_node_aggregated<::bliss::io::FASTQParser>(fileName, 0);
+}
+
+
+
 #endif
 
 
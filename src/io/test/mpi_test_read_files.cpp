@@ -0,0 +1,198 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * mpi_test_read_files.cpp
+ *
+ * reading a list of files tags each kmer with the index of its file.  kmer ids keep 8 bits of it, so at most 256 files
+ * when the parsed values store the file id.  kmer only parsers are not limited.
+ */
+
+#include "bliss-config.hpp"
+
+// include google test
+#include <gtest/gtest.h>
+
+#if defined(USE_MPI)
+#include "mxx/env.hpp"
+#include "mxx/comm.hpp"
+#include "mxx/collective.hpp"
+#include "mxx/reduction.hpp"
+
+#include <cstdint>
+#include <cstdio>     // remove
+#include <unistd.h>   // getpid
+#include <string>
+#include <vector>
+#include <map>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "common/kmer.hpp"
+#include "common/alphabets.hpp"
+#include "common/sequence.hpp"
+#include "io/kmer_file_helper.hpp"
+#include "io/kmer_parser.hpp"
+#include "io/fastq_loader.hpp"
+#include "io/sequence_iterator.hpp"
+
+
+using KmerType = ::bliss::common::Kmer<21, ::bliss::common::DNA, uint64_t>;
+using TupleType = ::std::pair<KmerType, ::bliss::common::ShortSequenceKmerId>;
+using ParserType = ::bliss::index::kmer::KmerPositionTupleParser<TupleType>;
+using KmerParserType = ::bliss::index::kmer::KmerParser<KmerType>;
+
+static_assert(::bliss::io::carries_file_id<TupleType>::value, "position tuples store the file id");
+static_assert(!::bliss::io::carries_file_id<KmerType>::value, "kmers do not store the file id");
+static_assert(!::bliss::io::carries_file_id<::std::pair<KmerType, uint32_t> >::value, "counts do not store the file id");
+
+
+class ReadFilesTest : public ::testing::Test {
+  protected:
+    ::mxx::comm comm;
+    std::vector<std::string> filenames;
+
+    /// one 21 base read per file, with the file index in the first 5 bases.
+    static std::string read_of(size_t const & f) {
+      const char bases[] = "ACGT";
+      std::string s(21, 'A');
+      for (size_t i = 0, x = f; i < 5; ++i, x >>= 2) s[i] = bases[x & 0x3];
+      return s;
+    }
+
+    static KmerType kmer_of(size_t const & f) {
+      std::string s = read_of(f);
+      KmerType km;
+      for (char c : s) km.nextFromChar(KmerType::KmerAlphabet::FROM_ASCII[static_cast<unsigned char>(c)]);
+      return km;
+    }
+
+    void make_files(size_t const & count) {
+      // same names on all ranks.
+      int pid = getpid();
+      ::mxx::bcast(pid, 0, comm);
+
+      for (size_t f = 0; f < count; ++f) {
+        std::stringstream ss;
+        ss << "/tmp/bliss_read_files_" << pid << "_" << f << ".fastq";
+        filenames.push_back(ss.str());
+        if (comm.rank() == 0) {
+          std::ofstream ofs(filenames.back());
+          ofs << "@read" << f << "\n" << read_of(f) << "\n+\n" << std::string(21, 'I') << "\n";
+        }
+      }
+      comm.barrier();
+    }
+
+    virtual void TearDown() {
+      comm.barrier();
+      if (comm.rank() == 0) {
+        for (auto const & n : filenames) std::remove(n.c_str());
+      }
+      filenames.clear();
+    }
+};
+
+
+TEST_F(ReadFilesTest, file_ids)
+{
+  // the maximum:  file ids 0 to 255.
+  this->make_files(256);
+
+  std::vector<TupleType> result;
+  ::bliss::io::KmerFileHelper::template read_files_posix<ParserType, ::bliss::io::FASTQParser,
+    ::bliss::io::SequencesIterator>(this->filenames, result, this->comm);
+
+  std::map<KmerType, size_t> file_of;
+  for (size_t f = 0; f < this->filenames.size(); ++f) file_of[this->kmer_of(f)] = f;
+
+  std::vector<int> seen(this->filenames.size(), 0);
+  for (auto const & t : result) {
+    auto it = file_of.find(t.first);
+    ASSERT_TRUE(it != file_of.end());
+    EXPECT_EQ(it->second, static_cast<size_t>(t.second.get_file_id()));
+    ++seen[t.second.get_file_id()];
+  }
+
+  // every file read exactly once, over all ranks.
+  seen = ::mxx::allreduce(seen, this->comm);
+  for (size_t f = 0; f < seen.size(); ++f) EXPECT_EQ(1, seen[f]) << "file " << f;
+}
+
+TEST_F(ReadFilesTest, too_many_files)
+{
+  // file 256 would alias file 0 in the 8 bit file id.
+  this->make_files(257);
+
+  std::vector<TupleType> result;
+  EXPECT_THROW((::bliss::io::KmerFileHelper::template read_files_posix<ParserType, ::bliss::io::FASTQParser,
+                ::bliss::io::SequencesIterator>(this->filenames, result, this->comm)), std::invalid_argument);
+}
+
+TEST_F(ReadFilesTest, many_files_kmers_only)
+{
+  // no file id stored, so more than 256 files are fine.
+  this->make_files(300);
+
+  std::vector<KmerType> result;
+  ::bliss::io::KmerFileHelper::template read_files_posix<KmerParserType, ::bliss::io::FASTQParser,
+    ::bliss::io::SequencesIterator>(this->filenames, result, this->comm);
+
+  std::map<KmerType, size_t> file_of;
+  for (size_t f = 0; f < this->filenames.size(); ++f) file_of[this->kmer_of(f)] = f;
+
+  std::vector<int> seen(this->filenames.size(), 0);
+  for (auto const & k : result) {
+    auto it = file_of.find(k);
+    ASSERT_TRUE(it != file_of.end());
+    ++seen[it->second];
+  }
+  seen = ::mxx::allreduce(seen, this->comm);
+  for (size_t f = 0; f < seen.size(); ++f) EXPECT_EQ(1, seen[f]) << "file " << f;
+}
+
+TEST_F(ReadFilesTest, missing_file)
+{
+  // every process throws, none waits in the size broadcast.
+  this->make_files(3);
+  std::vector<std::string> names(this->filenames);
+  names.insert(names.begin() + 1, names[0] + ".missing.fastq");
+
+  std::vector<TupleType> result;
+  EXPECT_THROW((::bliss::io::KmerFileHelper::template read_files_posix<ParserType, ::bliss::io::FASTQParser,
+                ::bliss::io::SequencesIterator>(names, result, this->comm)), ::bliss::io::IOException);
+}
+
+#endif
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+#if defined(USE_MPI)
+  ::mxx::env e(argc, argv);
+  ::mxx::comm comm;
+
+  result = RUN_ALL_TESTS();
+
+  comm.barrier();
+#endif
+
+  return result;
+}
@@ -229,6 +229,28 @@ TEST_P(BucketTest, bucket)
                                    this->p.first, this->p.last);
 }
 
+TEST_P(BucketTest, bucket_arena)
+{
+	this->bcounts.clear();
+	this->unbucketed.clear();
+  this->mapping.clear();
+
+  // allocate.
+  this->bucketed.resize(this->p.input_size);
+
+  BucketTestInfo pp = this->p;
+  imxx::exchange_arena arena;
+
+  size_t bytes = 0;
+  for (int round = 0; round < 2; ++round) {
+    imxx::local::bucketing_impl(this->data, [&pp](std::pair<size_t, size_t> const & x){ return x.first % pp.bucket_count; },
+		  this->p.bucket_count, this->bcounts,   this->bucketed,
+                                   this->p.first, this->p.last, &arena);
+    if (round == 0) bytes = arena.retained_bytes();
+  }
+  EXPECT_EQ(bytes, arena.retained_bytes());
+}
+
 TEST_P(BucketTest, mxx_bucket)
 {
 	this->bcounts.clear();
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// include google test
+#include <gtest/gtest.h>
+#include "io/exchange_arena.hpp"
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+
+TEST(ExchangeArena, get_retains_capacity)
+{
+  imxx::exchange_arena arena;
+
+  std::vector<uint64_t> & v = arena.get<uint64_t>(imxx::exchange_arena::QUERY);
+  v.resize(1000);
+  uint64_t * data = v.data();
+
+  // same slot and type:  same vector, emptied, capacity kept.
+  std::vector<uint64_t> & w = arena.get<uint64_t>(imxx::exchange_arena::QUERY);
+  EXPECT_EQ(&v, &w);
+  EXPECT_EQ(0UL, w.size());
+  w.resize(1000);
+  EXPECT_EQ(data, w.data());
+
+  // other slot or other type:  other vector.
+  EXPECT_NE(static_cast<void *>(&v), static_cast<void *>(&(arena.get<uint64_t>(imxx::exchange_arena::I2O))));
+  EXPECT_NE(static_cast<void *>(&v), static_cast<void *>(&(arena.get<uint32_t>(imxx::exchange_arena::QUERY))));
+
+  EXPECT_EQ(1000 * sizeof(uint64_t), arena.retained_bytes());
+}
+
+TEST(ExchangeArena, acquire_release)
+{
+  imxx::exchange_arena arena;
+  using T = std::pair<uint64_t, uint32_t>;
+
+  std::vector<T> results;
+  arena.acquire(imxx::exchange_arena::RESULTS, results);
+  EXPECT_EQ(0UL, results.capacity());
+
+  results.resize(500);
+  T * data = results.data();
+  arena.release(imxx::exchange_arena::RESULTS, results);
+  EXPECT_EQ(0UL, results.capacity());
+  EXPECT_EQ(500 * sizeof(T), arena.retained_bytes());
+
+  // the retained storage comes back.
+  arena.acquire(imxx::exchange_arena::RESULTS, results);
+  EXPECT_EQ(data, results.data());
+  EXPECT_EQ(0UL, results.size());
+  EXPECT_EQ(0UL, arena.retained_bytes());
+
+  // high water mark:  the smaller storage is dropped.
+  std::vector<T> small(10);
+  arena.release(imxx::exchange_arena::RESULTS, results);
+  arena.release(imxx::exchange_arena::RESULTS, small);
+  EXPECT_EQ(500 * sizeof(T), arena.retained_bytes());
+}
+
+TEST(ExchangeArena, trim)
+{
+  imxx::exchange_arena arena;
+  arena.get<uint8_t>(imxx::exchange_arena::TEMP).resize(100);
+  arena.get<uint64_t>(imxx::exchange_arena::I2O).resize(1000);
+  arena.get<uint32_t>(imxx::exchange_arena::QUERY).resize(1000);
+  EXPECT_EQ(12100UL, arena.retained_bytes());
+
+  // largest first.
+  arena.trim(5000);
+  EXPECT_EQ(4100UL, arena.retained_bytes());
+  EXPECT_EQ(0UL, arena.get<uint64_t>(imxx::exchange_arena::I2O).capacity());
+
+  arena.trim();
+  EXPECT_EQ(0UL, arena.retained_bytes());
+
+  // copies do not carry the buffers.
+  arena.get<uint64_t>(imxx::exchange_arena::I2O).resize(1000);
+  imxx::exchange_arena copy(arena);
+  EXPECT_EQ(0UL, copy.retained_bytes());
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * test_file_prefetcher.cpp
+ *
+ * test the asynchronous chunk reader, and FASTQ record alignment of its chunks.
+ */
+
+#include "bliss-config.hpp"    // for location of data.
+
+// include google test
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+#include "common/kmer.hpp"
+#include "common/alphabets.hpp"
+#include "io/file_prefetcher.hpp"
+#include "io/kmer_file_helper.hpp"
+
+
+using range_type = ::bliss::partition::range<size_t>;
+
+/// whole file content
+std::vector<unsigned char> get_gold(std::string const & filename) {
+  ::bliss::io::posix_file fobj(filename);
+  return fobj.read_range(range_type(0, fobj.size()));
+}
+
+
+/// chunks should have the file content, and valid ranges should tile the requested range.
+void check_chunks(std::string const & filename, range_type const & range, size_t const & chunk_bytes, size_t const & overlap) {
+  std::vector<unsigned char> gold = get_gold(filename);
+  range_type target = range_type::intersect(range, range_type(0, gold.size()));
+
+  ::bliss::io::chunk_prefetcher prefetcher(filename, range, chunk_bytes, overlap);
+  EXPECT_EQ((target.size() + chunk_bytes - 1) / chunk_bytes, prefetcher.size());
+
+  ::bliss::io::file_data chunk;
+  size_t next = target.start;
+  size_t count = 0;
+  while (prefetcher.next(chunk)) {
+    EXPECT_EQ(next, chunk.valid_range_bytes.start);
+    EXPECT_EQ(chunk.valid_range_bytes.start, chunk.in_mem_range_bytes.start);
+    EXPECT_EQ(std::min(chunk.valid_range_bytes.end + overlap, gold.size()), chunk.in_mem_range_bytes.end);
+    ASSERT_EQ(chunk.in_mem_range_bytes.size(), chunk.data.size());
+    EXPECT_TRUE(std::equal(chunk.data.begin(), chunk.data.end(), gold.begin() + chunk.in_mem_range_bytes.start))
+      << "chunk " << count << " " << chunk.in_mem_range_bytes;
+
+    next = chunk.valid_range_bytes.end;
+    ++count;
+  }
+  EXPECT_EQ(target.end, next);
+  EXPECT_EQ(prefetcher.size(), count);
+
+  // finished.  stays finished.
+  EXPECT_FALSE(prefetcher.next(chunk));
+}
+
+TEST(ChunkPrefetcher, ReadsWholeFile) {
+  std::string filename = std::string(PROJ_SRC_DIR) + "/test/data/test.medium.fastq";
+
+  check_chunks(filename, range_type(0, std::numeric_limits<size_t>::max()), 1000, 0);
+  check_chunks(filename, range_type(0, std::numeric_limits<size_t>::max()), 4096, 300);
+  check_chunks(filename, range_type(0, std::numeric_limits<size_t>::max()), 1UL << 30, 300);
+}
+
+TEST(ChunkPrefetcher, ReadsPartialRange) {
+  std::string filename = std::string(PROJ_SRC_DIR) + "/test/data/test.medium.fastq";
+
+  check_chunks(filename, range_type(1234, 98765), 777, 100);
+  check_chunks(filename, range_type(5, 6), 777, 100);
+  check_chunks(filename, range_type(100, 100), 777, 100);
+}
+
+TEST(ChunkPrefetcher, EarlyDestruction) {
+  std::string filename = std::string(PROJ_SRC_DIR) + "/test/data/test.medium.fastq";
+
+  // reader thread should stop without the remaining chunks being consumed.
+  ::bliss::io::chunk_prefetcher prefetcher(filename, range_type(0, std::numeric_limits<size_t>::max()), 100, 0);
+  ::bliss::io::file_data chunk;
+  EXPECT_TRUE(prefetcher.next(chunk));
+}
+
+TEST(ChunkPrefetcher, MissingFile) {
+  EXPECT_THROW(::bliss::io::chunk_prefetcher("nonexistent.fastq", range_type(0, 100), 10), ::bliss::io::IOException);
+}
+
+
+/// record aligned chunks should parse to the same kmers as the whole file.
+void check_aligned_kmers(std::string const & filename, size_t const & chunk_bytes, size_t const & overlap) {
+  using KmerType = ::bliss::common::Kmer<21, ::bliss::common::DNA, uint64_t>;
+  using KmerParserType = ::bliss::index::kmer::KmerParser<KmerType>;
+  using CharIterType = typename ::bliss::io::file_data::const_iterator;
+
+  std::vector<KmerType> gold, chunked;
+  {
+    ::bliss::io::posix_file fobj(filename);
+    ::bliss::io::file_data whole = fobj.read_file();
+    ::bliss::io::FASTQParser<CharIterType> parser;
+    parser.init_parser(whole.in_mem_cbegin(), whole.parent_range_bytes, whole.in_mem_range_bytes, whole.getRange());
+    ::bliss::io::KmerFileHelper::template read_block_old<KmerParserType, ::bliss::io::FASTQParser, ::bliss::io::SequencesIterator>(whole, parser, gold);
+  }
+
+  ::bliss::io::chunk_prefetcher prefetcher(filename, range_type(0, std::numeric_limits<size_t>::max()), chunk_bytes, overlap);
+  ::bliss::io::file_data chunk;
+  size_t next = 0;
+  while (prefetcher.next(chunk)) {
+    ::bliss::io::KmerFileHelper::align_chunk_to_records(chunk);
+
+    // adjacent chunks agree on their boundary.
+    EXPECT_EQ(next, chunk.valid_range_bytes.start);
+    next = chunk.valid_range_bytes.end;
+    if (chunk.getRange().size() == 0) continue;
+    EXPECT_EQ('@', *(chunk.cbegin()));
+
+    ::bliss::io::FASTQParser<CharIterType> parser;
+    parser.init_parser(chunk.in_mem_cbegin(), chunk.parent_range_bytes, chunk.in_mem_range_bytes, chunk.getRange());
+    ::bliss::io::KmerFileHelper::template read_block_old<KmerParserType, ::bliss::io::FASTQParser, ::bliss::io::SequencesIterator>(chunk, parser, chunked);
+  }
+  EXPECT_EQ(prefetcher.get_file_range().end, next);
+
+  ASSERT_GT(gold.size(), 0UL);
+  ASSERT_EQ(gold.size(), chunked.size());
+  std::sort(gold.begin(), gold.end());
+  std::sort(chunked.begin(), chunked.end());
+  EXPECT_TRUE(std::equal(gold.begin(), gold.end(), chunked.begin()));
+}
+
+TEST(ChunkPrefetcher, FASTQAlignedChunks) {
+  std::string filename = std::string(PROJ_SRC_DIR) + "/test/data/test.medium.fastq";
+
+  check_aligned_kmers(filename, 100000, 4096);
+  check_aligned_kmers(filename, 4096, 4096);
+  // chunks smaller than a record
+  check_aligned_kmers(filename, 50, 4096);
+}
+
+TEST(ChunkPrefetcher, FASTQOverlapTooSmall) {
+  std::string filename = std::string(PROJ_SRC_DIR) + "/test/data/test.medium.fastq";
+
+  ::bliss::io::chunk_prefetcher prefetcher(filename, range_type(0, std::numeric_limits<size_t>::max()), 4096, 10);
+  ::bliss::io::file_data chunk;
+  ASSERT_TRUE(prefetcher.next(chunk));
+  EXPECT_THROW(::bliss::io::KmerFileHelper::align_chunk_to_records(chunk), ::bliss::io::IOException);
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * test_multi_file_assignment.cpp
+ *
+ * test the size balanced assignment of files to processes.
+ */
+
+#include "bliss-config.hpp"
+
+// include google test
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+
+#include "io/kmer_file_helper.hpp"
+
+
+/// every non-empty file is assigned, groups are disjoint, and the max load is bounded.
+void check_assignment(std::vector<size_t> const & sizes, int const & nprocs) {
+  ::bliss::io::multi_file_assignment assign(sizes, nprocs);
+
+  size_t total = std::accumulate(sizes.begin(), sizes.end(), 0UL);
+  size_t share = (total + nprocs - 1) / nprocs;
+  size_t max_size = sizes.empty() ? 0 : *(std::max_element(sizes.begin(), sizes.end()));
+
+  std::vector<size_t> loads(nprocs, 0);
+  std::vector<int> groups(nprocs, -1);
+
+  for (size_t f = 0; f < sizes.size(); ++f) {
+    if (sizes[f] == 0) {
+      EXPECT_EQ(0, assign.rank_count[f]);
+      continue;
+    }
+    ASSERT_GE(assign.rank_count[f], 1);
+    ASSERT_GE(assign.first_rank[f], 0);
+    ASSERT_LE(assign.first_rank[f] + assign.rank_count[f], nprocs);
+
+    for (int r = assign.first_rank[f]; r < assign.first_rank[f] + assign.rank_count[f]; ++r) {
+      loads[r] += sizes[f] / assign.rank_count[f];
+      if (assign.rank_count[f] > 1) {
+        EXPECT_EQ(-1, groups[r]) << "rank " << r << " in 2 groups";
+        groups[r] = f;
+      }
+    }
+  }
+
+  for (int r = 0; r < nprocs; ++r) {
+    EXPECT_EQ(groups[r], assign.get_group(r));
+
+    // LPT bound, plus the group rounding.
+    EXPECT_LE(loads[r], 2 * share + max_size / nprocs + 1) << "rank " << r;
+
+    for (auto f : assign.get_whole_files(r)) {
+      EXPECT_EQ(1, assign.rank_count[f]);
+      EXPECT_EQ(r, assign.first_rank[f]);
+    }
+  }
+}
+
+
+TEST(MultiFileAssignment, ManySmallFiles) {
+  std::vector<size_t> sizes(2000);
+  for (size_t i = 0; i < sizes.size(); ++i) sizes[i] = 1000 + (i * 7919) % 5000;
+
+  check_assignment(sizes, 1);
+  check_assignment(sizes, 16);
+  check_assignment(sizes, 64);
+
+  // no parallel groups when all files are small.
+  ::bliss::io::multi_file_assignment assign(sizes, 64);
+  for (size_t f = 0; f < sizes.size(); ++f) {
+    EXPECT_EQ(1, assign.rank_count[f]);
+  }
+}
+
+TEST(MultiFileAssignment, MixedFiles) {
+  std::vector<size_t> sizes = {100000, 10, 0, 500, 250000, 20, 30, 40000, 0, 1};
+
+  check_assignment(sizes, 1);
+  check_assignment(sizes, 3);
+  check_assignment(sizes, 8);
+  check_assignment(sizes, 13);
+
+  // the largest file is split over multiple processes.
+  ::bliss::io::multi_file_assignment assign(sizes, 8);
+  EXPECT_GT(assign.rank_count[4], 1);
+}
+
+TEST(MultiFileAssignment, MoreProcsThanFiles) {
+  std::vector<size_t> sizes = {1000, 1000, 3000};
+
+  check_assignment(sizes, 16);
+
+  // every process gets work from the large file groups
+  ::bliss::io::multi_file_assignment assign(sizes, 16);
+  int used = 0;
+  for (size_t f = 0; f < sizes.size(); ++f) used += assign.rank_count[f];
+  EXPECT_LE(used, 16);
+  EXPECT_GE(used, 8);
+}
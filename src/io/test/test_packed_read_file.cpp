@@ -0,0 +1,198 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * test_packed_read_file.cpp
+ *
+ * round trip test for the packed read converter and reader.
+ */
+
+#include "bliss-config.hpp"    // for location of data.
+
+// include google test
+#include <gtest/gtest.h>
+#include <cstdint> // for uint64_t, etc.
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <unistd.h>  // getpid, unlink
+
+#include "common/kmer.hpp"
+#include "common/alphabets.hpp"
+#include "io/kmer_file_helper.hpp"
+#include "io/packed_read_file.hpp"
+
+
+/// serially parse a sequence file into reads, with ascii bases normalized as the packed reader decodes them.
+template <template <typename> class SeqParser>
+void get_gold(std::string const & filename, std::vector<std::string> & seqs) {
+  using CharIterType = unsigned char *;
+  using range_type = ::bliss::partition::range<size_t>;
+
+  ::bliss::io::mmap_file fobj(filename);
+  range_type file_range(0, fobj.size());
+  ::bliss::io::mapped_data md = fobj.map(file_range);
+
+  SeqParser<CharIterType> parser;
+  size_t offset = parser.init_parser(md.get_data(), file_range, file_range, file_range);
+
+  ::bliss::io::SequencesIterator<CharIterType, SeqParser> seqs_start(parser, md.get_data() + offset, md.get_data() + file_range.end, offset);
+  ::bliss::io::SequencesIterator<CharIterType, SeqParser> seqs_end(md.get_data() + file_range.end);
+
+  ::bliss::utils::file::NotEOL not_eol;
+  for (; seqs_start != seqs_end; ++seqs_start) {
+    std::string s;
+    for (auto it = seqs_start->seq_begin; it != seqs_start->seq_end; ++it) {
+      if (!not_eol(*it)) continue;
+      char c = *it & 0xDF;
+      s.push_back(((c == 'A') || (c == 'C') || (c == 'G') || (c == 'T')) ? c : 'N');
+    }
+    seqs.push_back(s);
+  }
+}
+
+/// quality chars of the FASTQ file, binned.
+void get_gold_quals(std::string const & filename, std::vector<std::string> & quals) {
+  using CharIterType = unsigned char *;
+  using range_type = ::bliss::partition::range<size_t>;
+
+  ::bliss::io::mmap_file fobj(filename);
+  range_type file_range(0, fobj.size());
+  ::bliss::io::mapped_data md = fobj.map(file_range);
+
+  ::bliss::io::FASTQParser<CharIterType> parser;
+  size_t offset = parser.init_parser(md.get_data(), file_range, file_range, file_range);
+
+  ::bliss::io::SequencesIterator<CharIterType, ::bliss::io::FASTQParser> seqs_start(parser, md.get_data() + offset, md.get_data() + file_range.end, offset);
+  ::bliss::io::SequencesIterator<CharIterType, ::bliss::io::FASTQParser> seqs_end(md.get_data() + file_range.end);
+
+  for (; seqs_start != seqs_end; ++seqs_start) {
+    std::string q;
+    for (auto it = seqs_start->qual_begin; it != seqs_start->qual_end; ++it) {
+      q.push_back(::bliss::io::BinnedQuality::decode(::bliss::io::BinnedQuality::encode(*it)));
+    }
+    quals.push_back(q);
+  }
+}
+
+std::string get_packed_name(std::string const & suffix) {
+  return std::string("test_packed_reads.") + std::to_string(getpid()) + "." + suffix + ".bpr";
+}
+
+template <template <typename> class SeqParser>
+void check_round_trip(std::string const & filename, bool check_quality) {
+  std::string packed_name = get_packed_name(::bliss::utils::file::get_file_extension(filename));
+
+  auto counts = ::bliss::io::packed_reads_converter::template convert<SeqParser>(filename, packed_name);
+
+  std::vector<std::string> seqs, quals;
+  get_gold<SeqParser>(filename, seqs);
+  if (check_quality) get_gold_quals(filename, quals);
+
+  size_t bases = 0;
+  for (auto s : seqs) bases += s.size();
+  EXPECT_EQ(seqs.size(), counts.first);
+  EXPECT_EQ(bases, counts.second);
+
+  {
+    ::bliss::io::packed_reads_file packed(packed_name);
+    EXPECT_EQ(seqs.size(), packed.read_count());
+    EXPECT_EQ(bases, packed.base_count());
+    EXPECT_EQ(check_quality, packed.has_quality());
+    EXPECT_EQ(0UL, packed.get_read_range().start);
+    EXPECT_EQ(seqs.size(), packed.get_read_range().end);
+
+    for (size_t i = 0; i < seqs.size(); ++i) {
+      auto seq = packed.get_sequence(i);
+      std::string s(seq.seq_begin, seq.seq_end);
+      EXPECT_EQ(seqs[i], s) << "read " << i;
+      if (check_quality) {
+        std::string q(seq.qual_begin, seq.qual_end);
+        EXPECT_EQ(quals[i], q) << "read " << i;
+      }
+    }
+  }
+
+  // slices should cover all reads, in order, with balanced base counts.
+  size_t max_len = 0;
+  for (auto s : seqs) max_len = std::max(max_len, s.size());
+  int nslices = 4;
+  size_t next = 0;
+  for (int i = 0; i < nslices; ++i) {
+    ::bliss::io::packed_reads_file packed(packed_name, i, nslices);
+    EXPECT_EQ(next, packed.get_read_range().start);
+    EXPECT_LE(packed.get_base_range().size(), bases / nslices + max_len + 1);
+    next = packed.get_read_range().end;
+
+    for (size_t j = packed.get_read_range().start; j < packed.get_read_range().end; ++j) {
+      auto seq = packed.get_sequence(j);
+      EXPECT_EQ(seqs[j], std::string(seq.seq_begin, seq.seq_end)) << "slice " << i << " read " << j;
+    }
+  }
+  EXPECT_EQ(seqs.size(), next);
+
+  unlink(packed_name.c_str());
+}
+
+
+TEST(PackedReadFile, FASTQRoundTrip) {
+  check_round_trip<::bliss::io::FASTQParser>(std::string(PROJ_SRC_DIR) + "/test/data/natural.withN.fastq", true);
+}
+
+TEST(PackedReadFile, FASTARoundTrip) {
+  check_round_trip<::bliss::io::FASTAParser>(std::string(PROJ_SRC_DIR) + "/test/data/natural.withN.fasta", false);
+}
+
+TEST(PackedReadFile, KmersMatchText) {
+  using KmerType = ::bliss::common::Kmer<21, ::bliss::common::DNA5, uint64_t>;
+  using KmerParserType = ::bliss::index::kmer::KmerParser<KmerType>;
+
+  std::string filename = std::string(PROJ_SRC_DIR) + "/test/data/natural.withN.fastq";
+  std::string packed_name = get_packed_name("kmers");
+  ::bliss::io::packed_reads_converter::template convert<::bliss::io::FASTQParser>(filename, packed_name);
+
+  std::vector<KmerType> text, packed;
+  {
+    // parse the text file directly.
+    using CharIterType = unsigned char *;
+    using range_type = ::bliss::partition::range<size_t>;
+
+    ::bliss::io::mmap_file fobj(filename);
+    range_type file_range(0, fobj.size());
+    ::bliss::io::mapped_data md = fobj.map(file_range);
+
+    ::bliss::io::FASTQParser<CharIterType> parser;
+    size_t offset = parser.init_parser(md.get_data(), file_range, file_range, file_range);
+
+    ::bliss::io::SequencesIterator<CharIterType, ::bliss::io::FASTQParser> seqs_start(parser, md.get_data() + offset, md.get_data() + file_range.end, offset);
+    ::bliss::io::SequencesIterator<CharIterType, ::bliss::io::FASTQParser> seqs_end(md.get_data() + file_range.end);
+
+    KmerParserType kmer_parser(file_range);
+    ::fsc::back_emplace_iterator<std::vector<KmerType> > emplace_iter(text);
+    for (; seqs_start != seqs_end; ++seqs_start) {
+      emplace_iter = kmer_parser(*seqs_start, emplace_iter);
+    }
+  }
+  ::bliss::io::KmerFileHelper::template read_file_packed<KmerParserType>(packed_name, packed);
+
+  unlink(packed_name.c_str());
+
+  ASSERT_GT(text.size(), 0UL);
+  ASSERT_EQ(text.size(), packed.size());
+  std::sort(text.begin(), text.end());
+  std::sort(packed.begin(), packed.end());
+  EXPECT_TRUE(std::equal(text.begin(), text.end(), packed.begin()));
+}
@@ -19,7 +19,8 @@
  * @ingroup   io
  * @author  Tony Pan <tpan7@gatech.edu>
  *
- * @brief     helper function to replicate file descriptor across all processes on the same node.
+ * @brief     helper function to replicate file descriptor across all processes on the same node,
+ *            and stream socket helpers for local client/server communication.
  * @details   based on information from
  *            http://www.microhowto.info/howto/listen_for_and_receive_udp_datagrams_in_c.html
  *            http://stackoverflow.com/questions/27014955/socket-connect-vs-bind
@@ -45,6 +46,10 @@
 
 #include <sys/stat.h>
 #include <fcntl.h>
+#include <cerrno>
+#include <string>
+
+#include "io/io_exception.hpp"
 
 #include <mxx/comm.hpp>
 
@@ -302,6 +307,101 @@ namespace bliss {
       }
 
 
+      //============== stream sockets, for local client/server communication.
+
+      /// create an address for a unix domain socket on the file system.
+      static struct sockaddr_un make_path_address(::std::string const & path,  socklen_t &address_length) {
+          struct sockaddr_un address;
+
+          if (path.size() >= sizeof(address.sun_path)) {
+            throw ::bliss::io::IOException("ERROR: unix socket path too long: " + path);
+          }
+
+          memset(&address, 0, sizeof(address));
+          address.sun_family = AF_UNIX;
+          strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+          address_length = sizeof(address.sun_family) + strlen(address.sun_path);
+
+          return address;
+      }
+
+      /// create a stream socket bound to path, and listen on it.  an existing socket file at path is replaced.
+      static int create_stream_listener(::std::string const & path, int const & backlog = 64) {
+        int socket_fd;
+        if ((socket_fd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0) {
+          perror("server: socket");
+          throw ::bliss::io::IOException("ERROR: unable to create stream socket");
+        }
+
+        socklen_t address_length;
+        struct sockaddr_un address = make_path_address(path, address_length);
+
+        unlink(address.sun_path);
+        if (bind(socket_fd, (const struct sockaddr *) &address, address_length) < 0) {
+          close(socket_fd);
+          perror("server: bind");
+          throw ::bliss::io::IOException("ERROR: unable to bind stream socket to " + path);
+        }
+        if (listen(socket_fd, backlog) < 0) {
+          close(socket_fd);
+          unlink(path.c_str());
+          perror("server: listen");
+          throw ::bliss::io::IOException("ERROR: unable to listen on " + path);
+        }
+        return socket_fd;
+      }
+
+      /// connect a stream socket to the server listening at path.
+      static int connect_stream(::std::string const & path) {
+        int socket_fd;
+        if ((socket_fd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0) {
+          perror("client: socket");
+          throw ::bliss::io::IOException("ERROR: unable to create stream socket");
+        }
+
+        socklen_t address_length;
+        struct sockaddr_un address = make_path_address(path, address_length);
+
+        if (connect(socket_fd, (const struct sockaddr *) &address, address_length) < 0) {
+          close(socket_fd);
+          throw ::bliss::io::IOException("ERROR: unable to connect to " + path);
+        }
+        return socket_fd;
+      }
+
+      /// write all bytes, retrying on interrupts and partial writes.  returns false if the peer has gone away.
+      static bool write_fully(int const & socket_fd, void const * data, size_t const & bytes) {
+        const char * ptr = reinterpret_cast<const char *>(data);
+        size_t s = 0;
+        while (s < bytes) {
+          ssize_t count = send(socket_fd, ptr + s, bytes - s, MSG_NOSIGNAL);
+          if (count < 0) {
+            if (errno == EINTR) continue;
+            return false;
+          }
+          s += count;
+        }
+        return true;
+      }
+
+      /// read exactly bytes, retrying on interrupts and partial reads.  returns false on end of stream or error.
+      static bool read_fully(int const & socket_fd, void * data, size_t const & bytes) {
+        char * ptr = reinterpret_cast<char *>(data);
+        size_t s = 0;
+        while (s < bytes) {
+          ssize_t count = recv(socket_fd, ptr + s, bytes - s, 0);
+          if (count < 0) {
+            if (errno == EINTR) continue;
+            return false;
+          }
+          if (count == 0) return false;
+          s += count;
+        }
+        return true;
+      }
+
+
     } // ns util
 
   } // ns io
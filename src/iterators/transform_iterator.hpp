@@ -254,6 +254,12 @@ public:
     return this->_f(*this->_base);
   }
 
+  /// const version, for wrapping iterators (e.g. ZipIterator) that dereference through a const reference.  requires a const functor.
+  value_type operator*() const
+  {
+    return this->_f(*this->_base);
+  }
+
   /**
    * @brief     Pre-increment operator.
    *
@@ -0,0 +1,368 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    bench_recorder.hpp
+ * @ingroup
+ * @author  agent <agent@local>
+ * @brief   structured output for the BL_BENCH timers:  JSON lines, CSV, and chrome trace-event timelines.
+ * @details every benchmark scope (BL_BENCH_INIT) registers with the recorder on a per thread scope stack, so each scope has a
+ *          path such as "app/insert/local_insert" that reflects how the scopes nest at run time.  each timed phase is an event
+ *          with its scope path, start, duration, element count, and current and peak RSS.
+ *
+ *          on report, the phases of the scope are summarized over the processes (min, max, mean, stdev, and max/mean imbalance)
+ *          and rank 0 appends one JSON object per line and one CSV row per phase.  each rank writes its events as a
+ *          chrome://tracing (trace-event format) file, pid = rank and tid = thread, with timestamps in microseconds
+ *          since the epoch so the ranks' timelines can be lined up.
+ *
+ *          output is off unless a destination is set, either with the setters (on all processes) or with the environment variables
+ *            BL_BENCH_JSON=file        summaries as JSON lines, appended
+ *            BL_BENCH_CSV=file         summaries as CSV, appended
+ *            BL_BENCH_TRACE=prefix     timelines, written to prefix.<rank>.json
+ *          when off, a phase costs a scope stack push and pop per scope.
+ */
+#ifndef SRC_UTILS_BENCH_RECORDER_HPP_
+#define SRC_UTILS_BENCH_RECORDER_HPP_
+
+#include <chrono>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <mutex>
+#include <atomic>
+#include <limits>
+#include <algorithm>  // min, max
+#include <cmath>      // sqrt
+#include <cstdlib>    // getenv
+#include <cstdio>
+
+#include <mxx/comm.hpp>
+#include <mxx/reduction.hpp>
+
+// note:  reports in bytes.
+#include "getRSS.h"
+
+namespace plog {
+
+class BenchRecorder {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    /// one timed phase.
+    struct event {
+        std::string path;    // scope path, e.g. app/insert
+        std::string name;    // phase name
+        int depth;           // scope depth, 1 for an outermost scope
+        int thread;
+        double start;        // seconds since the recorder started
+        double duration;     // seconds
+        double count;        // elements
+        double mem_curr;     // bytes, RSS at the end of the phase
+        double mem_peak;     // bytes, peak RSS at the end of the phase
+    };
+
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+  protected:
+    std::mutex mutex;
+    std::vector<event> events;
+
+    clock::time_point origin;
+    /// origin in microseconds since the epoch, so the ranks' timelines can be lined up.
+    double origin_us;
+
+    std::string json_path;
+    std::string csv_path;
+    std::string trace_prefix;
+
+    /// MPI_COMM_WORLD rank, cached while MPI is up so the trace can still be written after MPI_Finalize.
+    int rank;
+
+    /// active scope titles of the calling thread, outermost first.
+    static std::vector<std::string> & scope_stack() {
+      static thread_local std::vector<std::string> stack;
+      return stack;
+    }
+
+    static int thread_id() {
+      static std::atomic<int> next(0);
+      static thread_local int id = next++;
+      return id;
+    }
+
+    BenchRecorder() : origin(clock::now()), rank(0) {
+      origin_us = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::system_clock::now().time_since_epoch()).count());
+
+      const char * s = std::getenv("BL_BENCH_JSON");
+      if (s != nullptr) json_path = s;
+      s = std::getenv("BL_BENCH_CSV");
+      if (s != nullptr) csv_path = s;
+      s = std::getenv("BL_BENCH_TRACE");
+      if (s != nullptr) trace_prefix = s;
+    }
+
+    void cache_rank() {
+      int initialized = 0, finalized = 0;
+      MPI_Initialized(&initialized);
+      MPI_Finalized(&finalized);
+      if (initialized && !finalized) MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    }
+
+    static std::string escape(std::string const & x) {
+      std::string out;
+      out.reserve(x.size());
+      for (char c : x) {
+        if (c == '"' || c == '\\') out.push_back('\\');
+        if (static_cast<unsigned char>(c) < 0x20) continue;
+        out.push_back(c);
+      }
+      return out;
+    }
+
+    static std::string csv_field(std::string const & x) {
+      if (x.find_first_of(",\"\n") == std::string::npos) return x;
+      std::string out("\"");
+      for (char c : x) {
+        if (c == '"') out.push_back('"');
+        out.push_back(c);
+      }
+      out.push_back('"');
+      return out;
+    }
+
+    /// per phase statistics, each of size n.  metric order:  time, count, mem_curr, mem_peak.
+    struct summary {
+        std::vector<std::string> names;
+        std::vector<int> depths;
+        std::vector<double> mins, maxs, means, stdevs;   // 4 * n, metric major
+        size_t n;
+        int p;
+    };
+
+    /// local metrics of the phases, metric major.
+    std::vector<double> local_metrics(std::vector<size_t> const & ids, size_t const & n,
+                                      std::vector<std::string> & names, std::vector<int> & depths) {
+      std::vector<double> m(4 * n, 0.0);
+      names.resize(n);
+      depths.resize(n);
+
+      std::lock_guard<std::mutex> lock(mutex);
+      for (size_t i = 0; i < n; ++i) {
+        event const & e = events[ids[i]];
+        names[i] = e.name;
+        depths[i] = e.depth;
+        m[i] = e.duration;
+        m[n + i] = e.count;
+        m[2 * n + i] = e.mem_curr;
+        m[3 * n + i] = e.mem_peak;
+      }
+      return m;
+    }
+
+    void write(std::string const & title, std::string const & path, summary const & s) {
+      if (!json_path.empty()) {
+        std::stringstream out;
+        out.precision(9);
+        out << "{\"title\":\"" << escape(title) << "\",\"path\":\"" << escape(path) << "\",\"ranks\":" << s.p << ",\"phases\":[";
+        const char * metrics[4] = {"time_s", "count", "mem_curr_B", "mem_peak_B"};
+        for (size_t i = 0; i < s.n; ++i) {
+          if (i > 0) out << ",";
+          out << "{\"name\":\"" << escape(s.names[i]) << "\",\"depth\":" << s.depths[i];
+          for (size_t m = 0; m < 4; ++m) {
+            size_t j = m * s.n + i;
+            out << ",\"" << metrics[m] << "\":{\"min\":" << s.mins[j] << ",\"max\":" << s.maxs[j] <<
+                ",\"mean\":" << s.means[j] << ",\"stdev\":" << s.stdevs[j] << "}";
+          }
+          out << ",\"imbalance\":" << ((s.means[i] > 0) ? s.maxs[i] / s.means[i] : 1.0) << "}";
+        }
+        out << "]}" << std::endl;
+
+        std::ofstream f(json_path, std::ios::app);
+        f << out.str();
+      }
+
+      if (!csv_path.empty()) {
+        std::ofstream f(csv_path, std::ios::app | std::ios::ate);
+        if (f.tellp() == 0) {
+          f << "title,path,phase,index,depth,ranks,time_min,time_max,time_mean,time_stdev,imbalance,"
+               "count_min,count_max,count_mean,count_stdev,mem_curr_min,mem_curr_max,mem_curr_mean,"
+               "mem_peak_min,mem_peak_max,mem_peak_mean" << std::endl;
+        }
+        f.precision(9);
+        for (size_t i = 0; i < s.n; ++i) {
+          f << csv_field(title) << "," << csv_field(path) << "," << csv_field(s.names[i]) << "," << i << "," <<
+              s.depths[i] << "," << s.p;
+          for (size_t m = 0; m < 4; ++m) {
+            size_t j = m * s.n + i;
+            f << "," << s.mins[j] << "," << s.maxs[j] << "," << s.means[j];
+            if (m < 2) f << "," << s.stdevs[j];
+            if (m == 0) f << "," << ((s.means[i] > 0) ? s.maxs[i] / s.means[i] : 1.0);
+          }
+          f << std::endl;
+        }
+      }
+    }
+
+  public:
+    static BenchRecorder & instance() {
+      static BenchRecorder recorder;
+      return recorder;
+    }
+
+    ~BenchRecorder() {
+      if (!trace_prefix.empty()) write_trace();
+    }
+
+    void set_json_output(std::string const & file) { json_path = file; }
+    void set_csv_output(std::string const & file) { csv_path = file; }
+    void set_trace_output(std::string const & prefix) { trace_prefix = prefix; }
+
+    /// whether anything is recorded.
+    bool enabled() const {
+      return !(json_path.empty() && csv_path.empty() && trace_prefix.empty());
+    }
+
+    /// enter a benchmark scope on the calling thread.  returns the scope path.
+    std::string push_scope(std::string const & title) {
+      std::vector<std::string> & stack = scope_stack();
+      stack.push_back(stack.empty() ? title : stack.back() + "/" + title);
+      return stack.back();
+    }
+
+    void pop_scope() {
+      std::vector<std::string> & stack = scope_stack();
+      if (!stack.empty()) stack.pop_back();
+    }
+
+    /// scope depth of the calling thread.
+    int depth() const {
+      return static_cast<int>(scope_stack().size());
+    }
+
+    /// record a phase that ran from t1 to t2.  returns the event id, or npos if recording is off.
+    size_t record(std::string const & path, int const & depth, std::string const & name,
+                  clock::time_point const & t1, clock::time_point const & t2, double const & n_elem) {
+      if (!enabled()) return npos;
+
+      event e;
+      e.path = path;
+      e.name = name;
+      e.depth = depth;
+      e.thread = thread_id();
+      e.start = std::chrono::duration<double>(t1 - origin).count();
+      e.duration = std::chrono::duration<double>(t2 - t1).count();
+      e.count = n_elem;
+      e.mem_curr = static_cast<double>(::getCurrentRSS());
+      e.mem_peak = static_cast<double>(::getPeakRSS());
+
+      std::lock_guard<std::mutex> lock(mutex);
+      if (events.empty()) cache_rank();
+      events.emplace_back(std::move(e));
+      return events.size() - 1;
+    }
+
+    event get_event(size_t const & id) {
+      std::lock_guard<std::mutex> lock(mutex);
+      return events[id];
+    }
+
+    size_t size() {
+      std::lock_guard<std::mutex> lock(mutex);
+      return events.size();
+    }
+
+    /// drop all events.  ids held by live timers become invalid, so only call between scopes.
+    void clear() {
+      std::lock_guard<std::mutex> lock(mutex);
+      events.clear();
+    }
+
+    /// summarize the phases of one scope on this process only.
+    void summarize(std::string const & title, std::string const & path, std::vector<size_t> const & ids) {
+      if (json_path.empty() && csv_path.empty()) return;
+
+      summary s;
+      s.n = ids.size();
+      s.p = 1;
+      s.mins = local_metrics(ids, s.n, s.names, s.depths);
+      s.maxs = s.mins;
+      s.means = s.mins;
+      s.stdevs.assign(s.mins.size(), 0.0);
+      write(title, path, s);
+    }
+
+    /**
+     * @brief summarize the phases of one scope over the processes of comm.  collective.
+     * @details  phases are matched by position, as in Timer::report.  if processes recorded different numbers of phases,
+     *           only the common prefix is summarized.  names and depths are those of rank 0.
+     *           the trace files are rewritten when an outermost scope reports.
+     */
+    void summarize(std::string const & title, std::string const & path, std::vector<size_t> const & ids,
+                   ::mxx::comm const & comm) {
+      if (!json_path.empty() || !csv_path.empty()) {
+        summary s;
+        s.p = comm.size();
+        s.n = ::mxx::allreduce(ids.size(), [](size_t const & x, size_t const & y) { return std::min(x, y); }, comm);
+
+        if (s.n > 0) {
+          std::vector<double> m = local_metrics(ids, s.n, s.names, s.depths);
+          s.mins = ::mxx::reduce(m, 0, [](double const & x, double const & y) { return std::min(x, y); }, comm);
+          s.maxs = ::mxx::reduce(m, 0, [](double const & x, double const & y) { return std::max(x, y); }, comm);
+          s.means = ::mxx::reduce(m, 0, std::plus<double>(), comm);
+          std::for_each(m.begin(), m.end(), [](double & x) { x = x * x; });
+          s.stdevs = ::mxx::reduce(m, 0, std::plus<double>(), comm);
+
+          if (comm.rank() == 0) {
+            double p = s.p;
+            for (size_t j = 0; j < s.means.size(); ++j) {
+              s.means[j] /= p;
+              s.stdevs[j] = std::sqrt(std::max(0.0, s.stdevs[j] / p - s.means[j] * s.means[j]));
+            }
+          }
+        }
+        if (comm.rank() == 0) write(title, path, s);
+      }
+
+      if (!trace_prefix.empty() && (path.find('/') == std::string::npos)) write_trace();
+    }
+
+    /// write this process's events as a chrome trace-event file, prefix.<rank>.json.
+    void write_trace() {
+      std::stringstream name;
+      name << trace_prefix << "." << rank << ".json";
+
+      std::lock_guard<std::mutex> lock(mutex);
+      std::ofstream f(name.str(), std::ios::trunc);
+      f.precision(3);
+      f << std::fixed;
+      f << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+      f << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rank << ",\"args\":{\"name\":\"rank " << rank << "\"}}";
+      for (auto const & e : events) {
+        f << ",\n{\"name\":\"" << escape(e.name) << "\",\"cat\":\"" << escape(e.path) << "\",\"ph\":\"X\"" <<
+            ",\"pid\":" << rank << ",\"tid\":" << e.thread <<
+            ",\"ts\":" << (origin_us + e.start * 1e6) << ",\"dur\":" << (e.duration * 1e6) <<
+            ",\"args\":{\"count\":" << e.count << ",\"mem_curr_MB\":" << (e.mem_curr / (1024.0 * 1024.0)) <<
+            ",\"mem_peak_MB\":" << (e.mem_peak / (1024.0 * 1024.0)) << "}}";
+      }
+      f << "]}" << std::endl;
+    }
+};
+
+} // end namespace plog
+
+#endif /* SRC_UTILS_BENCH_RECORDER_HPP_ */
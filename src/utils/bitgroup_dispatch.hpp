@@ -0,0 +1,281 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    bitgroup_dispatch.hpp
+ * @ingroup
+ * @author  agent <agent@local>
+ * @brief   bit group reverse and reverse complement of byte arrays, with the SIMD kernel chosen at run time.
+ * @details bitgroup_ops.hpp selects SWAR/SSSE3/AVX2 with #if defined(__AVX2__) etc., i.e. by the compiler flags, so a
+ *          binary built for the oldest nodes (or with USE_SIMD_IF_AVAILABLE=OFF) never uses AVX2 on newer ones.
+ *          here each kernel is compiled for SWAR, SSSE3 and AVX2 with __attribute__((target(...))), and the widest one
+ *          the CPU supports is picked once, on first use, via __builtin_cpu_supports.  the environment variable
+ *            BL_SIMD=swar|ssse3|avx2
+ *          caps the choice, e.g. to compare kernels on one machine.
+ *
+ *          supported are power of 2 BIT_GROUP_SIZE up to 32 bits (same as the SWAR reverse), on whole bytes:
+ *            reverse_dispatch<BIT_GROUP_SIZE>(out, in, len)              same result as reverse<BIT_GROUP_SIZE, BIT_REV_SWAR>
+ *            reverse_complement_dispatch<BIT_GROUP_SIZE>(out, in, len)   reverse, then bitwise not (DNA/RNA complement)
+ *          out and in must not overlap.  the call goes through a function pointer, so for short arrays (a k-mer of
+ *          one or two words) the inlined compile time kernels are faster.
+ *
+ *          on non-x86 or non GCC-compatible compilers, only the SWAR kernel exists.
+ */
+#ifndef SRC_UTILS_BITGROUP_DISPATCH_HPP_
+#define SRC_UTILS_BITGROUP_DISPATCH_HPP_
+
+#include <cstdint>
+#include <cstring>    // memcpy
+#include <cstdlib>    // getenv
+#include <string>
+
+#include "utils/bitgroup_ops.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__)) && !defined(__INTEL_COMPILER)
+#define BL_BITREV_DISPATCH 1
+#include <x86intrin.h>   // the intrinsics are usable inside target("...") functions without -mavx2
+#else
+#define BL_BITREV_DISPATCH 0
+#endif
+
+namespace bliss {
+
+  namespace utils {
+
+    namespace bit_ops {
+
+      /// widest SIMD type supported by the CPU (BIT_REV_SWAR, BIT_REV_SSSE3 or BIT_REV_AVX2), capped by BL_SIMD.
+      inline unsigned char cpu_simd_level() {
+        static const unsigned char level = []() -> unsigned char {
+          unsigned char l = BIT_REV_SWAR;
+#if BL_BITREV_DISPATCH
+          __builtin_cpu_init();
+          if (__builtin_cpu_supports("avx2")) l = BIT_REV_AVX2;
+          else if (__builtin_cpu_supports("ssse3")) l = BIT_REV_SSSE3;
+#endif
+          const char * s = std::getenv("BL_SIMD");
+          if (s != nullptr) {
+            std::string cap(s);
+            unsigned char c = (cap == "swar" || cap == "seq") ? BIT_REV_SWAR : (cap == "ssse3") ? BIT_REV_SSSE3 : BIT_REV_AVX2;
+            if (c < l) l = c;
+          }
+          return l;
+        }();
+        return level;
+      }
+
+      /// true if the CPU runs a wider reverse than the one compiled into bitgroup_ops (BITREV_AVX2::SIMDVal).
+      inline bool cpu_simd_exceeds_compiled() {
+        return cpu_simd_level() > BITREV_AVX2::SIMDVal;
+      }
+
+
+      namespace dispatch {
+
+        /// kernel signature:  out[0, len) = reverse (and complement) of in[0, len), in bytes.
+        typedef void (*reverse_kernel)(uint8_t * out, uint8_t const * in, size_t len);
+
+        /// SWAR kernel, one uint64_t at a time, from the front of in to the back of out.
+        template <unsigned int BIT_GROUP_SIZE, bool COMPLEMENT>
+        void reverse_swar(uint8_t * out, uint8_t const * in, size_t len) {
+          bitgroup_ops<BIT_GROUP_SIZE, BIT_REV_SWAR> op;
+          const uint64_t neg = COMPLEMENT ? ~(0x0ULL) : 0x0ULL;
+
+          uint64_t x, y;
+          size_t i = 0;
+          for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+            memcpy(&x, in + i, sizeof(uint64_t));
+            y = op.reverse(x) ^ neg;
+            memcpy(out + len - i - sizeof(uint64_t), &y, sizeof(uint64_t));
+          }
+          if (i == len) return;
+
+          if (len >= sizeof(uint64_t)) {
+            // redo the last full word of in, into the front of out.
+            memcpy(&x, in + len - sizeof(uint64_t), sizeof(uint64_t));
+            y = op.reverse(x) ^ neg;
+            memcpy(out, &y, sizeof(uint64_t));
+          } else {
+            // short array.  do not read past the end:  the reversed bytes end up at the high end of y.
+            x = 0;
+            memcpy(&x, in, len);
+            y = op.reverse(x) ^ neg;
+            memcpy(out, reinterpret_cast<uint8_t *>(&y) + (sizeof(uint64_t) - len), len);
+          }
+        }
+
+#if BL_BITREV_DISPATCH
+
+        /// pshufb mask that reverses the order of the (BIT_GROUP_SIZE / 8)-byte units in 16 bytes.
+        /// for groups smaller than a byte, reverses the bytes.
+        template <unsigned int BIT_GROUP_SIZE>
+        struct shuffle_mask {
+            static constexpr unsigned int unit = (BIT_GROUP_SIZE < 8) ? 1 : (BIT_GROUP_SIZE >> 3);
+            static constexpr char at(unsigned int i) {
+              return static_cast<char>((16 / unit - 1 - i / unit) * unit + (i % unit));
+            }
+        };
+
+        /// within-nibble reverse of the bit groups, as a 16 entry lookup table.  identity for 4 bit groups.
+        template <unsigned int BIT_GROUP_SIZE>
+        struct nibble_lut {
+            static constexpr char at(unsigned int n) {
+              return (BIT_GROUP_SIZE == 1) ?
+                  static_cast<char>(((n & 0x1) << 3) | ((n & 0x2) << 1) | ((n & 0x4) >> 1) | ((n & 0x8) >> 3)) :
+                  (BIT_GROUP_SIZE == 2) ?
+                  static_cast<char>(((n & 0x3) << 2) | ((n & 0xC) >> 2)) :
+                  static_cast<char>(n);
+            }
+        };
+
+        /// reverse (and complement) one 16 byte block.
+        template <unsigned int BIT_GROUP_SIZE, bool COMPLEMENT>
+        __attribute__((target("ssse3"))) inline
+        __m128i reverse_block(__m128i x) {
+          typedef shuffle_mask<BIT_GROUP_SIZE> S;
+          typedef nibble_lut<BIT_GROUP_SIZE> L;
+
+          x = _mm_shuffle_epi8(x, _mm_setr_epi8(S::at(0), S::at(1), S::at(2), S::at(3), S::at(4), S::at(5), S::at(6), S::at(7),
+                                                S::at(8), S::at(9), S::at(10), S::at(11), S::at(12), S::at(13), S::at(14), S::at(15)));
+          if (BIT_GROUP_SIZE < 8) {
+            // reverse the groups in each nibble, then swap the nibbles.
+            const __m128i lut = _mm_setr_epi8(L::at(0), L::at(1), L::at(2), L::at(3), L::at(4), L::at(5), L::at(6), L::at(7),
+                                              L::at(8), L::at(9), L::at(10), L::at(11), L::at(12), L::at(13), L::at(14), L::at(15));
+            const __m128i lo4 = _mm_set1_epi8(0x0F);
+            __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(x, lo4));
+            __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(x, 4), lo4));
+            x = _mm_or_si128(_mm_slli_epi16(lo, 4), hi);
+          }
+          return COMPLEMENT ? _mm_xor_si128(x, _mm_set1_epi8(static_cast<char>(0xFF))) : x;
+        }
+
+        /// reverse (and complement) one 32 byte block:  in-lane reverse, then swap the 2 lanes.
+        template <unsigned int BIT_GROUP_SIZE, bool COMPLEMENT>
+        __attribute__((target("avx2"))) inline
+        __m256i reverse_block(__m256i x) {
+          typedef shuffle_mask<BIT_GROUP_SIZE> S;
+          typedef nibble_lut<BIT_GROUP_SIZE> L;
+
+          x = _mm256_shuffle_epi8(x, _mm256_setr_epi8(S::at(0), S::at(1), S::at(2), S::at(3), S::at(4), S::at(5), S::at(6), S::at(7),
+                                                      S::at(8), S::at(9), S::at(10), S::at(11), S::at(12), S::at(13), S::at(14), S::at(15),
+                                                      S::at(0), S::at(1), S::at(2), S::at(3), S::at(4), S::at(5), S::at(6), S::at(7),
+                                                      S::at(8), S::at(9), S::at(10), S::at(11), S::at(12), S::at(13), S::at(14), S::at(15)));
+          x = _mm256_permute4x64_epi64(x, 0x4E);
+          if (BIT_GROUP_SIZE < 8) {
+            const __m256i lut = _mm256_setr_epi8(L::at(0), L::at(1), L::at(2), L::at(3), L::at(4), L::at(5), L::at(6), L::at(7),
+                                                 L::at(8), L::at(9), L::at(10), L::at(11), L::at(12), L::at(13), L::at(14), L::at(15),
+                                                 L::at(0), L::at(1), L::at(2), L::at(3), L::at(4), L::at(5), L::at(6), L::at(7),
+                                                 L::at(8), L::at(9), L::at(10), L::at(11), L::at(12), L::at(13), L::at(14), L::at(15));
+            const __m256i lo4 = _mm256_set1_epi8(0x0F);
+            __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(x, lo4));
+            __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(x, 4), lo4));
+            x = _mm256_or_si256(_mm256_slli_epi16(lo, 4), hi);
+          }
+          return COMPLEMENT ? _mm256_xor_si256(x, _mm256_set1_epi8(static_cast<char>(0xFF))) : x;
+        }
+
+        template <unsigned int BIT_GROUP_SIZE, bool COMPLEMENT>
+        __attribute__((target("ssse3")))
+        void reverse_ssse3(uint8_t * out, uint8_t const * in, size_t len) {
+          if (len < 16) {
+            reverse_swar<BIT_GROUP_SIZE, COMPLEMENT>(out, in, len);
+            return;
+          }
+
+          size_t i = 0;
+          for (; i + 16 <= len; i += 16) {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + len - i - 16),
+                             reverse_block<BIT_GROUP_SIZE, COMPLEMENT>(_mm_loadu_si128(reinterpret_cast<__m128i const *>(in + i))));
+          }
+          if (i < len) {
+            // overlapping last block.  len is a multiple of the group size, so the units stay aligned.
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out),
+                             reverse_block<BIT_GROUP_SIZE, COMPLEMENT>(_mm_loadu_si128(reinterpret_cast<__m128i const *>(in + len - 16))));
+          }
+        }
+
+        template <unsigned int BIT_GROUP_SIZE, bool COMPLEMENT>
+        __attribute__((target("avx2")))
+        void reverse_avx2(uint8_t * out, uint8_t const * in, size_t len) {
+          if (len < 32) {
+            reverse_ssse3<BIT_GROUP_SIZE, COMPLEMENT>(out, in, len);
+            return;
+          }
+
+          size_t i = 0;
+          for (; i + 32 <= len; i += 32) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + len - i - 32),
+                                reverse_block<BIT_GROUP_SIZE, COMPLEMENT>(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + i))));
+          }
+          if (i < len) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out),
+                                reverse_block<BIT_GROUP_SIZE, COMPLEMENT>(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + len - 32))));
+          }
+        }
+
+#endif  // BL_BITREV_DISPATCH
+
+        /// the kernel for a SIMD type.  falls back to the next narrower one that is compiled.
+        template <unsigned int BIT_GROUP_SIZE, bool COMPLEMENT>
+        reverse_kernel kernel_for(unsigned char const & simd) {
+          static_assert((BIT_GROUP_SIZE > 0) && ((BIT_GROUP_SIZE & (BIT_GROUP_SIZE - 1)) == 0) && (BIT_GROUP_SIZE <= 32),
+                        "dispatched reverse supports power of 2 BIT_GROUP_SIZE up to 32");
+#if BL_BITREV_DISPATCH
+          if (simd >= BIT_REV_AVX2) return &reverse_avx2<BIT_GROUP_SIZE, COMPLEMENT>;
+          if (simd >= BIT_REV_SSSE3) return &reverse_ssse3<BIT_GROUP_SIZE, COMPLEMENT>;
+#endif
+          return &reverse_swar<BIT_GROUP_SIZE, COMPLEMENT>;
+        }
+
+        /// the kernel for this CPU, selected on first call.
+        template <unsigned int BIT_GROUP_SIZE, bool COMPLEMENT>
+        reverse_kernel selected() {
+          static const reverse_kernel k = kernel_for<BIT_GROUP_SIZE, COMPLEMENT>(cpu_simd_level());
+          return k;
+        }
+
+      } // namespace dispatch
+
+
+      /**
+       * @brief reverse the BIT_GROUP_SIZE bit groups of an array, with the widest kernel the CPU supports.
+       * @details same result as reverse<BIT_GROUP_SIZE, BIT_REV_SWAR>(out, in, len).  out and in must not overlap.
+       * @param len      number of words.
+       */
+      template <unsigned int BIT_GROUP_SIZE, typename WORD_TYPE>
+      inline void reverse_dispatch(WORD_TYPE * out, WORD_TYPE const * in, size_t const & len) {
+        dispatch::selected<BIT_GROUP_SIZE, false>()(reinterpret_cast<uint8_t *>(out),
+                                                     reinterpret_cast<uint8_t const *>(in), len * sizeof(WORD_TYPE));
+      }
+
+      /**
+       * @brief reverse the BIT_GROUP_SIZE bit groups of an array and negate all bits, with the widest kernel the CPU supports.
+       * @details the reverse complement for alphabets whose complement is the bitwise not (DNA, RNA).
+       * @param len      number of words.
+       */
+      template <unsigned int BIT_GROUP_SIZE, typename WORD_TYPE>
+      inline void reverse_complement_dispatch(WORD_TYPE * out, WORD_TYPE const * in, size_t const & len) {
+        dispatch::selected<BIT_GROUP_SIZE, true>()(reinterpret_cast<uint8_t *>(out),
+                                                    reinterpret_cast<uint8_t const *>(in), len * sizeof(WORD_TYPE));
+      }
+
+    } // namespace bit_ops
+
+  } // namespace utils
+
+} // namespace bliss
+
+#endif /* SRC_UTILS_BITGROUP_DISPATCH_HPP_ */
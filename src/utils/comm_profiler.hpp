@@ -0,0 +1,350 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    comm_profiler.hpp
+ * @ingroup
+ * @author  agent <agent@local>
+ * @brief   opt-in profiling of the all-to-all exchanges behind the distributed map operations.
+ * @details each exchange (imxx::distribute, imxx::undistribute, imxx::exchange) records, per process, the number of elements
+ *          sent to and received from each rank, the element size, the time spent in the count all2all (which blocks until
+ *          the slowest process arrives, so it is the wait time at the collective), and the time in the all2allv.
+ *          the row vectors of all processes form the per-exchange send matrix;  the receive matrix is its transpose.
+ *
+ *          exchanges are labeled by the innermost CommProfiler::scope on the calling thread, e.g. "find" or "insert",
+ *          which the distributed maps open in their public operations.  exchanges outside any scope are labeled "other".
+ *
+ *          report() is collective and is meant to be called once at the end of the run.  per operation it summarizes, over
+ *          the processes, the bytes sent, the elements received, wait and transfer time as max, mean and skew (max / mean),
+ *          the worst single exchange skew of received elements, and the message size range.  exchanges are matched by
+ *          position, so all processes must make the same sequence of exchanges on the reporting communicator.
+ *
+ *          recording is off unless enabled, either with enable() (on all processes) or with the environment variable
+ *            BL_COMM_PROFILE=prefix    summary on stdout of rank 0, prefix.summary.csv, and per exchange matrices in
+ *                                      prefix.exchanges.jsonl.  an empty prefix prints the summary only.
+ *          when off, an exchange costs four clock reads.
+ */
+#ifndef SRC_UTILS_COMM_PROFILER_HPP_
+#define SRC_UTILS_COMM_PROFILER_HPP_
+
+#include <chrono>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <mutex>
+#include <limits>
+#include <numeric>    // accumulate
+#include <algorithm>  // min, max, find
+#include <cstdlib>    // getenv
+
+#include <mxx/comm.hpp>
+#include <mxx/reduction.hpp>
+#include <mxx/collective.hpp>
+
+namespace plog {
+
+class CommProfiler {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    /// one exchange, as seen by this process.
+    struct exchange {
+        std::string op;
+        size_t elem_bytes;
+        double wait;                // seconds in the count all2all
+        double xfer;                // seconds in the all2allv
+        std::vector<size_t> send;   // elements sent to each rank
+        std::vector<size_t> recv;   // elements received from each rank
+    };
+
+    /// per operation summary over the processes.  max and mean are of the per process totals over the op's exchanges.
+    struct op_summary {
+        std::string op;
+        size_t calls;
+        double sent_bytes_max, sent_bytes_mean;
+        double recv_elems_max, recv_elems_mean;
+        double wait_max, wait_mean;
+        double xfer_max, xfer_mean;
+        double worst_call_skew;     // max over exchanges of max / mean received elements
+        double messages;            // non-empty messages, all processes
+        double msg_bytes_min, msg_bytes_max, msg_bytes_mean;
+
+        static double skew(double const & mx, double const & mean) { return (mean > 0) ? mx / mean : 1.0; }
+        double sent_skew() const { return skew(sent_bytes_max, sent_bytes_mean); }
+        double recv_skew() const { return skew(recv_elems_max, recv_elems_mean); }
+        double wait_skew() const { return skew(wait_max, wait_mean); }
+        double xfer_skew() const { return skew(xfer_max, xfer_mean); }
+    };
+
+    /// labels the exchanges of the calling thread for its lifetime.
+    class scope {
+      public:
+        explicit scope(std::string const & op) { op_stack().push_back(op); }
+        ~scope() { op_stack().pop_back(); }
+        scope(scope const &) = delete;
+        scope & operator=(scope const &) = delete;
+    };
+
+  protected:
+    std::mutex mutex;
+    std::vector<exchange> exchanges;
+
+    bool on;
+    std::string prefix;
+
+    static std::vector<std::string> & op_stack() {
+      static thread_local std::vector<std::string> stack;
+      return stack;
+    }
+
+    CommProfiler() : on(false) {
+      const char * s = std::getenv("BL_COMM_PROFILE");
+      if (s != nullptr) enable(s);
+    }
+
+    template <typename T, typename Op>
+    static std::vector<T> reduce(std::vector<T> const & x, Op const & op, ::mxx::comm const & comm) {
+      if (comm.size() == 1) return x;
+      return ::mxx::reduce(x, 0, op, comm);
+    }
+
+    /// ops of the first n exchanges in order of first appearance, and the op index of each exchange.
+    void group(size_t const & n, std::vector<std::string> & ops, std::vector<size_t> & op_of) {
+      ops.clear();
+      op_of.resize(n);
+      for (size_t i = 0; i < n; ++i) {
+        auto it = std::find(ops.begin(), ops.end(), exchanges[i].op);
+        op_of[i] = std::distance(ops.begin(), it);
+        if (it == ops.end()) ops.push_back(exchanges[i].op);
+      }
+    }
+
+    /// per exchange send matrices, receive counts and times of all processes as JSON lines.  collective.
+    void write_exchanges(size_t const & n, ::mxx::comm const & comm) {
+      int p = comm.size();
+      std::vector<size_t> rows(n * p, 0);
+      std::vector<double> times(2 * n, 0.0);
+      for (size_t i = 0; i < n; ++i) {
+        exchange const & e = exchanges[i];
+        std::copy(e.send.begin(), e.send.begin() + std::min(e.send.size(), static_cast<size_t>(p)), rows.begin() + i * p);
+        times[2 * i] = e.wait;
+        times[2 * i + 1] = e.xfer;
+      }
+      rows = ::mxx::gatherv(rows, 0, comm);     // rank major:  [rank][exchange][dest]
+      times = ::mxx::gatherv(times, 0, comm);   // rank major:  [rank][exchange][wait, xfer]
+      if (comm.rank() != 0) return;
+
+      std::ofstream f(prefix + ".exchanges.jsonl", std::ios::trunc);
+      f.precision(9);
+      for (size_t i = 0; i < n; ++i) {
+        f << "{\"exchange\":" << i << ",\"op\":\"" << exchanges[i].op << "\",\"elem_bytes\":" << exchanges[i].elem_bytes <<
+            ",\"ranks\":" << p << ",\"send\":[";
+        std::vector<size_t> recv(p, 0);
+        for (int r = 0; r < p; ++r) {
+          f << (r > 0 ? ",[" : "[");
+          for (int d = 0; d < p; ++d) {
+            size_t c = rows[(r * n + i) * p + d];
+            recv[d] += c;
+            f << (d > 0 ? "," : "") << c;
+          }
+          f << "]";
+        }
+        f << "],\"recv_elems\":[";
+        for (int r = 0; r < p; ++r) f << (r > 0 ? "," : "") << recv[r];
+        f << "],\"wait_s\":[";
+        for (int r = 0; r < p; ++r) f << (r > 0 ? "," : "") << times[(r * n + i) * 2];
+        f << "],\"xfer_s\":[";
+        for (int r = 0; r < p; ++r) f << (r > 0 ? "," : "") << times[(r * n + i) * 2 + 1];
+        f << "]}" << std::endl;
+      }
+    }
+
+  public:
+    static CommProfiler & instance() {
+      static CommProfiler profiler;
+      return profiler;
+    }
+
+    /// start recording.  output files are written under prefix by report();  empty prefix reports to stdout only.
+    void enable(std::string const & _prefix = std::string()) {
+      prefix = _prefix;
+      on = true;
+    }
+    void disable() { on = false; }
+    bool enabled() const { return on; }
+
+    /// label of the calling thread's exchanges.
+    std::string op() const {
+      std::vector<std::string> const & stack = op_stack();
+      return stack.empty() ? std::string("other") : stack.back();
+    }
+
+    /**
+     * @brief record an exchange of elements of elem_bytes each.  no-op if recording is off.
+     * @details  the count all2all ran from w0 to w1, and the all2allv from x0 to x1.
+     */
+    template <typename S1, typename S2>
+    void record(std::vector<S1> const & send_counts, std::vector<S2> const & recv_counts, size_t const & elem_bytes,
+                clock::time_point const & w0, clock::time_point const & w1,
+                clock::time_point const & x0, clock::time_point const & x1) {
+      if (!on) return;
+
+      exchange e;
+      e.op = op();
+      e.elem_bytes = elem_bytes;
+      e.wait = std::chrono::duration<double>(w1 - w0).count();
+      e.xfer = std::chrono::duration<double>(x1 - x0).count();
+      e.send.assign(send_counts.begin(), send_counts.end());
+      e.recv.assign(recv_counts.begin(), recv_counts.end());
+
+      std::lock_guard<std::mutex> lock(mutex);
+      exchanges.emplace_back(std::move(e));
+    }
+
+    size_t size() {
+      std::lock_guard<std::mutex> lock(mutex);
+      return exchanges.size();
+    }
+
+    exchange get(size_t const & i) {
+      std::lock_guard<std::mutex> lock(mutex);
+      return exchanges[i];
+    }
+
+    void clear() {
+      std::lock_guard<std::mutex> lock(mutex);
+      exchanges.clear();
+    }
+
+    /**
+     * @brief summarize the exchanges per operation over the processes of comm.  collective.
+     * @details only the exchanges common to all processes are summarized.  op labels are those of this process.
+     *          the result is complete on rank 0 only.
+     */
+    std::vector<op_summary> summarize(::mxx::comm const & comm) {
+      std::lock_guard<std::mutex> lock(mutex);
+
+      size_t n = ::mxx::allreduce(exchanges.size(), [](size_t const & x, size_t const & y) { return std::min(x, y); }, comm);
+      std::vector<std::string> ops;
+      std::vector<size_t> op_of;
+      group(n, ops, op_of);
+      size_t m = ops.size();
+
+      // per op:  sent bytes, received elements, wait, xfer, messages, message bytes.  then per exchange received elements.
+      std::vector<double> sums(6 * m + n, 0.0);
+      std::vector<double> mins(m, std::numeric_limits<double>::max());
+      std::vector<double> maxs(m, 0.0);
+      for (size_t i = 0; i < n; ++i) {
+        exchange const & e = exchanges[i];
+        size_t o = op_of[i];
+        double recvd = static_cast<double>(std::accumulate(e.recv.begin(), e.recv.end(), static_cast<size_t>(0)));
+        for (size_t c : e.send) {
+          if (c == 0) continue;
+          double b = static_cast<double>(c * e.elem_bytes);
+          sums[6 * o] += b;
+          sums[6 * o + 4] += 1.0;
+          sums[6 * o + 5] += b;
+          mins[o] = std::min(mins[o], b);
+          maxs[o] = std::max(maxs[o], b);
+        }
+        sums[6 * o + 1] += recvd;
+        sums[6 * o + 2] += e.wait;
+        sums[6 * o + 3] += e.xfer;
+        sums[6 * m + i] = recvd;
+      }
+
+      std::vector<double> totals = reduce(sums, std::plus<double>(), comm);
+      std::vector<double> peaks = reduce(sums, [](double const & x, double const & y) { return std::max(x, y); }, comm);
+      mins = reduce(mins, [](double const & x, double const & y) { return std::min(x, y); }, comm);
+      maxs = reduce(maxs, [](double const & x, double const & y) { return std::max(x, y); }, comm);
+
+      if (!prefix.empty()) write_exchanges(n, comm);
+
+      std::vector<op_summary> result(m);
+      if (comm.rank() != 0) return result;
+
+      double p = comm.size();
+      for (size_t o = 0; o < m; ++o) {
+        op_summary & s = result[o];
+        s.op = ops[o];
+        s.calls = std::count(op_of.begin(), op_of.end(), o);
+        s.sent_bytes_max = peaks[6 * o];       s.sent_bytes_mean = totals[6 * o] / p;
+        s.recv_elems_max = peaks[6 * o + 1];   s.recv_elems_mean = totals[6 * o + 1] / p;
+        s.wait_max = peaks[6 * o + 2];         s.wait_mean = totals[6 * o + 2] / p;
+        s.xfer_max = peaks[6 * o + 3];         s.xfer_mean = totals[6 * o + 3] / p;
+        s.messages = totals[6 * o + 4];
+        s.msg_bytes_min = (s.messages > 0) ? mins[o] : 0.0;
+        s.msg_bytes_max = maxs[o];
+        s.msg_bytes_mean = (s.messages > 0) ? totals[6 * o + 5] / s.messages : 0.0;
+        s.worst_call_skew = 1.0;
+      }
+      for (size_t i = 0; i < n; ++i) {
+        op_summary & s = result[op_of[i]];
+        s.worst_call_skew = std::max(s.worst_call_skew, op_summary::skew(peaks[6 * m + i], totals[6 * m + i] / p));
+      }
+      return result;
+    }
+
+    /// summarize, print the table on rank 0, and write the output files if a prefix is set.  collective.  no-op if off.
+    void report(::mxx::comm const & comm, std::ostream & os = std::cout) {
+      if (!on) return;
+      std::vector<op_summary> result = summarize(comm);
+      if (comm.rank() != 0) return;
+
+      std::stringstream out;
+      out << "[COMM PROFILE] " << comm.size() << " ranks.  max and skew (max/mean) over ranks of per rank totals." << std::endl;
+      out << std::left << std::setw(16) << "op" << std::right << std::setw(8) << "calls" <<
+          std::setw(14) << "sent_MB_max" << std::setw(10) << "skew" <<
+          std::setw(14) << "recv_max" << std::setw(10) << "skew" << std::setw(12) << "worst_call" <<
+          std::setw(12) << "wait_s_max" << std::setw(10) << "skew" <<
+          std::setw(12) << "xfer_s_max" << std::setw(10) << "skew" <<
+          std::setw(12) << "messages" << std::setw(14) << "msg_B_min" << std::setw(14) << "msg_B_mean" <<
+          std::setw(14) << "msg_B_max" << std::endl;
+      out << std::fixed << std::setprecision(3);
+      for (auto const & s : result) {
+        out << std::left << std::setw(16) << s.op << std::right << std::setw(8) << s.calls <<
+            std::setw(14) << (s.sent_bytes_max / (1024.0 * 1024.0)) << std::setw(10) << s.sent_skew() <<
+            std::setw(14) << std::setprecision(0) << s.recv_elems_max << std::setprecision(3) << std::setw(10) << s.recv_skew() <<
+            std::setw(12) << s.worst_call_skew <<
+            std::setw(12) << s.wait_max << std::setw(10) << s.wait_skew() <<
+            std::setw(12) << s.xfer_max << std::setw(10) << s.xfer_skew() <<
+            std::setprecision(0) << std::setw(12) << s.messages << std::setw(14) << s.msg_bytes_min <<
+            std::setw(14) << s.msg_bytes_mean << std::setw(14) << s.msg_bytes_max << std::setprecision(3) << std::endl;
+      }
+      os << out.str() << std::flush;
+
+      if (prefix.empty()) return;
+      std::ofstream f(prefix + ".summary.csv", std::ios::trunc);
+      f.precision(9);
+      f << "op,calls,ranks,sent_bytes_max,sent_bytes_mean,sent_skew,recv_elems_max,recv_elems_mean,recv_skew,worst_call_skew,"
+           "wait_s_max,wait_s_mean,wait_skew,xfer_s_max,xfer_s_mean,xfer_skew,messages,msg_bytes_min,msg_bytes_mean,msg_bytes_max" << std::endl;
+      for (auto const & s : result) {
+        f << s.op << "," << s.calls << "," << comm.size() << "," <<
+            s.sent_bytes_max << "," << s.sent_bytes_mean << "," << s.sent_skew() << "," <<
+            s.recv_elems_max << "," << s.recv_elems_mean << "," << s.recv_skew() << "," << s.worst_call_skew << "," <<
+            s.wait_max << "," << s.wait_mean << "," << s.wait_skew() << "," <<
+            s.xfer_max << "," << s.xfer_mean << "," << s.xfer_skew() << "," <<
+            s.messages << "," << s.msg_bytes_min << "," << s.msg_bytes_mean << "," << s.msg_bytes_max << std::endl;
+      }
+    }
+};
+
+} // end namespace plog
+
+#endif /* SRC_UTILS_COMM_PROFILER_HPP_ */
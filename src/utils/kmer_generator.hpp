@@ -0,0 +1,210 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    kmer_generator.hpp
+ * @ingroup utils
+ * @author  agent <agent@local>
+ * @brief   kmer workload generators for benchmarking the hash tables and indices.
+ * @details uniformly random kmers make every key distinct, so they hide how real data behaves.  these generators
+ *          produce kmer streams with a realistic multiplicity structure:
+ *            zipf_kmers:      repeats with zipfian multiplicity, so a few kmers are very frequent.
+ *            spectrum_kmers:  a read-set like spectrum.  most distinct kmers are singletons (sequencing errors),
+ *                             the rest appear about `coverage` times.
+ *            read_kmers:      kmers of reads sampled from both strands of a random genome, with substitution errors.
+ *          flip_strands turns a fraction of the kmers into their reverse complements, which collide under canonicalization.
+ *
+ *          all generators are deterministic for a given seed.  zipf_kmers and read_kmers also take separate seeds for
+ *          the key set (or genome) and for the sampling, so processes can share the keys and sample different streams.
+ */
+#ifndef BLISS_UTILS_KMER_GENERATOR_HPP
+#define BLISS_UTILS_KMER_GENERATOR_HPP
+
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace bliss
+{
+namespace utils
+{
+
+  /// a random kmer.  the unused high bits are cleared.
+  template <typename Kmer, typename RNG>
+  Kmer random_kmer(RNG & gen) {
+    std::uniform_int_distribution<uint64_t> word;
+    Kmer km;
+    for (size_t j = 0; j < Kmer::nWords; ++j) {
+      km.getDataRef()[j] = static_cast<typename Kmer::KmerWordType>(word(gen));
+    }
+    km.sanitize();
+    return km;
+  }
+
+  /// `count` uniformly random kmers.  almost all distinct.
+  template <typename Kmer>
+  void uniform_kmers(std::vector<Kmer> & output, size_t const count, unsigned int const seed = 23) {
+    std::mt19937_64 gen(seed);
+    output.resize(count);
+    for (size_t i = 0; i < count; ++i) output[i] = random_kmer<Kmer>(gen);
+  }
+
+  /**
+   * @brief `count` kmers drawn from `distinct` random kmers, with the kmer of rank r drawn with probability proportional to 1 / r^s.
+   * @details s = 0 is uniform over the distinct kmers.  s around 1 gives the heavy head of highly repetitive sequence.
+   *          the distinct kmers and their ranks come from key_seed, the draws from sample_seed.
+   */
+  template <typename Kmer>
+  void zipf_kmers(std::vector<Kmer> & output, size_t const count, size_t const distinct, double const s,
+                  unsigned int const key_seed, unsigned int const sample_seed) {
+    std::mt19937_64 gen(sample_seed);
+
+    std::vector<Kmer> keys;
+    uniform_kmers(keys, std::max(distinct, static_cast<size_t>(1)), key_seed);
+
+    std::vector<double> weights(keys.size());
+    for (size_t r = 0; r < keys.size(); ++r) weights[r] = 1.0 / std::pow(static_cast<double>(r + 1), s);
+    std::discrete_distribution<size_t> rank(weights.begin(), weights.end());
+
+    output.resize(count);
+    for (size_t i = 0; i < count; ++i) output[i] = keys[rank(gen)];
+  }
+
+  template <typename Kmer>
+  void zipf_kmers(std::vector<Kmer> & output, size_t const count, size_t const distinct, double const s,
+                  unsigned int const seed = 23) {
+    zipf_kmers(output, count, distinct, s, seed + 1, seed);
+  }
+
+  /**
+   * @brief `count` kmers with the spectrum of a sequencing read set, shuffled.
+   * @details each new distinct kmer is a singleton with probability `singleton_frac`.  otherwise its multiplicity
+   *          is 1 + poisson(coverage - 1).  the last kmer is truncated to fill exactly `count`.
+   */
+  template <typename Kmer>
+  void spectrum_kmers(std::vector<Kmer> & output, size_t const count, double const singleton_frac, double const coverage,
+                      unsigned int const seed = 23) {
+    std::mt19937_64 gen(seed);
+    std::bernoulli_distribution singleton(singleton_frac);
+    std::poisson_distribution<size_t> extra(std::max(coverage - 1.0, 0.0));
+
+    output.clear();
+    output.reserve(count);
+    while (output.size() < count) {
+      Kmer km = random_kmer<Kmer>(gen);
+      size_t n = singleton(gen) ? 1 : 1 + extra(gen);
+      n = std::min(n, count - output.size());
+      output.insert(output.end(), n, km);
+    }
+    std::shuffle(output.begin(), output.end(), gen);
+  }
+
+  /**
+   * @brief `count` kmers from reads sampled uniformly from a random genome of `genome_length` bases.
+   * @details reads of `read_length` bases come from either strand with equal probability, and each base is
+   *          substituted with probability `error_rate`.  with error_rate = 0 every kmer occurs in the genome.
+   *          requires an alphabet with A, C, G and T.  the genome comes from genome_seed, the reads from sample_seed.
+   */
+  template <typename Kmer>
+  void read_kmers(std::vector<Kmer> & output, size_t const count, size_t const genome_length, size_t const read_length,
+                  double const error_rate, unsigned int const genome_seed, unsigned int const sample_seed) {
+    static const char bases[] = "ACGT";
+    std::uniform_int_distribution<int> base(0, 3);
+
+    size_t const len = std::max(genome_length, static_cast<size_t>(Kmer::size));
+    size_t const rlen = std::min(std::max(read_length, static_cast<size_t>(Kmer::size)), len);
+
+    std::string genome(len, 'A');
+    {
+      std::mt19937_64 genome_gen(genome_seed);
+      for (size_t i = 0; i < len; ++i) genome[i] = bases[base(genome_gen)];
+    }
+
+    std::mt19937_64 gen(sample_seed);
+
+    std::uniform_int_distribution<size_t> start(0, len - rlen);
+    std::bernoulli_distribution reverse(0.5);
+    std::bernoulli_distribution error(error_rate);
+    std::uniform_int_distribution<int> other(1, 3);
+
+    output.clear();
+    output.reserve(count);
+    std::string read(rlen, 'A');
+    while (output.size() < count) {
+      size_t pos = start(gen);
+      if (reverse(gen)) {
+        for (size_t i = 0; i < rlen; ++i) {
+          switch (genome[pos + rlen - 1 - i]) {
+            case 'A': read[i] = 'T'; break;
+            case 'C': read[i] = 'G'; break;
+            case 'G': read[i] = 'C'; break;
+            default:  read[i] = 'A'; break;
+          }
+        }
+      } else {
+        read.assign(genome, pos, rlen);
+      }
+      for (size_t i = 0; i < rlen; ++i) {
+        if (error(gen)) read[i] = bases[((std::find(bases, bases + 4, read[i]) - bases) + other(gen)) & 0x3];
+      }
+
+      Kmer km;
+      for (size_t i = 0; (i < rlen) && (output.size() < count); ++i) {
+        km.nextFromChar(Kmer::KmerAlphabet::FROM_ASCII[static_cast<unsigned char>(read[i])]);
+        if (i + 1 >= Kmer::size) output.push_back(km);
+      }
+    }
+  }
+
+  template <typename Kmer>
+  void read_kmers(std::vector<Kmer> & output, size_t const count, size_t const genome_length, size_t const read_length,
+                  double const error_rate, unsigned int const seed = 23) {
+    read_kmers(output, count, genome_length, read_length, error_rate, seed, seed + 1);
+  }
+
+  /// replace a `frac` fraction of the kmers by their reverse complements.  the kmers are unchanged under canonicalization.
+  template <typename Kmer>
+  void flip_strands(std::vector<Kmer> & kmers, double const frac, unsigned int const seed = 23) {
+    if (frac <= 0.0) return;
+    std::mt19937_64 gen(seed);
+    std::bernoulli_distribution flip(frac);
+    for (size_t i = 0; i < kmers.size(); ++i) {
+      if (flip(gen)) kmers[i] = kmers[i].reverse_complement();
+    }
+  }
+
+  /// number of distinct kmers and of singletons.  sorts the input.
+  template <typename Kmer>
+  std::pair<size_t, size_t> count_distinct(std::vector<Kmer> & kmers) {
+    std::sort(kmers.begin(), kmers.end());
+    size_t distinct = 0, singletons = 0;
+    for (size_t i = 0; i < kmers.size(); ) {
+      size_t j = i + 1;
+      while ((j < kmers.size()) && (kmers[j] == kmers[i])) ++j;
+      ++distinct;
+      if (j - i == 1) ++singletons;
+      i = j;
+    }
+    return std::make_pair(distinct, singletons);
+  }
+
+} // namespace utils
+} // namespace bliss
+
+#endif // BLISS_UTILS_KMER_GENERATOR_HPP
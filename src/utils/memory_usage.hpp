@@ -22,6 +22,9 @@
  * @details each "mark" call snapshots the current memory usage and peak memory usage.
  *          relies on http://nadeausoftware.com/articles/2012/07/c_c_tip_how_get_process_resident_set_size_physical_memory_use#GetProcessMemoryInfonbspforpeakandcurrentresidentsetsize
  *
+ *          bytes handed out by plog::tracking_allocator are also snapshot per category at each mark:  the live bytes, and
+ *          the peak since the previous mark.  see tracking_allocator.hpp.
+ *
  *          also see http://www.linuxatemyram.com/play.html and
  *          http://stackoverflow.com/questions/349889/how-do-you-determine-the-amount-of-linux-system-ram-in-c
  *
@@ -45,10 +48,14 @@
 #include <string>
 #include <algorithm>  // std::min
 #include <sstream>
+#include <iterator>  // ostream_iterator
 #include <cmath>  // std::sqrt
 
 #include <io/io_exception.hpp>
 #include <mxx/reduction.hpp>
+#include <mxx/collective.hpp>  // allgatherv
+
+#include "utils/tracking_allocator.hpp"
 
 //http://nadeausoftware.com/articles/2012/07/c_c_tip_how_get_process_resident_set_size_physical_memory_use#GetProcessMemoryInfonbspforpeakandcurrentresidentsetsize
 // note:  reports in bytes.
@@ -113,6 +120,45 @@ class MemUsage {
     std::vector<double> mem_curr;
     std::vector<double> mem_max;
 
+    // tracked allocations:  per mark, live bytes and peak since the previous mark, per category.
+    AllocTracker::window alloc_window;
+    std::vector<std::vector<int64_t> > alloc_live;
+    std::vector<std::vector<int64_t> > alloc_peak;
+
+    /// [mark][category id] as [category in cats][mark].  categories this process has not used are 0.
+    static std::vector<std::vector<double> > by_category(std::vector<std::vector<int64_t> > const & x,
+                                                         std::vector<std::string> const & cats) {
+      std::vector<std::string> local = AllocTracker::instance().categories();
+      std::vector<std::vector<double> > out(cats.size(), std::vector<double>(x.size(), 0.0));
+      for (size_t l = 0; l < local.size(); ++l) {
+        size_t c = std::distance(cats.begin(), std::find(cats.begin(), cats.end(), local[l]));
+        if (c == cats.size()) continue;
+        for (size_t i = 0; i < x.size(); ++i)
+          if (l < x[i].size()) out[c][i] = x[i][l];
+      }
+      return out;
+    }
+
+    /// the category names of all processes, sorted.  the ids of a category can differ between processes.
+    static std::vector<std::string> category_names(::mxx::comm const & comm) {
+      std::vector<char> joined;
+      for (auto const & n : AllocTracker::instance().categories()) {
+        joined.insert(joined.end(), n.begin(), n.end());
+        joined.push_back('\0');
+      }
+      joined = ::mxx::allgatherv(joined, comm);
+
+      std::vector<std::string> cats;
+      for (auto it = joined.begin(); it != joined.end(); ) {
+        auto e = std::find(it, joined.end(), '\0');
+        cats.emplace_back(it, e);
+        it = (e == joined.end()) ? e : e + 1;
+      }
+      std::sort(cats.begin(), cats.end());
+      cats.erase(std::unique(cats.begin(), cats.end()), cats.end());
+      return cats;
+    }
+
   public:
 
     /// return the program usable ram in bytes.
@@ -158,6 +204,9 @@ class MemUsage {
       names.clear();
       mem_curr.clear();
       mem_max.clear();
+      alloc_live.clear();
+      alloc_peak.clear();
+      alloc_window.reset();
     }
 
 
@@ -166,6 +215,9 @@ class MemUsage {
       names.push_back(name);
       mem_curr.push_back(::getCurrentRSS());
       mem_max.push_back(::getPeakRSS());
+      alloc_live.push_back(AllocTracker::instance().live());
+      alloc_peak.push_back(alloc_window.peak());
+      alloc_window.reset();
     }
     void collective_mark(::std::string const & name, ::mxx::comm const & comm) {
 
@@ -198,6 +250,18 @@ class MemUsage {
         std::transform(mem_max.begin(), mem_max.end(), dit, BtoMB);
         output << "]";
 
+        std::vector<std::string> cats = AllocTracker::instance().categories();
+        size_t ncats = cats.size();
+        std::vector<std::vector<double> > live = by_category(alloc_live, cats);
+        std::vector<std::vector<double> > peak = by_category(alloc_peak, cats);
+        for (size_t c = 0; c < ncats; ++c) {
+          output << std::endl << "[MEM] " << title << "\t" << cats[c] << "_live\t[,";
+          std::transform(live[c].begin(), live[c].end(), dit, BtoMB);
+          output << "]" << std::endl << "[MEM] " << title << "\t" << cats[c] << "_peak\t[,";
+          std::transform(peak[c].begin(), peak[c].end(), dit, BtoMB);
+          output << "]";
+        }
+
         // print pending stuff, then print entire string at once (minimizes multiple threads/processes mixing output )
         fflush(stdout);
         printf("%s\n", output.str().c_str());
@@ -311,6 +375,23 @@ class MemUsage {
       int p = comm.size();
       int rank = comm.rank();
 
+      // tracked allocations, max and mean over the processes, matched by category name.
+      std::vector<std::string> cats = category_names(comm);
+      size_t ncats = cats.size();
+      std::vector<std::vector<double> > live = by_category(alloc_live, cats);
+      std::vector<std::vector<double> > peak = by_category(alloc_peak, cats);
+      std::vector<std::vector<double> > live_maxs(ncats), live_means(ncats), alloc_peak_maxs(ncats), alloc_peak_means(ncats);
+      if (names.size() > 0) {
+        for (size_t c = 0; c < ncats; ++c) {
+          live_maxs[c] = ::mxx::reduce(live[c], 0, [](double const & x, double const & y) { return ::std::max(x, y); }, comm);
+          live_means[c] = ::mxx::reduce(live[c], 0, ::std::plus<double>(), comm);
+          alloc_peak_maxs[c] = ::mxx::reduce(peak[c], 0, [](double const & x, double const & y) { return ::std::max(x, y); }, comm);
+          alloc_peak_means[c] = ::mxx::reduce(peak[c], 0, ::std::plus<double>(), comm);
+          ::std::for_each(live_means[c].begin(), live_means[c].end(), [&p](double & x) { x /= p; });
+          ::std::for_each(alloc_peak_means[c].begin(), alloc_peak_means[c].end(), [&p](double & x) { x /= p; });
+        }
+      }
+
       if (mem_curr.size() > 0) {
     	  curr_mins = ::mxx::reduce(mem_curr, 0,
     			[](double const & x, double const & y) { return ::std::min(x, y); }, comm);
@@ -387,6 +468,17 @@ class MemUsage {
           std::transform(peak_stdevs.begin(), peak_stdevs.end(), dit, BtoMB);
           output << "]";
 
+          for (size_t c = 0; c < ncats; ++c) {
+            output << std::endl << "[MEM] " << title << "\t" << cats[c] << "_live_max\t[,";
+            std::transform(live_maxs[c].begin(), live_maxs[c].end(), dit, BtoMB);
+            output << "]" << std::endl << "[MEM] " << title << "\t" << cats[c] << "_live_mean\t[,";
+            std::transform(live_means[c].begin(), live_means[c].end(), dit, BtoMB);
+            output << "]" << std::endl << "[MEM] " << title << "\t" << cats[c] << "_peak_max\t[,";
+            std::transform(alloc_peak_maxs[c].begin(), alloc_peak_maxs[c].end(), dit, BtoMB);
+            output << "]" << std::endl << "[MEM] " << title << "\t" << cats[c] << "_peak_mean\t[,";
+            std::transform(alloc_peak_means[c].begin(), alloc_peak_means[c].end(), dit, BtoMB);
+            output << "]";
+          }
 
           fflush(stdout);
           printf("%s\n", output.str().c_str());
@@ -0,0 +1,124 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    net_delay.hpp
+ * @ingroup
+ * @author  agent <agent@local>
+ * @brief   synthetic network delay for the all-to-all exchanges, to emulate inter-node links on a single machine.
+ * @details ranks are grouped into virtual nodes of ranks_per_node consecutive ranks.  after each exchange
+ *          (imxx::distribute, imxx::undistribute, imxx::exchange), a process sleeps for
+ *
+ *            latency * (remote peers + remote messages) + max(remote bytes sent, remote bytes received) / bandwidth
+ *
+ *          where remote counts only ranks on other virtual nodes, a message is a non-empty send, and the remote peers
+ *          term accounts for the count all2all that precedes each exchange.  shared memory transfers between ranks of
+ *          the same virtual node are not delayed.  the next collective propagates the delay of the slowest process.
+ *
+ *          off unless enabled, either with enable() or with the environment variable
+ *            BL_NET_DELAY=latency_us:bandwidth_MBps[:ranks_per_node]     e.g. 2:10000:4.  bandwidth 0 is unlimited.
+ */
+#ifndef SRC_UTILS_NET_DELAY_HPP_
+#define SRC_UTILS_NET_DELAY_HPP_
+
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <algorithm>  // max
+#include <cstdlib>    // getenv
+#include <stdexcept>
+
+#include <mxx/comm.hpp>
+
+namespace plog {
+
+  class NetDelay {
+    protected:
+      bool on;
+      double latency;       // seconds per message
+      double bandwidth;     // bytes per second.  0 is unlimited.
+      int ranks_per_node;
+
+      NetDelay() : on(false), latency(0.0), bandwidth(0.0), ranks_per_node(1) {
+        const char * s = std::getenv("BL_NET_DELAY");
+        if (s != nullptr) enable(s);
+      }
+
+    public:
+      static NetDelay & instance() {
+        static NetDelay delay;
+        return delay;
+      }
+
+      /// delay exchanges by latency_us per message and a per process link of bandwidth_MBps.
+      void enable(double const & latency_us, double const & bandwidth_MBps, int const & _ranks_per_node = 1) {
+        if ((latency_us < 0.0) || (bandwidth_MBps < 0.0) || (_ranks_per_node < 1))
+          throw std::invalid_argument("net delay:  latency and bandwidth must be non-negative, ranks per node positive");
+        latency = latency_us * 1.0e-6;
+        bandwidth = bandwidth_MBps * 1.0e6;
+        ranks_per_node = _ranks_per_node;
+        on = true;
+      }
+      /// enable from "latency_us:bandwidth_MBps[:ranks_per_node]".
+      void enable(std::string const & spec) {
+        std::stringstream ss(spec);
+        std::string item;
+        std::vector<double> v;
+        try {
+          while (std::getline(ss, item, ':')) v.push_back(std::stod(item));
+        } catch (std::logic_error &) {
+          v.clear();
+        }
+        if ((v.size() < 2) || (v.size() > 3))
+          throw std::invalid_argument("net delay:  expected latency_us:bandwidth_MBps[:ranks_per_node], got " + spec);
+        enable(v[0], v[1], (v.size() > 2) ? static_cast<int>(v[2]) : 1);
+      }
+      void disable() { on = false; }
+      bool enabled() const { return on; }
+
+      /// seconds of delay for process rank, given its element counts to and from each rank.
+      template <typename S1, typename S2>
+      double cost(std::vector<S1> const & send_counts, std::vector<S2> const & recv_counts, size_t const & elem_bytes,
+                  int const & rank) const {
+        int node = rank / ranks_per_node;
+        size_t peers = 0, messages = 0, sent = 0, recvd = 0;
+        for (size_t r = 0; r < send_counts.size(); ++r) {
+          if (static_cast<int>(r) / ranks_per_node == node) continue;
+          ++peers;
+          if (send_counts[r] > 0) ++messages;
+          sent += send_counts[r];
+          if (r < recv_counts.size()) recvd += recv_counts[r];
+        }
+        double t = latency * static_cast<double>(peers + messages);
+        if (bandwidth > 0.0) t += static_cast<double>(std::max(sent, recvd) * elem_bytes) / bandwidth;
+        return t;
+      }
+
+      /// sleep for the emulated transfer time of an exchange.  no-op if off.
+      template <typename S1, typename S2>
+      void inject(std::vector<S1> const & send_counts, std::vector<S2> const & recv_counts, size_t const & elem_bytes,
+                  ::mxx::comm const & comm) const {
+        if (!on) return;
+        double t = cost(send_counts, recv_counts, elem_bytes, comm.rank());
+        if (t > 0.0) std::this_thread::sleep_for(std::chrono::duration<double>(t));
+      }
+  };
+
+} // namespace plog
+
+#endif // SRC_UTILS_NET_DELAY_HPP_
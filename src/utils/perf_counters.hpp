@@ -0,0 +1,357 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    perf_counters.hpp
+ * @ingroup
+ * @author  agent <agent@local>
+ * @brief   hardware performance counters (cycles, instructions, LLC, dTLB and branch misses) for the benchmark phases.
+ * @details uses linux perf_event_open directly, so no vendor tools or libraries are needed.  the counters are opened once
+ *          per thread, user space only, and count the calling thread.  each counter is opened separately and scaled by
+ *          time enabled / time running, so counters still work when the PMU multiplexes them.
+ *
+ *          a counter that cannot be opened (no PMU in a VM, perf_event_paranoid too high, not linux) is reported as n/a;
+ *          the others still work.
+ *
+ *          PerfCounters follows Timer and MemUsage:  one per BL_BENCH scope, one entry per phase, and the MPI report
+ *          gives the min, max and mean over the processes.  enabled by the ENABLE_PERF_BENCHMARK cmake option.
+ */
+#ifndef SRC_UTILS_PERF_COUNTERS_HPP_
+#define SRC_UTILS_PERF_COUNTERS_HPP_
+
+#include "bliss-logger_config.hpp"
+
+#include <vector>
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <algorithm>  // std::min
+#include <functional> // std::plus
+#include <sstream>
+#include <iterator>   // ostream_iterator
+#include <cstdint>
+#include <cstring>    // memset
+#include <cstdio>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+#include <mxx/reduction.hpp>
+
+
+namespace plog {
+
+/// the calling thread's counters.  opened on first use, closed when the thread exits.
+class PerfEvents {
+  public:
+    static constexpr int N = 5;
+    enum counter { CYCLES = 0, INSTRUCTIONS, LLC_MISSES, DTLB_MISSES, BRANCH_MISSES };
+
+    /// raw value, time enabled, time running, per counter.
+    using sample = std::array<std::array<uint64_t, 3>, N>;
+
+  protected:
+    std::array<int, N> fds;
+
+#if defined(__linux__)
+    static int open_counter(uint32_t const & type, uint64_t const & config) {
+      struct perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = type;
+      attr.config = config;
+      attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    static uint64_t cache_miss(uint64_t const & cache) {
+      return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    }
+#endif
+
+    PerfEvents() {
+      fds.fill(-1);
+#if defined(__linux__)
+      fds[CYCLES] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+      fds[INSTRUCTIONS] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+      fds[LLC_MISSES] = open_counter(PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_LL));
+      fds[DTLB_MISSES] = open_counter(PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_DTLB));
+      fds[BRANCH_MISSES] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+#endif
+    }
+
+  public:
+    ~PerfEvents() {
+#if defined(__linux__)
+      for (int fd : fds) if (fd >= 0) close(fd);
+#endif
+    }
+    PerfEvents(PerfEvents const &) = delete;
+    PerfEvents & operator=(PerfEvents const &) = delete;
+
+    static PerfEvents & instance() {
+      static thread_local PerfEvents events;
+      return events;
+    }
+
+    static const char * name(int const & i) {
+      static const char * names[N] = {"cycles", "instructions", "llc_misses", "dtlb_misses", "branch_misses"};
+      return names[i];
+    }
+
+    bool available(int const & i) const { return fds[i] >= 0; }
+
+    void read(sample & s) const {
+      for (int i = 0; i < N; ++i) {
+        s[i].fill(0);
+#if defined(__linux__)
+        if (fds[i] >= 0 && (::read(fds[i], s[i].data(), sizeof(s[i])) != static_cast<ssize_t>(sizeof(s[i])))) s[i].fill(0);
+#endif
+      }
+    }
+
+    /// events of counter i between samples a and b, scaled up for the fraction of the time the counter ran.
+    static double delta(sample const & a, sample const & b, int const & i) {
+      double value = static_cast<double>(b[i][0] - a[i][0]);
+      double enabled = static_cast<double>(b[i][1] - a[i][1]);
+      double running = static_cast<double>(b[i][2] - a[i][2]);
+      return (running > 0) ? value * (enabled / running) : value;
+    }
+};
+
+
+class PerfCounters {
+  protected:
+    static constexpr int N = PerfEvents::N;
+
+    std::vector<std::string> names;
+    std::array<std::vector<double>, N> values;
+    PerfEvents::sample s1;
+
+    std::unordered_map<size_t, PerfEvents::sample> loop_s1;
+    std::unordered_map<size_t, std::array<double, N> > loop_acc;
+
+    void add(::std::string const & name, std::array<double, N> const & v) {
+      names.push_back(name);
+      for (int i = 0; i < N; ++i) values[i].push_back(v[i]);
+    }
+
+    std::array<double, N> since(PerfEvents::sample const & start) const {
+      PerfEvents::sample s2;
+      PerfEvents::instance().read(s2);
+      std::array<double, N> v;
+      for (int i = 0; i < N; ++i) v[i] = PerfEvents::delta(start, s2, i);
+      return v;
+    }
+
+    /// instructions per cycle of each phase.
+    static std::vector<double> ipc(std::vector<double> const & instructions, std::vector<double> const & cycles) {
+      std::vector<double> r(cycles.size(), 0.0);
+      for (size_t j = 0; j < r.size(); ++j) r[j] = (cycles[j] > 0) ? instructions[j] / cycles[j] : 0.0;
+      return r;
+    }
+
+  public:
+    PerfCounters() {
+      reset();
+    }
+
+    void reset() {
+      names.clear();
+      for (int i = 0; i < N; ++i) values[i].clear();
+      loop_s1.clear();
+      loop_acc.clear();
+      PerfEvents::instance().read(s1);
+    }
+
+//=========== loop stuff.
+    void loop_start(size_t const & id) {
+      loop_acc[id].fill(0.0);
+      PerfEvents::instance().read(loop_s1[id]);
+    }
+    void loop_resume(size_t const & id) {
+      PerfEvents::instance().read(loop_s1[id]);
+    }
+    void loop_pause(size_t const & id) {
+      std::array<double, N> v = since(loop_s1[id]);
+      std::array<double, N> & acc = loop_acc[id];
+      for (int i = 0; i < N; ++i) acc[i] += v[i];
+    }
+    void loop_end(size_t const & id, ::std::string const & name) {
+      add(name, loop_acc[id]);
+      loop_acc.erase(id);
+      loop_s1.erase(id);
+    }
+
+//============ counter start
+    void start() { PerfEvents::instance().read(s1); }
+    void end(::std::string const & name) {
+      add(name, since(s1));
+    }
+
+    size_t size() const { return names.size(); }
+    /// per phase values of counter i.
+    std::vector<double> const & get(int const & i) const { return values[i]; }
+
+    void report(::std::string const & title) {
+      std::stringstream output;
+      std::ostream_iterator<std::string> nit(output, ",");
+      std::ostream_iterator<double> dit(output, ",");
+
+      output << std::fixed;
+      output << "[PERF] " << title << "\theader\t[,";
+      std::copy(names.begin(), names.end(), nit);
+      output << "]";
+
+      output.precision(0);
+      for (int i = 0; i < N; ++i) {
+        output << std::endl << "[PERF] " << title << "\t" << PerfEvents::name(i);
+        if (!PerfEvents::instance().available(i)) {
+          output << "\tn/a";
+          continue;
+        }
+        output << "\t[,";
+        std::copy(values[i].begin(), values[i].end(), dit);
+        output << "]";
+      }
+
+      if (PerfEvents::instance().available(PerfEvents::CYCLES) && PerfEvents::instance().available(PerfEvents::INSTRUCTIONS)) {
+        output.precision(3);
+        output << std::endl << "[PERF] " << title << "\tipc\t[,";
+        std::vector<double> r = ipc(values[PerfEvents::INSTRUCTIONS], values[PerfEvents::CYCLES]);
+        std::copy(r.begin(), r.end(), dit);
+        output << "]";
+      }
+
+      // print pending stuff, then print entire string at once (minimizes multiple threads/processes mixing output )
+      fflush(stdout);
+      printf("%s\n", output.str().c_str());
+      fflush(stdout);
+    }
+
+    /// min, max and mean of each counter over the processes, and the ipc of the summed counts.  collective.
+    void report(::std::string const & title, ::mxx::comm const & comm) {
+      int p = comm.size();
+      int rank = comm.rank();
+
+      // a counter is reported only if it is available everywhere.
+      std::vector<int> avail(N);
+      for (int i = 0; i < N; ++i) avail[i] = PerfEvents::instance().available(i) ? 1 : 0;
+      avail = ::mxx::allreduce(avail, [](int const & x, int const & y) { return ::std::min(x, y); }, comm);
+
+      std::array<std::vector<double>, N> mins, maxs, means;
+      if (names.size() > 0) {
+        for (int i = 0; i < N; ++i) {
+          if (avail[i] == 0) continue;
+          mins[i] = ::mxx::reduce(values[i], 0,
+                                  [](double const & x, double const & y) { return ::std::min(x, y); }, comm);
+          maxs[i] = ::mxx::reduce(values[i], 0,
+                                  [](double const & x, double const & y) { return ::std::max(x, y); }, comm);
+          means[i] = ::mxx::reduce(values[i], 0, ::std::plus<double>(), comm);
+        }
+      }
+
+      if (rank == 0) {
+        std::stringstream output;
+        std::ostream_iterator<std::string> nit(output, ",");
+        std::ostream_iterator<double> dit(output, ",");
+
+        output << std::fixed;
+        output << "[PERF] " << "R " << rank << "/" << p << std::endl;
+
+        output << "[PERF] " << title << "\theader\t[,";
+        std::copy(names.begin(), names.end(), nit);
+        output << "]";
+
+        output.precision(0);
+        for (int i = 0; i < N; ++i) {
+          if (avail[i] == 0) {
+            output << std::endl << "[PERF] " << title << "\t" << PerfEvents::name(i) << "\tn/a";
+            continue;
+          }
+          // ipc below needs the sums, so divide a copy.
+          std::vector<double> mean(means[i]);
+          ::std::for_each(mean.begin(), mean.end(), [&p](double & x) { x /= p; });
+
+          output << std::endl << "[PERF] " << title << "\t" << PerfEvents::name(i) << "_min\t[,";
+          std::copy(mins[i].begin(), mins[i].end(), dit);
+          output << "]" << std::endl << "[PERF] " << title << "\t" << PerfEvents::name(i) << "_max\t[,";
+          std::copy(maxs[i].begin(), maxs[i].end(), dit);
+          output << "]" << std::endl << "[PERF] " << title << "\t" << PerfEvents::name(i) << "_mean\t[,";
+          std::copy(mean.begin(), mean.end(), dit);
+          output << "]";
+        }
+
+        if (avail[PerfEvents::CYCLES] && avail[PerfEvents::INSTRUCTIONS]) {
+          output.precision(3);
+          output << std::endl << "[PERF] " << title << "\tipc\t[,";
+          std::vector<double> r = ipc(means[PerfEvents::INSTRUCTIONS], means[PerfEvents::CYCLES]);
+          std::copy(r.begin(), r.end(), dit);
+          output << "]";
+        }
+
+        fflush(stdout);
+        printf("%s\n", output.str().c_str());
+        fflush(stdout);
+      }
+      comm.barrier();
+    }
+};
+
+} // end namespace plog
+
+#if BL_BENCHMARK_PERF == 1
+
+#define BL_PERF_INIT(title)      ::plog::PerfCounters title##_perf;
+#define BL_PERF_RESET(title)     do { title##_perf.reset(); } while (0)
+
+#define BL_PERF_LOOP_START(title, id)     do { title##_perf.loop_start(id); } while (0)
+#define BL_PERF_LOOP_RESUME(title, id)    do { title##_perf.loop_resume(id); } while (0)
+#define BL_PERF_LOOP_PAUSE(title, id)     do { title##_perf.loop_pause(id); } while (0)
+#define BL_PERF_LOOP_END(title, id, name) do { title##_perf.loop_end(id, name); } while (0)
+
+#define BL_PERF_START(title)     do { title##_perf.start(); } while (0)
+#define BL_PERF_END(title, name) do { title##_perf.end(name); } while (0)
+#define BL_PERF_REPORT(title) do { title##_perf.report(#title); } while (0)
+#define BL_PERF_REPORT_NAMED(title, name) do { title##_perf.report(name); } while (0)
+#define BL_PERF_REPORT_MPI(title, comm) do { title##_perf.report(#title, comm); } while (0)
+#define BL_PERF_REPORT_MPI_NAMED(title, name, comm) do { title##_perf.report(name, comm); } while (0)
+
+#else
+
+#define BL_PERF_INIT(title)
+#define BL_PERF_RESET(title)
+#define BL_PERF_LOOP_START(title, id)
+#define BL_PERF_LOOP_RESUME(title, id)
+#define BL_PERF_LOOP_PAUSE(title, id)
+#define BL_PERF_LOOP_END(title, id, name)
+#define BL_PERF_START(title)
+#define BL_PERF_END(title, name)
+#define BL_PERF_REPORT(title)
+#define BL_PERF_REPORT_NAMED(title, name)
+#define BL_PERF_REPORT_MPI(title, comm)
+#define BL_PERF_REPORT_MPI_NAMED(title, name, comm)
+
+#endif
+
+
+#endif /* SRC_UTILS_PERF_COUNTERS_HPP_ */
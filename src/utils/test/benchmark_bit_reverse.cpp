@@ -28,6 +28,7 @@
 
 // include files to test
 #include "utils/bitgroup_ops.hpp"
+#include "utils/bitgroup_dispatch.hpp"
 
 #include "utils/benchmark_utils.hpp"
 #include "utils/test/bit_test_common.hpp"
@@ -37,6 +38,7 @@
 //TESTS: for each, test different input (drawing from a 32 byte array),
 //       different offsets, different bit group sizes, different word types, and different byte array lengths.
 //TESTS: reverse entire array via multiplel SWAR, SSSE3, and AVX2 calls.
+//TESTS: reverse entire array via the run time dispatched kernels (bitgroup_dispatch.hpp), each one the CPU supports.
 
 // NOTE if the gtest fixture class is missing the trailing semicolon, compile error about "expected initializer..."
 template <unsigned char BITS_PER_GROUP>
@@ -322,6 +324,25 @@ class BitReverseArrayBenchmark : public ::testing::Test {
       BL_TIMER_END(this->bitrev, name, BitReverseBenchmarkHelper<P2::bitsPerGroup>::iters * 128);
     }
 
+    // run time dispatched kernel.  the kernels require out and in not to overlap, so read from the input array
+    // and write to a separate one, at the same offsets as array_test.
+    template <bool COMPLEMENT, typename P2 = P,
+        typename ::std::enable_if<((P2::bitsPerGroup & (P2::bitsPerGroup - 1)) == 0), int>::type = 0>
+    void dispatch_test( std::string name, unsigned char simd ) {
+      ::bliss::utils::bit_ops::dispatch::reverse_kernel k =
+          ::bliss::utils::bit_ops::dispatch::kernel_for<P2::bitsPerGroup, COMPLEMENT>(simd);
+      uint8_t BLISS_ALIGNED_ARRAY(out, 384, 32);
+
+      BL_TIMER_START(this->bitrev);
+      for (size_t iter = 0; iter < BitReverseBenchmarkHelper<P2::bitsPerGroup>::iters; ++iter) {
+        k( out + (iter + 119) % 238, this->helper.input + (iter % 238), 128);
+      }
+      BL_TIMER_END(this->bitrev, name, BitReverseBenchmarkHelper<P2::bitsPerGroup>::iters * 128);
+    }
+    template <bool COMPLEMENT, typename P2 = P,
+        typename ::std::enable_if<((P2::bitsPerGroup & (P2::bitsPerGroup - 1)) != 0), int>::type = 0>
+    void dispatch_test( std::string name, unsigned char simd ) {
+    }
 
 
   public:
@@ -359,6 +380,15 @@ TYPED_TEST_P(BitReverseArrayBenchmark, reverse_short_array)
 #ifdef __AVX2__
    this->template array_test<::bliss::utils::bit_ops::BIT_REV_AVX2>("avx2");
 #endif
+
+   // dispatched kernels, up to the one selected for this CPU.
+   unsigned char level = ::bliss::utils::bit_ops::cpu_simd_level();
+   this->template dispatch_test<false>("dispatch_swar", ::bliss::utils::bit_ops::BIT_REV_SWAR);
+   if (level >= ::bliss::utils::bit_ops::BIT_REV_SSSE3)
+     this->template dispatch_test<false>("dispatch_ssse3", ::bliss::utils::bit_ops::BIT_REV_SSSE3);
+   if (level >= ::bliss::utils::bit_ops::BIT_REV_AVX2)
+     this->template dispatch_test<false>("dispatch_avx2", ::bliss::utils::bit_ops::BIT_REV_AVX2);
+   this->template dispatch_test<true>("dispatch_revcomp", level);
 }
 
 
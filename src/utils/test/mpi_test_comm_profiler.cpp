@@ -0,0 +1,175 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/**
+ * mpi_test_comm_profiler.cpp
+ *
+ * the comm profiler's send counts, labels and skew summary for known exchange patterns.
+ */
+
+// include google test
+#include <gtest/gtest.h>
+#include "bliss-config.hpp"
+
+#if defined(USE_MPI)
+#include "mxx/env.hpp"
+#include "mxx/comm.hpp"
+
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <cstdio>   // remove
+#include <unistd.h> // getpid
+
+#include "io/incremental_mxx.hpp"
+#include "utils/comm_profiler.hpp"
+
+
+class CommProfilerTest : public ::testing::Test {
+  protected:
+    ::mxx::comm comm;
+    std::string prefix;
+
+    virtual void SetUp() {
+      std::stringstream ss;
+      ss << "/tmp/bliss_comm_profile_" << getpid();   // only rank 0 writes.
+      prefix = ss.str();
+
+      ::plog::CommProfiler & prof = ::plog::CommProfiler::instance();
+      prof.clear();
+      prof.enable(prefix);
+    }
+
+    virtual void TearDown() {
+      ::plog::CommProfiler & prof = ::plog::CommProfiler::instance();
+      prof.disable();
+      prof.clear();
+      comm.barrier();
+      if (comm.rank() == 0) {
+        std::remove((prefix + ".exchanges.jsonl").c_str());
+        std::remove((prefix + ".summary.csv").c_str());
+      }
+    }
+};
+
+
+TEST_F(CommProfilerTest, distribute)
+{
+  int p = comm.size();
+
+  // rank r sends (d + 1) * (r + 1) elements to rank d.
+  std::vector<uint32_t> input;
+  for (int d = 0; d < p; ++d) input.insert(input.end(), (d + 1) * (comm.rank() + 1), d);
+  std::vector<size_t> recv_counts;
+  std::vector<size_t> i2o;
+  std::vector<uint32_t> output;
+
+  {
+    ::plog::CommProfiler::scope s("find");
+    ::imxx::distribute(input, [](uint32_t const & x) { return x; }, recv_counts, i2o, output, comm);
+  }
+  ::imxx::distribute(input, [](uint32_t const & x) { return x; }, recv_counts, i2o, output, comm);
+
+  ::plog::CommProfiler & prof = ::plog::CommProfiler::instance();
+  ASSERT_EQ(2UL, prof.size());
+  auto e = prof.get(0);
+  EXPECT_EQ("find", e.op);
+  EXPECT_EQ(sizeof(uint32_t), e.elem_bytes);
+  ASSERT_EQ(static_cast<size_t>(p), e.send.size());
+  for (int d = 0; d < p; ++d) {
+    EXPECT_EQ(static_cast<size_t>((d + 1) * (comm.rank() + 1)), e.send[d]);
+    EXPECT_EQ(static_cast<size_t>((comm.rank() + 1) * (d + 1)), e.recv[d]);
+  }
+  EXPECT_EQ("other", prof.get(1).op);
+}
+
+TEST_F(CommProfilerTest, summary)
+{
+  int p = comm.size();
+  ::plog::CommProfiler & prof = ::plog::CommProfiler::instance();
+
+  // rank r sends r + 1 elements of 8 bytes to every rank, and each rank receives p(p+1)/2.
+  std::vector<size_t> send(p, comm.rank() + 1);
+  std::vector<size_t> recv(p);
+  for (int s = 0; s < p; ++s) recv[s] = s + 1;
+  auto t = ::plog::CommProfiler::clock::now();
+  {
+    ::plog::CommProfiler::scope s("insert");
+    prof.record(send, recv, 8, t, t, t, t);
+    prof.record(send, recv, 8, t, t, t, t);
+  }
+
+  std::vector<::plog::CommProfiler::op_summary> result = prof.summarize(comm);
+  ASSERT_EQ(1UL, result.size());
+  if (comm.rank() == 0) {
+    auto const & s = result[0];
+    EXPECT_EQ("insert", s.op);
+    EXPECT_EQ(2UL, s.calls);
+    EXPECT_DOUBLE_EQ(2.0 * 8 * p * p, s.sent_bytes_max);
+    EXPECT_DOUBLE_EQ(8.0 * p * (p + 1), s.sent_bytes_mean);
+    EXPECT_DOUBLE_EQ(2.0 * p / (p + 1), s.sent_skew());
+    EXPECT_DOUBLE_EQ(1.0, s.recv_skew());
+    EXPECT_DOUBLE_EQ(1.0, s.worst_call_skew);
+    EXPECT_DOUBLE_EQ(2.0 * p * p, s.messages);
+    EXPECT_DOUBLE_EQ(8.0, s.msg_bytes_min);
+    EXPECT_DOUBLE_EQ(8.0 * p, s.msg_bytes_max);
+
+    // one line per exchange, with the full send matrix.
+    std::ifstream f(prefix + ".exchanges.jsonl");
+    std::string line;
+    size_t lines = 0;
+    while (std::getline(f, line)) {
+      EXPECT_NE(std::string::npos, line.find("\"op\":\"insert\""));
+      EXPECT_NE(std::string::npos, line.find("\"send\":[[1"));
+      ++lines;
+    }
+    EXPECT_EQ(2UL, lines);
+  }
+}
+
+TEST_F(CommProfilerTest, disabled)
+{
+  ::plog::CommProfiler & prof = ::plog::CommProfiler::instance();
+  prof.disable();
+
+  std::vector<size_t> counts(comm.size(), 1);
+  auto t = ::plog::CommProfiler::clock::now();
+  prof.record(counts, counts, 8, t, t, t, t);
+  EXPECT_EQ(0UL, prof.size());
+}
+
+#endif
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+#if defined(USE_MPI)
+  ::mxx::env e(argc, argv);
+  ::mxx::comm comm;
+
+  result = RUN_ALL_TESTS();
+
+  comm.barrier();
+#endif
+
+  return result;
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// include google test
+#include <gtest/gtest.h>
+#include "utils/timer.hpp"
+#include "utils/bench_recorder.hpp"
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <cstdio>   // remove
+#include <unistd.h> // getpid
+
+
+class BenchRecorderTest : public ::testing::Test {
+  protected:
+    std::string json, csv, trace;
+
+    virtual void SetUp() {
+      std::stringstream ss;
+      ss << "/tmp/bliss_bench_recorder_" << getpid();
+      json = ss.str() + ".jsonl";
+      csv = ss.str() + ".csv";
+      trace = ss.str() + ".trace";
+
+      ::plog::BenchRecorder & r = ::plog::BenchRecorder::instance();
+      r.clear();
+      r.set_json_output(json);
+      r.set_csv_output(csv);
+      r.set_trace_output(trace);
+    }
+
+    virtual void TearDown() {
+      ::plog::BenchRecorder & r = ::plog::BenchRecorder::instance();
+      r.set_json_output("");
+      r.set_csv_output("");
+      r.set_trace_output("");
+      r.clear();
+      std::remove(json.c_str());
+      std::remove(csv.c_str());
+      std::remove((trace + ".0.json").c_str());
+    }
+
+    static std::vector<std::string> lines(std::string const & file) {
+      std::vector<std::string> out;
+      std::ifstream f(file);
+      std::string line;
+      while (std::getline(f, line)) out.push_back(line);
+      return out;
+    }
+};
+
+
+TEST_F(BenchRecorderTest, nested_scopes)
+{
+  {
+    ::plog::Timer outer("outer");
+    outer.start();
+    {
+      ::plog::Timer inner("inner");
+      inner.start();
+      inner.end("work", 10);
+      inner.start();
+      inner.end("more_work", 20);
+      inner.report("inner");
+    }
+    outer.end("phase", 30);
+    outer.report("outer");
+  }
+  EXPECT_EQ(0, ::plog::BenchRecorder::instance().depth());
+  EXPECT_EQ(3UL, ::plog::BenchRecorder::instance().size());
+
+  auto j = lines(json);
+  ASSERT_EQ(2UL, j.size());
+  EXPECT_NE(std::string::npos, j[0].find("\"path\":\"outer/inner\""));
+  EXPECT_NE(std::string::npos, j[0].find("\"name\":\"work\""));
+  EXPECT_NE(std::string::npos, j[0].find("\"name\":\"more_work\""));
+  EXPECT_NE(std::string::npos, j[0].find("\"depth\":2"));
+  EXPECT_NE(std::string::npos, j[1].find("\"path\":\"outer\""));
+  EXPECT_NE(std::string::npos, j[1].find("\"count\":{\"min\":30,\"max\":30"));
+
+  auto c = lines(csv);
+  ASSERT_EQ(4UL, c.size());   // header, 2 inner phases, 1 outer phase
+  EXPECT_EQ(0UL, c[0].find("title,path,phase,index"));
+  EXPECT_EQ(0UL, c[1].find("inner,outer/inner,work,0,2,1,"));
+  EXPECT_EQ(0UL, c[3].find("outer,outer,phase,0,1,1,"));
+}
+
+TEST_F(BenchRecorderTest, csv_header_once)
+{
+  for (int i = 0; i < 2; ++i) {
+    ::plog::Timer t("loop");
+    t.loop_start(0);
+    t.loop_pause(0);
+    t.loop_resume(0);
+    t.loop_pause(0);
+    t.loop_end(0, "iter", i);
+    t.report("loop");
+  }
+
+  auto c = lines(csv);
+  ASSERT_EQ(3UL, c.size());
+  EXPECT_EQ(0UL, c[0].find("title,"));
+  EXPECT_EQ(0UL, c[1].find("loop,loop,iter,0,1,1,"));
+  EXPECT_EQ(0UL, c[2].find("loop,loop,iter,0,1,1,"));
+}
+
+TEST_F(BenchRecorderTest, trace)
+{
+  {
+    ::plog::Timer t("traced");
+    t.start();
+    t.end("a \"quoted\" phase", 5);
+  }
+  ::plog::BenchRecorder::instance().write_trace();
+
+  auto t = lines(trace + ".0.json");
+  ASSERT_LT(1UL, t.size());
+  EXPECT_EQ(0UL, t[0].find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+  EXPECT_NE(std::string::npos, t[1].find("\"name\":\"a \\\"quoted\\\" phase\""));
+  EXPECT_NE(std::string::npos, t[1].find("\"cat\":\"traced\""));
+  EXPECT_NE(std::string::npos, t[1].find("\"ph\":\"X\""));
+  EXPECT_NE(std::string::npos, t[1].find("\"count\":5.000"));
+}
+
+TEST_F(BenchRecorderTest, disabled)
+{
+  ::plog::BenchRecorder & r = ::plog::BenchRecorder::instance();
+  r.set_json_output("");
+  r.set_csv_output("");
+  r.set_trace_output("");
+
+  ::plog::Timer t("off");
+  t.start();
+  t.end("phase", 1);
+  t.report("off");
+  EXPECT_EQ(0UL, r.size());
+  EXPECT_EQ(1, r.depth());
+}
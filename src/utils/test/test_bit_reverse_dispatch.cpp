@@ -0,0 +1,121 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// include google test
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// include files to test
+#include "utils/bitgroup_dispatch.hpp"
+
+#include "utils/test/bit_test_common.hpp"
+
+
+// every run time kernel the CPU supports should match the compile time SWAR reverse, at all lengths, including the
+// overlapping last block.
+template <typename P>
+class BitReverseDispatchTest : public ::testing::Test {
+  protected:
+    static constexpr unsigned int bits = P::bitsPerGroup;
+    static constexpr size_t unit = (bits < 8) ? 1 : (bits >> 3);
+
+    std::vector<uint8_t> input;
+
+    virtual void SetUp() {
+      input.resize(256 + 8);
+      for (size_t i = 0; i < input.size(); ++i) input[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+
+    void check(unsigned char simd, bool complement) {
+      ::bliss::utils::bit_ops::dispatch::reverse_kernel k = complement ?
+          ::bliss::utils::bit_ops::dispatch::kernel_for<bits, true>(simd) :
+          ::bliss::utils::bit_ops::dispatch::kernel_for<bits, false>(simd);
+
+      std::vector<uint8_t> gold(256 + 8), out(256 + 8);
+      for (size_t len = unit; len <= 256; len += unit) {
+        // the compile time SWAR reverse reads up to 8 bytes from in.  input has the slack.
+        ::bliss::utils::bit_ops::reverse<bits, ::bliss::utils::bit_ops::BIT_REV_SWAR>(gold.data(), input.data(), len);
+        if (complement) for (size_t i = 0; i < len; ++i) gold[i] = ~gold[i];
+
+        std::fill(out.begin(), out.end(), 0xA5);
+        k(out.data(), input.data(), len);
+
+        ASSERT_EQ(0, memcmp(gold.data(), out.data(), len)) << "simd " << static_cast<int>(simd) << " len " << len;
+        ASSERT_EQ(0xA5, out[len]) << "simd " << static_cast<int>(simd) << " len " << len << " wrote past the end";
+      }
+    }
+};
+
+template <typename P>
+constexpr unsigned int BitReverseDispatchTest<P>::bits;
+template <typename P>
+constexpr size_t BitReverseDispatchTest<P>::unit;
+
+// indicate this is a typed test
+TYPED_TEST_CASE_P(BitReverseDispatchTest);
+
+TYPED_TEST_P(BitReverseDispatchTest, reverse)
+{
+  unsigned char level = ::bliss::utils::bit_ops::cpu_simd_level();
+  for (unsigned char simd : { ::bliss::utils::bit_ops::BIT_REV_SWAR, ::bliss::utils::bit_ops::BIT_REV_SSSE3,
+                              ::bliss::utils::bit_ops::BIT_REV_AVX2 }) {
+    if (simd > level) break;
+    this->check(simd, false);
+  }
+}
+
+TYPED_TEST_P(BitReverseDispatchTest, reverse_complement)
+{
+  unsigned char level = ::bliss::utils::bit_ops::cpu_simd_level();
+  for (unsigned char simd : { ::bliss::utils::bit_ops::BIT_REV_SWAR, ::bliss::utils::bit_ops::BIT_REV_SSSE3,
+                              ::bliss::utils::bit_ops::BIT_REV_AVX2 }) {
+    if (simd > level) break;
+    this->check(simd, true);
+  }
+}
+
+TYPED_TEST_P(BitReverseDispatchTest, word_array)
+{
+  // the word array entry points use the selected kernel, and match the compile time reverse on uint64_t words.
+  uint64_t in[10], gold[10], out[10];
+  memcpy(in, this->input.data(), sizeof(in));
+
+  ::bliss::utils::bit_ops::reverse<TestFixture::bits, ::bliss::utils::bit_ops::BIT_REV_SWAR>(gold, in, 10);
+  ::bliss::utils::bit_ops::reverse_dispatch<TestFixture::bits>(out, in, 10);
+  EXPECT_EQ(0, memcmp(gold, out, sizeof(out)));
+
+  ::bliss::utils::bit_ops::reverse_complement_dispatch<TestFixture::bits>(out, in, 10);
+  for (int i = 0; i < 10; ++i) EXPECT_EQ(~gold[i], out[i]);
+}
+
+// now register the test cases
+REGISTER_TYPED_TEST_CASE_P(BitReverseDispatchTest, reverse, reverse_complement, word_array);
+
+
+//////////////////// RUN the tests with different types.
+typedef ::testing::Types<
+    ::bliss::utils::bit_ops::test::BitsParam< 1>,
+    ::bliss::utils::bit_ops::test::BitsParam< 2>,
+    ::bliss::utils::bit_ops::test::BitsParam< 4>,
+    ::bliss::utils::bit_ops::test::BitsParam< 8>,
+    ::bliss::utils::bit_ops::test::BitsParam<16>,
+    ::bliss::utils::bit_ops::test::BitsParam<32>
+> BitReverseDispatchTestTypes;
+INSTANTIATE_TYPED_TEST_CASE_P(Bliss, BitReverseDispatchTest, BitReverseDispatchTestTypes);
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// include google test
+#include <gtest/gtest.h>
+#include "utils/kmer_generator.hpp"
+
+#include "common/alphabets.hpp"
+#include "common/kmer.hpp"
+
+#include <vector>
+#include <string>
+#include <algorithm>
+
+
+using Kmer = ::bliss::common::Kmer<21, ::bliss::common::DNA, uint64_t>;
+
+TEST(KmerGenerator, zipf)
+{
+  std::vector<Kmer> kmers;
+  ::bliss::utils::zipf_kmers(kmers, 100000, 1000, 1.0, 7);
+  ASSERT_EQ(100000UL, kmers.size());
+
+  // the most frequent kmer takes about 1 / H(1000) = 13% of the stream.
+  std::sort(kmers.begin(), kmers.end());
+  size_t top = 0;
+  for (size_t i = 0; i < kmers.size(); ) {
+    size_t j = i + 1;
+    while ((j < kmers.size()) && (kmers[j] == kmers[i])) ++j;
+    top = std::max(top, j - i);
+    i = j;
+  }
+  EXPECT_GT(top, 10000UL);
+  EXPECT_LT(top, 17000UL);
+
+  EXPECT_LE(::bliss::utils::count_distinct(kmers).first, 1000UL);
+
+  // deterministic
+  std::vector<Kmer> again;
+  ::bliss::utils::zipf_kmers(again, 100000, 1000, 1.0, 7);
+  std::sort(again.begin(), again.end());
+  EXPECT_TRUE(std::equal(kmers.begin(), kmers.end(), again.begin()));
+}
+
+TEST(KmerGenerator, spectrum)
+{
+  std::vector<Kmer> kmers;
+  ::bliss::utils::spectrum_kmers(kmers, 200000, 0.8, 20.0, 7);
+  ASSERT_EQ(200000UL, kmers.size());
+
+  auto counts = ::bliss::utils::count_distinct(kmers);
+  double singletons = static_cast<double>(counts.second) / static_cast<double>(counts.first);
+  EXPECT_NEAR(0.8, singletons, 0.02);
+}
+
+TEST(KmerGenerator, reads)
+{
+  // without errors, every kmer of the reads is in the genome:  at most 2 (genome - k + 1) distinct kmers with both strands.
+  std::vector<Kmer> kmers;
+  ::bliss::utils::read_kmers(kmers, 50000, 1000, 100, 0.0, 7);
+  ASSERT_EQ(50000UL, kmers.size());
+  EXPECT_LE(::bliss::utils::count_distinct(kmers).first, 2UL * (1000 - Kmer::size + 1));
+
+  // the strands collapse under canonicalization.
+  for (auto & km : kmers) km = std::min(km, km.reverse_complement());
+  EXPECT_LE(::bliss::utils::count_distinct(kmers).first, 1000UL - Kmer::size + 1);
+
+  // errors add mostly singleton kmers.
+  std::vector<Kmer> noisy;
+  ::bliss::utils::read_kmers(noisy, 50000, 1000, 100, 0.01, 7);
+  EXPECT_GT(::bliss::utils::count_distinct(noisy).second, 1000UL);
+}
+
+TEST(KmerGenerator, shared_keys)
+{
+  // as for different processes:  same key set and genome, different samples.
+  std::vector<Kmer> a, b;
+  ::bliss::utils::zipf_kmers(a, 20000, 100, 1.0, 7, 8);
+  ::bliss::utils::zipf_kmers(b, 20000, 100, 1.0, 7, 9);
+  EXPECT_FALSE(a == b);
+  std::vector<Kmer> both(a);
+  both.insert(both.end(), b.begin(), b.end());
+  EXPECT_LE(::bliss::utils::count_distinct(both).first, 100UL);
+
+  ::bliss::utils::read_kmers(a, 20000, 1000, 100, 0.0, 7, 8);
+  ::bliss::utils::read_kmers(b, 20000, 1000, 100, 0.0, 7, 9);
+  EXPECT_FALSE(a == b);
+  both = a;
+  both.insert(both.end(), b.begin(), b.end());
+  EXPECT_LE(::bliss::utils::count_distinct(both).first, 2UL * (1000 - Kmer::size + 1));
+}
+
+TEST(KmerGenerator, flip_strands)
+{
+  std::vector<Kmer> kmers;
+  ::bliss::utils::uniform_kmers(kmers, 10000, 7);
+  std::vector<Kmer> flipped(kmers);
+  ::bliss::utils::flip_strands(flipped, 0.5, 7);
+
+  size_t changed = 0;
+  for (size_t i = 0; i < kmers.size(); ++i) {
+    if (!(kmers[i] == flipped[i])) {
+      ++changed;
+      EXPECT_TRUE(kmers[i] == flipped[i].reverse_complement());
+    }
+  }
+  EXPECT_NEAR(5000.0, static_cast<double>(changed), 300.0);
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// include google test
+#include <gtest/gtest.h>
+#include "utils/net_delay.hpp"
+
+#include <vector>
+#include <stdexcept>
+
+
+class NetDelayTest : public ::testing::Test {
+  protected:
+    virtual void TearDown() {
+      ::plog::NetDelay::instance().disable();
+    }
+};
+
+TEST_F(NetDelayTest, cost)
+{
+  ::plog::NetDelay & delay = ::plog::NetDelay::instance();
+
+  // 10 us per message, 1 MB/s, 2 ranks per node.  rank 1 shares a node with rank 0.
+  delay.enable("10:1:2");
+  EXPECT_TRUE(delay.enabled());
+
+  std::vector<size_t> send = {5, 5, 100, 0};
+  std::vector<size_t> recv = {1, 1, 10, 10};
+
+  // 2 remote peers, 1 remote message, 100 remote elements of 8 bytes sent.
+  EXPECT_NEAR(3.0e-5 + 800.0e-6, delay.cost(send, recv, 8, 1), 1.0e-12);
+
+  // on one node there is nothing to delay.
+  delay.enable(10.0, 1.0, 4);
+  EXPECT_DOUBLE_EQ(0.0, delay.cost(send, recv, 8, 1));
+
+  // unlimited bandwidth:  latency only.
+  delay.enable(10.0, 0.0, 1);
+  EXPECT_NEAR(3.0e-5 + 3.0e-5, delay.cost(send, recv, 8, 3), 1.0e-12);   // 3 remote peers, 3 remote messages.
+}
+
+TEST_F(NetDelayTest, spec)
+{
+  ::plog::NetDelay & delay = ::plog::NetDelay::instance();
+  EXPECT_THROW(delay.enable("10"), std::invalid_argument);
+  EXPECT_THROW(delay.enable("10:1:0"), std::invalid_argument);
+  EXPECT_THROW(delay.enable("-1:1"), std::invalid_argument);
+  EXPECT_THROW(delay.enable("ten:1"), std::invalid_argument);
+}
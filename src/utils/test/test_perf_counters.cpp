@@ -0,0 +1,88 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// include google test
+#include <gtest/gtest.h>
+#include "utils/perf_counters.hpp"
+
+#include <vector>
+#include <numeric>  // iota
+
+
+// counters may be unavailable (VMs, perf_event_paranoid), in which case only the bookkeeping is checked.
+
+static volatile size_t sink;
+
+static void work(size_t const & n) {
+  std::vector<size_t> v(n);
+  std::iota(v.begin(), v.end(), 0);
+  size_t s = 0;
+  for (size_t i = 0; i < n; ++i) s += (v[i] & 1) ? v[i] : (v[i] >> 1);
+  sink = s;
+}
+
+TEST(PerfCounters, phases)
+{
+  ::plog::PerfCounters perf;
+  perf.start();
+  work(1000);
+  perf.end("small");
+  perf.start();
+  work(1000000);
+  perf.end("large");
+
+  ASSERT_EQ(2UL, perf.size());
+  for (int i = 0; i < ::plog::PerfEvents::N; ++i) {
+    ASSERT_EQ(2UL, perf.get(i).size());
+    if (!::plog::PerfEvents::instance().available(i)) {
+      EXPECT_EQ(0.0, perf.get(i)[0]);
+      EXPECT_EQ(0.0, perf.get(i)[1]);
+    }
+  }
+
+  if (::plog::PerfEvents::instance().available(::plog::PerfEvents::INSTRUCTIONS)) {
+    auto const & ins = perf.get(::plog::PerfEvents::INSTRUCTIONS);
+    EXPECT_LT(1000.0, ins[0]);
+    EXPECT_LT(ins[0], ins[1]);
+  }
+  perf.report("phases");
+}
+
+TEST(PerfCounters, loop)
+{
+  ::plog::PerfCounters perf;
+  perf.loop_start(3);
+  for (int i = 0; i < 4; ++i) {
+    perf.loop_resume(3);
+    work(10000);
+    perf.loop_pause(3);
+    work(100000);    // not counted
+  }
+  perf.loop_end(3, "loop");
+
+  perf.start();
+  for (int i = 0; i < 4; ++i) work(10000);
+  perf.end("straight");
+
+  ASSERT_EQ(2UL, perf.size());
+  if (::plog::PerfEvents::instance().available(::plog::PerfEvents::INSTRUCTIONS)) {
+    auto const & ins = perf.get(::plog::PerfEvents::INSTRUCTIONS);
+    // same work in both phases, and the paused work is excluded.
+    EXPECT_LT(ins[0], 2.0 * ins[1]);
+    EXPECT_LT(ins[1], 2.0 * ins[0]);
+  }
+}
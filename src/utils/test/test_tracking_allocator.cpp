@@ -0,0 +1,92 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// include google test
+#include <gtest/gtest.h>
+#include "utils/tracking_allocator.hpp"
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <algorithm>
+
+
+struct test_tag { static const char * name() { return "test"; } };
+struct node_tag { static const char * name() { return "nodes"; } };
+
+static int64_t live_of(std::string const & name) {
+  ::plog::AllocTracker & t = ::plog::AllocTracker::instance();
+  std::vector<std::string> cats = t.categories();
+  size_t c = std::distance(cats.begin(), std::find(cats.begin(), cats.end(), name));
+  return (c < cats.size()) ? t.live()[c] : -1;
+}
+
+static int64_t peak_of(::plog::AllocTracker::window const & w, std::string const & name) {
+  std::vector<std::string> cats = ::plog::AllocTracker::instance().categories();
+  size_t c = std::distance(cats.begin(), std::find(cats.begin(), cats.end(), name));
+  std::vector<int64_t> peaks = w.peak();
+  return (c < peaks.size()) ? peaks[c] : -1;
+}
+
+TEST(TrackingAllocator, live_and_peak)
+{
+  ::plog::AllocTracker::window w;
+  {
+    std::vector<uint64_t, ::plog::tracking_allocator<uint64_t, test_tag> > v;
+    v.reserve(1000);
+    EXPECT_EQ(8000, live_of("test"));
+
+    {
+      std::vector<uint64_t, ::plog::tracking_allocator<uint64_t, test_tag> > tmp(500);
+      EXPECT_EQ(12000, live_of("test"));
+    }
+    EXPECT_EQ(8000, live_of("test"));
+    EXPECT_EQ(12000, peak_of(w, "test"));
+
+    // peak restarts from the live bytes.
+    w.reset();
+    EXPECT_EQ(8000, peak_of(w, "test"));
+  }
+  EXPECT_EQ(0, live_of("test"));
+  EXPECT_EQ(8000, peak_of(w, "test"));
+}
+
+TEST(TrackingAllocator, rebind)
+{
+  // nodes and buckets of a node based container are charged to its tag.
+  using Alloc = ::plog::tracking_allocator<std::pair<const int, int>, node_tag>;
+  {
+    std::unordered_map<int, int, std::hash<int>, std::equal_to<int>, Alloc> m;
+    for (int i = 0; i < 1000; ++i) m[i] = i;
+    EXPECT_GE(live_of("nodes"), static_cast<int64_t>(1000 * sizeof(std::pair<const int, int>)));
+  }
+  EXPECT_EQ(0, live_of("nodes"));
+}
+
+TEST(TrackingAllocator, windows)
+{
+  ::plog::AllocTracker::window outer;
+  std::vector<char, ::plog::tracking_allocator<char, test_tag> > a(100);
+  {
+    // nested windows see the same allocations.
+    ::plog::AllocTracker::window inner;
+    std::vector<char, ::plog::tracking_allocator<char, test_tag> > b(300);
+    EXPECT_EQ(400, peak_of(inner, "test"));
+  }
+  EXPECT_EQ(400, peak_of(outer, "test"));
+  EXPECT_EQ(100, live_of("test"));
+}
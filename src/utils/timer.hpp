@@ -36,10 +36,13 @@
 #include <string>
 #include <algorithm>  // std::min
 #include <sstream>
+#include <iterator>  // ostream_iterator
 #include <cmath>
 
 #include <mxx/reduction.hpp>
 
+#include "utils/bench_recorder.hpp"
+
 
 namespace plog {
 
@@ -55,16 +58,39 @@ class Timer {
     std::unordered_map<size_t, std::chrono::steady_clock::time_point> loop_t1;
     std::unordered_map<size_t, std::chrono::duration<double> > loop_span;
 
+    /// scope path and depth in the BenchRecorder, and the recorder events of the phases.  empty path if not scoped.
+    std::string path;
+    int depth;
+    std::vector<size_t> event_ids;
+
+    void record(::std::string const & name, std::chrono::steady_clock::time_point const & start,
+                std::chrono::steady_clock::time_point const & stop, double const & n_elem) {
+      size_t id = BenchRecorder::instance().record(path, depth, name, start, stop, n_elem);
+      if (id != BenchRecorder::npos) event_ids.push_back(id);
+    }
+
   public:
-    Timer() {
+    Timer() : depth(0) {
     	reset();
     }
 
+    /// timer of a named benchmark scope.  nested scopes are tracked by the BenchRecorder for structured output.
+    explicit Timer(::std::string const & title) {
+      path = BenchRecorder::instance().push_scope(title);
+      depth = BenchRecorder::instance().depth();
+      reset();
+    }
+
+    ~Timer() {
+      if (!path.empty()) BenchRecorder::instance().pop_scope();
+    }
+
     void reset() {
       names.clear();
       durations.clear();
       cumulative.clear();
       counts.clear();
+      event_ids.clear();
 
       first = std::chrono::steady_clock::now();
       loop_t1.clear();
@@ -90,6 +116,8 @@ class Timer {
         std::chrono::steady_clock::time_point lt2 = std::chrono::steady_clock::now();
     	cumulative.push_back((std::chrono::duration_cast<std::chrono::duration<double> >(lt2 - first)).count());
     	counts.push_back(n_elem);
+    	// the loop's accumulated time, shown as ending now.
+    	record(name, lt2 - std::chrono::duration_cast<std::chrono::steady_clock::duration>(loop_span[id]), lt2, n_elem);
 
     	loop_span.erase(id);
     	loop_t1.erase(id);
@@ -110,6 +138,7 @@ class Timer {
       durations.push_back(time_span.count());
       cumulative.push_back((std::chrono::duration_cast<std::chrono::duration<double> >(t2 - first)).count());
       counts.push_back(0);
+      record(tmp, t1, t2, 0);
 
       t1 = std::chrono::steady_clock::now();
     }
@@ -121,6 +150,7 @@ class Timer {
       durations.push_back(time_span.count());
       cumulative.push_back((std::chrono::duration_cast<std::chrono::duration<double> >(t2 - first)).count());
       counts.push_back(n_elem);
+      record(name, t1, t2, n_elem);
     }
     void collective_end(::std::string const & name, double const & n_elem, ::mxx::comm const & comm) {
 
@@ -159,6 +189,8 @@ class Timer {
         fflush(stdout);
         printf("%s\n", output.str().c_str());
         fflush(stdout);
+
+        BenchRecorder::instance().summarize(title, path.empty() ? title : path, event_ids);
     }
 
 #if 0
@@ -386,6 +418,9 @@ class Timer {
           printf("%s\n", output.str().c_str());
           fflush(stdout);
         }
+
+        BenchRecorder::instance().summarize(title, path.empty() ? title : path, event_ids, comm);
+
         comm.barrier();
     }
 
@@ -395,7 +430,7 @@ class Timer {
 
 #if BL_BENCHMARK_TIME == 1
 
-#define BL_TIMER_INIT(title)      ::plog::Timer title##_timer;
+#define BL_TIMER_INIT(title)      ::plog::Timer title##_timer(#title);
 #define BL_TIMER_RESET(title)     do { title##_timer.reset(); } while (0)
 
 #define BL_TIMER_LOOP_START(title, id)     do { title##_timer.loop_start(id); } while (0)
@@ -0,0 +1,252 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    tracking_allocator.hpp
+ * @ingroup
+ * @author  agent <agent@local>
+ * @brief   allocator that attributes live and peak bytes to named categories, e.g. the table, the exchange buffers, the results.
+ * @details RSS deltas (MemUsage) cannot tell which container a peak comes from.  tracking_allocator<T, Tag> counts the bytes
+ *          it hands out under the category Tag::name(), in the process wide AllocTracker.  it is a stateless std::allocator
+ *          replacement, so it can be the Alloc parameter of the fsc/dsc containers or of any std::vector, e.g.
+ *
+ *            dsc::counting_densehash_map<Kmer, uint32_t, Params, SpecialKeys, plog::tracking_allocator<std::pair<const Kmer, uint32_t>, plog::alloc_tag::table> >
+ *            std::vector<Kmer, plog::tracking_allocator<Kmer, plog::alloc_tag::buffer> >
+ *
+ *          rebinding keeps the tag, so the nodes and buckets of a container are all charged to the container's category.
+ *
+ *          bytes that are not allocated through a tracking_allocator, e.g. the std::vector temporaries of imxx and dsc,
+ *          can be charged to a category explicitly:  AllocTracker::charge holds bytes for as long as it lives (e.g. the
+ *          buffers an imxx::exchange_arena retains), and AllocTracker::transient counts bytes towards the peaks only
+ *          (e.g. query results handed to the caller).
+ *
+ *          AllocTracker::window records the peak of each category since its last reset.  MemUsage keeps one, so each
+ *          BL_BENCH phase reports, next to the RSS columns, the live bytes of each category at the end of the phase and
+ *          the peak during the phase.  categories are numbered in order of first use, which can differ between processes,
+ *          so the MPI reports match them by name.
+ *
+ *          each allocation takes a mutex.  use for diagnosis, not in production builds.
+ */
+#ifndef SRC_UTILS_TRACKING_ALLOCATOR_HPP_
+#define SRC_UTILS_TRACKING_ALLOCATOR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>     // std::allocator
+#include <mutex>
+#include <vector>
+#include <string>
+#include <algorithm>  // max, find
+#include <utility>    // move
+
+namespace plog {
+
+  class AllocTracker {
+    public:
+      /// peak bytes per category since the last reset.  registered with the tracker while it exists.
+      class window {
+          friend class AllocTracker;
+          std::vector<int64_t> peaks;
+
+        public:
+          window() {
+            AllocTracker & t = AllocTracker::instance();
+            std::lock_guard<std::mutex> lock(t.mutex);
+            peaks = t.curr;
+            t.windows.push_back(this);
+          }
+          window(window const & other) : window() {
+            std::lock_guard<std::mutex> lock(AllocTracker::instance().mutex);
+            peaks = other.peaks;
+          }
+          window & operator=(window const & other) {
+            std::lock_guard<std::mutex> lock(AllocTracker::instance().mutex);
+            peaks = other.peaks;
+            return *this;
+          }
+          ~window() {
+            AllocTracker & t = AllocTracker::instance();
+            std::lock_guard<std::mutex> lock(t.mutex);
+            t.windows.erase(std::find(t.windows.begin(), t.windows.end(), this));
+          }
+
+          /// restart the peaks from the current live bytes.
+          void reset() {
+            AllocTracker & t = AllocTracker::instance();
+            std::lock_guard<std::mutex> lock(t.mutex);
+            peaks = t.curr;
+          }
+
+          /// peak bytes per category since the last reset.
+          std::vector<int64_t> peak() const {
+            AllocTracker & t = AllocTracker::instance();
+            std::lock_guard<std::mutex> lock(t.mutex);
+            std::vector<int64_t> out(peaks);
+            out.resize(t.curr.size(), 0);
+            for (size_t c = 0; c < out.size(); ++c) out[c] = std::max(out[c], t.curr[c]);
+            return out;
+          }
+      };
+
+      /// bytes held outside of tracking_allocator, charged to a category while the charge lives.
+      class charge {
+          std::string name;
+          size_t cat;
+          int64_t bytes;
+
+        public:
+          explicit charge(std::string const & _name, size_t const & _bytes = 0) : name(_name), cat(0), bytes(0) {
+            set(_bytes);
+          }
+          charge(charge const &) = delete;
+          charge & operator=(charge const &) = delete;
+          charge(charge && other) : name(std::move(other.name)), cat(other.cat), bytes(other.bytes) {
+            other.bytes = 0;
+          }
+          charge & operator=(charge && other) {
+            set(0);
+            name = std::move(other.name);
+            cat = other.cat;
+            bytes = other.bytes;
+            other.bytes = 0;
+            return *this;
+          }
+          ~charge() { set(0); }
+
+          /// charge b bytes instead of the current amount.  the category is registered at the first non-zero charge.
+          void set(size_t const & b) {
+            int64_t nb = static_cast<int64_t>(b);
+            if (nb == bytes) return;
+            AllocTracker & t = AllocTracker::instance();
+            if (bytes == 0) cat = t.category(name);
+            if (nb > bytes) t.allocated(cat, nb - bytes);
+            else t.deallocated(cat, bytes - nb);
+            bytes = nb;
+          }
+      };
+
+    protected:
+      mutable std::mutex mutex;
+      std::vector<std::string> names;
+      std::vector<int64_t> curr;
+      std::vector<window *> windows;
+
+      AllocTracker() {}
+
+    public:
+      static AllocTracker & instance() {
+        static AllocTracker tracker;
+        return tracker;
+      }
+
+      /// id of a category, registered on first use.
+      size_t category(std::string const & name) {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t id = std::distance(names.begin(), std::find(names.begin(), names.end(), name));
+        if (id == names.size()) {
+          names.push_back(name);
+          curr.push_back(0);
+        }
+        return id;
+      }
+
+      void allocated(size_t const & cat, size_t const & bytes) {
+        std::lock_guard<std::mutex> lock(mutex);
+        curr[cat] += bytes;
+        for (window * w : windows) {
+          if (w->peaks.size() <= cat) w->peaks.resize(cat + 1, 0);
+          w->peaks[cat] = std::max(w->peaks[cat], curr[cat]);
+        }
+      }
+      void deallocated(size_t const & cat, size_t const & bytes) {
+        std::lock_guard<std::mutex> lock(mutex);
+        curr[cat] -= bytes;
+      }
+
+      /// bytes held briefly outside of tracking_allocator:  they count towards the peaks, not the live bytes.
+      void transient(std::string const & name, size_t const & bytes) {
+        if (bytes == 0) return;
+        size_t cat = category(name);
+        allocated(cat, bytes);
+        deallocated(cat, bytes);
+      }
+
+      /// category names, in id order.
+      std::vector<std::string> categories() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return names;
+      }
+      /// live bytes per category.
+      std::vector<int64_t> live() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return curr;
+      }
+  };
+
+
+  /// standard categories.  any type with a static name() works as a tag.
+  namespace alloc_tag {
+    struct table   { static const char * name() { return "table"; } };
+    struct buffer  { static const char * name() { return "buffer"; } };
+    struct results { static const char * name() { return "results"; } };
+    struct other   { static const char * name() { return "other"; } };
+  }
+
+
+  /// std::allocator that charges its bytes to the category Tag::name() in the AllocTracker.
+  template <typename T, typename Tag = alloc_tag::other>
+  class tracking_allocator : public std::allocator<T> {
+      using base = std::allocator<T>;
+
+      static size_t id() {
+        static size_t cat = AllocTracker::instance().category(Tag::name());
+        return cat;
+      }
+
+    public:
+      using value_type = T;
+      using pointer = T *;
+      using size_type = size_t;
+
+      template <typename U>
+      struct rebind {
+          using other = tracking_allocator<U, Tag>;
+      };
+
+      tracking_allocator() noexcept {}
+      tracking_allocator(tracking_allocator const &) noexcept : base() {}
+      template <typename U>
+      tracking_allocator(tracking_allocator<U, Tag> const &) noexcept {}
+
+      pointer allocate(size_type n, const void * = nullptr) {
+        pointer p = base::allocate(n);
+        AllocTracker::instance().allocated(id(), n * sizeof(T));
+        return p;
+      }
+      void deallocate(pointer p, size_type n) {
+        base::deallocate(p, n);
+        AllocTracker::instance().deallocated(id(), n * sizeof(T));
+      }
+  };
+
+  template <typename T, typename U, typename Tag>
+  bool operator==(tracking_allocator<T, Tag> const &, tracking_allocator<U, Tag> const &) { return true; }
+  template <typename T, typename U, typename Tag>
+  bool operator!=(tracking_allocator<T, Tag> const &, tracking_allocator<U, Tag> const &) { return false; }
+
+} // namespace plog
+
+#endif // SRC_UTILS_TRACKING_ALLOCATOR_HPP_
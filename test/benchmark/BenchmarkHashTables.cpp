@@ -2,6 +2,10 @@
 #include <vector>
 #include <random>
 #include <cstdint>
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>  // sysconf
 
 #if 0
 #include <tommyds/tommyalloc.h>
@@ -21,6 +25,7 @@
 #include "common/kmer.hpp"
 #include "common/kmer_transform.hpp"
 #include "index/kmer_hash.hpp"
+#include "index/kmer_index.hpp"   // KmerParser and KmerFileHelper, for replaying a FASTQ file
 
 
 #include "mxx/env.hpp"
@@ -28,6 +33,9 @@
 
 #include "utils/benchmark_utils.hpp"
 #include "utils/transform_utils.hpp"
+#include "utils/kmer_generator.hpp"
+
+#include "tclap/CmdLine.h"
 
 // comparison of some hash tables.  note that this is not exhaustive and includes only the well tested ones and my own.  not so much
 // the one-off ones people wrote.
@@ -63,8 +71,24 @@
 
 
 
+/// input workload, set from the command line.  see generate_input.
+struct workload_options {
+    std::string kind = "uniform";     // uniform, zipf, spectrum, reads, file
+    double zipf_s = 1.0;
+    double distinct_frac = 0.1;       // zipf:  distinct kmers as a fraction of count
+    double singleton_frac = 0.8;      // spectrum
+    double coverage = 30.0;           // spectrum
+    double genome_frac = 0.05;        // reads:  genome length as a fraction of count
+    size_t read_length = 100;         // reads
+    double error_rate = 0.01;         // reads
+    double rc_frac = 0.0;             // fraction of kmers replaced by their reverse complement
+    std::string filename;             // file:  FASTQ to replay
+    unsigned int seed = 23;
+} workload;
+
+/// uniformly random kmers, with a few short runs of repeats.
 template <typename Kmer, typename Value>
-void generate_input(std::vector<::std::pair<Kmer, Value> > & output, size_t const count, bool canonical = false) {
+void generate_uniform_input(std::vector<::std::pair<Kmer, Value> > & output, size_t const count) {
   output.resize(count);
 
   srand(23);
@@ -104,6 +128,54 @@ void generate_input(std::vector<::std::pair<Kmer, Value> > & output, size_t cons
       }
     }
   }
+}
+
+/// kmers from the FASTQ file, replayed cyclically if the file has fewer than count kmers.  each rank reads its own block.
+template <typename Kmer>
+void replay_kmers(std::vector<Kmer> & output, size_t const count, std::string const & filename) {
+  ::mxx::comm comm;
+  std::vector<Kmer> kmers;
+  ::bliss::io::KmerFileHelper::template read_file_posix<::bliss::index::kmer::KmerParser<Kmer>, ::bliss::io::FASTQParser,
+    ::bliss::io::SequencesIterator>(filename, kmers, comm);
+  if (kmers.size() == 0) throw std::invalid_argument("no kmers in " + filename);
+
+  output.resize(count);
+  for (size_t i = 0; i < count; ++i) output[i] = kmers[i % kmers.size()];
+}
+
+/// input for the configured workload, with value = position.  canonical replaces each kmer with its canonical form.
+template <typename Kmer, typename Value>
+void generate_input(std::vector<::std::pair<Kmer, Value> > & output, size_t const count, bool canonical = false) {
+  if (workload.kind == "uniform") {
+    generate_uniform_input(output, count);
+  } else {
+    std::vector<Kmer> kmers;
+    if (workload.kind == "zipf")
+      ::bliss::utils::zipf_kmers(kmers, count, std::max(static_cast<size_t>(workload.distinct_frac * count), 1UL),
+                                 workload.zipf_s, workload.seed);
+    else if (workload.kind == "spectrum")
+      ::bliss::utils::spectrum_kmers(kmers, count, workload.singleton_frac, workload.coverage, workload.seed);
+    else if (workload.kind == "reads")
+      ::bliss::utils::read_kmers(kmers, count, static_cast<size_t>(workload.genome_frac * count), workload.read_length,
+                                 workload.error_rate, workload.seed);
+    else if (workload.kind == "file")
+      replay_kmers(kmers, count, workload.filename);
+    else
+      throw std::invalid_argument("unknown workload " + workload.kind);
+
+    output.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+      output[i].first = kmers[i];
+      output[i].second = i;
+    }
+  }
+
+  if (workload.rc_frac > 0.0) {
+    std::vector<Kmer> kmers(output.size());
+    for (size_t i = 0; i < output.size(); ++i) kmers[i] = output[i].first;
+    ::bliss::utils::flip_strands(kmers, workload.rc_frac, workload.seed);
+    for (size_t i = 0; i < output.size(); ++i) output[i].first = kmers[i];
+  }
 
   if (canonical) {
 	  for (size_t i = 0; i < output.size(); ++i) {
@@ -1163,17 +1235,130 @@ void benchmark_tommytrie(size_t const count, size_t const query_frac, ::mxx::com
 //  BL_BENCH_REPORT_MPI_NAMED(map, "judyhs", comm);
 //}
 
+/**
+ * query cost as the table fills.  the map is reserved for the distinct kmers in the input, and the input is inserted
+ * in quarters.  after each quarter, find and count run on the same queries, and the step names carry the load factor reached.
+ */
+template <typename Map, typename Kmer, typename Value>
+void benchmark_load_factors(std::string const & name, size_t const count, size_t const query_frac, ::mxx::comm const & comm) {
+  BL_BENCH_INIT(map);
+
+  std::vector<::std::pair<Kmer, Value> > input(count);
+  generate_input(input, count);
+  std::vector<Kmer> query(count);
+  std::transform(input.begin(), input.end(), query.begin(),
+                 [](::std::pair<Kmer, Value> const & x){
+    return x.first;
+  });
+  size_t distinct = ::bliss::utils::count_distinct(query).first;
+  query.resize(count / query_frac);
+  std::transform(input.begin(), input.begin() + query.size(), query.begin(),
+                 [](::std::pair<Kmer, Value> const & x){
+    return x.first;
+  });
+
+  BL_BENCH_START(map);
+  Map map(distinct);
+  BL_BENCH_END(map, "reserve", distinct);
+
+  size_t const steps = 4;
+  for (size_t s = 0; s < steps; ++s) {
+    BL_BENCH_START(map);
+    map.insert(input.begin() + (s * count) / steps, input.begin() + ((s + 1) * count) / steps);
+    BL_BENCH_END(map, "insert", map.size());
+
+    std::stringstream ss;
+    ss.precision(2);
+    ss << std::fixed << "@lf" << (static_cast<double>(map.size()) / static_cast<double>(map.bucket_count()));
+
+    BL_BENCH_START(map);
+    size_t result = 0;
+    for (size_t i = 0; i < query.size(); ++i) {
+      auto iters = map.equal_range(query[i]);
+      for (auto it = iters.first; it != iters.second; ++it)
+        result ^= it->second;
+    }
+    BL_BENCH_END(map, "find" + ss.str(), result);
+
+    BL_BENCH_START(map);
+    result = 0;
+    for (size_t i = 0; i < query.size(); ++i) {
+      result += map.count(query[i]);
+    }
+    BL_BENCH_END(map, "count" + ss.str(), result);
+  }
+
+  BL_BENCH_REPORT_MPI_NAMED(map, name, comm);
+}
+
+/// comma separated list of sizes.
+std::vector<size_t> parse_counts(std::string const & s) {
+  std::vector<size_t> out;
+  std::stringstream ss(s);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (!item.empty()) out.push_back(std::stoull(item));
+  }
+  return out;
+}
+
+
 int main(int argc, char** argv) {
 
-  size_t count = 10000000;
-//  size_t count = 100;
+  std::vector<size_t> counts;
   size_t query_frac = 10;
 
 
   mxx::env e(argc, argv);
   mxx::comm comm;
 
-  if (comm.rank() == 0) printf("EXECUTING %s\n", argv[0]);
+  try {
+    TCLAP::CmdLine cmd("Benchmark local hash tables on synthetic or replayed kmer workloads", ' ', "0.1");
+
+    TCLAP::ValueArg<std::string> countsArg("n", "counts", "comma separated input sizes per rank.  include sizes well beyond the LLC",
+                                           false, "10000000", "string", cmd);
+    TCLAP::ValueArg<size_t> queryArg("q", "query-frac", "query count is count / query-frac", false, query_frac, "size_t", cmd);
+    TCLAP::ValueArg<std::string> workloadArg("w", "workload", "input workload: uniform, zipf, spectrum, reads, file",
+                                             false, workload.kind, "string", cmd);
+    TCLAP::ValueArg<double> zipfArg("", "zipf-s", "zipf: exponent", false, workload.zipf_s, "double", cmd);
+    TCLAP::ValueArg<double> distinctArg("", "distinct-frac", "zipf: distinct kmers as fraction of count", false, workload.distinct_frac, "double", cmd);
+    TCLAP::ValueArg<double> singletonArg("", "singleton-frac", "spectrum: fraction of distinct kmers that are singletons", false, workload.singleton_frac, "double", cmd);
+    TCLAP::ValueArg<double> coverageArg("", "coverage", "spectrum: multiplicity of the non-singleton kmers", false, workload.coverage, "double", cmd);
+    TCLAP::ValueArg<double> genomeArg("", "genome-frac", "reads: genome length as fraction of count", false, workload.genome_frac, "double", cmd);
+    TCLAP::ValueArg<size_t> readLenArg("", "read-length", "reads: read length", false, workload.read_length, "size_t", cmd);
+    TCLAP::ValueArg<double> errorArg("", "error-rate", "reads: per base substitution rate", false, workload.error_rate, "double", cmd);
+    TCLAP::ValueArg<double> rcArg("", "rc-frac", "fraction of kmers replaced by their reverse complement", false, workload.rc_frac, "double", cmd);
+    TCLAP::ValueArg<std::string> fileArg("F", "file", "file: FASTQ file to replay", false, "", "string", cmd);
+    TCLAP::ValueArg<unsigned int> seedArg("", "seed", "random seed", false, workload.seed, "unsigned int", cmd);
+
+    cmd.parse( argc, argv );
+
+    counts = parse_counts(countsArg.getValue());
+    query_frac = std::max(queryArg.getValue(), static_cast<size_t>(1));
+    workload.kind = workloadArg.getValue();
+    workload.zipf_s = zipfArg.getValue();
+    workload.distinct_frac = distinctArg.getValue();
+    workload.singleton_frac = singletonArg.getValue();
+    workload.coverage = coverageArg.getValue();
+    workload.genome_frac = genomeArg.getValue();
+    workload.read_length = readLenArg.getValue();
+    workload.error_rate = errorArg.getValue();
+    workload.rc_frac = rcArg.getValue();
+    workload.filename = fileArg.getValue();
+    workload.seed = seedArg.getValue();
+
+  } catch (TCLAP::ArgException &e)  // catch any exceptions
+  {
+    std::cerr << "error: " << e.error() << " for arg " << e.argId() << std::endl;
+    exit(-1);
+  }
+
+  if ((workload.kind == "file") && workload.filename.empty()) {
+    std::cerr << "error: workload file requires -F" << std::endl;
+    exit(-1);
+  }
+
+  if (comm.rank() == 0) printf("EXECUTING %s workload %s\n", argv[0], workload.kind.c_str());
 
   comm.barrier();
 
@@ -1183,87 +1368,111 @@ int main(int argc, char** argv) {
   using DNA5Kmer = ::bliss::common::Kmer<21, ::bliss::common::DNA5, uint64_t>;
   using FullKmer = ::bliss::common::Kmer<32, ::bliss::common::DNA, uint64_t>;
 
-  BL_BENCH_INIT(test);
-
-  comm.barrier();
+  long llc = sysconf(_SC_LEVEL3_CACHE_SIZE);
 
-  BL_BENCH_START(test);
-  benchmark_unordered_map<Kmer, size_t>(count, query_frac, comm);
-  BL_BENCH_COLLECTIVE_END(test, "unordered_map", count, comm);
+  for (size_t count : counts) {
+    if (comm.rank() == 0) {
+      size_t bytes = count * sizeof(::std::pair<Kmer, size_t>);
+      if (llc > 0) printf("count %lu: input %lu bytes = %.1f x LLC (%ld bytes)\n", count, bytes, static_cast<double>(bytes) / llc, llc);
+      else printf("count %lu: input %lu bytes\n", count, bytes);
+    }
 
-  BL_BENCH_START(test);
-  benchmark_densehash_map<Kmer, size_t>(count, query_frac, comm);
-  BL_BENCH_COLLECTIVE_END(test, "densehash_map_warmup", count, comm);
+    BL_BENCH_INIT(test);
 
-  BL_BENCH_START(test);
-  benchmark_densehash_map<Kmer, size_t>(count, query_frac, comm);
-  BL_BENCH_COLLECTIVE_END(test, "densehash_map", count, comm);
+    comm.barrier();
 
-  BL_BENCH_START(test);
-  benchmark_densehash_map<DNA5Kmer, size_t>(count, query_frac, comm);
-  BL_BENCH_COLLECTIVE_END(test, "densehash_map_DNA5", count, comm);
+    BL_BENCH_START(test);
+    benchmark_unordered_map<Kmer, size_t>(count, query_frac, comm);
+    BL_BENCH_COLLECTIVE_END(test, "unordered_map", count, comm);
 
-  BL_BENCH_START(test);
-  benchmark_densehash_full_map<FullKmer, size_t, true>(count, query_frac, comm);
-  BL_BENCH_COLLECTIVE_END(test, "densehash_full_map_canonical", count, comm);
+    BL_BENCH_START(test);
+    benchmark_densehash_map<Kmer, size_t>(count, query_frac, comm);
+    BL_BENCH_COLLECTIVE_END(test, "densehash_map_warmup", count, comm);
 
-  BL_BENCH_START(test);
-  benchmark_densehash_full_map<FullKmer, size_t, false>(count, query_frac, comm);
-  BL_BENCH_COLLECTIVE_END(test, "densehash_full_map", count, comm);
+    BL_BENCH_START(test);
+    benchmark_densehash_map<Kmer, size_t>(count, query_frac, comm);
+    BL_BENCH_COLLECTIVE_END(test, "densehash_map", count, comm);
 
+    BL_BENCH_START(test);
+    benchmark_densehash_map<DNA5Kmer, size_t>(count, query_frac, comm);
+    BL_BENCH_COLLECTIVE_END(test, "densehash_map_DNA5", count, comm);
 
-  BL_BENCH_START(test);
-  benchmark_unordered_multimap<Kmer, size_t>(count, query_frac, comm);
-  BL_BENCH_COLLECTIVE_END(test, "unordered_multimap", count, comm);
+    BL_BENCH_START(test);
+    benchmark_densehash_full_map<FullKmer, size_t, true>(count, query_frac, comm);
+    BL_BENCH_COLLECTIVE_END(test, "densehash_full_map_canonical", count, comm);
 
-//  BL_BENCH_START(test);
-//  benchmark_densehash_vecmap<Kmer, size_t>(count, query_frac, comm);
-//  BL_BENCH_COLLECTIVE_END(test, "densehash_vecmap", count, comm);
+    BL_BENCH_START(test);
+    benchmark_densehash_full_map<FullKmer, size_t, false>(count, query_frac, comm);
+    BL_BENCH_COLLECTIVE_END(test, "densehash_full_map", count, comm);
 
-  BL_BENCH_START(test);
-  benchmark_densehash_multimap<Kmer, size_t>(count, query_frac, comm);
-  BL_BENCH_COLLECTIVE_END(test, "densehash_multimap_warmup", count, comm);
 
-  BL_BENCH_START(test);
-  benchmark_densehash_multimap<Kmer, size_t>(count, query_frac, comm);
-  BL_BENCH_COLLECTIVE_END(test, "densehash_multimap", count, comm);
+    BL_BENCH_START(test);
+    benchmark_unordered_multimap<Kmer, size_t>(count, query_frac, comm);
+    BL_BENCH_COLLECTIVE_END(test, "unordered_multimap", count, comm);
 
-  BL_BENCH_START(test);
-  benchmark_densehash_multimap<DNA5Kmer, size_t>(count, query_frac, comm);
-  BL_BENCH_COLLECTIVE_END(test, "densehash_multimap_DNA5", count, comm);
+  //  BL_BENCH_START(test);
+  //  benchmark_densehash_vecmap<Kmer, size_t>(count, query_frac, comm);
+  //  BL_BENCH_COLLECTIVE_END(test, "densehash_vecmap", count, comm);
 
-  BL_BENCH_START(test);
-  benchmark_densehash_full_multimap<FullKmer, size_t, false>(count, query_frac, comm);
-  BL_BENCH_COLLECTIVE_END(test, "densehash_full_multimap", count, comm);
+    BL_BENCH_START(test);
+    benchmark_densehash_multimap<Kmer, size_t>(count, query_frac, comm);
+    BL_BENCH_COLLECTIVE_END(test, "densehash_multimap_warmup", count, comm);
 
-  BL_BENCH_START(test);
-  benchmark_densehash_full_multimap<FullKmer, size_t, true>(count, query_frac, comm);
-  BL_BENCH_COLLECTIVE_END(test, "densehash_full_multimap_canonical", count, comm);
+    BL_BENCH_START(test);
+    benchmark_densehash_multimap<Kmer, size_t>(count, query_frac, comm);
+    BL_BENCH_COLLECTIVE_END(test, "densehash_multimap", count, comm);
 
-#if 0
-  BL_BENCH_START(test);
-  benchmark_tommyhashdyn<Kmer, size_t>(count, query_frac, comm);
-  BL_BENCH_COLLECTIVE_END(test, "tommyhashdyn", count, comm);
+    BL_BENCH_START(test);
+    benchmark_densehash_multimap<DNA5Kmer, size_t>(count, query_frac, comm);
+    BL_BENCH_COLLECTIVE_END(test, "densehash_multimap_DNA5", count, comm);
 
+    BL_BENCH_START(test);
+    benchmark_densehash_full_multimap<FullKmer, size_t, false>(count, query_frac, comm);
+    BL_BENCH_COLLECTIVE_END(test, "densehash_full_multimap", count, comm);
 
-  BL_BENCH_START(test);
-  benchmark_tommyhashlin<Kmer, size_t>(count, query_frac, comm);
-  BL_BENCH_COLLECTIVE_END(test, "tommyhashlin", count, comm);
+    BL_BENCH_START(test);
+    benchmark_densehash_full_multimap<FullKmer, size_t, true>(count, query_frac, comm);
+    BL_BENCH_COLLECTIVE_END(test, "densehash_full_multimap_canonical", count, comm);
 
-  BL_BENCH_START(test);
-  benchmark_tommytrie<Kmer, size_t>(count, query_frac, comm);
-  BL_BENCH_COLLECTIVE_END(test, "tommytrie", count, comm);
-#endif
-  BL_BENCH_START(test);
-  benchmark_unordered_vecmap<Kmer, size_t>(count, query_frac, comm);
-  BL_BENCH_COLLECTIVE_END(test, "unordered_vecmap", count, comm);
+#if 0
+    BL_BENCH_START(test);
+    benchmark_tommyhashdyn<Kmer, size_t>(count, query_frac, comm);
+    BL_BENCH_COLLECTIVE_END(test, "tommyhashdyn", count, comm);
 
-//  BL_BENCH_START(test);
-//  benchmark_hashed_vecmap<Kmer, size_t>(count, query_frac, comm);
-//  BL_BENCH_COLLECTIVE_END(test, "hashed_vecmap", count, comm);
 
+    BL_BENCH_START(test);
+    benchmark_tommyhashlin<Kmer, size_t>(count, query_frac, comm);
+    BL_BENCH_COLLECTIVE_END(test, "tommyhashlin", count, comm);
 
-  BL_BENCH_REPORT_MPI_NAMED(test, "hashmaps", comm);
+    BL_BENCH_START(test);
+    benchmark_tommytrie<Kmer, size_t>(count, query_frac, comm);
+    BL_BENCH_COLLECTIVE_END(test, "tommytrie", count, comm);
+#endif
+    BL_BENCH_START(test);
+    benchmark_unordered_vecmap<Kmer, size_t>(count, query_frac, comm);
+    BL_BENCH_COLLECTIVE_END(test, "unordered_vecmap", count, comm);
+
+  //  BL_BENCH_START(test);
+  //  benchmark_hashed_vecmap<Kmer, size_t>(count, query_frac, comm);
+  //  BL_BENCH_COLLECTIVE_END(test, "hashed_vecmap", count, comm);
+
+    BL_BENCH_START(test);
+    benchmark_load_factors<::std::unordered_map<Kmer, size_t, ::bliss::kmer::hash::farm<Kmer, false> >, Kmer, size_t>(
+        "unordered_map_load", count, query_frac, comm);
+    BL_BENCH_COLLECTIVE_END(test, "unordered_map_load", count, comm);
+
+    BL_BENCH_START(test);
+    benchmark_load_factors<::fsc::densehash_map<Kmer, size_t,
+                                                ::bliss::kmer::hash::sparsehash::special_keys<Kmer, false>,
+                                                ::bliss::transform::identity,
+                                                ::bliss::kmer::hash::farm<Kmer, false> >, Kmer, size_t>(
+        "densehash_map_load", count, query_frac, comm);
+    BL_BENCH_COLLECTIVE_END(test, "densehash_map_load", count, comm);
+
+    std::stringstream title;
+    title << "hashmaps_" << workload.kind << "_n" << count;
+    BL_BENCH_REPORT_MPI_NAMED(test, title.str(), comm);
+  }
 
 }
 
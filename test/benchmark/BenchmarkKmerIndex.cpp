@@ -59,8 +59,10 @@
 #include "index/quality_score_iterator.hpp"
 
 #include "index/kmer_index.hpp"
+#include "index/kmer_query_server.hpp"
 
 #include "utils/benchmark_utils.hpp"
+#include "utils/comm_profiler.hpp"
 #include "utils/exception_handling.hpp"
 
 #include "tclap/CmdLine.h"
@@ -92,6 +94,7 @@
 #define HASHEDVEC 45
 #define UNORDERED 46
 #define DENSEHASH 47
+#define POSTING 48
 
 #define SINGLE 51
 #define CANONICAL 52
@@ -128,7 +131,16 @@ using KmerType = bliss::common::Kmer<21, Alphabet, WordType>;
 
 
 // ============  index value type
+#if defined(pQUAL)
+// fixed point kmer quality, pQUAL bits.  see QualityPayloadCodec
+#if (pQUAL == 8)
+using QualType = uint8_t;
+#elif (pQUAL == 16)
+using QualType = uint16_t;
+#endif
+#else
 using QualType = float;
+#endif
 using KmerInfoType = std::pair<IdType, QualType>;
 using CountType = uint32_t;
 
@@ -277,6 +289,9 @@ using CountType = uint32_t;
     #elif (pMAP == DENSEHASH)
       using MapType = ::dsc::densehash_multimap<
           KmerType, ValType, MapParams, SpecialKeys>;
+    #elif (pMAP == POSTING)
+      using MapType = ::dsc::posting_list_multimap<
+          KmerType, ValType, MapParams>;
     #endif
   #elif (pINDEX == COUNT)  // map
     #if (pMAP == DENSEHASH)
@@ -428,6 +443,8 @@ int main(int argc, char** argv) {
   int sample_ratio = 100;
 
   int reader_algo = -1;
+
+  std::string socket_path;
   // Wrap everything in a try block.  Do this every time,
   // because exceptions will be thrown for problems.
   try {
@@ -447,13 +464,17 @@ int main(int argc, char** argv) {
     TCLAP::ValueArg<std::string> queryArg("Q", "query", "FASTQ file path for query. default to same file as index file", false, "", "string", cmd);
 
     TCLAP::ValueArg<int> algoArg("A",
-                                 "algo", "Reader Algorithm id. Fileloader w/o preload = 2, mmap = 5, posix=7, piio = 10. default is 7.",
+                                 "algo", "Reader Algorithm id. Fileloader w/o preload = 2, mmap = 5, posix=7, piio = 10, packed reads (see utils/pack_reads) = 12, node aggregated (1 reader per node, shared memory) = 13. default is 7.",
                                  false, 7, "int", cmd);
 
     TCLAP::ValueArg<int> sampleArg("S",
                                  "query-sample", "sampling ratio for the query kmers. default=100",
                                  false, sample_ratio, "int", cmd);
 
+    TCLAP::ValueArg<std::string> serveArg("",
+                                 "serve", "after the benchmark, keep the index and serve queries from local clients on this unix socket path until shutdown.",
+                                 false, "", "string", cmd);
+
 
     // Parse the argv array.
     cmd.parse( argc, argv );
@@ -466,6 +487,7 @@ int main(int argc, char** argv) {
     filename = fileArg.getValue();
     reader_algo = algoArg.getValue();
     sample_ratio = sampleArg.getValue();
+    socket_path = serveArg.getValue();
 
     // set the default for query to filename, and reparse
 
@@ -520,6 +542,12 @@ int main(int argc, char** argv) {
 	  } else if (reader_algo == 10){
 		if (comm.rank() == 0) printf("reading %s via mpiio\n", filename.c_str());
 		::bliss::io::KmerFileHelper::read_file_mpiio<typename IndexType::KmerParserType, PARSER_TYPE, bliss::io::SequencesIterator>(filename, temp, comm);
+	  } else if (reader_algo == 12){
+		if (comm.rank() == 0) printf("reading %s via packed reads\n", filename.c_str());
+		::bliss::io::KmerFileHelper::read_file_packed<typename IndexType::KmerParserType>(filename, temp, comm);
+	  } else if (reader_algo == 13){
+		if (comm.rank() == 0) printf("reading %s via node aggregated io\n", filename.c_str());
+		::bliss::io::KmerFileHelper::read_file_node_aggregated<typename IndexType::KmerParserType, PARSER_TYPE, bliss::io::SequencesIterator>(filename, temp, comm);
 	  } else {
 		throw std::invalid_argument("missing file reader type");
 	  }
@@ -576,15 +604,34 @@ int main(int argc, char** argv) {
     }
 #endif
 
+	  if (!socket_path.empty()) {
+		  ::bliss::index::kmer::QueryServer<IndexType> server(idx, comm, socket_path);
+		  BL_BENCH_START(test);
+		  server.serve();
+		  BL_BENCH_COLLECTIVE_END(test, "serve", server.get_served(), comm);
+	  }
+
 	  BL_BENCH_START(test);
 	  idx.erase(query);
 	  BL_BENCH_COLLECTIVE_END(test, "erase", idx.local_size(), comm);
 
+#if (pMAP == DENSEHASH)
+	  double tombstones = idx.get_map().tombstone_ratio();
+	  if (comm.rank() == 0) printf("tombstone ratio after erase is %f\n", tombstones);
+
+	  BL_BENCH_START(test);
+	  idx.get_map().local_compact();
+	  BL_BENCH_COLLECTIVE_END(test, "compact", idx.local_size(), comm);
+#endif
+
   }
 
   
   BL_BENCH_REPORT_MPI_NAMED(test, "app", comm);
 
+  // exchange volume and skew per map operation, when BL_COMM_PROFILE is set.
+  ::plog::CommProfiler::instance().report(comm);
+
 
   // mpi cleanup is automatic
   comm.barrier();
@@ -0,0 +1,487 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    BenchmarkKmerIndexSweep.cpp
+ * @ingroup
+ * @author  agent <agent@local>
+ * @brief   kmer index benchmark with the configuration chosen at run time.
+ * @details BenchmarkKmerIndex.cpp is compiled once per configuration (-DpK=... -DpMAP=...).  this driver instead
+ *          pre-instantiates a curated set of configurations and picks one from the command line, e.g.
+ *
+ *            testKmerIndex-sweep --map DENSEHASH --index COUNT --store CANONICAL -K 31 -F reads.fastq --fractions 0.01,0.1,1
+ *
+ *          for each repeat and each query fraction, the index is rebuilt, then a sample of that fraction of the query kmers
+ *          is used for find, count and erase.  each step is timed on every rank (between barriers, excluding the wait
+ *          at the closing barrier), and rank 0 writes min, max and mean over the ranks to one JSON result file per sweep.
+ *
+ *          --workload zipf|spectrum|reads replaces the input file with synthetic kmers (count indices only), see
+ *          utils/kmer_generator.hpp.
+ *
+ *          --net-delay (or BL_NET_DELAY) delays the exchanges to emulate inter-node links, see utils/net_delay.hpp.
+ *          utils/scaling_sweep.sh runs this driver over a rank sweep and reports parallel efficiency per phase.
+ *
+ *          use --list to print the available configurations.  all use FARM distribution and storage hashes and the
+ *          identity distribution transform, as the default testKmerIndex targets do.
+ */
+
+#include "bliss-config.hpp"
+
+#include <functional>
+#include <random>
+#include <algorithm>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+#include <cstdlib>   // getenv
+#include <type_traits>
+#include <utility>
+
+#include "utils/logging.h"
+
+#include "common/alphabets.hpp"
+#include "common/kmer.hpp"
+#include "common/base_types.hpp"
+
+#include "index/kmer_index.hpp"
+#include "index/kmer_hash.hpp"
+#include "utils/kmer_generator.hpp"
+#include "utils/net_delay.hpp"
+
+#include "tclap/CmdLine.h"
+
+#include "mxx/env.hpp"
+#include "mxx/comm.hpp"
+#include "mxx/reduction.hpp"
+
+
+namespace sweep {
+
+  enum store_kind { SINGLE, CANONICAL, BIMOLECULE };
+  enum map_kind { SORTED, UNORDERED, DENSEHASH };
+  enum index_kind { COUNT, POS };
+
+  //================ types of a configuration
+
+  /// map params for a kmer store model.
+  template <typename Kmer, store_kind S>
+  struct store_params;
+
+  template <typename Kmer>
+  struct store_params<Kmer, SINGLE> {
+      template <typename Key>
+      using hashed = ::bliss::index::kmer::SingleStrandHashMapParams<Key,
+          ::bliss::index::kmer::DistHashFarm, ::bliss::index::kmer::StoreHashFarm>;
+      template <typename Key>
+      using sorted = ::bliss::index::kmer::SingleStrandSortedMapParams<Key>;
+      using special_keys = ::bliss::kmer::hash::sparsehash::special_keys<Kmer, false>;
+  };
+
+  template <typename Kmer>
+  struct store_params<Kmer, CANONICAL> {
+      template <typename Key>
+      using hashed = ::bliss::index::kmer::CanonicalHashMapParams<Key,
+          ::bliss::index::kmer::DistHashFarm, ::bliss::index::kmer::StoreHashFarm>;
+      template <typename Key>
+      using sorted = ::bliss::index::kmer::CanonicalSortedMapParams<Key>;
+      using special_keys = ::bliss::kmer::hash::sparsehash::special_keys<Kmer, true>;
+  };
+
+  template <typename Kmer>
+  struct store_params<Kmer, BIMOLECULE> {
+      template <typename Key>
+      using hashed = ::bliss::index::kmer::BimoleculeHashMapParams<Key,
+          ::bliss::index::kmer::DistHashFarm, ::bliss::index::kmer::StoreHashFarm>;
+      template <typename Key>
+      using sorted = ::bliss::index::kmer::BimoleculeSortedMapParams<Key>;
+      using special_keys = ::bliss::kmer::hash::sparsehash::special_keys<Kmer, false>;
+  };
+
+  /// distributed map for the map backend and index kind.
+  template <typename Kmer, typename Val, store_kind S, map_kind M, index_kind I>
+  struct map_type;
+
+  template <typename Kmer, typename Val, store_kind S>
+  struct map_type<Kmer, Val, S, SORTED, COUNT> {
+      using type = ::dsc::counting_sorted_map<Kmer, Val, store_params<Kmer, S>::template sorted>;
+  };
+  template <typename Kmer, typename Val, store_kind S>
+  struct map_type<Kmer, Val, S, SORTED, POS> {
+      using type = ::dsc::sorted_multimap<Kmer, Val, store_params<Kmer, S>::template sorted>;
+  };
+  template <typename Kmer, typename Val, store_kind S>
+  struct map_type<Kmer, Val, S, UNORDERED, COUNT> {
+      using type = ::dsc::counting_unordered_map<Kmer, Val, store_params<Kmer, S>::template hashed>;
+  };
+  template <typename Kmer, typename Val, store_kind S>
+  struct map_type<Kmer, Val, S, UNORDERED, POS> {
+      using type = ::dsc::unordered_multimap<Kmer, Val, store_params<Kmer, S>::template hashed>;
+  };
+  template <typename Kmer, typename Val, store_kind S>
+  struct map_type<Kmer, Val, S, DENSEHASH, COUNT> {
+      using type = ::dsc::counting_densehash_map<Kmer, Val, store_params<Kmer, S>::template hashed,
+          typename store_params<Kmer, S>::special_keys>;
+  };
+  template <typename Kmer, typename Val, store_kind S>
+  struct map_type<Kmer, Val, S, DENSEHASH, POS> {
+      using type = ::dsc::densehash_multimap<Kmer, Val, store_params<Kmer, S>::template hashed,
+          typename store_params<Kmer, S>::special_keys>;
+  };
+
+  /// index type.  position indices store the kmer id type that matches the sequence parser.
+  template <typename IdType, unsigned int K, store_kind S, map_kind M, index_kind I>
+  struct index_type;
+
+  template <typename IdType, unsigned int K, store_kind S, map_kind M>
+  struct index_type<IdType, K, S, M, COUNT> {
+      using kmer = ::bliss::common::Kmer<K, ::bliss::common::DNA, WordType>;
+      using type = ::bliss::index::kmer::CountIndex<typename map_type<kmer, uint32_t, S, M, COUNT>::type>;
+  };
+  template <typename IdType, unsigned int K, store_kind S, map_kind M>
+  struct index_type<IdType, K, S, M, POS> {
+      using kmer = ::bliss::common::Kmer<K, ::bliss::common::DNA, WordType>;
+      using type = ::bliss::index::kmer::PositionIndex<typename map_type<kmer, IdType, S, M, POS>::type>;
+  };
+
+  //================ sweep
+
+  struct options {
+      std::string filename;
+      std::string queryname;
+      std::vector<double> fractions;
+      int repeat;
+      unsigned int seed;
+      std::string workload;   // file, or a synthetic workload:  zipf, spectrum, reads
+      size_t count;           // synthetic kmers per rank
+      std::string net_delay;  // latency_us:bandwidth_MBps[:ranks_per_node], or empty
+  };
+
+  /// synthetic kmers for this rank.  parameters are the kmer_generator defaults for read-set like data.
+  template <typename Kmer>
+  void generate(std::vector<Kmer> & kmers, options const & opt, mxx::comm const & comm) {
+    // shared by all ranks:  the zipf key set and the genome.  per rank:  the samples.
+    unsigned int shared_seed = opt.seed;
+    unsigned int seed = opt.seed + 1 + comm.rank();
+    if (opt.workload == "zipf")
+      ::bliss::utils::zipf_kmers(kmers, opt.count, std::max(opt.count * comm.size() / 10, static_cast<size_t>(1)), 1.0,
+                                 shared_seed, seed);
+    else if (opt.workload == "spectrum")
+      ::bliss::utils::spectrum_kmers(kmers, opt.count, 0.8, 30.0, seed);
+    else if (opt.workload == "reads")
+      ::bliss::utils::read_kmers(kmers, opt.count, std::max(opt.count * comm.size() / 30, static_cast<size_t>(1000)), 100, 0.01,
+                                 shared_seed, seed);
+    else
+      throw std::invalid_argument("unknown workload " + opt.workload);
+  }
+
+  /// index input from synthetic kmers.  only the count indices take bare kmers, or (kmer, count) pairs.
+  template <typename Kmer>
+  void to_input(std::vector<Kmer> & input, std::vector<Kmer> const & kmers) {
+    input = kmers;
+  }
+  template <typename Kmer, typename C, typename = typename std::enable_if<std::is_arithmetic<C>::value>::type>
+  void to_input(std::vector<std::pair<Kmer, C> > & input, std::vector<Kmer> const & kmers) {
+    input.clear();
+    input.reserve(kmers.size());
+    for (auto const & k : kmers) input.emplace_back(k, 1);
+  }
+  template <typename T, typename Kmer>
+  void to_input(std::vector<T> &, std::vector<Kmer> const &) {
+    throw std::invalid_argument("synthetic workloads need a COUNT index");
+  }
+
+  /// one timed step, over the ranks.
+  struct result {
+      int rep;
+      double fraction;
+      std::string op;
+      size_t count;           // elements, summed over the ranks
+      double min, max, mean;  // seconds
+  };
+
+  /// time f on each rank, between barriers.  returns min, max and mean over the ranks in r.
+  template <typename F>
+  void timed(result & r, F && f, mxx::comm const & comm) {
+    comm.barrier();
+    auto t0 = std::chrono::steady_clock::now();
+    size_t n = f();
+    double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    comm.barrier();
+
+    r.count = ::mxx::allreduce(n, comm);
+    r.min = ::mxx::allreduce(t, [](double const & x, double const & y) { return std::min(x, y); }, comm);
+    r.max = ::mxx::allreduce(t, [](double const & x, double const & y) { return std::max(x, y); }, comm);
+    r.mean = ::mxx::allreduce(t, comm) / static_cast<double>(comm.size());
+  }
+
+  template <typename IndexType, template <typename> class SeqParser>
+  std::vector<result> run(options const & opt, mxx::comm const & comm) {
+    using KmerType = typename IndexType::KmerType;
+    std::vector<result> results;
+
+    // read or generate once, then rebuild from a copy for each step.
+    ::std::vector<typename IndexType::KmerParserType::value_type> input;
+    ::std::vector<KmerType> all_queries;
+    if (opt.workload == "file") {
+      ::bliss::io::KmerFileHelper::template read_file_posix<typename IndexType::KmerParserType, SeqParser,
+        ::bliss::io::SequencesIterator>(opt.filename, input, comm);
+
+      ::bliss::io::KmerFileHelper::template read_file_posix<::bliss::index::kmer::KmerParser<KmerType>, SeqParser,
+        ::bliss::io::SequencesIterator>(opt.queryname, all_queries, comm);
+    } else {
+      generate(all_queries, opt, comm);
+      to_input(input, all_queries);
+    }
+
+    for (int rep = 0; rep < opt.repeat; ++rep) {
+      for (double fraction : opt.fractions) {
+        result r;
+        r.rep = rep;
+        r.fraction = fraction;
+
+        // local sample of the query kmers.  the maps redistribute the queries anyway.
+        ::std::vector<KmerType> query(all_queries);
+        std::shuffle(query.begin(), query.end(), std::default_random_engine(opt.seed + rep * comm.size() + comm.rank()));
+        query.resize(std::min(query.size(), static_cast<size_t>(std::ceil(fraction * query.size()))));
+
+        IndexType idx(comm);
+
+        r.op = "build";
+        timed(r, [&]() { auto temp = input; idx.insert(temp); return idx.local_size(); }, comm);
+        results.push_back(r);
+
+        r.op = "find";
+        timed(r, [&]() { auto q = query; return idx.find(q).size(); }, comm);
+        results.push_back(r);
+
+        r.op = "count";
+        timed(r, [&]() { auto q = query; return idx.count(q).size(); }, comm);
+        results.push_back(r);
+
+        r.op = "erase";
+        timed(r, [&]() { auto q = query; idx.erase(q); return idx.local_size(); }, comm);
+        results.push_back(r);
+
+        if (comm.rank() == 0) {
+          for (size_t i = results.size() - 4; i < results.size(); ++i)
+            printf("rep %d fraction %f %s: count %lu time min %f max %f mean %f\n", rep, fraction,
+                   results[i].op.c_str(), results[i].count, results[i].min, results[i].max, results[i].mean);
+        }
+      }
+    }
+    return results;
+  }
+
+  //================ curated configurations
+
+  using runner = std::vector<result> (*)(options const &, mxx::comm const &);
+
+  struct config {
+      const char * parser;
+      unsigned int k;
+      const char * store;
+      const char * map;
+      const char * index;
+      runner run;
+
+      std::string name() const {
+        std::stringstream ss;
+        ss << parser << "-a4-k" << k << "-" << store << "-" << map << "-" << index << "-dtIDEN-dhFARM-shFARM";
+        return ss.str();
+      }
+  };
+
+#define SWEEP_CONFIG(parser, idtype, k, store, map, index) \
+  { #parser, k, #store, #map, #index, \
+    &run<typename index_type<::bliss::common::idtype, k, store, map, index>::type, ::bliss::io::parser##Parser> }
+
+  /// the pre-instantiated matrix:  kmer stores and backends at k = 31, k scaling for one backend, and FASTA input.
+  inline std::vector<config> const & configs() {
+    static const std::vector<config> list = {
+      SWEEP_CONFIG(FASTQ, ShortSequenceKmerId, 31, SINGLE,     DENSEHASH, COUNT),
+      SWEEP_CONFIG(FASTQ, ShortSequenceKmerId, 31, CANONICAL,  DENSEHASH, COUNT),
+      SWEEP_CONFIG(FASTQ, ShortSequenceKmerId, 31, BIMOLECULE, DENSEHASH, COUNT),
+      SWEEP_CONFIG(FASTQ, ShortSequenceKmerId, 31, CANONICAL,  SORTED,    COUNT),
+      SWEEP_CONFIG(FASTQ, ShortSequenceKmerId, 31, CANONICAL,  UNORDERED, COUNT),
+      SWEEP_CONFIG(FASTQ, ShortSequenceKmerId, 31, CANONICAL,  DENSEHASH, POS),
+      SWEEP_CONFIG(FASTQ, ShortSequenceKmerId, 31, CANONICAL,  SORTED,    POS),
+      SWEEP_CONFIG(FASTQ, ShortSequenceKmerId, 31, CANONICAL,  UNORDERED, POS),
+      SWEEP_CONFIG(FASTQ, ShortSequenceKmerId, 21, CANONICAL,  DENSEHASH, COUNT),
+      SWEEP_CONFIG(FASTQ, ShortSequenceKmerId, 63, CANONICAL,  DENSEHASH, COUNT),
+      SWEEP_CONFIG(FASTA, LongSequenceKmerId,  21, CANONICAL,  DENSEHASH, COUNT),
+      SWEEP_CONFIG(FASTA, LongSequenceKmerId,  21, CANONICAL,  SORTED,    COUNT)
+    };
+    return list;
+  }
+
+#undef SWEEP_CONFIG
+
+  /// comma separated list of numbers.
+  inline std::vector<double> parse_fractions(std::string const & s) {
+    std::vector<double> out;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+      if (item.empty()) continue;
+      double f = 0.0;
+      try {
+        f = std::stod(item);
+      } catch (std::logic_error &) {  // stod throws invalid_argument or out_of_range without the offending text
+        throw std::invalid_argument("query fraction is not a number: " + item);
+      }
+      if ((f <= 0.0) || (f > 1.0)) throw std::invalid_argument("query fraction must be in (0, 1]: " + item);
+      out.push_back(f);
+    }
+    return out;
+  }
+
+  inline void write_json(std::string const & path, config const & c, options const & opt,
+                         std::vector<result> const & results, int const & p) {
+    std::ofstream f(path, std::ios::trunc);
+    f.precision(9);
+    f << "{\"config\":{\"name\":\"" << c.name() << "\",\"parser\":\"" << c.parser << "\",\"k\":" << c.k <<
+        ",\"store\":\"" << c.store << "\",\"map\":\"" << c.map << "\",\"index\":\"" << c.index << "\"}" <<
+        ",\"ranks\":" << p << ",\"file\":\"" << opt.filename << "\",\"query\":\"" << opt.queryname << "\"" <<
+        ",\"workload\":\"" << opt.workload << "\",\"count\":" << opt.count <<
+        ",\"net_delay\":\"" << opt.net_delay << "\"" <<
+        ",\"repeat\":" << opt.repeat << ",\"seed\":" << opt.seed << ",\"results\":[";
+    for (size_t i = 0; i < results.size(); ++i) {
+      result const & r = results[i];
+      f << (i > 0 ? ",\n" : "\n") << "{\"rep\":" << r.rep << ",\"fraction\":" << r.fraction << ",\"op\":\"" << r.op <<
+          "\",\"count\":" << r.count << ",\"time_s\":{\"min\":" << r.min << ",\"max\":" << r.max <<
+          ",\"mean\":" << r.mean << "},\"imbalance\":" << ((r.mean > 0) ? r.max / r.mean : 1.0) << "}";
+    }
+    f << "\n]}" << std::endl;
+  }
+
+} // namespace sweep
+
+
+int main(int argc, char** argv) {
+
+  //////////////// init logging
+  LOG_INIT();
+
+  //////////////// initialize MPI and openMP
+  mxx::env e(argc, argv);
+  mxx::comm comm;
+
+  sweep::options opt;
+  std::string parser, store, map, index, output;
+  unsigned int k = 31;
+
+  try {
+    TCLAP::CmdLine cmd("Sweep parallel kmer index build and queries over query fractions", ' ', "0.1");
+
+    TCLAP::ValueArg<std::string> fileArg("F", "file", "input file path. default test/data/test.small.fastq, or test2.fasta for FASTA",
+                                         false, "", "string", cmd);
+    TCLAP::ValueArg<std::string> queryArg("Q", "query", "file path for query. default to same file as index file", false, "", "string", cmd);
+    TCLAP::ValueArg<std::string> parserArg("P", "parser", "sequence file format: FASTQ, FASTA", false, "FASTQ", "string", cmd);
+    TCLAP::ValueArg<unsigned int> kArg("K", "k", "kmer size", false, k, "unsigned int", cmd);
+    TCLAP::ValueArg<std::string> storeArg("s", "store", "kmer store model: SINGLE, CANONICAL, BIMOLECULE", false, "CANONICAL", "string", cmd);
+    TCLAP::ValueArg<std::string> mapArg("m", "map", "map backend: SORTED, UNORDERED, DENSEHASH", false, "DENSEHASH", "string", cmd);
+    TCLAP::ValueArg<std::string> indexArg("i", "index", "index type: COUNT, POS", false, "COUNT", "string", cmd);
+    TCLAP::ValueArg<std::string> fracArg("f", "fractions", "comma separated query fractions in (0, 1]", false, "0.01,0.1,1", "string", cmd);
+    TCLAP::ValueArg<int> repeatArg("r", "repeat", "number of repeats of the sweep", false, 1, "int", cmd);
+    TCLAP::ValueArg<unsigned int> seedArg("", "seed", "seed for query sampling", false, 11, "unsigned int", cmd);
+    TCLAP::ValueArg<std::string> outputArg("O", "output", "result file.  default sweep-<configuration>.json", false, "", "string", cmd);
+    TCLAP::ValueArg<std::string> workloadArg("w", "workload", "input: file, or synthetic COUNT index input: zipf, spectrum, reads",
+                                             false, "file", "string", cmd);
+    TCLAP::ValueArg<size_t> countArg("n", "count", "synthetic kmers per rank", false, 1000000, "size_t", cmd);
+    TCLAP::ValueArg<std::string> delayArg("", "net-delay", "emulate inter-node links: latency_us:bandwidth_MBps[:ranks_per_node]",
+                                          false, "", "string", cmd);
+    TCLAP::SwitchArg listArg("l", "list", "list the available configurations and exit", cmd, false);
+
+    cmd.parse( argc, argv );
+
+    if (listArg.getValue()) {
+      if (comm.rank() == 0) {
+        for (auto const & c : sweep::configs())
+          printf("--parser %s -K %u --store %s --map %s --index %s\n", c.parser, c.k, c.store, c.map, c.index);
+      }
+      return 0;
+    }
+
+    parser = parserArg.getValue();
+    k = kArg.getValue();
+    store = storeArg.getValue();
+    map = mapArg.getValue();
+    index = indexArg.getValue();
+    output = outputArg.getValue();
+
+    opt.filename = fileArg.getValue();
+    if (opt.filename.empty()) {
+      opt.filename.assign(PROJ_SRC_DIR);
+      opt.filename.append((parser == "FASTA") ? "/test/data/test2.fasta" : "/test/data/test.small.fastq");
+    }
+    opt.queryname = queryArg.getValue();
+    if (opt.queryname.empty()) opt.queryname = opt.filename;
+    opt.fractions = sweep::parse_fractions(fracArg.getValue());
+    opt.repeat = repeatArg.getValue();
+    opt.seed = seedArg.getValue();
+    opt.workload = workloadArg.getValue();
+    opt.count = countArg.getValue();
+    opt.net_delay = delayArg.getValue();
+    if (!opt.net_delay.empty()) ::plog::NetDelay::instance().enable(opt.net_delay);
+    else if (std::getenv("BL_NET_DELAY") != nullptr) opt.net_delay = std::getenv("BL_NET_DELAY");
+
+  } catch (TCLAP::ArgException &e)  // catch any exceptions
+  {
+    std::cerr << "error: " << e.error() << " for arg " << e.argId() << std::endl;
+    exit(-1);
+  } catch (std::invalid_argument & e)  // malformed --fractions or --net-delay.  every rank parses the same values.
+  {
+    if (comm.rank() == 0) std::cerr << "error: " << e.what() << std::endl;
+    exit(-1);
+  }
+
+  auto const & list = sweep::configs();
+  auto it = std::find_if(list.begin(), list.end(), [&](sweep::config const & c) {
+    return (parser == c.parser) && (k == c.k) && (store == c.store) && (map == c.map) && (index == c.index);
+  });
+  if (it == list.end()) {
+    if (comm.rank() == 0)
+      std::cerr << "error: configuration " << parser << " k=" << k << " " << store << " " << map << " " << index <<
+        " is not instantiated.  use --list to see the available configurations." << std::endl;
+    return 1;
+  }
+
+  if (comm.rank() == 0) printf("EXECUTING %s %s on %d ranks\n", argv[0], it->name().c_str(), comm.size());
+
+  std::vector<sweep::result> results;
+  try {
+    results = it->run(opt, comm);
+  } catch (std::invalid_argument & e)  // unsupported workload for the configuration
+  {
+    if (comm.rank() == 0) std::cerr << "error: " << e.what() << std::endl;
+    exit(-1);
+  }
+
+  if (comm.rank() == 0) {
+    if (output.empty()) output = "sweep-" + it->name() + ".json";
+    sweep::write_json(output, *it, opt, results, comm.size());
+    printf("results written to %s\n", output.c_str());
+  }
+
+  comm.barrier();
+
+  return 0;
+}
@@ -0,0 +1,215 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    benchmark_concurrent_IO.cpp
+ * @ingroup
+ * @author  agent <agent@local>
+ * @brief   measures how well file reading overlaps with computation on the loaded data.
+ * @details the file is processed chunk by chunk.  for each chunk the OpenMP threads compute a base count
+ *          (repeated to emulate heavier parsing).  the reading method is chosen at compile time:
+ *            TEST_OP_MMAP                  mmap the file, no hints
+ *            TEST_OP_MMAP_ADVISE           mmap the file, sequential hint, willneed hint on the next chunk
+ *            TEST_OP_MMAP_POPULATE         mmap the file with MAP_POPULATE
+ *            TEST_OP_MMAP_POPULATE_ADVISE  MAP_POPULATE and the hints
+ *            TEST_OP_POSIX                 synchronous pread of each chunk
+ *            TEST_OP_PREFETCH              chunk_prefetcher: pread of the next chunk on a background thread
+ *          use with a cold page cache (see utils/clear_cache) to measure the disk.
+ */
+
+#include "bliss-config.hpp"
+
+#include <string>
+#include <sstream>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <sys/mman.h>   // mmap
+
+#if defined(USE_OPENMP)
+#include <omp.h>
+#endif
+
+#include "utils/logging.h"
+
+#include "io/file.hpp"
+#include "io/file_prefetcher.hpp"
+
+#include "utils/benchmark_utils.hpp"
+#include "utils/exception_handling.hpp"
+
+#include "tclap/CmdLine.h"
+
+
+/// emulated parse: count ACGT in a chunk, repeated.
+template <typename Iter>
+size_t compute(Iter const & first, Iter const & last, int const & repeat) {
+  size_t n = std::distance(first, last);
+  size_t count = 0;
+
+  for (int r = 0; r < repeat; ++r) {
+#pragma omp parallel for reduction(+:count)
+    for (size_t i = 0; i < n; ++i) {
+      unsigned char c = *(first + i);
+      count += ((c == 'A') || (c == 'C') || (c == 'G') || (c == 'T')) ? 1 : 0;
+    }
+  }
+  return count / repeat;
+}
+
+
+#if defined(TEST_OP_MMAP) || defined(TEST_OP_MMAP_ADVISE) || defined(TEST_OP_MMAP_POPULATE) || defined(TEST_OP_MMAP_POPULATE_ADVISE)
+
+size_t process(std::string const & filename, size_t const & chunk_bytes, int const & repeat) {
+  using range_type = ::bliss::partition::range<size_t>;
+
+  int fd = open64(filename.c_str(), O_RDONLY);
+  if (fd == -1) {
+    std::stringstream ss;
+    int myerr = errno;
+    ss << "ERROR open: ["  << filename << "] error " << myerr << ": " << strerror(myerr);
+    throw ::bliss::utils::make_exception<::bliss::io::IOException>(ss.str());
+  }
+  struct stat64 filestat;
+  fstat64(fd, &filestat);
+  size_t file_size = filestat.st_size;
+
+  int flags = MAP_SHARED | MAP_NORESERVE;
+#if defined(TEST_OP_MMAP_POPULATE) || defined(TEST_OP_MMAP_POPULATE_ADVISE)
+  flags |= MAP_POPULATE;
+#endif
+  unsigned char * data = (unsigned char*)mmap64(nullptr, file_size, PROT_READ, flags, fd, 0);
+  if (data == MAP_FAILED) {
+    std::stringstream ss;
+    int myerr = errno;
+    ss << "ERROR in mmap: " << myerr << ": " << strerror(myerr);
+    throw ::bliss::utils::make_exception<::bliss::io::IOException>(ss.str());
+  }
+#if defined(TEST_OP_MMAP_ADVISE) || defined(TEST_OP_MMAP_POPULATE_ADVISE)
+  size_t page_size = sysconf(_SC_PAGE_SIZE);
+  madvise(data, file_size, ::bliss::io::to_madvise(::bliss::io::access_hint::sequential));
+#endif
+
+  size_t count = 0;
+  for (size_t s = 0; s < file_size; s += chunk_bytes) {
+    range_type chunk(s, std::min(s + chunk_bytes, file_size));
+
+#if defined(TEST_OP_MMAP_ADVISE) || defined(TEST_OP_MMAP_POPULATE_ADVISE)
+    if (chunk.end < file_size) {
+      size_t ahead = range_type::align_to_page(chunk.end, page_size);
+      madvise(data + ahead, std::min(chunk_bytes, file_size - ahead),
+              ::bliss::io::to_madvise(::bliss::io::access_hint::willneed));
+    }
+#endif
+
+    count += compute(data + chunk.start, data + chunk.end, repeat);
+  }
+
+  munmap(data, file_size);
+  close(fd);
+
+  return count;
+}
+
+#elif defined(TEST_OP_POSIX)
+
+size_t process(std::string const & filename, size_t const & chunk_bytes, int const & repeat) {
+  using range_type = ::bliss::partition::range<size_t>;
+
+  ::bliss::io::posix_file file(filename);
+  size_t file_size = file.size();
+
+  ::bliss::io::file_data::container buf;
+  size_t count = 0;
+  for (size_t s = 0; s < file_size; s += chunk_bytes) {
+    file.read_range(buf, range_type(s, std::min(s + chunk_bytes, file_size)));
+    count += compute(buf.begin(), buf.end(), repeat);
+  }
+  return count;
+}
+
+#elif defined(TEST_OP_PREFETCH)
+
+size_t process(std::string const & filename, size_t const & chunk_bytes, int const & repeat) {
+  using range_type = ::bliss::partition::range<size_t>;
+
+  ::bliss::io::chunk_prefetcher prefetcher(filename, range_type(0, std::numeric_limits<size_t>::max()), chunk_bytes);
+
+  ::bliss::io::file_data chunk;
+  size_t count = 0;
+  while (prefetcher.next(chunk)) {
+    count += compute(chunk.cbegin(), chunk.cend(), repeat);
+  }
+  return count;
+}
+
+#else
+#error "benchmark_concurrent_IO requires one of the TEST_OP_ defines."
+#endif
+
+
+int main(int argc, char** argv) {
+
+  //////////////// init logging
+  LOG_INIT();
+
+  std::string filename;
+  filename.assign(PROJ_SRC_DIR);
+  filename.append("/test/data/test.fastq");
+
+  size_t chunk_bytes = 64UL << 20;
+  int repeat = 1;
+  int nthreads = 1;
+
+  try {
+    TCLAP::CmdLine cmd("Benchmark overlap of file reading and computation", ' ', "0.1");
+
+    TCLAP::ValueArg<std::string> fileArg("F", "file", "file path", false, filename, "string", cmd);
+    TCLAP::ValueArg<size_t> chunkArg("C", "chunk", "chunk size in MB", false, 64, "size_t", cmd);
+    TCLAP::ValueArg<int> repeatArg("R", "repeat", "number of compute passes per chunk", false, 1, "int", cmd);
+    TCLAP::ValueArg<int> threadArg("T", "threads", "number of OpenMP threads", false, 1, "int", cmd);
+
+    cmd.parse( argc, argv );
+
+    filename = fileArg.getValue();
+    chunk_bytes = chunkArg.getValue() << 20;
+    repeat = std::max(1, repeatArg.getValue());
+    nthreads = std::max(1, threadArg.getValue());
+
+  } catch (TCLAP::ArgException &e)  // catch any exceptions
+  {
+    std::cerr << "error: " << e.error() << " for arg " << e.argId() << std::endl;
+    exit(-1);
+  }
+  if (chunk_bytes == 0) chunk_bytes = 1UL << 20;
+
+#if defined(USE_OPENMP)
+  omp_set_num_threads(nthreads);
+#endif
+
+  BL_BENCH_INIT(concurrent_io);
+
+  BL_BENCH_START(concurrent_io);
+  size_t count = process(filename, chunk_bytes, repeat);
+  BL_BENCH_END(concurrent_io, "read_compute", count);
+
+  BL_BENCH_REPORT(concurrent_io, 0);
+
+  std::cout << "counted " << count << " bases in " << filename << " with " << nthreads << " threads, chunk " << chunk_bytes << " bytes." << std::endl;
+
+  return 0;
+}
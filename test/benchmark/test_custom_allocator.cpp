@@ -14,11 +14,26 @@
  * limitations under the License.
  */
 
+/**
+ * @file    test_custom_allocator.cpp
+ * @ingroup
+ * @author  Tony Pan <tpan7@gatech.edu>
+ * @brief   effect of the local container allocator:  std::allocator vs fsc::huge_page_allocator in its page and NUMA modes.
+ * @details a vector and a densehash_map are filled, then probed at random, which is dTLB bound for tables much larger
+ *          than the TLB reach (e.g. 1536 x 4KB = 6MB).  build with ENABLE_PERF_BENCHMARK to see the dTLB miss counts
+ *          next to the times.
+ *
+ *            cust_alloc -n 100000000 --pages thp,hugetlb,small --numa interleave
+ */
+
 #include <cstdio>
 #include <stdint.h>
 
 #include <tuple>
 #include <vector>
+#include <string>
+#include <sstream>
+#include <random>
 #include <unordered_map>
 #include <unordered_set>
 #include <algorithm>
@@ -27,86 +42,33 @@
 #include "common/kmer.hpp"
 #include "index/kmer_hash.hpp"
 #include "common/kmer_transform.hpp"
-
-#include "boost/pool/pool_alloc.hpp"
+#include "containers/densehash_map.hpp"
+#include "containers/huge_page_allocator.hpp"
 
 #include "utils/benchmark_utils.hpp"
+#include "utils/transform_utils.hpp"
+
+#include "tclap/CmdLine.h"
 
 
-using Kmer = bliss::common::Kmer<21, bliss::common::DNA, uint64_t>;
+using Kmer = bliss::common::Kmer<31, bliss::common::DNA, uint64_t>;
 using KmerPos = ::std::pair<Kmer, uint64_t>;
-using KmerPosQual = ::std::pair<Kmer, ::std::pair<uint64_t, float> >;
 
-typedef bliss::kmer::transform::lex_less<Kmer> KeyTransform;
 typedef bliss::kmer::hash::farm<Kmer, false> KmerHash;
 
-struct TransformedHash {
-    KmerHash h;
-    KeyTransform trans;
-
-    inline uint64_t operator()(Kmer const& k) const {
-      return h(trans(k));
-    }
-    template<typename V>
-    inline uint64_t operator()(::std::pair<Kmer, V> const& x) const {
-      return this->operator()(x.first);
-    }
-    template<typename V>
-    inline uint64_t operator()(::std::pair<const Kmer, V> const& x) const {
-      return this->operator()(x.first);
-    }
-};
-
-template <typename Comparator>
-struct TransformedComp {
-    Comparator comp;
-    KeyTransform trans;
-
-    inline bool operator()(Kmer const & x, Kmer const & y) const {
-      return comp(trans(x), trans(y));
-    }
-    template<typename V>
-    inline bool operator()(::std::pair<Kmer, V> const & x, Kmer const & y) const {
-      return this->operator()(x.first, y);
-    }
-    template<typename V>
-    inline bool operator()(::std::pair<const Kmer, V> const & x, Kmer const & y) const {
-      return this->operator()(x.first, y);
-    }
-    template<typename V>
-    inline bool operator()(Kmer const & x, ::std::pair<Kmer, V> const & y) const {
-      return this->operator()(x, y.first);
-    }
-    template<typename V>
-    inline bool operator()(Kmer const & x, ::std::pair<const Kmer, V> const & y) const {
-      return this->operator()(x, y.first);
-    }
-    template<typename V>
-    inline bool operator()(::std::pair<Kmer, V> const & x, ::std::pair<Kmer, V> const & y) const {
-      return this->operator()(x.first, y.first);
-    }
-    template<typename V>
-    inline bool operator()(::std::pair<const Kmer, V> const & x, ::std::pair<const Kmer, V> const & y) const {
-      return this->operator()(x.first, y.first);
-    }
-};
-
-typedef TransformedComp<::std::less<Kmer> > TransformedLess;
-typedef TransformedComp<::std::equal_to<Kmer> > TransformedEqual;
-
 template <typename T>
 using vector_stl_alloc = ::std::vector<T, ::std::allocator<T > >;
 
 template <typename T>
-using vector_boost_pool = ::std::vector<T, ::boost::pool_allocator<T > >;
-
-template <typename K, typename T>
-using umap_stl_alloc = ::std::unordered_map<K, T, TransformedHash, TransformedEqual, ::std::allocator<::std::pair<const K, T> > >;
-
-template <typename K, typename T>
-using umap_boost_pool = ::std::unordered_map<K, T, TransformedHash, TransformedEqual, ::boost::fast_pool_allocator<::std::pair<const K, T> > >;
-
+using vector_huge_page = ::std::vector<T, ::fsc::huge_page_allocator<T > >;
 
+template <typename Alloc>
+using densehash_map = ::fsc::densehash_map<Kmer, uint64_t,
+    ::bliss::kmer::hash::sparsehash::special_keys<Kmer, false>,
+    ::bliss::transform::identity,
+    KmerHash,
+    ::fsc::sparsehash::compare<Kmer, ::std::equal_to, ::bliss::transform::identity>,
+    Alloc>;
 
 
 class KmerHelper
@@ -119,118 +81,128 @@ public:
 
     Kmer random_kmer() {
         *v = distribution(generator);
-        return Kmer(v);
+        Kmer km(v);
+        km.sanitize();
+        return km;
     }
 
 };
 
 
+/// fill a vector, then read it at random positions.
+template <typename Vector>
+void benchmark_vector(std::string const & name, size_t const iterations) {
+  BL_BENCH_INIT(vector);
+  KmerHelper helper;
+  std::default_random_engine gen(11);
+  Kmer result;
+
+  BL_BENCH_START(vector);
+  Vector vec(iterations);
+  BL_BENCH_END(vector, "alloc", iterations);
+
+  BL_BENCH_START(vector);
+  for (size_t i = 0; i < iterations; ++i) {
+    vec[i] = KmerPos(helper.random_kmer(), i);
+  }
+  BL_BENCH_END(vector, "fill", iterations);
+
+  BL_BENCH_START(vector);
+  std::uniform_int_distribution<size_t> pos(0, iterations - 1);
+  for (size_t i = 0; i < iterations; ++i) {
+    result ^= vec[pos(gen)].first;
+  }
+  BL_BENCH_END(vector, "random_read", iterations);
+  printf("result : %s\n", result.toAlphabetString().c_str());
+
+  BL_BENCH_REPORT_NAMED(vector, name);
+}
+
+/// insert into a densehash_map, then probe at random, half hits.
+template <typename Map>
+void benchmark_densehash(std::string const & name, size_t const iterations) {
+  BL_BENCH_INIT(map);
+  KmerHelper helper;
+
+  std::vector<KmerPos> input(iterations);
+  for (size_t i = 0; i < iterations; ++i) input[i] = KmerPos(helper.random_kmer(), i);
+  std::vector<Kmer> query(iterations);
+  for (size_t i = 0; i < iterations; ++i) query[i] = (i & 1) ? helper.random_kmer() : input[(i * 7919) % iterations].first;
+
+  BL_BENCH_START(map);
+  Map map(iterations);
+  BL_BENCH_END(map, "reserve", iterations);
+
+  BL_BENCH_START(map);
+  map.insert(input.begin(), input.end());
+  BL_BENCH_END(map, "insert", map.size());
+
+  BL_BENCH_START(map);
+  size_t found = 0;
+  for (size_t i = 0; i < iterations; ++i) {
+    found += map.count(query[i]);
+  }
+  BL_BENCH_END(map, "random_count", found);
+
+  BL_BENCH_START(map);
+  uint64_t result = 0;
+  for (size_t i = 0; i < iterations; ++i) {
+    auto iters = map.equal_range(query[i]);
+    for (auto it = iters.first; it != iters.second; ++it) result ^= it->second;
+  }
+  BL_BENCH_END(map, "random_find", result);
+
+  BL_BENCH_REPORT_NAMED(map, name);
+}
 
 
 int main(int argc, char** argv) {
 
-	int iterations = 1000000;
-	if (argc > 1) {
-		iterations = atoi(argv[1]);
-	}
-
-
-	printf("SIZES:\n");
-	printf("kmer size: %lu\n", sizeof(Kmer));
-	printf("Kmer Pos size: %lu\n", sizeof(KmerPos));
-	printf("Kmer PosQual size: %lu\n", sizeof(KmerPosQual));
-
-	printf("Vector of Kmer, base size: %lu\n", sizeof(::std::vector<Kmer>));
-	printf("Vector of KmerPos, base size: %lu\n", sizeof(::std::vector<KmerPos >));
-	printf("Vector of KmerPosQual, base size: %lu\n", sizeof(::std::vector<KmerPosQual >));
-
-	printf("Kmer Vector1 pair, base size: %lu\n", sizeof(::std::pair<Kmer, ::std::vector<Kmer> >));
-	printf("Kmer Vector2 pair, base size: %lu\n", sizeof(::std::pair<Kmer, ::std::vector<KmerPos> >));
-	printf("Kmer Vector3 pair, base size: %lu\n", sizeof(::std::pair<Kmer, ::std::vector<KmerPosQual > >));
-
-
-
-	KmerHelper helper;
-
-	BL_BENCH_INIT(vector);
-
-	Kmer result;
-
-	BL_BENCH_START(vector);
-	{
-		vector_stl_alloc<KmerPos> stlvec;
-		for (int i = 0; i < iterations; ++i) {
-			stlvec.emplace_back(helper.random_kmer(), 1UL);
-		}
-		result = helper.random_kmer();
-		for (int i = 0; i < iterations; ++i) {
-			result ^= stlvec[i].first.reverse_complement();
-		}
-	}
-	BL_BENCH_END(vector, "stl", iterations);
-	printf("result : %s\n", result.toAlphabetString().c_str());
-
-
-	BL_BENCH_START(vector);
-	{
-		vector_boost_pool<KmerPos> boostvec;
-		for (int i = 0; i < iterations; ++i) {
-			boostvec.emplace_back(helper.random_kmer(), 1UL);
-		}
-		result = helper.random_kmer();
-		for (int i = 0; i < iterations; ++i) {
-			result ^= boostvec[i].first.reverse_complement();
-		}
-		boost::singleton_pool<boost::pool_allocator_tag, sizeof(KmerPos)>::release_memory();
-
-		// could be 4x slower than stl allocator.
-	}
-	BL_BENCH_END(vector, "boost", iterations);
-	printf("result : %s\n", result.toAlphabetString().c_str());
-
-
-	BL_BENCH_REPORT(vector);
-
-
-
-	BL_BENCH_INIT(map);
-
-	BL_BENCH_START(map);
-	{
-		umap_stl_alloc<Kmer, uint64_t> stlumap;
-		for (int i = 0; i < iterations; ++i) {
-			stlumap.emplace(helper.random_kmer(), 1UL);
-		}
-		result = helper.random_kmer();
-		for (auto it = stlumap.begin(), max = stlumap.end(); it != max; ++it) {
-			result ^= it->first.reverse_complement();
-		}
-	}
-	BL_BENCH_END(map, "stl", iterations);
-	printf("result : %s\n", result.toAlphabetString().c_str());
-
-
-	// cannot get this to work...
-//	BL_BENCH_START(map);
-//	{
-//		umap_boost_pool<Kmer, uint64_t> boostumap;
-//		for (int i = 0; i < iterations; ++i) {
-//			boostumap.emplace(helper.random_kmer(), 1UL);
-//		}
-//		result = helper.random_kmer();
-//		for (auto it = boostumap.begin(), max = boostumap.end(); it != max; ++it) {
-//			result ^= it->first.reverse_complement();
-//		}
-//
-//		boost::singleton_pool<boost::pool_allocator_tag, sizeof(KmerPos)>::release_memory();
-//
-//		// could be 4x slower than stl allocator.
-//	}
-//	BL_BENCH_END(map, "boost", iterations);
-//	printf("result : %s\n", result.toAlphabetString().c_str());
-
-
-	BL_BENCH_REPORT(map);
+  size_t iterations = 10000000;
+  std::vector<std::string> pages;
+  std::string numa;
+
+  try {
+    TCLAP::CmdLine cmd("Compare std::allocator and huge page allocation for large local containers", ' ', "0.1");
+
+    TCLAP::ValueArg<size_t> countArg("n", "count", "number of elements", false, iterations, "size_t", cmd);
+    TCLAP::ValueArg<std::string> pagesArg("p", "pages", "comma separated huge page modes: thp, hugetlb, small", false, "thp,hugetlb,small", "string", cmd);
+    TCLAP::ValueArg<std::string> numaArg("", "numa", "numa policy: first_touch, interleave, bind:<node>", false, "first_touch", "string", cmd);
+
+    cmd.parse( argc, argv );
+
+    iterations = countArg.getValue();
+    std::stringstream ss(pagesArg.getValue());
+    std::string item;
+    while (std::getline(ss, item, ',')) if (!item.empty()) pages.push_back(item);
+    numa = numaArg.getValue();
+
+  } catch (TCLAP::ArgException &e)  // catch any exceptions
+  {
+    std::cerr << "error: " << e.error() << " for arg " << e.argId() << std::endl;
+    exit(-1);
+  }
+
+  printf("SIZES:\n");
+  printf("kmer size: %lu\n", sizeof(Kmer));
+  printf("Kmer Pos size: %lu\n", sizeof(KmerPos));
+  printf("vector: %lu MB\n", (iterations * sizeof(KmerPos)) >> 20);
+
+  benchmark_vector<vector_stl_alloc<KmerPos> >("vector_stl", iterations);
+  benchmark_densehash<densehash_map<::std::allocator<::std::pair<const Kmer, uint64_t> > > >("densehash_stl", iterations);
+
+  ::fsc::huge_page_options & opts = ::fsc::huge_page_options::instance();
+  opts.set_numa(numa);
+  for (auto const & mode : pages) {
+    opts.set_pages(mode);
+    opts.reset_counts();
+
+    benchmark_vector<vector_huge_page<KmerPos> >("vector_" + mode + "_" + numa, iterations);
+    benchmark_densehash<densehash_map<::fsc::huge_page_allocator<::std::pair<const Kmer, uint64_t> > > >(
+        "densehash_" + mode + "_" + numa, iterations);
 
+    printf("%s: hugetlb maps %lu, thp maps %lu, small maps %lu, mbind failures %lu\n", mode.c_str(),
+           opts.hugetlb_maps.load(), opts.thp_maps.load(), opts.small_maps.load(), opts.mbind_failures.load());
+  }
 
 }
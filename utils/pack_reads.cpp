@@ -0,0 +1,92 @@
+/*
+ * Copyright 2026 Georgia Institute of Technology
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    pack_reads.cpp
+ * @ingroup
+ * @author  agent <agent@local>
+ * @brief   converts a FASTQ or FASTA file into the 2-bit packed read format.
+ * @details the packed file can be used in place of the text file for repeated index builds.
+ *          see io/packed_read_file.hpp.  serial.
+ */
+#include "bliss-config.hpp"
+
+#include <string>
+#include <algorithm>
+#include <cstdio>
+
+#ifdef USE_MPI
+#include <mxx/env.hpp>
+#include <mxx/comm.hpp>
+#endif
+
+#include "io/fastq_loader.hpp"
+#include "io/fasta_loader.hpp"
+#include "io/packed_read_file.hpp"
+#include "utils/file_utils.hpp"
+
+#include "tclap/CmdLine.h"
+
+
+int main(int argc, char** argv) {
+
+#ifdef USE_MPI
+  ::mxx::env e(argc, argv);
+  ::mxx::comm world;
+  if (world.rank() != 0) return 0;
+#endif
+
+  std::string input;
+  std::string output;
+  bool keep_quality = true;
+
+  try {
+    TCLAP::CmdLine cmd("Convert FASTQ/FASTA file into 2-bit packed read file", ' ', "0.1");
+
+    TCLAP::ValueArg<std::string> inArg("I", "input", "FASTQ or FASTA input file path", true, "", "string", cmd);
+    TCLAP::ValueArg<std::string> outArg("O", "output", "packed read output file path. default is input path with .bpr extension", false, "", "string", cmd);
+    TCLAP::SwitchArg noQualArg("N", "no-quality", "do not store quantized quality scores", cmd, false);
+
+    cmd.parse( argc, argv );
+
+    input = inArg.getValue();
+    output = outArg.getValue();
+    if (output.empty()) output = input + ".bpr";
+    keep_quality = !noQualArg.getValue();
+
+  } catch (TCLAP::ArgException &e)  // catch any exceptions
+  {
+    std::cerr << "error: " << e.error() << " for arg " << e.argId() << std::endl;
+    exit(-1);
+  }
+
+  std::string extension = ::bliss::utils::file::get_file_extension(input);
+  std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+  std::pair<size_t, size_t> counts;
+  if (extension.compare("fastq") == 0) {
+    counts = ::bliss::io::packed_reads_converter::template convert<::bliss::io::FASTQParser>(input, output, keep_quality);
+  } else if ((extension.compare("fasta") == 0) || (extension.compare("fa") == 0)) {
+    counts = ::bliss::io::packed_reads_converter::template convert<::bliss::io::FASTAParser>(input, output, false);
+  } else {
+    std::cerr << "error: input filename extension is not supported: " << input << std::endl;
+    return -1;
+  }
+
+  printf("packed %lu reads, %lu bases from %s into %s\n", counts.first, counts.second, input.c_str(), output.c_str());
+
+  return 0;
+}
@@ -0,0 +1,76 @@
+#!/bin/bash
+
+## strong or weak scaling of the kmer index build and queries on one machine, with oversubscribed MPI.
+##
+## runs testKmerIndex-sweep once per rank count, then writes the time of each phase (max over ranks, mean over repeats),
+## the speedup and the parallel efficiency relative to the smallest rank count to <outdir>/efficiency.csv.
+##   strong:  total work fixed.  efficiency = p0 T(p0) / (p T(p)).  synthetic input is count / p kmers per rank.
+##   weak:    work per rank fixed.  efficiency = T(p0) / T(p).  synthetic input is count kmers per rank.
+## with -d, exchanges between virtual nodes are delayed (see src/utils/net_delay.hpp), e.g. -d 2:10000:4 for
+## 2 us latency, 10 GB/s per rank and 4 ranks per node.
+##
+## rank counts should be ascending;  the first is the baseline.
+## usage: scaling_sweep.sh [-b binary] [-r "1 2 4 8"] [-m strong|weak] [-w workload] [-n count] [-d delay] [-o outdir] [-- sweep args]
+##   e.g. scaling_sweep.sh -b build/bin/testKmerIndex-sweep -m weak -w spectrum -n 2000000 -d 2:10000:4 -- --map DENSEHASH
+## set MPIRUN to override the launcher, e.g. MPIRUN="mpiexec" for MPICH.  -w file uses the sweep's -F (strong only).
+
+binary=./bin/testKmerIndex-sweep
+ranks="1 2 4 8"
+mode=strong
+workload=spectrum
+count=4000000
+delay=
+outdir=scaling
+mpirun=${MPIRUN:-mpirun --oversubscribe}
+
+while getopts "b:r:m:w:n:d:o:" opt; do
+  case $opt in
+    b) binary=$OPTARG ;;
+    r) ranks=$OPTARG ;;
+    m) mode=$OPTARG ;;
+    w) workload=$OPTARG ;;
+    n) count=$OPTARG ;;
+    d) delay=$OPTARG ;;
+    o) outdir=$OPTARG ;;
+    *) grep "^##" $0 | cut -c 4-; exit 1 ;;
+  esac
+done
+shift $((OPTIND - 1))
+if [ "$1" == "--" ]; then shift; fi
+
+if [ "$mode" != "strong" ] && [ "$mode" != "weak" ]; then
+  echo "mode must be strong or weak";  exit 1
+fi
+if [ "$mode" == "weak" ] && [ "$workload" == "file" ]; then
+  echo "weak scaling needs a synthetic workload";  exit 1
+fi
+
+mkdir -p $outdir
+
+for p in $ranks; do
+  args="--workload $workload --fractions 1 -O $outdir/p$p.json"
+  if [ "$workload" != "file" ]; then
+    if [ "$mode" == "strong" ]; then
+      args="$args -n $((count / p))"
+    else
+      args="$args -n $count"
+    fi
+  fi
+  if [ -n "$delay" ]; then args="$args --net-delay $delay"; fi
+
+  echo "$mpirun -np $p $binary $args $@"
+  $mpirun -np $p $binary $args "$@" > $outdir/p$p.log 2>&1 || { echo "failed at $p ranks, see $outdir/p$p.log"; exit 1; }
+done
+
+## one line per result in the sweep's json:  {"rep":..,"fraction":..,"op":"build",..,"time_s":{"min":..,"max":..,"mean":..},..}
+echo "mode,op,ranks,time_s,speedup,efficiency" > $outdir/efficiency.csv
+for p in $ranks; do
+  grep '"op":' $outdir/p$p.json | sed -e 's/.*"op":"\([a-z]*\)".*"max":\([^,}]*\).*/\1 \2/' | \
+    awk -v p=$p '{ t[$1] += $2; n[$1] += 1 } END { for (op in t) print op, p, t[op] / n[op] }'
+done | awk -v mode=$mode '
+  { if (!($1 in t0)) { p0[$1] = $2; t0[$1] = $3 }
+    speedup = ($3 > 0) ? t0[$1] / $3 : 0
+    eff = (mode == "strong") ? speedup * p0[$1] / $2 : speedup
+    printf "%s,%s,%d,%.9f,%.3f,%.3f\n", mode, $1, $2, $3, speedup, eff }' >> $outdir/efficiency.csv
+
+column -s , -t $outdir/efficiency.csv 2>/dev/null || cat $outdir/efficiency.csv